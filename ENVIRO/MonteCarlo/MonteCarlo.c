@@ -58,8 +58,6 @@ int material_parameter; /* which parameter of the symbol specifies the material
 
 char proc_name[] = "MonteCarlo";
 
-unsigned long ray_signature;
-
 #define BLINN_PHONG 1
 #define PHONG 2
 #define PARCINOPY 3
@@ -111,6 +109,7 @@ void FreeFieldStructures(void) {
 
   if (grid.data != NULL) {
     for (i = grid.size[X] * grid.size[Y] * grid.size[Z] - 1; i >= 0; i--) {
+      FreePackedCell(&grid.data[i].packed);
       ptr = grid.data[i].list;
       while (ptr != NULL) {
         next = ptr->next;
@@ -129,6 +128,7 @@ void FreeFieldStructures(void) {
 
 /****************************************************************************/
 void InitializeFieldStructures(void) {
+  int i;
 
   FreeFieldStructures();
   num_queries = 0;
@@ -145,6 +145,9 @@ void InitializeFieldStructures(void) {
     fprintf(stderr, "%s - cannot allocate memory for the grid!\n", proc_name);
     exit(0);
   }
+
+  for (i = grid.size[X] * grid.size[Y] * grid.size[Z] - 1; i >= 0; i--)
+    InitPackedCell(&grid.data[i].packed);
 }
 
 /****************************************************************************/
@@ -898,14 +901,13 @@ int ResolveIntersection(float *pt, float *dir, int spectrum,
 int TraceRay(float *pt, float *dir, int spectrum,
              ray_spectrum_type *ray_spectrum, grid_type *grid) {
   double smallest[3], smallest_step[3];
-  float len, rnorm[3] = {0, 0, 0}, norm[3], sky_int;
-  OBJECT_LIST_TYPE *ptr;
+  float norm[3], sky_int;
   int c, node[3], ind, cstep[3], spec;
   CELL_TYPE *cell;
   primitive_type *last_primitive = NULL; /* pointer to the primitive of the
                                             last intersection */
   float mindist;                         /* so far the closest intersection */
-  primitive_type *intersected;
+  primitive_type *intersected, *prim;
   int any_intersection = 0;
   int depth; /* depth of the current ray */
 
@@ -929,13 +931,6 @@ int TraceRay(float *pt, float *dir, int spectrum,
       /* 5 should be a parameter */
       mindist = 5 * grid->maxdist;
 
-    /* increase the current ray signature */
-    if (++ray_signature == 0) {
-      ray_signature = 1;
-
-      /* all signatures of obstacles and objects should be set to 0 */
-    }
-
     for (c = X; c <= Z; c++) {
       /* adjusted according to the direction */
       if (dir[c] < 0) {
@@ -972,26 +967,13 @@ int TraceRay(float *pt, float *dir, int spectrum,
     intersected = NULL;
 
     for (;;) {
-      /* go through the list associated with the node and check for
-         intersection with each object */
-      ptr = cell->list;
-
-      while (ptr != NULL) {
-        if (ptr->prim->ray_signature != ray_signature &&
-            ptr->prim != last_primitive) {
-          /* make sure that the direction is of unit lenght! */
-          if ((len = IsIntersection(pt, dir, mindist, ptr->prim, rnorm)) >= 0) {
-            ptr->prim->ray_signature = ray_signature;
-
-            if (len < mindist) {
-              mindist = len;
-              intersected = ptr->prim;
-              for (c = X; c <= Z; c++)
-                norm[c] = rnorm[c];
-            }
-          }
-        }
-        ptr = ptr->next;
+      /* check for intersection with the objects associated with the node,
+         several at a time (the direction has to be of unit length!) */
+      if ((prim = (primitive_type *)FindPackedIntersection(
+               &cell->packed, pt, dir, &mindist, last_primitive)) != NULL) {
+        intersected = prim;
+        for (c = X; c <= Z; c++)
+          norm[c] = prim->normal[c];
       }
 
       /* determine the next node intersected by the ray */
@@ -1502,6 +1484,9 @@ void DetermineResponse(grid_type *grid) {
   Cmodule_type comm_symbol, comm_symbol2;
   float aux[MAX_SPECTRUM_SAMPLES];
 
+  /* objects may have been added since the last step */
+  PackGrid(grid);
+
   /* initializing stats */
   for (q = 0; q < num_queries; q++) {
     queries[q].ratio_mean = 0;
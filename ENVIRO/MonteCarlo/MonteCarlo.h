@@ -1,3 +1,5 @@
+#include "cellpack.h"
+
 #define MAX_SPECTRUM_SAMPLES 5
 
 struct material_type {
@@ -17,7 +19,6 @@ struct primitive_type {
   float normal[3];
   char ci;                    /* index of projection */
   material_type *material[2]; /* top and bottom */
-  unsigned long ray_signature;
 };
 typedef struct primitive_type primitive_type;
 
@@ -35,6 +36,7 @@ typedef struct OBJECT_LIST_TYPE OBJECT_LIST_TYPE;
 
 struct CELL_TYPE {
   OBJECT_LIST_TYPE *list;
+  packed_cell_type packed; /* primitives from list, see PackGrid() */
 };
 typedef struct CELL_TYPE CELL_TYPE;
 
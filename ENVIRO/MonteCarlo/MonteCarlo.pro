@@ -1,6 +1,6 @@
 TEMPLATE = app
 CONFIG   += console
-SOURCES  = MonteCarlo.c matrix.c scene3d.c sky.c message.c
+SOURCES  = MonteCarlo.c matrix.c scene3d.c sky.c cellpack.c message.c
 TARGET   = MonteCarlo
 VPATH += ../../libs/comm
 
@@ -0,0 +1,302 @@
+/*
+  Primitives of one grid cell packed for intersecting them with a ray
+  several at a time.
+
+  The tests use the same single precision arithmetic as IsIntersection()
+  in scene3d.c, so the closest primitive and the distance to it are the
+  same as when the primitives are tested one by one.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define PACK_AVX
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define PACK_SSE
+#endif
+
+#include "cellpack.h"
+
+/****************************************************************************/
+void InitPackedCell(packed_cell_type *cell) {
+  cell->num_primitives = 0;
+  cell->num_blocks = 0;
+  cell->blocks = NULL;
+  cell->source = NULL;
+}
+
+/****************************************************************************/
+void FreePackedCell(packed_cell_type *cell) {
+  if (cell->blocks != NULL)
+    free(cell->blocks);
+  InitPackedCell(cell);
+}
+
+/****************************************************************************/
+/* removes all primitives, the memory is kept for the next packing */
+void ClearPackedCell(packed_cell_type *cell, const void *source) {
+  if (cell->num_primitives > 0)
+    memset(cell->blocks, 0,
+           ((cell->num_primitives - 1) / PACK_WIDTH + 1) *
+               sizeof(packed_block_type));
+  cell->num_primitives = 0;
+  cell->source = source;
+}
+
+/****************************************************************************/
+void AddToPackedCell(packed_cell_type *cell, void *prim, const float *normal,
+                     const float *vertices, int num_vertices, int projection) {
+  packed_block_type *block;
+  const float *v0, *v1;
+  int lane, i, u, v;
+  float d;
+
+  if (cell->num_primitives == cell->num_blocks * PACK_WIDTH) {
+    cell->num_blocks = cell->num_blocks == 0 ? 1 : 2 * cell->num_blocks;
+
+    if ((block = (packed_block_type *)realloc(
+             cell->blocks, cell->num_blocks * sizeof(packed_block_type))) ==
+        NULL) {
+      fprintf(stderr, "Cellpack - cannot allocate memory for a grid cell!\n");
+      exit(0);
+    }
+    cell->blocks = block;
+
+    /* unused lanes have zero normal, which no ray intersects */
+    memset(cell->blocks + cell->num_primitives / PACK_WIDTH, 0,
+           (cell->num_blocks - cell->num_primitives / PACK_WIDTH) *
+               sizeof(packed_block_type));
+  }
+
+  block = cell->blocks + cell->num_primitives / PACK_WIDTH;
+  lane = cell->num_primitives % PACK_WIDTH;
+  cell->num_primitives++;
+
+  block->prim[lane] = prim;
+
+  for (i = 0; i < 3; i++)
+    block->normal[i][lane] = normal[i];
+
+  /* plane equation n.x + d = 0 through the first vertex */
+  d = -normal[0] * vertices[0] - normal[1] * vertices[1] -
+      normal[2] * vertices[2];
+  block->plane[lane] = -d;
+
+  /* edges in the projection plane (u,v) */
+  u = (projection + 1) % 3;
+  v = (projection + 2) % 3;
+
+  for (i = 0; i < 4; i++) {
+    v0 = vertices + 3 * (i % num_vertices);
+    v1 = vertices + 3 * ((i + 1) % num_vertices);
+
+    if (i == 3 && num_vertices == 3) {
+      /* triangle - repeat the first edge */
+      v0 = vertices;
+      v1 = vertices + 3;
+    }
+
+    block->edge[i][projection][lane] = 0;
+    block->edge[i][u][lane] = v1[v] - v0[v];
+    block->edge[i][v][lane] = v0[u] - v1[u];
+    block->edge[i][3][lane] = v1[u] * v0[v] - v1[v] * v0[u];
+  }
+}
+
+#if defined(PACK_AVX)
+
+/****************************************************************************/
+/* tests lanes [first,first+8) of the block, returns the mask of lanes
+   intersected closer than mindist and stores the distances in len */
+static int TestLanes(const packed_block_type *block, int first,
+                     const float *pt, const float *dir, float mindist,
+                     float *len) {
+  __m256 nx, ny, nz, dot, dist, ix, iy, iz, side, pos, neg, ok;
+  int e;
+
+  nx = _mm256_loadu_ps(block->normal[0] + first);
+  ny = _mm256_loadu_ps(block->normal[1] + first);
+  nz = _mm256_loadu_ps(block->normal[2] + first);
+
+  dot = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(dir[0]), nx),
+                                    _mm256_mul_ps(_mm256_set1_ps(dir[1]), ny)),
+                      _mm256_mul_ps(_mm256_set1_ps(dir[2]), nz));
+
+  dist = _mm256_sub_ps(
+      _mm256_sub_ps(
+          _mm256_sub_ps(_mm256_loadu_ps(block->plane + first),
+                        _mm256_mul_ps(_mm256_set1_ps(pt[0]), nx)),
+          _mm256_mul_ps(_mm256_set1_ps(pt[1]), ny)),
+      _mm256_mul_ps(_mm256_set1_ps(pt[2]), nz));
+  dist = _mm256_div_ps(dist, dot);
+
+  ok = _mm256_and_ps(
+      _mm256_cmp_ps(dot, _mm256_setzero_ps(), _CMP_NEQ_UQ),
+      _mm256_and_ps(_mm256_cmp_ps(dist, _mm256_setzero_ps(), _CMP_GT_OQ),
+                    _mm256_cmp_ps(dist, _mm256_set1_ps(mindist), _CMP_LT_OQ)));
+
+  if (_mm256_movemask_ps(ok) == 0)
+    return 0;
+
+  ix = _mm256_add_ps(_mm256_set1_ps(pt[0]),
+                     _mm256_mul_ps(dist, _mm256_set1_ps(dir[0])));
+  iy = _mm256_add_ps(_mm256_set1_ps(pt[1]),
+                     _mm256_mul_ps(dist, _mm256_set1_ps(dir[1])));
+  iz = _mm256_add_ps(_mm256_set1_ps(pt[2]),
+                     _mm256_mul_ps(dist, _mm256_set1_ps(dir[2])));
+
+  pos = neg = ok;
+  for (e = 0; e < 4; e++) {
+    side = _mm256_add_ps(
+        _mm256_add_ps(
+            _mm256_add_ps(
+                _mm256_mul_ps(_mm256_loadu_ps(block->edge[e][0] + first), ix),
+                _mm256_mul_ps(_mm256_loadu_ps(block->edge[e][1] + first), iy)),
+            _mm256_mul_ps(_mm256_loadu_ps(block->edge[e][2] + first), iz)),
+        _mm256_loadu_ps(block->edge[e][3] + first));
+
+    pos = _mm256_and_ps(pos,
+                        _mm256_cmp_ps(side, _mm256_setzero_ps(), _CMP_GE_OQ));
+    neg = _mm256_and_ps(neg,
+                        _mm256_cmp_ps(side, _mm256_setzero_ps(), _CMP_LT_OQ));
+  }
+
+  _mm256_storeu_ps(len, dist);
+  return _mm256_movemask_ps(_mm256_or_ps(pos, neg));
+}
+
+#define LANES 8
+
+#elif defined(PACK_SSE)
+
+/****************************************************************************/
+/* tests lanes [first,first+4) of the block, returns the mask of lanes
+   intersected closer than mindist and stores the distances in len */
+static int TestLanes(const packed_block_type *block, int first,
+                     const float *pt, const float *dir, float mindist,
+                     float *len) {
+  __m128 nx, ny, nz, dot, dist, ix, iy, iz, side, pos, neg, ok;
+  int e;
+
+  nx = _mm_loadu_ps(block->normal[0] + first);
+  ny = _mm_loadu_ps(block->normal[1] + first);
+  nz = _mm_loadu_ps(block->normal[2] + first);
+
+  dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(dir[0]), nx),
+                              _mm_mul_ps(_mm_set1_ps(dir[1]), ny)),
+                   _mm_mul_ps(_mm_set1_ps(dir[2]), nz));
+
+  dist = _mm_sub_ps(
+      _mm_sub_ps(_mm_sub_ps(_mm_loadu_ps(block->plane + first),
+                            _mm_mul_ps(_mm_set1_ps(pt[0]), nx)),
+                 _mm_mul_ps(_mm_set1_ps(pt[1]), ny)),
+      _mm_mul_ps(_mm_set1_ps(pt[2]), nz));
+  dist = _mm_div_ps(dist, dot);
+
+  ok = _mm_and_ps(_mm_cmpneq_ps(dot, _mm_setzero_ps()),
+                  _mm_and_ps(_mm_cmpgt_ps(dist, _mm_setzero_ps()),
+                             _mm_cmplt_ps(dist, _mm_set1_ps(mindist))));
+
+  if (_mm_movemask_ps(ok) == 0)
+    return 0;
+
+  ix = _mm_add_ps(_mm_set1_ps(pt[0]), _mm_mul_ps(dist, _mm_set1_ps(dir[0])));
+  iy = _mm_add_ps(_mm_set1_ps(pt[1]), _mm_mul_ps(dist, _mm_set1_ps(dir[1])));
+  iz = _mm_add_ps(_mm_set1_ps(pt[2]), _mm_mul_ps(dist, _mm_set1_ps(dir[2])));
+
+  pos = neg = ok;
+  for (e = 0; e < 4; e++) {
+    side = _mm_add_ps(
+        _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(block->edge[e][0] + first), ix),
+                       _mm_mul_ps(_mm_loadu_ps(block->edge[e][1] + first), iy)),
+            _mm_mul_ps(_mm_loadu_ps(block->edge[e][2] + first), iz)),
+        _mm_loadu_ps(block->edge[e][3] + first));
+
+    pos = _mm_and_ps(pos, _mm_cmpge_ps(side, _mm_setzero_ps()));
+    neg = _mm_and_ps(neg, _mm_cmplt_ps(side, _mm_setzero_ps()));
+  }
+
+  _mm_storeu_ps(len, dist);
+  return _mm_movemask_ps(_mm_or_ps(pos, neg));
+}
+
+#define LANES 4
+
+#else
+
+/****************************************************************************/
+/* tests lane first of the block, returns 1 if it is intersected closer
+   than mindist and stores the distance in len */
+static int TestLanes(const packed_block_type *block, int first,
+                     const float *pt, const float *dir, float mindist,
+                     float *len) {
+  float nx, ny, nz, dot, dist, I[3], side;
+  int e, pos, neg;
+
+  nx = block->normal[0][first];
+  ny = block->normal[1][first];
+  nz = block->normal[2][first];
+
+  if ((dot = dir[0] * nx + dir[1] * ny + dir[2] * nz) == 0)
+    return 0;
+
+  dist = (block->plane[first] - pt[0] * nx - pt[1] * ny - pt[2] * nz) / dot;
+
+  if (dist <= 0 || dist >= mindist)
+    return 0;
+
+  for (e = 0; e < 3; e++)
+    I[e] = pt[e] + dist * dir[e];
+
+  pos = neg = 1;
+  for (e = 0; e < 4; e++) {
+    side = block->edge[e][0][first] * I[0] + block->edge[e][1][first] * I[1] +
+           block->edge[e][2][first] * I[2] + block->edge[e][3][first];
+    if (side >= 0)
+      neg = 0;
+    else
+      pos = 0;
+  }
+
+  *len = dist;
+  return pos || neg;
+}
+
+#define LANES 1
+
+#endif
+
+/****************************************************************************/
+void *FindPackedIntersection(const packed_cell_type *cell, const float *pt,
+                             const float *dir, float *mindist,
+                             const void *skip) {
+  const packed_block_type *block;
+  float len[LANES];
+  void *closest = NULL;
+  int b, first, lane, mask;
+
+  for (b = 0; b < cell->num_primitives; b += PACK_WIDTH) {
+    block = cell->blocks + b / PACK_WIDTH;
+
+    for (first = 0; first < PACK_WIDTH && b + first < cell->num_primitives;
+         first += LANES) {
+      if ((mask = TestLanes(block, first, pt, dir, *mindist, len)) == 0)
+        continue;
+
+      /* in the order of primitives, so ties go to the first one */
+      for (lane = 0; lane < LANES; lane++)
+        if ((mask & (1 << lane)) && len[lane] < *mindist &&
+            block->prim[first + lane] != skip) {
+          *mindist = len[lane];
+          closest = block->prim[first + lane];
+        }
+    }
+  }
+
+  return closest;
+}
@@ -0,0 +1,48 @@
+/*
+  Primitives of one grid cell packed for intersecting them with a ray
+  several at a time (SSE or AVX, plain C elsewhere).
+  Shared by MonteCarlo and radiosity.
+*/
+
+#ifndef _CELLPACK_H
+#define _CELLPACK_H
+
+/* primitives in one block, the same for all instruction sets */
+#define PACK_WIDTH 8
+
+/* each primitive is stored as its plane and four edges of its projection;
+   the point is inside if it is on the same side of all edges
+   (the first edge of a triangle is repeated as the fourth one) */
+struct packed_block_type {
+  float normal[3][PACK_WIDTH];
+  float plane[PACK_WIDTH];          /* distance of the plane from origin */
+  float edge[4][4][PACK_WIDTH];     /* x, y, z coefficients and constant */
+  void *prim[PACK_WIDTH];
+};
+typedef struct packed_block_type packed_block_type;
+
+struct packed_cell_type {
+  int num_primitives;
+  int num_blocks;
+  packed_block_type *blocks;
+  const void *source; /* what the cell was packed from */
+};
+typedef struct packed_cell_type packed_cell_type;
+
+void InitPackedCell(packed_cell_type *cell);
+void FreePackedCell(packed_cell_type *cell);
+void ClearPackedCell(packed_cell_type *cell, const void *source);
+
+/* projection is the coordinate dropped when testing whether the
+   intersection is inside (0, 1 or 2); num_vertices is 3 or 4 */
+void AddToPackedCell(packed_cell_type *cell, void *prim, const float *normal,
+                     const float *vertices, int num_vertices, int projection);
+
+/* returns the closest primitive intersected by the ray (dir of unit length)
+   at a distance smaller than *mindist and updates *mindist, or NULL.
+   Primitive skip is not tested. */
+void *FindPackedIntersection(const packed_cell_type *cell, const float *pt,
+                             const float *dir, float *mindist,
+                             const void *skip);
+
+#endif
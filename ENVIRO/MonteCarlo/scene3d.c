@@ -333,7 +333,6 @@ int SetPrimitive(unsigned char flag, int float_num, array_item **last_array,
     }
 
   ptr->flag = flag;
-  ptr->ray_signature = 0;
 
   for (i = 0; i < MAX_SPECTRUM_SAMPLES; i++)
     ptr->intensity[i] = 0;
@@ -1016,3 +1015,28 @@ void FillGrid(grid_type *grid) {
   if (verbose)
     fprintf(stderr, "Grid filled.\n");
 }
+
+/*************************************************************************/
+/* packs primitives of the cells whose lists changed since the last call,
+   so they can be intersected several at a time */
+void PackGrid(grid_type *grid) {
+  int i;
+  CELL_TYPE *cell;
+  OBJECT_LIST_TYPE *ptr;
+
+  for (i = grid->size[X] * grid->size[Y] * grid->size[Z] - 1; i >= 0; i--) {
+    cell = grid->data + i;
+
+    /* lists only grow at the beginning */
+    if (cell->packed.source == cell->list)
+      continue;
+
+    ClearPackedCell(&cell->packed, cell->list);
+
+    for (ptr = cell->list; ptr != NULL; ptr = ptr->next)
+      if (ptr->prim->flag == TRIANGLE || ptr->prim->flag == POLYGON)
+        AddToPackedCell(&cell->packed, ptr->prim, ptr->prim->normal,
+                        ptr->prim->data, ptr->prim->flag == TRIANGLE ? 3 : 4,
+                        ptr->prim->ci);
+  }
+}
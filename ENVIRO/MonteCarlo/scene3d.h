@@ -21,6 +21,7 @@ primitive_type *AddTriangle(grid_type *grid, float *vertices,
                             Cmodule_type *next_symbol, int npars, int *top_mat,
                             int *bottom_mat);
 void FillGrid(grid_type *grid);
+void PackGrid(grid_type *grid);
 void OutputPrimitives(grid_type *grid);
 
 float IsIntersection(float *pt, float *dir, float mindist, primitive_type *prim,
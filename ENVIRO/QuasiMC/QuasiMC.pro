@@ -22,6 +22,7 @@ HEADERS += combinedpk.h \
            surface.h
 SOURCES += main.cpp \
            args.c \
+           bvh.c \
            combinedpk.c \
            gldisplay.cpp \
            globjwin.cpp \
@@ -39,7 +40,8 @@ SOURCES += main.cpp \
            sky.c \
            sobol.c \
            statsqmc.c \
-           surface.c
+           surface.c \
+           envthreads.cpp
 TARGET   = QuasiMC
 VPATH += ../../libs/comm
 INCLUDEPATH += ../../libs
@@ -2,6 +2,7 @@
             field specification file */
 
 #include "quasiMC.h"
+#include "envthreads.h"
 
 static char proc_name[32] = "QuasiMC";
 // all these extern variables are declared in main.cpp
@@ -27,6 +28,7 @@ extern SOURCESPECTRUM source_spectrum[MAX_SPECTRUM_SAMPLES];
 extern RUSSIANROULETTE russian_roulette;
 extern SCENE scene;
 extern int numSides;
+extern int number_of_threads;
 
 VISUALIZATION visualization;
 
@@ -61,6 +63,8 @@ static char *keywords[] = {"verbose",
                            "light source file",
                            "visualization",
                            "cylinder sides",
+                           "number of threads",
+                           "acceleration structure",
                            NULL};
 
 void DefaultSettings(void);
@@ -215,6 +219,8 @@ void DefaultSettings(void)
 
   numSides = 4;
 
+  number_of_threads = 1;
+
   return;
 }
 
@@ -839,6 +845,32 @@ void ProcessKeyword(FILE *infile, int index, int *line_num)
     if (numSides > 128)
       numSides = 128;
     break;
+
+  case 31: /* number of threads tracing rays, 0 for one per processor */
+    token = strtok(NULL, ",; \t:\n");
+    if (token == NULL) {
+      fprintf(stderr, "%s - (line: %d) nothing specified for directive %s\n",
+              proc_name, *line_num, keywords[index]);
+      break;
+    }
+    number_of_threads = NumberOfThreads(token);
+    break;
+
+  case 32: /* grid or bounding volume hierarchy */
+    token = strtok(NULL, ",; \t:\n");
+    if (token == NULL) {
+      fprintf(stderr, "%s - (line: %d) nothing specified for directive %s\n",
+              proc_name, *line_num, keywords[index]);
+      break;
+    }
+    if (!StrCaseCmp(token, "bvh"))
+      scene.bvh.enabled = 1;
+    else if (!StrCaseCmp(token, "grid"))
+      scene.bvh.enabled = 0;
+    else
+      fprintf(stderr, "%s - (line: %d) unknown acceleration structure %s\n",
+              proc_name, *line_num, token);
+    break;
   }
   return;
 }
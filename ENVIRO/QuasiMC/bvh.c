@@ -0,0 +1,439 @@
+/* bvh.c - bounding volume hierarchy over the primitives of a scene */
+
+#include "quasiMC.h"
+
+#define TRIANGLE 3 /* defines a triangle - with 3 vertices */
+#define POLYGON 4  /* defines a quad - with 4 vertices */
+
+#define BVH_BINS 12      /* candidate splits per axis */
+#define BVH_MAX_LEAF 16  /* largest leaf made when no split helps */
+#define BVH_MAX_DEPTH 64 /* deepest leaf, bounds the traversal stack */
+#define BVH_REFIT_COST 1.3f /* rebuild if refitting made it this much worse */
+
+/* parameters for all scenes */
+extern int verbose;
+
+/* local prototypes */
+void PrimitiveBounds(PRIMITIVE *prim, float *bbox);
+float BoxArea(float *bbox);
+void GrowBox(float *bbox, float *other);
+void EmptyBox(float *bbox);
+int BuildNode(BVH *bvh, float *bounds, float *centroids, int first,
+              int count, int depth);
+float RefitBVH(SCENE *scene);
+
+/* ------------------------------------------------------------------------- */
+
+void InitBVH(BVH *bvh)
+/* sets an empty hierarchy - the grid is used unless enabled is set */
+{
+  bvh->enabled = 0;
+  bvh->nodes = NULL;
+  bvh->num_nodes = 0;
+  bvh->list = NULL;
+  bvh->num_primitives = 0;
+  bvh->max_primitives = 0;
+  bvh->cost = 0.f;
+
+  return;
+}
+
+/* ------------------------------------------------------------------------- */
+
+void FreeBVH(BVH *bvh)
+/* frees the nodes of the hierarchy */
+{
+  if (bvh->nodes != NULL)
+    free(bvh->nodes);
+  if (bvh->list != NULL)
+    free(bvh->list);
+  bvh->nodes = NULL;
+  bvh->list = NULL;
+  bvh->num_nodes = 0;
+  bvh->num_primitives = 0;
+  bvh->max_primitives = 0;
+
+  return;
+}
+
+/* ------------------------------------------------------------------------- */
+
+void UpdateBVH(SCENE *scene)
+/* builds the hierarchy for the primitives in the scene. If the number of
+   primitives did not change since the last step the boxes are only refit,
+   unless that makes the hierarchy much worse than a new one would be */
+{
+  BVH *bvh;
+  float *bounds, *centroids;
+  float cost;
+  int i, x;
+
+  bvh = &scene->bvh;
+
+  if (bvh->num_nodes > 0 && bvh->num_primitives == scene->num_primitives) {
+    cost = RefitBVH(scene);
+    if (cost <= BVH_REFIT_COST * bvh->cost) {
+      if (verbose >= 1)
+        fprintf(stderr, "QuasiMC - BVH refit (cost %g, built %g)\n", cost,
+                bvh->cost);
+      return;
+    }
+  }
+
+  bvh->num_nodes = 0;
+  bvh->num_primitives = scene->num_primitives;
+  if (scene->num_primitives == 0)
+    return;
+
+  /* a binary tree with one primitive per leaf at most has 2n-1 nodes */
+  if (scene->num_primitives > bvh->max_primitives) {
+    if (bvh->nodes != NULL)
+      free(bvh->nodes);
+    if (bvh->list != NULL)
+      free(bvh->list);
+    bvh->nodes =
+        (BVHNODE *)malloc(sizeof(BVHNODE) * 2 * scene->num_primitives);
+    bvh->list = (int *)malloc(sizeof(int) * scene->num_primitives);
+    if (bvh->nodes == NULL || bvh->list == NULL) {
+      fprintf(stderr, "bvh - cannot allocate memory for the hierarchy\n");
+      FreeBVH(bvh);
+      return;
+    }
+    bvh->max_primitives = scene->num_primitives;
+  }
+
+  bounds = (float *)malloc(sizeof(float) * 6 * scene->num_primitives);
+  centroids = (float *)malloc(sizeof(float) * 3 * scene->num_primitives);
+  if (bounds == NULL || centroids == NULL) {
+    fprintf(stderr, "bvh - cannot allocate memory for the hierarchy\n");
+    if (bounds != NULL)
+      free(bounds);
+    if (centroids != NULL)
+      free(centroids);
+    bvh->num_primitives = 0;
+    return;
+  }
+
+  for (i = 0; i < scene->num_primitives; i++) {
+    bvh->list[i] = i;
+    PrimitiveBounds(&scene->primitives[i], bounds + 6 * i);
+    for (x = X; x <= Z; x++)
+      centroids[3 * i + x] =
+          0.5f * (bounds[6 * i + x] + bounds[6 * i + x + 3]);
+  }
+
+  BuildNode(bvh, bounds, centroids, 0, scene->num_primitives, 0);
+  free(bounds);
+  free(centroids);
+
+  bvh->cost = RefitBVH(scene);
+
+  if (verbose >= 1)
+    fprintf(stderr, "QuasiMC - BVH built with %d nodes (cost %g)\n",
+            bvh->num_nodes, bvh->cost);
+
+  return;
+}
+
+/* ------------------------------------------------------------------------- */
+
+int BuildNode(BVH *bvh, float *bounds, float *centroids, int first,
+              int count, int depth)
+/* builds the subtree for the primitives list[first..first+count-1] using
+   the surface area heuristic over binned centroids, returns its node.
+   A node which could not otherwise reach leaves of BVH_MAX_LEAF
+   primitives by BVH_MAX_DEPTH is split in halves instead */
+{
+  BVHNODE *node;
+  float bin_box[BVH_BINS][6], left_box[6], right_box[6];
+  float left_area[BVH_BINS];
+  float extent[6], scale, cost, best_cost;
+  int bin_count[BVH_BINS], left_count[BVH_BINS];
+  int index, i, j, x, b, best_axis, best_bin, n;
+
+  index = bvh->num_nodes++;
+  node = &bvh->nodes[index];
+
+  /* bounds of the node and of the centroids */
+  EmptyBox(node->bbox);
+  EmptyBox(extent);
+  for (i = first; i < first + count; i++) {
+    GrowBox(node->bbox, bounds + 6 * bvh->list[i]);
+    for (x = X; x <= Z; x++) {
+      extent[x] = MIN2D(extent[x], centroids[3 * bvh->list[i] + x]);
+      extent[x + 3] = MAX2D(extent[x + 3], centroids[3 * bvh->list[i] + x]);
+    }
+  }
+
+  /* cost of a leaf is the number of primitives to test, of a split one
+     traversal step plus the tests weighted by the area of the children */
+  best_cost = 1e30f;
+  best_axis = -1;
+  best_bin = 0;
+  if (count > 2)
+    for (x = X; x <= Z; x++) {
+      if (extent[x + 3] - extent[x] <= 0.f)
+        continue;
+      scale = (float)BVH_BINS / (extent[x + 3] - extent[x]);
+
+      for (b = 0; b < BVH_BINS; b++) {
+        bin_count[b] = 0;
+        EmptyBox(bin_box[b]);
+      }
+      for (i = first; i < first + count; i++) {
+        b = (int)((centroids[3 * bvh->list[i] + x] - extent[x]) * scale);
+        b = MIN2D(b, BVH_BINS - 1);
+        ++bin_count[b];
+        GrowBox(bin_box[b], bounds + 6 * bvh->list[i]);
+      }
+
+      /* sweep from the left, then from the right evaluating the splits */
+      EmptyBox(left_box);
+      n = 0;
+      for (b = 0; b < BVH_BINS - 1; b++) {
+        n += bin_count[b];
+        GrowBox(left_box, bin_box[b]);
+        left_count[b] = n;
+        left_area[b] = n > 0 ? BoxArea(left_box) : 0.f;
+      }
+      EmptyBox(right_box);
+      n = 0;
+      for (b = BVH_BINS - 1; b > 0; b--) {
+        n += bin_count[b];
+        GrowBox(right_box, bin_box[b]);
+        if (left_count[b - 1] == 0 || n == 0)
+          continue;
+        cost = 1.f + (left_area[b - 1] * (float)left_count[b - 1] +
+                      BoxArea(right_box) * (float)n) /
+                         BoxArea(node->bbox);
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_axis = x;
+          best_bin = b;
+        }
+      }
+    }
+
+  if (count <= BVH_MAX_LEAF &&
+      (best_axis < 0 || best_cost >= (float)count || depth >= BVH_MAX_DEPTH)) {
+    node->index = first;
+    node->count = (unsigned short)count;
+    node->axis = 0;
+    return (index);
+  }
+
+  if (best_axis < 0 ||
+      (depth < BVH_MAX_DEPTH && BVH_MAX_DEPTH - depth < 24 &&
+       count > BVH_MAX_LEAF << (BVH_MAX_DEPTH - depth - 1))) {
+    /* the centroids coincide or the depth runs out - split the primitives
+       in halves */
+    n = count / 2;
+    best_axis = MAX3Di(node->bbox[X + 3] - node->bbox[X],
+                       node->bbox[Y + 3] - node->bbox[Y],
+                       node->bbox[Z + 3] - node->bbox[Z]);
+  } else {
+    /* partition the list on the chosen bin */
+    scale = (float)BVH_BINS / (extent[best_axis + 3] - extent[best_axis]);
+    i = first;
+    j = first + count - 1;
+    while (i <= j) {
+      b = (int)((centroids[3 * bvh->list[i] + best_axis] - extent[best_axis]) *
+                scale);
+      if (MIN2D(b, BVH_BINS - 1) < best_bin)
+        ++i;
+      else {
+        b = bvh->list[i];
+        bvh->list[i] = bvh->list[j];
+        bvh->list[j--] = b;
+      }
+    }
+    n = i - first;
+  }
+
+  /* the first child follows its parent, index points to the second one */
+  node->count = 0;
+  node->axis = (unsigned short)best_axis;
+  BuildNode(bvh, bounds, centroids, first, n, depth + 1);
+  i = BuildNode(bvh, bounds, centroids, first + n, count - n, depth + 1);
+  bvh->nodes[index].index = i;
+
+  return (index);
+}
+
+/* ------------------------------------------------------------------------- */
+
+float RefitBVH(SCENE *scene)
+/* recomputes the boxes of all nodes bottom-up and returns the cost of the
+   hierarchy according to the surface area heuristic */
+{
+  BVH *bvh;
+  BVHNODE *node;
+  float bbox[6], cost;
+  int i, j;
+
+  bvh = &scene->bvh;
+  cost = 0.f;
+
+  /* children are always stored after their parent */
+  for (i = bvh->num_nodes - 1; i >= 0; i--) {
+    node = &bvh->nodes[i];
+    if (node->count > 0) {
+      EmptyBox(node->bbox);
+      for (j = node->index; j < node->index + node->count; j++) {
+        PrimitiveBounds(&scene->primitives[bvh->list[j]], bbox);
+        GrowBox(node->bbox, bbox);
+      }
+      cost += BoxArea(node->bbox) * (float)node->count;
+    } else {
+      memcpy(node->bbox, bvh->nodes[i + 1].bbox, sizeof(float) * 6);
+      GrowBox(node->bbox, bvh->nodes[node->index].bbox);
+      cost += BoxArea(node->bbox);
+    }
+  }
+
+  if (bvh->num_nodes > 0 && BoxArea(bvh->nodes[0].bbox) > 0.f)
+    cost /= BoxArea(bvh->nodes[0].bbox);
+
+  return (cost);
+}
+
+/* ------------------------------------------------------------------------- */
+
+float FindBVHIntersection(SCENE *scene, RAY *ray, int skip, float *normal,
+                          PRIMITIVE **intersected, int *index)
+/* returns the distance to the closest primitive hit by the ray (other than
+   the one at skip) or -1 if there is none. The primitives are tested with
+   IsIntersection, as in the cells of the grid */
+{
+  BVH *bvh;
+  BVHNODE *node;
+  PRIMITIVE *prim;
+  float inv_dir[3], near_t, far_t, t0, t1, tmp;
+  float norm[3], dist, mindist;
+  int stack[BVH_MAX_DEPTH + 1];
+  int top, i, x;
+
+  bvh = &scene->bvh;
+  *intersected = NULL;
+  if (bvh->num_nodes == 0)
+    return (-1.0);
+
+  for (x = X; x <= Z; x++)
+    inv_dir[x] = fabs(ray->dir[x]) > 1e-20 ? 1.0f / ray->dir[x]
+                                           : (ray->dir[x] < 0.0 ? -1e20f
+                                                                : 1e20f);
+
+  mindist = 1e30f;
+  top = 0;
+  stack[top++] = 0;
+  while (top > 0) {
+    node = &bvh->nodes[stack[--top]];
+
+    /* slab test of the box against the segment up to the closest hit */
+    near_t = 0.f;
+    far_t = mindist;
+    for (x = X; x <= Z; x++) {
+      t0 = (node->bbox[x] - ray->pt[x]) * inv_dir[x];
+      t1 = (node->bbox[x + 3] - ray->pt[x]) * inv_dir[x];
+      if (t0 > t1) {
+        tmp = t0;
+        t0 = t1;
+        t1 = tmp;
+      }
+      near_t = MAX2D(near_t, t0);
+      far_t = MIN2D(far_t, t1);
+    }
+    if (near_t > far_t)
+      continue;
+
+    if (node->count > 0) {
+      for (i = node->index; i < node->index + node->count; i++) {
+        if (bvh->list[i] == skip)
+          continue;
+        dist = IsIntersection(scene, ray, bvh->list[i], mindist, norm, &prim);
+        if (dist >= 0.0 && dist < mindist) {
+          mindist = dist;
+          *intersected = prim;
+          *index = bvh->list[i];
+          normal[X] = norm[X];
+          normal[Y] = norm[Y];
+          normal[Z] = norm[Z];
+        }
+      }
+    } else {
+      /* visit the child closer to the ray origin first */
+      if (ray->dir[node->axis] < 0.0) {
+        stack[top++] = (int)(node - bvh->nodes) + 1;
+        stack[top++] = node->index;
+      } else {
+        stack[top++] = node->index;
+        stack[top++] = (int)(node - bvh->nodes) + 1;
+      }
+    }
+  }
+
+  return (*intersected != NULL ? mindist : -1.0f);
+}
+
+/* ------------------------------------------------------------------------- */
+
+void PrimitiveBounds(PRIMITIVE *prim, float *bbox)
+/* sets bbox to the box around the triangle or quad */
+{
+  int x;
+
+  for (x = X; x <= Z; x++) {
+    bbox[x + 3] = MAX3D(prim->data[x], prim->data[x + 3], prim->data[x + 6]);
+    bbox[x] = MIN3D(prim->data[x], prim->data[x + 3], prim->data[x + 6]);
+    if (prim->object_type == POLYGON) {
+      bbox[x + 3] = MAX2D(bbox[x + 3], prim->data[x + 9]);
+      bbox[x] = MIN2D(bbox[x], prim->data[x + 9]);
+    }
+  }
+
+  return;
+}
+
+/* ------------------------------------------------------------------------- */
+
+float BoxArea(float *bbox)
+/* returns the surface area of the box */
+{
+  float dx, dy, dz;
+
+  dx = bbox[X + 3] - bbox[X];
+  dy = bbox[Y + 3] - bbox[Y];
+  dz = bbox[Z + 3] - bbox[Z];
+  if (dx < 0.f || dy < 0.f || dz < 0.f)
+    return (0.f);
+
+  return (2.0f * (dx * dy + dy * dz + dz * dx));
+}
+
+/* ------------------------------------------------------------------------- */
+
+void GrowBox(float *bbox, float *other)
+/* extends bbox to contain the other box */
+{
+  int x;
+
+  for (x = X; x <= Z; x++) {
+    bbox[x] = MIN2D(bbox[x], other[x]);
+    bbox[x + 3] = MAX2D(bbox[x + 3], other[x + 3]);
+  }
+
+  return;
+}
+
+/* ------------------------------------------------------------------------- */
+
+void EmptyBox(float *bbox)
+/* sets a box that contains nothing */
+{
+  bbox[X] = bbox[Y] = bbox[Z] = 1e30f;
+  bbox[X + 3] = bbox[Y + 3] = bbox[Z + 3] = -1e30f;
+
+  return;
+}
+
+/* ------------------------------------------------------------------------- */
@@ -47,6 +47,7 @@ RUSSIANROULETTE russian_roulette;
 QUERIES queries;
 SCENE scene;
 int numSides; // the number of sides on the triangulated cylinder
+int number_of_threads; // the number of threads tracing rays
 
 // RQMC points
 double *pointqmc, *rpointqmc, *randqmc;
@@ -196,7 +197,10 @@ void quasiMCThread::run(void) {
     if (!new_data) {
       scene_mutex.lock();
       FindBoundingSphere(&scene);
-      FillGrid(&scene);
+      if (scene.bvh.enabled)
+        UpdateBVH(&scene);
+      else
+        FillGrid(&scene);
       scene_mutex.unlock();
 
       if (queries.num_queries > 0) {
@@ -234,6 +238,7 @@ void quasiMCThread::run(void) {
   // thread thus, I ensured that freeing memory in Scene3d will not cause faults
   // in debugwindow.
   FreeQMC();
+  FreeTracers();
   FreeQuery(&queries);
   // lock the mutex for freeing memory, so debug window doesn't try to draw
   // while memory is being freed!
@@ -3,6 +3,7 @@
 #include "quasiMC.h"
 #include "qmc.h"
 #include "randquasimc.h"
+#include "envthreads.h"
 
 static char proc_name[32] = "QuasiMC";
 
@@ -35,6 +36,46 @@ extern SCENE scene;
 extern double *pointqmc, *rpointqmc, *randqmc; // RQMC points
 extern double npoints;
 extern int numSides;
+extern int number_of_threads;
+
+// number of rays given to each thread at a time
+#define RAY_BATCH 1024
+
+// light reaching a primitive, recorded by a thread
+typedef struct tagFLUXRECORD {
+  int index;
+  int spectrum;
+  float absorbed, incident, hits;
+} FLUXRECORD;
+
+// the ray and sums of a thread, the sums of all threads are added in the
+// order of the threads so the results depend only on their number
+typedef struct tagTRACER {
+  RAY ray;
+  unsigned int hits;
+  float flux[MAX_SPECTRUM_SAMPLES];  // light available to the rays
+  float value[MAX_SPECTRUM_SAMPLES]; // light reaching the virtual sensor
+  FLUXRECORD *records;
+  int num_records, max_records;
+  int cos_angles; // if set the cosine angles of primitives are summed
+  float *cos_angle;
+} TRACER;
+
+// the rays traced by the threads at a time
+typedef struct tagRAYBATCH {
+  QUERY *query;
+  int spectrum;
+  int threads;
+  unsigned int first, count;
+} RAYBATCH;
+
+static TRACER serial;            // rays traced on the main thread
+static TRACER *tracers = NULL;   // rays traced on several threads
+static int num_tracers = 0;      // threads allocated
+static int tracer_primitives = 0;
+static double *batch_points = NULL; // RQMC points of the batch
+static int batch_dimen = 0;
+static THREAD_LOCAL TRACER *thread_tracer = NULL;
 
 // local prototypes
 
@@ -42,6 +83,14 @@ int ReadPolygons(int master, unsigned long module_id, int polygon_num,
                  Cmodule_type *two_modules, CTURTLE *turtle);
 void ShootRaysFromObjects(QUERY *query, Cmodule_type *comm_module);
 void ShootAllRays(void);
+void ShootSensorRay(TRACER *tracer, unsigned int i, QUERY *query, int spectrum);
+void ShootLightRay(TRACER *tracer, unsigned int i, int spectrum);
+void ShootRays(QUERY *query, int spectrum, int threads);
+void TraceBatch(int thread, void *data);
+int StartTracers(int cos_angles);
+TRACER *FinishTracers(int threads);
+void AddFlux(PRIMITIVE *prim, int spectrum, float absorbed, float incident,
+             float hits);
 
 int TraceRay(RAY *ray, int spectrum);
 int ResolveIntersection(RAY *ray, float *normal, float mindist,
@@ -790,148 +839,33 @@ void ShootRaysFromObjects(QUERY *query, Cmodule_type *comm_module)
 /* shoot rays from the polygon in "query" and determine amount of light reaching
    it */
 {
-  RAY ray;
-  float ldir[3]; // light direction
-  unsigned int i, hits;
-  float num, temp;
-  int spectrum;
+  TRACER *sums;
+  unsigned int hits;
+  int spectrum, threads;
 
   // NOTE: virtual sensors should not have material properties, only a
   // scattering exponent! because virtual sensors do not absorb light! so return
   // type cannot be F or D, as those are for absorbed light
 
-  // determine the number of rays
-  num = (float)npoints;
-
-  hits = 0;
-  for (spectrum = 0; spectrum < spectrum_samples; spectrum++) {
-    comm_module->params[spectrum].value = 0;
-    total_spectrum_flux[spectrum] = 0.f;
-  }
-
-  if (one_ray_per_spectrum) {
-    ResetQMC();
-    randqmc = GenRandom();
+  threads = StartTracers(0);
 
-    for (i = (unsigned int)num; i > 0; i--) {
-      pointqmc = QMC();
-      rpointqmc = AppRandom(pointqmc, randqmc);
-      ResetU01();
-
-      GenerateRayFromSensor(&ray, ldir, query, 0);
-      temp = ray.intensity[0];
-      // save total available light and set ray intensity
-      for (spectrum = 0; spectrum < spectrum_samples; spectrum++) {
-        if (return_type[spectrum] != LW_INCIDENT_IRRADIANCE)
-          total_spectrum_flux[spectrum] += temp;
-        else
-          temp = 1.0;
-
-        // adjust ray intensity according to angle between its direction and
-        // surface's normal this is the normalizing term so a flat surface at
-        // top of canopy gets 1 W/m^2 taking the abs() is necessary to avoid
-        // multiplying by negative numbers when the light is below the surface
-        // (this could change if we are only interested in the top side of the
-        // sensor)
-        ray.intensity[spectrum] = temp *
-                                  (float)fabs(DotProduct(ray.dir, query->up)) *
-                                  source_spectrum[spectrum].weight;
-      }
-
-      // if (FindBoxIntersection (&scene, &ray))
-      {
-        if (verbose >= 3) {
-          fprintf(stderr, "\n%s - tracing ray %d for %d spectrum samples:\n",
-                  proc_name, i, spectrum);
-          fprintf(stderr, "\t(%g, %g, %g) + t*(%g, %g, %g)\n", ray.pt[X],
-                  ray.pt[Y], ray.pt[Z], ray.dir[X], ray.dir[Y], ray.dir[Z]);
-          glDisplayRay(ray);
-        }
-        // the 2nd parameter is arbitrary because all wavelengths are evaluated
-        hits += TraceRay(&ray, 0);
-      }
-      for (spectrum = 0; spectrum < spectrum_samples; spectrum++)
-        if (return_type[spectrum] != LW_INCIDENT_IRRADIANCE) {
-          comm_module->params[spectrum].value +=
-              ray.intensity[spectrum] * (float)fabs(DotProduct(ldir, ray.dir));
-        } else {
-          if (use_sky_model) {
-            total_spectrum_flux[spectrum] = 1.0; // GetSkyIntensity (ray.dir);
-            comm_module->params[spectrum].value +=
-                ray.intensity[spectrum] * GetSkyIntensity(ray.dir);
-          } else
-            fprintf(stderr,
-                    "QuasiMC - shoot rays from lower surface of virtual sensor "
-                    "not implemented for light source\n");
-        }
-
-      if (verbose >= 3)
-        fprintf(stderr, "%s - ray %d killed\n", proc_name, i);
-    }
-  } else {
+  if (one_ray_per_spectrum)
+    ShootRays(query, 0, threads);
+  else
     // for each wavelength
-    for (spectrum = 0; spectrum < spectrum_samples; spectrum++) {
-      ResetQMC();
-      randqmc = GenRandom();
-
-      // for number of rays
-      for (i = (unsigned int)num; i > 0; i--) {
-        pointqmc = QMC();
-        rpointqmc = AppRandom(pointqmc, randqmc);
-        ResetU01();
-
-        GenerateRayFromSensor(&ray, ldir, query, spectrum);
-        if (return_type[spectrum] != LW_INCIDENT_IRRADIANCE)
-          total_spectrum_flux[spectrum] += ray.intensity[spectrum];
-        else
-          ray.intensity[spectrum] = 1.0;
-        // adjust ray intensity according to angle between its direction and
-        // surface's normal taking the abs() is necessary to avoid multiplying
-        // by negative numbers when the light is below the surface (this could
-        // change if we are only interested in the top side of the sensor)
-        ray.intensity[spectrum] *= (float)fabs(DotProduct(ray.dir, query->up)) *
-                                   source_spectrum[spectrum].weight;
-
-        // I turned off findboxintersection for rays_from_objects because
-        // it didn't work.  instead i've included the sensors in the bounding
-        // box and sphere of the scene, so rays generated from sensors already
-        // intersect the bounding box.
-        // BUT do the sensors really have to be included in bounding box?
-        // The senors are never tested for intersection anyway...
-        // if (FindBoxIntersection (&scene, &ray))
-        //{
-        if (verbose >= 3) {
-          fprintf(stderr, "\n%s - tracing ray %d for spectrum %d:\n", proc_name,
-                  i, spectrum + 1);
-          fprintf(stderr, "\t(%g, %g, %g) + t*(%g, %g, %g)\n", ray.pt[X],
-                  ray.pt[Y], ray.pt[Z], ray.dir[X], ray.dir[Y], ray.dir[Z]);
-          fprintf(stderr, "\tlight dir: %g, %g, %g\n", ldir[X], ldir[Y],
-                  ldir[Z]);
-          fprintf(stderr, "\tintensity: %g\n", ray.intensity[spectrum]);
-          glDisplayRay(ray);
-        }
-
-        hits += TraceRay(&ray, spectrum);
-        if (return_type[spectrum] != LW_INCIDENT_IRRADIANCE) {
-          // adjust ray intensity according to angle between final ray direction
-          // and the original shooting direction
-          comm_module->params[spectrum].value +=
-              ray.intensity[spectrum] * (float)fabs(DotProduct(ldir, ray.dir));
-        } else {
-          if (use_sky_model) {
-            total_spectrum_flux[spectrum] = 1.0; // GetSkyIntensity (ray.dir);
-            comm_module->params[spectrum].value +=
-                ray.intensity[spectrum] * GetSkyIntensity(ray.dir);
-          } else
-            fprintf(stderr,
-                    "QuasiMC - shoot rays from lower surface of virtual sensor "
-                    "not implemented for light source\n");
-        }
+    for (spectrum = 0; spectrum < spectrum_samples; spectrum++)
+      ShootRays(query, spectrum, threads);
 
-        if (verbose >= 3)
-          fprintf(stderr, "%s - ray %d killed\n", proc_name, i);
-      }
-    }
+  sums = FinishTracers(threads);
+  hits = sums->hits;
+  for (spectrum = 0; spectrum < spectrum_samples; spectrum++) {
+    comm_module->params[spectrum].value = sums->value[spectrum];
+    if (return_type[spectrum] != LW_INCIDENT_IRRADIANCE)
+      total_spectrum_flux[spectrum] = sums->flux[spectrum];
+    else if (use_sky_model)
+      total_spectrum_flux[spectrum] = 1.0; // GetSkyIntensity (ray.dir);
+    else
+      total_spectrum_flux[spectrum] = 0.f;
   }
 
   for (spectrum = 0; spectrum < spectrum_samples; spectrum++) {
@@ -963,6 +897,117 @@ void ShootRaysFromObjects(QUERY *query, Cmodule_type *comm_module)
 
 /* ------------------------------------------------------------------------- */
 
+void ShootSensorRay(TRACER *tracer, unsigned int i, QUERY *query, int spectrum)
+/* generate and trace ray i from the virtual sensor in "query" */
+{
+  RAY *ray;
+  float ldir[3]; // light direction
+  float temp;
+
+  ray = &tracer->ray;
+
+  if (one_ray_per_spectrum) {
+    GenerateRayFromSensor(ray, ldir, query, 0);
+    temp = ray->intensity[0];
+    // save total available light and set ray intensity
+    for (spectrum = 0; spectrum < spectrum_samples; spectrum++) {
+      if (return_type[spectrum] != LW_INCIDENT_IRRADIANCE)
+        tracer->flux[spectrum] += temp;
+      else
+        temp = 1.0;
+
+      // adjust ray intensity according to angle between its direction and
+      // surface's normal this is the normalizing term so a flat surface at
+      // top of canopy gets 1 W/m^2 taking the abs() is necessary to avoid
+      // multiplying by negative numbers when the light is below the surface
+      // (this could change if we are only interested in the top side of the
+      // sensor)
+      ray->intensity[spectrum] = temp *
+                                 (float)fabs(DotProduct(ray->dir, query->up)) *
+                                 source_spectrum[spectrum].weight;
+    }
+
+    // if (FindBoxIntersection (&scene, ray))
+    {
+      if (verbose >= 3) {
+        fprintf(stderr, "\n%s - tracing ray %d for %d spectrum samples:\n",
+                proc_name, i, spectrum);
+        fprintf(stderr, "\t(%g, %g, %g) + t*(%g, %g, %g)\n", ray->pt[X],
+                ray->pt[Y], ray->pt[Z], ray->dir[X], ray->dir[Y], ray->dir[Z]);
+        glDisplayRay(*ray);
+      }
+      // the 2nd parameter is arbitrary because all wavelengths are evaluated
+      tracer->hits += TraceRay(ray, 0);
+    }
+    for (spectrum = 0; spectrum < spectrum_samples; spectrum++)
+      if (return_type[spectrum] != LW_INCIDENT_IRRADIANCE) {
+        tracer->value[spectrum] +=
+            ray->intensity[spectrum] * (float)fabs(DotProduct(ldir, ray->dir));
+      } else {
+        if (use_sky_model)
+          tracer->value[spectrum] +=
+              ray->intensity[spectrum] * GetSkyIntensity(ray->dir);
+        else
+          fprintf(stderr,
+                  "QuasiMC - shoot rays from lower surface of virtual sensor "
+                  "not implemented for light source\n");
+      }
+  } else {
+    GenerateRayFromSensor(ray, ldir, query, spectrum);
+    if (return_type[spectrum] != LW_INCIDENT_IRRADIANCE)
+      tracer->flux[spectrum] += ray->intensity[spectrum];
+    else
+      ray->intensity[spectrum] = 1.0;
+    // adjust ray intensity according to angle between its direction and
+    // surface's normal taking the abs() is necessary to avoid multiplying
+    // by negative numbers when the light is below the surface (this could
+    // change if we are only interested in the top side of the sensor)
+    ray->intensity[spectrum] *= (float)fabs(DotProduct(ray->dir, query->up)) *
+                                source_spectrum[spectrum].weight;
+
+    // I turned off findboxintersection for rays_from_objects because
+    // it didn't work.  instead i've included the sensors in the bounding
+    // box and sphere of the scene, so rays generated from sensors already
+    // intersect the bounding box.
+    // BUT do the sensors really have to be included in bounding box?
+    // The senors are never tested for intersection anyway...
+    // if (FindBoxIntersection (&scene, ray))
+    //{
+    if (verbose >= 3) {
+      fprintf(stderr, "\n%s - tracing ray %d for spectrum %d:\n", proc_name,
+              i, spectrum + 1);
+      fprintf(stderr, "\t(%g, %g, %g) + t*(%g, %g, %g)\n", ray->pt[X],
+              ray->pt[Y], ray->pt[Z], ray->dir[X], ray->dir[Y], ray->dir[Z]);
+      fprintf(stderr, "\tlight dir: %g, %g, %g\n", ldir[X], ldir[Y], ldir[Z]);
+      fprintf(stderr, "\tintensity: %g\n", ray->intensity[spectrum]);
+      glDisplayRay(*ray);
+    }
+
+    tracer->hits += TraceRay(ray, spectrum);
+    if (return_type[spectrum] != LW_INCIDENT_IRRADIANCE) {
+      // adjust ray intensity according to angle between final ray direction
+      // and the original shooting direction
+      tracer->value[spectrum] +=
+          ray->intensity[spectrum] * (float)fabs(DotProduct(ldir, ray->dir));
+    } else {
+      if (use_sky_model)
+        tracer->value[spectrum] +=
+            ray->intensity[spectrum] * GetSkyIntensity(ray->dir);
+      else
+        fprintf(stderr,
+                "QuasiMC - shoot rays from lower surface of virtual sensor "
+                "not implemented for light source\n");
+    }
+  }
+
+  if (verbose >= 3)
+    fprintf(stderr, "%s - ray %d killed\n", proc_name, i);
+
+  return;
+}
+
+/* ------------------------------------------------------------------------- */
+
 void GenerateRayFromSensor(RAY *ray, float *ldir, QUERY *query, int spectrum)
 // generate a ray from a virtual sensor
 // if directional light source is used, generate a ray towards the light source
@@ -1064,113 +1109,314 @@ void GenerateRayFromSensor(RAY *ray, float *ldir, QUERY *query, int spectrum)
 void ShootAllRays(void)
 /* shoot rays from the light sources */
 {
-  RAY ray;
-  float num;
-  int spectrum;
-  unsigned int i, hits, rays;
+  TRACER *sums;
+  int spectrum, threads;
 
-  hits = rays = 0;
+  threads = StartTracers(return_var && use_sky_model);
 
-  if (one_ray_per_spectrum) {
-    ResetQMC();
-    randqmc = GenRandom();
+  if (one_ray_per_spectrum)
+    ShootRays(NULL, 0, threads);
+  else
+    // for each wavelength
+    for (spectrum = 0; spectrum < spectrum_samples; spectrum++)
+      ShootRays(NULL, spectrum, threads);
+
+  // OLD CODE: divide available light by area of projected bounding sphere
+  // this is now done in the DetermineResponse function
+  // spectrum_density[spectrum] /= M_PIf * scene.grid.bsph_radius *
+  // scene.grid.bsph_radius;
+  sums = FinishTracers(threads);
+  for (spectrum = 0; spectrum < spectrum_samples; spectrum++)
+    total_spectrum_flux[spectrum] = sums->flux[spectrum];
+
+  if (verbose >= 1)
+    fprintf(stderr, "%s - number of intersections %d from %g rays\n", proc_name,
+            sums->hits, npoints);
+
+  return;
+}
+
+/* ------------------------------------------------------------------------- */
+
+void ShootLightRay(TRACER *tracer, unsigned int i, int spectrum)
+/* generate and trace ray i from the light sources */
+{
+  RAY *ray;
+
+  ray = &tracer->ray;
 
-    /* determine the number of rays */
-    num = (float)npoints;
+  GenerateRandomRay(ray);
+  // increment the spectrum density by amount of available light
+  // NOTE: do not incorporate direction of incoming light with respect to
+  // zenith for multiple lights, because the returned radiant flux is
+  // averaged over the directional light sources
+  if (one_ray_per_spectrum) {
     for (spectrum = 0; spectrum < spectrum_samples; spectrum++)
-      total_spectrum_flux[spectrum] = 0.f;
+      tracer->flux[spectrum] += ray->intensity[spectrum];
+    spectrum = 0;
+  } else
+    tracer->flux[spectrum] += ray->intensity[spectrum];
+
+  if (FindBoxIntersection(&scene, ray)) {
+    if (verbose >= 3) {
+      if (one_ray_per_spectrum)
+        fprintf(stderr, "\n%s - tracing ray %d for %d spectrum samples:\n",
+                proc_name, i, spectrum_samples);
+      else
+        fprintf(stderr,
+                "\n%s - tracing ray %d for spectrum %d, with energy %g:\n",
+                proc_name, i, spectrum + 1, ray->intensity[spectrum]);
+      fprintf(stderr, "\t(%g, %g, %g) + t*(%g, %g, %g)\n", ray->pt[X],
+              ray->pt[Y], ray->pt[Z], ray->dir[X], ray->dir[Y], ray->dir[Z]);
+      glDisplayRay(*ray);
+    }
+
+    // the 2nd parameter is not used if one ray for entire spectrums is used
+    tracer->hits += TraceRay(ray, spectrum);
+
+    if (verbose >= 3)
+      fprintf(stderr, "%s - ray %d killed\n", proc_name, i);
+  } else if (verbose >= 3)
+    fprintf(stderr, "%s - ray %d does not intersect bounding box\n", proc_name,
+            i);
+
+  return;
+}
 
-    for (i = 0; i < (unsigned int)num; i++) {
+/* ------------------------------------------------------------------------- */
+
+void ShootRays(QUERY *query, int spectrum, int threads)
+/* shoot the rays of one spectrum sample (or all of them if one ray per
+   spectrum is used) from the light sources or, if query is given, from the
+   virtual sensor. With several threads the RQMC points are generated here in
+   batches, in the order of the serial loop, so each ray gets the same point
+   whatever the number of threads */
+{
+  RAYBATCH batch;
+  unsigned int i, num;
+
+  num = (unsigned int)npoints;
+
+  ResetQMC();
+  randqmc = GenRandom();
+
+  if (threads == 1) {
+    for (i = 0; i < num; i++) {
       pointqmc = QMC();
       rpointqmc = AppRandom(pointqmc, randqmc);
       ResetU01();
 
-      GenerateRandomRay(&ray);
-      for (spectrum = 0; spectrum < spectrum_samples; spectrum++)
-        total_spectrum_flux[spectrum] += ray.intensity[spectrum];
-      ++rays;
-
-      if (FindBoxIntersection(&scene, &ray)) {
-        if (verbose >= 3) {
-          fprintf(stderr, "\n%s - tracing ray %d for %d spectrum samples:\n",
-                  proc_name, i, spectrum_samples);
-          fprintf(stderr, "\t(%g, %g, %g) + t*(%g, %g, %g)\n", ray.pt[X],
-                  ray.pt[Y], ray.pt[Z], ray.dir[X], ray.dir[Y], ray.dir[Z]);
-          glDisplayRay(ray);
-        }
+      if (query != NULL)
+        ShootSensorRay(&serial, i, query, spectrum);
+      else
+        ShootLightRay(&serial, i, spectrum);
+    }
+    return;
+  }
 
-        // the 2nd parameter is not used because one ray for entire spectrums is
-        // used
-        hits += TraceRay(&ray, 0);
+  batch.query = query;
+  batch.spectrum = spectrum;
+  batch.threads = threads;
+  for (batch.first = 0; batch.first < num; batch.first += batch.count) {
+    batch.count = num - batch.first;
+    if (batch.count > RAY_BATCH * (unsigned int)threads)
+      batch.count = RAY_BATCH * (unsigned int)threads;
 
-        if (verbose >= 3)
-          fprintf(stderr, "%s - ray %d killed\n", proc_name, i);
-      } else if (verbose >= 3)
-        fprintf(stderr, "%s - ray %d does not intersect bounding box\n",
-                proc_name, i);
+    for (i = 0; i < batch.count; i++) {
+      pointqmc = QMC();
+      memcpy(batch_points + i * batch_dimen, AppRandom(pointqmc, randqmc),
+             sizeof(double) * batch_dimen);
     }
-    // OLD CODE: this division is now done in the DetermineResponse function
-    // for (spectrum = 0; spectrum < spectrum_samples; spectrum++)
-    //  spectrum_density[spectrum] /= M_PIf * scene.grid.bsph_radius *
-    //  scene.grid.bsph_radius;
-  } else {
-    num = (float)npoints;
 
-    // for each wavelength
-    for (spectrum = 0; spectrum < spectrum_samples; spectrum++) {
-      ResetQMC();
-      randqmc = GenRandom();
-
-      /* FROM OLD VERSION: determine the ray 'density' according to  */
-      // spectrum_density[spectrum] = num / (M_PIf * scene.grid.bsph_radius *
-      // scene.grid.bsph_radius);
-      /* THIS IS THE NEW VERSION: */
-      // spectrum density is initialized to zero, and incremented by the amount
-      // of available light
-      total_spectrum_flux[spectrum] = 0.f;
+    RunThreads(threads, TraceBatch, &batch);
+  }
 
-      // for the number of rays specfied by user do
-      for (i = 0; i < (unsigned int)num; i++) {
-        pointqmc = QMC();
-        rpointqmc = AppRandom(pointqmc, randqmc);
-        ResetU01();
-
-        GenerateRandomRay(&ray);
-        // increment the spectrum density by amount of available light
-        // NOTE: do not incorporate direction of incoming light with respect to
-        // zenith for multiple lights, because the returned radiant flux is
-        // averaged over the directional light sources
-        total_spectrum_flux[spectrum] += ray.intensity[spectrum];
-        ++rays;
-
-        if (FindBoxIntersection(&scene, &ray)) {
-          if (verbose >= 3) {
-            fprintf(stderr,
-                    "\n%s - tracing ray %d for spectrum %d, with energy %g:\n",
-                    proc_name, i, spectrum + 1, ray.intensity[spectrum]);
-            fprintf(stderr, "\t(%g, %g, %g) + t*(%g, %g, %g)\n", ray.pt[X],
-                    ray.pt[Y], ray.pt[Z], ray.dir[X], ray.dir[Y], ray.dir[Z]);
-            glDisplayRay(ray);
-          }
+  return;
+}
 
-          hits += TraceRay(&ray, spectrum);
+/* ------------------------------------------------------------------------- */
 
-          if (verbose >= 3)
-            fprintf(stderr, "%s - ray %d killed\n", proc_name, i);
-        } else if (verbose >= 3)
-          fprintf(stderr, "%s - ray %d does not intersect bounding box\n",
-                  proc_name, i);
+void TraceBatch(int thread, void *data)
+/* trace the slice of the batch of rays given to the thread */
+{
+  RAYBATCH *batch;
+  TRACER *tracer;
+  unsigned int i, first, last;
+
+  batch = (RAYBATCH *)data;
+  tracer = &tracers[thread];
+  first = batch->count * (unsigned int)thread / (unsigned int)batch->threads;
+  last =
+      batch->count * (unsigned int)(thread + 1) / (unsigned int)batch->threads;
+
+  thread_tracer = tracer;
+  for (i = first; i < last; i++) {
+    StartU01(batch_points + i * batch_dimen);
+
+    if (batch->query != NULL)
+      ShootSensorRay(tracer, batch->first + i, batch->query, batch->spectrum);
+    else
+      ShootLightRay(tracer, batch->first + i, batch->spectrum);
+  }
+  thread_tracer = NULL;
+
+  return;
+}
+
+/* ------------------------------------------------------------------------- */
+
+int StartTracers(int cos_angles)
+/* clear the sums of the rays, returns the number of threads used to trace
+   them which is one if the rays are displayed */
+{
+  int threads, t;
+
+  memset(serial.flux, 0, sizeof(serial.flux));
+  memset(serial.value, 0, sizeof(serial.value));
+  serial.hits = 0;
+  serial.ray.mailbox = NULL;
+
+  threads = verbose >= 3 ? 1 : number_of_threads;
+  if (threads <= 1)
+    return (1);
+
+  if (threads != num_tracers || scene.num_primitives > tracer_primitives ||
+      (int)GetQMC(QMC_DIMEN) != batch_dimen) {
+    FreeTracers();
+    tracers = (TRACER *)calloc(threads, sizeof(TRACER));
+    batch_dimen = (int)GetQMC(QMC_DIMEN);
+    batch_points = (double *)malloc(sizeof(double) * batch_dimen * RAY_BATCH *
+                                    threads);
+    if (tracers == NULL || batch_points == NULL) {
+      fprintf(stderr, "%s - cannot allocate memory for %d threads\n",
+              proc_name, threads);
+      FreeTracers();
+      return (1);
+    }
+    num_tracers = threads;
+    tracer_primitives = scene.num_primitives;
+    for (t = 0; t < threads; t++) {
+      // each thread marks the primitives tested by its rays
+      tracers[t].ray.mailbox = (unsigned int *)calloc(
+          tracer_primitives > 0 ? tracer_primitives : 1, sizeof(unsigned int));
+      tracers[t].cos_angle = (float *)malloc(
+          sizeof(float) * (tracer_primitives > 0 ? tracer_primitives : 1));
+      if (tracers[t].ray.mailbox == NULL || tracers[t].cos_angle == NULL) {
+        fprintf(stderr, "%s - cannot allocate memory for %d threads\n",
+                proc_name, threads);
+        FreeTracers();
+        return (1);
       }
-      // OLD CODE:divide available light by area of projected bounding sphere
-      // this is now done in the DetermineResponse function
-      // spectrum_density[spectrum] /= M_PIf * scene.grid.bsph_radius *
-      // scene.grid.bsph_radius;
     }
   }
 
-  if (verbose >= 1)
-    fprintf(stderr, "%s - number of intersections %d from %g rays\n", proc_name,
-            hits, num);
+  for (t = 0; t < threads; t++) {
+    memset(tracers[t].flux, 0, sizeof(tracers[t].flux));
+    memset(tracers[t].value, 0, sizeof(tracers[t].value));
+    tracers[t].hits = 0;
+    tracers[t].num_records = 0;
+    tracers[t].cos_angles = cos_angles;
+    if (cos_angles)
+      memset(tracers[t].cos_angle, 0, sizeof(float) * scene.num_primitives);
+  }
+
+  return (threads);
+}
+
+/* ------------------------------------------------------------------------- */
+
+TRACER *FinishTracers(int threads)
+/* add the sums of the threads in their order, returns the total */
+{
+  FLUXRECORD *record;
+  PRIMITIVE *prim;
+  int t, i, spectrum;
+
+  if (threads == 1)
+    return (&serial);
+
+  for (t = 0; t < threads; t++) {
+    serial.hits += tracers[t].hits;
+    for (spectrum = 0; spectrum < spectrum_samples; spectrum++) {
+      serial.flux[spectrum] += tracers[t].flux[spectrum];
+      serial.value[spectrum] += tracers[t].value[spectrum];
+    }
+
+    for (i = 0; i < tracers[t].num_records; i++) {
+      record = &tracers[t].records[i];
+      prim = &scene.primitives[record->index];
+      prim->absorbed_flux[record->spectrum] += record->absorbed;
+      prim->incident_flux[record->spectrum] += record->incident;
+      prim->direct_hits[record->spectrum] += record->hits;
+    }
+
+    if (tracers[t].cos_angles)
+      for (i = 0; i < scene.num_primitives; i++)
+        scene.primitives[i].avg_cos_angle += tracers[t].cos_angle[i];
+  }
+
+  return (&serial);
+}
+
+/* ------------------------------------------------------------------------- */
+
+void FreeTracers(void)
+/* free the memory of the threads tracing rays */
+{
+  int t;
+
+  if (tracers != NULL)
+    for (t = 0; t < num_tracers; t++) {
+      free(tracers[t].ray.mailbox);
+      free(tracers[t].cos_angle);
+      free(tracers[t].records);
+    }
+  free(tracers);
+  free(batch_points);
+  tracers = NULL;
+  batch_points = NULL;
+  num_tracers = tracer_primitives = batch_dimen = 0;
+
+  return;
+}
+
+/* ------------------------------------------------------------------------- */
+
+void AddFlux(PRIMITIVE *prim, int spectrum, float absorbed, float incident,
+             float hits)
+/* add the light reaching the primitive. Threads record it and the records are
+   added to the primitives in the order of the threads, in FinishTracers */
+{
+  FLUXRECORD *record;
+  int size;
+
+  if (thread_tracer == NULL) {
+    prim->absorbed_flux[spectrum] += absorbed;
+    prim->incident_flux[spectrum] += incident;
+    prim->direct_hits[spectrum] += hits;
+    return;
+  }
+
+  if (thread_tracer->num_records == thread_tracer->max_records) {
+    size = thread_tracer->max_records > 0 ? 2 * thread_tracer->max_records
+                                          : 1024;
+    record = (FLUXRECORD *)realloc(thread_tracer->records,
+                                   sizeof(FLUXRECORD) * size);
+    if (record == NULL) {
+      fprintf(stderr, "%s - cannot allocate memory for flux records\n",
+              proc_name);
+      return;
+    }
+    thread_tracer->records = record;
+    thread_tracer->max_records = size;
+  }
+
+  record = &thread_tracer->records[thread_tracer->num_records++];
+  record->index = (int)(prim - scene.primitives);
+  record->spectrum = spectrum;
+  record->absorbed = absorbed;
+  record->incident = incident;
+  record->hits = hits;
 
   return;
 }
@@ -1193,10 +1439,19 @@ int TraceRay(RAY *ray, int spectrum)
     intersected = NULL;
     mindist = 1e30f;
 
-    cell = FindFirstCell(&scene, ray);
     if (++ray->signature == 0)
       ray->signature = 1;
 
+    // the hierarchy returns the closest of the same intersections
+    if (scene.bvh.enabled) {
+      dist = FindBVHIntersection(&scene, ray, last_intersected_index, minnorm,
+                                 &intersected, &last_intersected_index);
+      if (dist >= 0.0)
+        mindist = dist;
+      cell = NULL;
+    } else
+      cell = FindFirstCell(&scene, ray);
+
     // loop through all the cells (voxels) in the subdivided space
     while (cell != NULL) {
       // for each primitive in this cell
@@ -1289,16 +1544,14 @@ int ResolveIntersection(RAY *ray, float *normal, float mindist,
     }
 
   // absorb some of the light
-  if ((!no_direct_light) || (ray->depth > 0)) {
-    intersected->absorbed_flux[spectrum] +=
-        ray->intensity[spectrum] * (1.0f - radiant);
-    if ((return_type[spectrum] == UP_INCIDENT_IRRADIANCE && side == 0) ||
-        (return_type[spectrum] == LW_INCIDENT_IRRADIANCE && side == 1))
-      intersected->incident_flux[spectrum] += ray->intensity[spectrum];
-    // count direct hits
-    if (ray->depth == 0)
-      intersected->direct_hits[spectrum] += 1.0f;
-  }
+  if ((!no_direct_light) || (ray->depth > 0))
+    AddFlux(intersected, spectrum, ray->intensity[spectrum] * (1.0f - radiant),
+            ((return_type[spectrum] == UP_INCIDENT_IRRADIANCE && side == 0) ||
+             (return_type[spectrum] == LW_INCIDENT_IRRADIANCE && side == 1))
+                ? ray->intensity[spectrum]
+                : 0.0f,
+            // count direct hits
+            ray->depth == 0 ? 1.0f : 0.0f);
 
   // the ray's new intensity = the intensity that was not absorbed
   ray->intensity[spectrum] *= radiant;
@@ -1446,16 +1699,15 @@ int ResolveIntersectionOne(RAY *ray, float *normal, float mindist,
 
   // absorb some of the intensity
   if ((!no_direct_light) || (ray->depth > 0))
-    for (spectrum = 0; spectrum < spectrum_samples; spectrum++) {
-      intersected->absorbed_flux[spectrum] +=
-          ray->intensity[spectrum] * (1.0f - radiant[spectrum]);
-      if ((return_type[spectrum] == UP_INCIDENT_IRRADIANCE && side == 0) ||
-          (return_type[spectrum] == LW_INCIDENT_IRRADIANCE && side == 1))
-        intersected->incident_flux[spectrum] += ray->intensity[spectrum];
-      // count direct hits
-      if (ray->depth == 0)
-        intersected->direct_hits[spectrum] += 1.0f;
-    }
+    for (spectrum = 0; spectrum < spectrum_samples; spectrum++)
+      AddFlux(intersected, spectrum,
+              ray->intensity[spectrum] * (1.0f - radiant[spectrum]),
+              ((return_type[spectrum] == UP_INCIDENT_IRRADIANCE && side == 0) ||
+               (return_type[spectrum] == LW_INCIDENT_IRRADIANCE && side == 1))
+                  ? ray->intensity[spectrum]
+                  : 0.0f,
+              // count direct hits
+              ray->depth == 0 ? 1.0f : 0.0f);
 
   // adjust the intensities after the absorption
   for (spectrum = 0; spectrum < spectrum_samples; spectrum++)
@@ -1600,7 +1852,7 @@ float GenerateRandomDirection_mPhong(float *outgoing, float n, float *dir,
 /* generate random direction for ray based on ideally reflected ray */
 {
   float theta, phi, psi, udotn, sin_theta, cos_theta, r1, angleON;
-  static float vec[3], u[3], v[3], w[3];
+  float vec[3], u[3], v[3], w[3];
 
   // if exponent is < 0, do nothing
   if (n < 0.f)
@@ -1694,7 +1946,7 @@ float GenerateRandomDirection_Phong(float *outgoing, float n, float *dir,
 /* generate random direction for ray based on ideally reflected ray */
 {
   float theta, phi, psi, udotn, sin_theta, cos_theta, r1, angleON;
-  static float vec[3], u[3], v[3], w[3];
+  float vec[3], u[3], v[3], w[3];
 
   // if exponent is < 0, do nothing
   if (n < 0.f)
@@ -1780,7 +2032,7 @@ float GenerateRandomDirection_Lambertian(__attribute__((unused))float *outgoing,
 // fov is the field of view if a virtual sensor is used (should be 0.0
 // otherwise)
 {
-  static float vec[3], u[3], v[3], w[3];
+  float vec[3], u[3], v[3], w[3];
   float e1, e2;
 
   // use normal for outgoing ray of the Lambertian model
@@ -1880,10 +2132,17 @@ void GenerateRandomRay(RAY *ray)
       // method 1: save the cosine angle for each object, but this is very slow!
       // scene.primitives[i].avg_cos_angle is reset to zero in
       // DetermineResponse() for every "run"
-      for (i = 0; i < scene.num_primitives; i++)
-        scene.primitives[i].avg_cos_angle +=
-            (float)fabs(DotProduct(ray->dir, scene.primitives[i].normal)) *
-            intensity;
+      // (the threads keep their own sums, see FinishTracers)
+      if (thread_tracer != NULL)
+        for (i = 0; i < scene.num_primitives; i++)
+          thread_tracer->cos_angle[i] +=
+              (float)fabs(DotProduct(ray->dir, scene.primitives[i].normal)) *
+              intensity;
+      else
+        for (i = 0; i < scene.num_primitives; i++)
+          scene.primitives[i].avg_cos_angle +=
+              (float)fabs(DotProduct(ray->dir, scene.primitives[i].normal)) *
+              intensity;
       // method 2: save the average ray direction, but this doesn't give the
       // exact same result as the above? This is strange because vector dot
       // product is distributive... anyway, there is only a small numerical
@@ -51,6 +51,13 @@
 #define PHONG 2
 #define LAMBERTIAN 3
 
+// storage class of the state kept by each tracing thread
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
 #define EPSILON 0.00001 /* 1x10^(-5) */
 
 #ifndef M_PI
@@ -84,6 +91,7 @@ int StrCaseCmp(char *str1, char *str2);
 void StoreQuery(int master, unsigned long module_id, int polygon_num,
                 Cmodule_type *two_modules, CTURTLE *turtle);
 void DetermineResponse(void);
+void FreeTracers(void);
 
 // implemented in gldisplay.cpp
 void glDisplayRay(RAY ray);
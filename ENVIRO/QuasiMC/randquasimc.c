@@ -8,17 +8,24 @@ extern int use_sky_model;
 extern unsigned int max_depth;
 extern double *rpointqmc;
 extern SCENE scene;
-static int startdim[RANDQMC_MAX];
+// each tracing thread reads its own RQMC point
+static THREAD_LOCAL double *point;
+static THREAD_LOCAL int startdim[RANDQMC_MAX];
 
 /* ------------------------------------------------------------------------- */
 
-void ResetU01(void)
+void ResetU01(void) { StartU01(rpointqmc); }
+
+/* ------------------------------------------------------------------------- */
+
+void StartU01(double *rpoint)
 // first two QMC points are used for generating random pt to trace ray
 // if sky model, next two allocated to generating sample from sky (THETA starts
 // at dim 4) if more than one directional light sources, next one allocated for
 // picking light (THETA starts at dim 3) if only one light source, THETA starts
 // at dim 2
 {
+  point = rpoint;
   startdim[RANDQMC_START] = 0;
   startdim[RANDQMC_THETA] = 2;
   if (use_sky_model)
@@ -38,7 +45,7 @@ void ResetU01(void)
 float RandU01(int index) {
   float value;
 
-  value = (float)rpointqmc[startdim[index]];
+  value = (float)point[startdim[index]];
   startdim[index]++;
 
   return (value);
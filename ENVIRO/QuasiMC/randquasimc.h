@@ -23,6 +23,7 @@
 extern "C" {
 #endif
 void ResetU01(void);
+void StartU01(double *rpoint);
 float RandU01(int index);
 int SetRQMC(char *RQMC_method, unsigned int max_depth, int num_samples,
             double *npoints);
@@ -9,6 +9,9 @@ typedef struct tagRAY {
   float intensity[MAX_SPECTRUM_SAMPLES];
   unsigned int signature;
   unsigned int depth;
+  unsigned int *mailbox; /* signatures per primitive, NULL to use the scene's */
+  int cell[3], cell_step[3]; /* used to find the voxels that are pierced */
+  float smallest[3], smallest_step[3]; /* by the ray */
 } RAY;
 
 typedef struct tagRUSSIANROULETTE {
@@ -81,6 +81,8 @@ void InitScene(SCENE *scene) {
   scene->grid.num_cells = 0;
   scene->grid.cells = NULL;
 
+  InitBVH(&scene->bvh);
+
   ptsBot = NULL;
   ptsTop = NULL;
 
@@ -186,6 +188,8 @@ void FreeScene(SCENE *scene)
     scene->grid.cells = NULL;
   }
 
+  FreeBVH(&scene->bvh);
+
   if (ptsBot != NULL) {
     free(ptsBot);
     ptsBot = NULL;
@@ -1135,7 +1139,11 @@ float IsIntersection(SCENE *scene, RAY *ray, int index, float mindist,
 
   prim = &scene->primitives[index];
 
-  if (prim->ray_signature == ray->signature)
+  if (ray->mailbox != NULL) {
+    if (ray->mailbox[index] == ray->signature)
+      return (-1);
+    ray->mailbox[index] = ray->signature;
+  } else if (prim->ray_signature == ray->signature)
     return (-1);
   else
     prim->ray_signature = ray->signature;
@@ -1363,45 +1371,45 @@ CELL *FindFirstCell(SCENE *scene, RAY *ray)
   grid = &scene->grid;
 
   /* find the first cell that is intersecting with the ray. */
-  grid->cell[X] = (int)((ray->pt[X] - grid->bbox[X]) / grid->cell_size[X]);
-  grid->cell[Y] = (int)((ray->pt[Y] - grid->bbox[Y]) / grid->cell_size[Y]);
-  grid->cell[Z] = (int)((ray->pt[Z] - grid->bbox[Z]) / grid->cell_size[Z]);
+  ray->cell[X] = (int)((ray->pt[X] - grid->bbox[X]) / grid->cell_size[X]);
+  ray->cell[Y] = (int)((ray->pt[Y] - grid->bbox[Y]) / grid->cell_size[Y]);
+  ray->cell[Z] = (int)((ray->pt[Z] - grid->bbox[Z]) / grid->cell_size[Z]);
 
-  if ((grid->cell[X] < 0) || (grid->cell[Y] < 0) || (grid->cell[Z] < 0))
+  if ((ray->cell[X] < 0) || (ray->cell[Y] < 0) || (ray->cell[Z] < 0))
     return (NULL);
 
-  if ((grid->cell[X] >= grid->size[X]) || (grid->cell[Y] >= grid->size[Y]) ||
-      (grid->cell[Z] >= grid->size[Z]))
+  if ((ray->cell[X] >= grid->size[X]) || (ray->cell[Y] >= grid->size[Y]) ||
+      (ray->cell[Z] >= grid->size[Z]))
     return (NULL);
 
   for (i = X; i <= Z; i++)
     if (ray->dir[i] < -EPSILON) {
-      grid->cell_step[i] = -1;
-      grid->smallest[i] =
-          (grid->bbox[i] + (float)grid->cell[i] * grid->cell_size[i] -
+      ray->cell_step[i] = -1;
+      ray->smallest[i] =
+          (grid->bbox[i] + (float)ray->cell[i] * grid->cell_size[i] -
            ray->pt[i]) /
           ray->dir[i];
-      grid->smallest_step[i] = -grid->cell_size[i] / ray->dir[i];
+      ray->smallest_step[i] = -grid->cell_size[i] / ray->dir[i];
     } else if (ray->dir[i] > EPSILON) {
-      grid->cell_step[i] = 1;
-      grid->smallest[i] =
-          (grid->bbox[i] + ((float)grid->cell[i] + 1.0f) * grid->cell_size[i] -
+      ray->cell_step[i] = 1;
+      ray->smallest[i] =
+          (grid->bbox[i] + ((float)ray->cell[i] + 1.0f) * grid->cell_size[i] -
            ray->pt[i]) /
           ray->dir[i];
-      grid->smallest_step[i] = grid->cell_size[i] / ray->dir[i];
+      ray->smallest_step[i] = grid->cell_size[i] / ray->dir[i];
     } else {
-      grid->cell_step[i] = 0;
-      grid->smallest[i] = 1e30f;
-      grid->smallest_step[i] = 0.0;
+      ray->cell_step[i] = 0;
+      ray->smallest[i] = 1e30f;
+      ray->smallest_step[i] = 0.0;
     }
 
-  return (&grid->cells[grid->cell[X] * grid->size[Y] * grid->size[Z] +
-                       grid->cell[Y] * grid->size[Z] + grid->cell[Z]]);
+  return (&grid->cells[ray->cell[X] * grid->size[Y] * grid->size[Z] +
+                       ray->cell[Y] * grid->size[Z] + ray->cell[Z]]);
 }
 
 /* ------------------------------------------------------------------------- */
 
-CELL *FindNextCell(SCENE *scene, __attribute__((unused))RAY *ray)
+CELL *FindNextCell(SCENE *scene, RAY *ray)
 /* returns the next cell pierced by the ray after the first one */
 {
   GRID *grid;
@@ -1409,19 +1417,19 @@ CELL *FindNextCell(SCENE *scene, __attribute__((unused))RAY *ray)
 
   grid = &scene->grid;
 
-  index = MIN3Di(grid->smallest[X], grid->smallest[Y], grid->smallest[Z]);
+  index = MIN3Di(ray->smallest[X], ray->smallest[Y], ray->smallest[Z]);
 
-  if (grid->cell_step[index] == 0)
+  if (ray->cell_step[index] == 0)
     return (NULL);
 
-  grid->smallest[index] += grid->smallest_step[index];
-  grid->cell[index] += grid->cell_step[index];
+  ray->smallest[index] += ray->smallest_step[index];
+  ray->cell[index] += ray->cell_step[index];
 
-  if ((grid->cell[index] < 0) || (grid->cell[index] >= grid->size[index]))
+  if ((ray->cell[index] < 0) || (ray->cell[index] >= grid->size[index]))
     return (NULL);
 
-  return (&grid->cells[grid->cell[X] * grid->size[Y] * grid->size[Z] +
-                       grid->cell[Y] * grid->size[Z] + grid->cell[Z]]);
+  return (&grid->cells[ray->cell[X] * grid->size[Y] * grid->size[Z] +
+                       ray->cell[Y] * grid->size[Z] + ray->cell[Z]]);
 }
 
 /* ------------------------------------------------------------------------- */
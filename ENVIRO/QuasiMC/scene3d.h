@@ -19,11 +19,26 @@ typedef struct tagGRID {
   float range[6];
   float maxdist; /* the distance of the largest extreme of bbox */
   int num_cells;
-  int cell[3], cell_step[3]; /* used to find the voxels that are pierced */
-  float smallest[3], smallest_step[3]; /* by the ray */
   CELL *cells;
 } GRID;
 
+typedef struct tagBVHNODE {
+  float bbox[6];        /* the six extremes that define a bounding box */
+  int index;            /* first primitive of a leaf, or the second child */
+  unsigned short count; /* number of primitives in a leaf, 0 otherwise */
+  unsigned short axis;  /* axis along which the children were split */
+} BVHNODE;
+
+typedef struct tagBVH {
+  int enabled;    /* use the hierarchy instead of the grid */
+  BVHNODE *nodes; /* depth first, the first child follows its parent */
+  int num_nodes;
+  int *list; /* index of primitives in the order of the leaves */
+  int num_primitives;
+  int max_primitives;
+  float cost; /* surface area heuristic cost when it was built */
+} BVH;
+
 typedef struct tagLIGHT {
   float dir[3], u[3], v[3]; /* directional light - no location is needed */
   float weight;
@@ -74,6 +89,7 @@ typedef struct tagSCENE {
   float max_light_weight;  // maxium weight over all light sources
 
   GRID grid; /* uniform spatial subdivison grid */
+  BVH bvh;   /* or bounding volume hierarchy */
 } SCENE;
 
 #ifdef __cplusplus
@@ -104,6 +120,13 @@ float IsIntersection(SCENE *scene, RAY *ray, int index, float mindist,
 int FindBoxIntersection(SCENE *scene, RAY *ray);
 CELL *FindFirstCell(SCENE *scene, RAY *ray);
 CELL *FindNextCell(SCENE *scene, RAY *ray);
+
+// implemented in bvh.c
+void InitBVH(BVH *bvh);
+void FreeBVH(BVH *bvh);
+void UpdateBVH(SCENE *scene);
+float FindBVHIntersection(SCENE *scene, RAY *ray, int skip, float *normal,
+                          PRIMITIVE **intersected, int *index);
 #ifdef __cplusplus
 }
 #endif
@@ -13,9 +13,11 @@
 #include "ecosystem.h"
 #include "grid.h"
 #include "comm_lib.h"
+#include "envthreads.h"
 
 /**** field specific variables ****/
 #define QUERY_ARRAY_SIZE 100
+#define QUERY_BLOCK 256 /* queries tested by a thread at once */
 
 item_type *queries;
 int num_queries;
@@ -24,6 +26,7 @@ int query_array_size;
 char verbose;
 char is3d;
 char vigor;
+int number_of_threads;
 
 float min_pos[3];
 float max_pos[3];
@@ -48,26 +51,44 @@ void InitializeFieldStructures(void) {
   }
 }
 
+/****************************************************************************/
+/* tests blocks of queries assigned to the given thread */
+void TestQueries(int thread, void *data) {
+  int num_threads = *(int *)data;
+  int block, i;
+
+  for (block = thread * QUERY_BLOCK; block < num_queries;
+       block += num_threads * QUERY_BLOCK)
+    for (i = block; i < block + QUERY_BLOCK && i < num_queries; i++)
+      queries[i].response = TestIntersection(queries + i);
+}
+
 /****************************************************************************/
 void DetermineResponse(void) {
-  int i;
+  int i, num_threads;
   Cmodule_type comm_symbol;
 
-  ResetGrid(min_pos, max_pos);
-
-  /* add all objects */
-  for (i = 0; i < num_queries; i++)
-    AddObject(queries + i);
+  FillGrid(queries, num_queries, min_pos, max_pos);
 
   comm_symbol.num_params = 1;
   comm_symbol.params[0].set = 1;
 
   /* for all queries determine intersection with another sphere by checking all
-   spheres in all voxes occyppied by the current sphere */
+   spheres in all voxes occyppied by the current sphere.
+   In vigor mode, queries removed earlier do not count, so they have to
+   be tested in order. */
+  num_threads = vigor ? 1 : number_of_threads;
+  if (num_threads > num_queries / QUERY_BLOCK)
+    num_threads = num_queries / QUERY_BLOCK;
+  if (num_threads < 1)
+    num_threads = 1;
+
+  RunThreads(num_threads, TestQueries, &num_threads);
+
   for (i = 0; i < num_queries; i++) {
 
-    /* returns 0 if there is an intersection */
-    comm_symbol.params[0].value = TestIntersection(queries + i);
+    /* 0 if there is an intersection */
+    comm_symbol.params[0].value = queries[i].response;
 
     CSSendData(queries[i].master, queries[i].dist, &comm_symbol);
   }
@@ -157,11 +178,12 @@ void ProcessArguments(int argc, char **argv) {
   FILE *fp;
   int i;
   char *keywords[] = {
-      "verbose",   /*  0 */
-      "grid size", /*  1 */
-      "3d case",   /*  2 */
-      "vigor",     /*  3 */
-      NULL         /* the last item must be NULL! */
+      "verbose",           /*  0 */
+      "grid size",         /*  1 */
+      "3d case",           /*  2 */
+      "vigor",             /*  3 */
+      "number of threads", /*  4 */
+      NULL                 /* the last item must be NULL! */
   };
   char *token, input_line[255];
   int size[3];
@@ -178,6 +200,7 @@ void ProcessArguments(int argc, char **argv) {
 
   is3d = 0;
   vigor = 0;
+  number_of_threads = 1;
 
   InitializeFieldStructures();
 
@@ -250,6 +273,13 @@ void ProcessArguments(int argc, char **argv) {
         if (!strcmp(token, "on"))
           vigor = 1;
         break;
+
+      case 4: /* number of threads, 0 for one per processor */
+        token = strtok(NULL, "x,; \t:\n");
+        if (token == NULL)
+          break;
+        number_of_threads = NumberOfThreads(token);
+        break;
       }
     }
   }
@@ -12,5 +12,6 @@ struct item_type {
   int index;
   unsigned long dist;
   int master;
+  int response; /* result of TestIntersection */
 };
 typedef struct item_type item_type;
@@ -1,6 +1,6 @@
 TEMPLATE = app
 CONFIG   += console
-SOURCES  = ecosystem.c grid.c message.c
+SOURCES  = ecosystem.c grid.c message.c envthreads.cpp
 TARGET   = ecosystem
 VPATH += ../../libs/comm
 
@@ -12,23 +12,15 @@
 #define Y 1
 #define Z 2
 
-/* grid */
-struct OBJECT_LIST_TYPE {
-  item_type *prim;
-  struct OBJECT_LIST_TYPE *next;
-};
-typedef struct OBJECT_LIST_TYPE OBJECT_LIST_TYPE;
-
-struct CELL_TYPE {
-  OBJECT_LIST_TYPE *list;
-};
-typedef struct CELL_TYPE CELL_TYPE;
-
+/* grid - objects overlapping each cell are stored contiguously in items,
+   from cell_start[cell] to cell_start[cell+1] */
 struct grid_type {
   int size[DIM];    /* size of the grid (in nodes) */
   float range[DIM]; /* size in coordinates */
   float pos[DIM];   /* position of lower left corner */
-  CELL_TYPE *data;
+  int *cell_start;  /* number of cells + 1 */
+  item_type **items;
+  int max_items; /* allocated items */
 };
 typedef struct grid_type grid_type;
 
@@ -40,14 +32,19 @@ extern char vigor;
 
 /****************************************************************************/
 void FreeGrid(void) {
-  if (grid.data != NULL)
-    free(grid.data);
-  grid.data = NULL;
+  if (grid.cell_start != NULL)
+    free(grid.cell_start);
+  grid.cell_start = NULL;
+
+  if (grid.items != NULL)
+    free(grid.items);
+  grid.items = NULL;
+  grid.max_items = 0;
 }
 
 /****************************************************************************/
 void InitializeGrid(int *size) {
-  int x, y, z, c;
+  int c;
 
   FreeGrid();
 
@@ -58,64 +55,19 @@ void InitializeGrid(int *size) {
   if (!is3d)
     grid.size[Z] = 1;
 
-  if ((grid.data = (CELL_TYPE *)malloc(grid.size[X] * grid.size[Y] *
-                                       grid.size[Z] * sizeof(CELL_TYPE))) ==
-      NULL) {
+  if ((grid.cell_start = (int *)calloc(grid.size[X] * grid.size[Y] *
+                                           grid.size[Z] + 1,
+                                       sizeof(int))) == NULL) {
     fprintf(stderr, "Cannot allocate enough memory for the grid\n");
     exit(0);
   }
-
-  for (z = 0; z < grid.size[Z]; z++)
-    for (y = 0; y < grid.size[Y]; y++)
-      for (x = 0; x < grid.size[X]; x++)
-        grid.data[z * grid.size[X] * grid.size[Y] + y * grid.size[X] + x].list =
-            NULL;
-}
-
-/****************************************************************************/
-CELL_TYPE *GetCell(grid_type *grid, int x, int y, int z) {
-  if (x < 0)
-    x = 0;
-  if (x >= grid->size[X])
-    x = grid->size[X] - 1;
-
-  if (y < 0)
-    y = 0;
-  if (y >= grid->size[Y])
-    y = grid->size[Y] - 1;
-
-  if (is3d) {
-    if (z < 0)
-      z = 0;
-    if (z >= grid->size[Z])
-      z = grid->size[Z] - 1;
-  } else
-    z = 0;
-
-  return grid->data + z * grid->size[X] * grid->size[Y] + y * grid->size[X] + x;
-}
-
-/****************************************************************************/
-/* adds a new item to the beginning of a linked list */
-void AddToList(OBJECT_LIST_TYPE **first, item_type *prim) {
-  OBJECT_LIST_TYPE *ptr;
-
-  if ((ptr = (OBJECT_LIST_TYPE *)malloc(sizeof(OBJECT_LIST_TYPE))) == NULL) {
-    fprintf(stderr, "ecosystem - cannot allocate memory for an item!\n");
-    exit(0);
-  }
-
-  ptr->next = (*first);
-  ptr->prim = prim;
-  *first = ptr;
 }
 
 /*************************************************************************/
-/* Add primitive to cells iside its bounding box
+/* Sets the range of cells iside the primitive's bounding box
    COULD BE TIGHTER!  */
-void AddObject(item_type *prim) {
-  int c, x, y, z;
-  CELL_TYPE *cell;
+void SetObjectRange(item_type *prim) {
+  int c;
 
   for (c = X; c <= (is3d ? Z : Y); c++) {
     prim->range[c][0] = floor((prim->position[c] - prim->radius - grid.pos[c]) /
@@ -137,73 +89,96 @@ void AddObject(item_type *prim) {
   if (verbose)
     fprintf(stderr, "Primitive range: x:%d-%d; y:%d-%d;\n", prim->range[X][0],
             prim->range[X][1], prim->range[Y][0], prim->range[Y][1]);
-
-  /* for all nodes in the range */
-  for (z = prim->range[Z][0]; z <= prim->range[Z][1]; z++)
-    for (y = prim->range[Y][0]; y <= prim->range[Y][1]; y++)
-      for (x = prim->range[X][0]; x <= prim->range[X][1]; x++) {
-        cell =
-            grid.data + z * grid.size[X] * grid.size[Y] + y * grid.size[X] + x;
-
-        AddToList(&(cell->list), prim);
-      }
 }
 
 /*************************************************************************/
-/* reset the grid */
-void ResetGrid(float *min_pos, float *max_pos) {
-  int x, y, z, c;
-  CELL_TYPE *cell;
-  OBJECT_LIST_TYPE *ptr, *ptr2;
+/* sorts the objects into cells of the grid spanning from min_pos to
+   max_pos: counts the objects in each cell first and then places them
+   into one array */
+void FillGrid(item_type *prims, int num_prims, float *min_pos,
+              float *max_pos) {
+  int i, c, x, y, z, cell, num_cells, num_items, count;
+  item_type *prim;
 
   for (c = 0; c <= (is3d ? Z : Y); c++) {
     grid.pos[c] = min_pos[c] - 0.001;
     grid.range[c] = max_pos[c] - min_pos[c] + 0.002;
   }
 
-  /* initialize all nodes */
-  for (z = 0; z < grid.size[Z]; z++)
-    for (y = 0; y < grid.size[Y]; y++)
-      for (x = 0; x < grid.size[X]; x++) {
+  num_cells = grid.size[X] * grid.size[Y] * grid.size[Z];
+
+  for (cell = 0; cell <= num_cells; cell++)
+    grid.cell_start[cell] = 0;
 
-        cell =
-            grid.data + z * grid.size[X] * grid.size[Y] + y * grid.size[X] + x;
+  /* count the objects in each cell */
+  for (i = 0; i < num_prims; i++) {
+    prim = prims + i;
+    SetObjectRange(prim);
 
-        ptr = cell->list;
+    for (z = prim->range[Z][0]; z <= prim->range[Z][1]; z++)
+      for (y = prim->range[Y][0]; y <= prim->range[Y][1]; y++)
+        for (x = prim->range[X][0]; x <= prim->range[X][1]; x++)
+          grid.cell_start[z * grid.size[X] * grid.size[Y] + y * grid.size[X] +
+                          x]++;
+  }
 
-        while (ptr != NULL) {
-          ptr2 = ptr;
-          ptr = ptr->next;
+  /* cell_start[cell] is the end of the cell ... */
+  num_items = 0;
+  for (cell = 0; cell <= num_cells; cell++) {
+    count = grid.cell_start[cell];
+    num_items += count;
+    grid.cell_start[cell] = num_items;
+  }
 
-          free(ptr2);
-        }
+  if (num_items > grid.max_items) {
+    if (grid.items != NULL)
+      free(grid.items);
+
+    grid.max_items = 2 * num_items;
+    if ((grid.items = (item_type **)malloc(grid.max_items *
+                                           sizeof(item_type *))) == NULL) {
+      fprintf(stderr, "ecosystem - cannot allocate memory for %d items!\n",
+              grid.max_items);
+      exit(0);
+    }
+  }
 
-        cell->list = NULL;
-      }
+  /* ... and becomes its beginning when all objects are placed */
+  for (i = num_prims - 1; i >= 0; i--) {
+    prim = prims + i;
+
+    for (z = prim->range[Z][0]; z <= prim->range[Z][1]; z++)
+      for (y = prim->range[Y][0]; y <= prim->range[Y][1]; y++)
+        for (x = prim->range[X][0]; x <= prim->range[X][1]; x++)
+          grid.items[--grid.cell_start[z * grid.size[X] * grid.size[Y] +
+                                       y * grid.size[X] + x]] = prim;
+  }
 
   if (verbose)
-    fprintf(stderr, "Grid reset.\n");
+    fprintf(stderr, "Grid filled with %d items.\n", num_items);
 }
 
 /*************************************************************************/
+/* returns 0 if the object intersects another one which dominates it.
+   In vigor mode, the object is marked as removed, which affects objects
+   tested later. Otherwise objects can be tested in any order. */
 int TestIntersection(item_type *prim) {
-  OBJECT_LIST_TYPE *ptr;
   item_type *prim2;
   char not_found = 1;
   float vec[DIM];
-  int x, y, z;
+  int x, y, z, cell, item;
 
   /* for all nodes in the range */
   for (z = prim->range[Z][0]; z <= prim->range[Z][1]; z++)
     for (y = prim->range[Y][0]; y <= prim->range[Y][1]; y++)
       for (x = prim->range[X][0]; x <= prim->range[X][1]; x++) {
 
-        ptr = grid.data[z * grid.size[X] * grid.size[Y] + y * grid.size[X] + x]
-                  .list;
+        cell = z * grid.size[X] * grid.size[Y] + y * grid.size[X] + x;
 
-        /* go through the linked list */
-        while (ptr != NULL) {
-          if ((prim2 = ptr->prim) != NULL){
+        /* go through the objects in the cell */
+        for (item = grid.cell_start[cell]; item < grid.cell_start[cell + 1];
+             item++) {
+          if ((prim2 = grid.items[item]) != NULL){
 
             /* perform the test */
             if (prim2 != prim &&             /* don't test with itself */
@@ -262,8 +237,6 @@ int TestIntersection(item_type *prim) {
 	      }
 	    }
 	  }
-
-          ptr = ptr->next;
         }
       }
 
@@ -1,6 +1,5 @@
 
 void FreeGrid(void);
 void InitializeGrid(int *size);
-void AddObject(item_type *prim);
-void ResetGrid(float *min_pos, float *max_pos);
+void FillGrid(item_type *prims, int num_prims, float *min_pos, float *max_pos);
 int TestIntersection(item_type *prim);
@@ -18,8 +18,7 @@ struct item_type {
   float position[3];
   float vigor;
   int index;
-  unsigned long dist;
-  int master;
+  int query; /* index of the query in the batch */
 };
 typedef struct item_type item_type;
 
@@ -32,6 +31,18 @@ char is3d;
 
 float radius2;  /* squared radius */
 
+/* uniform spatial hash of the queries, rebuilt in each step. The cells
+   are at least as big as the radius, so only the neighbouring cells
+   have to be searched. */
+#define MAX_CELLS_PER_AXIS 1000000
+
+int *hash_start;    /* first item of each bucket in hash_items */
+int *hash_items;    /* query indices sorted by buckets */
+int hash_size;      /* number of buckets, a power of 2 */
+int hash_allocated; /* number of allocated items */
+float hash_min[3];  /* the lower corner of the queries' bounding box */
+float hash_cell;    /* size of a cell */
+
 
 /****************************************************************************/
 void FreeFieldStructures(void)
@@ -39,6 +50,15 @@ void FreeFieldStructures(void)
   if(queries != NULL) 
     free(queries);
   queries = NULL;
+
+  if(hash_start != NULL)
+    free(hash_start);
+  hash_start = NULL;
+
+  if(hash_items != NULL)
+    free(hash_items);
+  hash_items = NULL;
+  hash_allocated = 0;
 }
 
 /****************************************************************************/
@@ -56,46 +76,171 @@ void InitializeFieldStructures(void)
 }
 
 /****************************************************************************/
-void DetermineResponse(void)
+/* integer coordinates of the cell containing query i */
+void QueryCell(int i, int *cell)
 {
-  int i, j;
-  float vec[3];
-  Cmodule_type comm_symbol;
+  int c;
 
-  comm_symbol.num_params = 1;
-  comm_symbol.params[0].set = 1;
-  
-  /* for all queries */
-  for(i=0; i< num_queries; i++) {
-    comm_symbol.params[0].value = 1;
-    
-    for(j=0; j< num_queries; j++) 
-      if((i!=j)&&(queries[i].index == queries[j].index)&&
-	 (queries[i].vigor <= queries[j].vigor)) {
-	vec[0] = queries[i].position[0] - queries[j].position[0];
-	vec[1] = queries[i].position[1] - queries[j].position[1];
+  cell[2] = 0;
+  for(c=0; c < (is3d ? 3 : 2); c++)
+    cell[c] = (int) floor((queries[i].position[c] - hash_min[c]) / hash_cell);
+}
+
+/****************************************************************************/
+/* bucket of the given cell */
+int HashBucket(int x, int y, int z)
+{
+  return (int)(((unsigned int)x * 73856093u ^ (unsigned int)y * 19349663u ^
+		(unsigned int)z * 83492791u) & (unsigned int)(hash_size - 1));
+}
+
+/****************************************************************************/
+/* sorts the queries into buckets of the spatial hash */
+void BuildHash(void)
+{
+  int i, c, b, cell[3], sum, count;
+  float max[3], extent;
+
+  if(num_queries == 0)
+    return;
+
+  /* bounding box of the queries */
+  for(c=0; c<3; c++)
+    hash_min[c] = max[c] = 0;
+
+  for(i=0; i < num_queries; i++)
+    for(c=0; c < (is3d ? 3 : 2); c++) {
+      if(i == 0 || queries[i].position[c] < hash_min[c])
+	hash_min[c] = queries[i].position[c];
+      if(i == 0 || queries[i].position[c] > max[c])
+	max[c] = queries[i].position[c];
+    }
+
+  /* slightly bigger than the radius, so rounding cannot put two queries
+     closer than the radius into cells which are not neighbours */
+  hash_cell = 1.001 * sqrt(radius2);
+
+  /* but not so small that cell coordinates overflow */
+  for(c=0; c < (is3d ? 3 : 2); c++) {
+    extent = max[c] - hash_min[c];
+    if(hash_cell < extent / MAX_CELLS_PER_AXIS)
+      hash_cell = extent / MAX_CELLS_PER_AXIS;
+  }
+  if(hash_cell <= 0)
+    hash_cell = 1;
+
+  if(num_queries > hash_allocated) {
+    /* reallocate */
+    hash_allocated = query_array_size;
+    if(hash_allocated < num_queries)
+      hash_allocated = num_queries;
+
+    for(hash_size = 1; hash_size < 2*hash_allocated; hash_size *= 2);
+
+    if(hash_start != NULL)
+      free(hash_start);
+    if(hash_items != NULL)
+      free(hash_items);
+
+    if((hash_start = (int*)malloc((hash_size+1)*sizeof(int))) == NULL ||
+       (hash_items = (int*)malloc(hash_allocated*sizeof(int))) == NULL) {
+      fprintf(stderr,"honda81 - cannot allocate memory for spatial hash.\n");
+      exit(0);
+    }
+  }
+
+  /* count the queries in each bucket */
+  for(b=0; b <= hash_size; b++)
+    hash_start[b] = 0;
+
+  for(i=0; i < num_queries; i++) {
+    QueryCell(i, cell);
+    hash_start[HashBucket(cell[0], cell[1], cell[2])]++;
+  }
+
+  /* hash_start[b] is the end of bucket b ... */
+  for(b=0, sum=0; b <= hash_size; b++) {
+    count = hash_start[b];
+    hash_start[b] = sum += count;
+  }
+
+  /* ... and becomes its beginning when all queries are inserted */
+  for(i=num_queries-1; i >= 0; i--) {
+    QueryCell(i, cell);
+    hash_items[--hash_start[HashBucket(cell[0], cell[1], cell[2])]] = i;
+  }
 
-	if(is3d) {
-	  /* 3d case */
-	  vec[2] = queries[i].position[2] - queries[j].position[2];
+  if(verbose)
+    fprintf(stderr, "honda81 - %d queries in %d buckets, cell size %g.\n",
+	    num_queries, hash_size, hash_cell);
+}
 
+/****************************************************************************/
+/* returns 1 if there is a query with the same index and higher or
+   equal vigor within the radius of query i */
+int IsShaded(int i)
+{
+  int j, k, x, y, z, b, cell[3], zrange;
+  float vec[3];
 
-	  if(vec[0]*vec[0]+vec[1]*vec[1]+vec[2]*vec[2] <= radius2)
-	    comm_symbol.params[0].value = 0;
+  QueryCell(i, cell);
+  zrange = is3d ? 1 : 0;
+
+  for(z = cell[2]-zrange; z <= cell[2]+zrange; z++)
+    for(y = cell[1]-1; y <= cell[1]+1; y++)
+      for(x = cell[0]-1; x <= cell[0]+1; x++) {
+	/* different cells may share a bucket, queries from other cells
+	   are eliminated by the distance test */
+	b = HashBucket(x, y, z);
+
+	for(k = hash_start[b]; k < hash_start[b+1]; k++) {
+	  j = hash_items[k];
+
+	  if((i!=j)&&(queries[i].index == queries[j].index)&&
+	     (queries[i].vigor <= queries[j].vigor)) {
+	    vec[0] = queries[i].position[0] - queries[j].position[0];
+	    vec[1] = queries[i].position[1] - queries[j].position[1];
+
+	    if(is3d) {
+	      /* 3d case */
+	      vec[2] = queries[i].position[2] - queries[j].position[2];
+
+	      if(vec[0]*vec[0]+vec[1]*vec[1]+vec[2]*vec[2] <= radius2)
+		return 1;
+	    }
+	    else
+	      /* 2d case */
+	      if(vec[0]*vec[0]+vec[1]*vec[1] <= radius2)
+		return 1;
+	  }
 	}
-	else
-	  /* 2d case */
-	  if(vec[0]*vec[0]+vec[1]*vec[1] <= radius2)
-	    comm_symbol.params[0].value = 0;
       }
-      
-    CSSendData(queries[i].master, queries[i].dist, &comm_symbol);
+
+  return 0;
+}
+
+/****************************************************************************/
+/* the reply to a query replaces its communication symbol */
+void DetermineResponse(Cmodule_type *two_modules, char *answer)
+{
+  int i;
+  Cmodule_type *comm_symbol;
+
+  BuildHash();
+
+  /* for all queries */
+  for(i=0; i< num_queries; i++) {
+    comm_symbol = two_modules + 2*queries[i].query;
+    comm_symbol->num_params = 1;
+    comm_symbol->params[0].set = 1;
+    comm_symbol->params[0].value = IsShaded(i) ? 0 : 1;
+
+    answer[queries[i].query] = 1;
   }
 }
 
 /****************************************************************************/
-void StoreQuery(int master, unsigned long module_id, Cmodule_type *comm_symbol,
-		CTURTLE *tu)
+void StoreQuery(int query, Cmodule_type *comm_symbol, CTURTLE *tu)
 {
   if(tu->positionC < 3) {
     fprintf(stderr,
@@ -135,8 +280,7 @@ void StoreQuery(int master, unsigned long module_id, Cmodule_type *comm_symbol,
     /* 2d case */
     queries[num_queries].position[1] = tu->position[2];
 
-  queries[num_queries].dist = module_id;
-  queries[num_queries].master = master;
+  queries[num_queries].query = query;
   queries[num_queries].vigor = comm_symbol->params[0].value;
   
   queries[num_queries].index = (comm_symbol->num_params > 1 ? 
@@ -228,43 +372,33 @@ void ProcessArguments(int argc, char **argv)
 }
 
 /****************************************************************************/
-void MainLoop(void)
+/* all queries of a step are answered together, the replies are sent in
+   the order of the queries */
+void AnswerQueries(int nqueries, Cmodule_type *two_modules, CTURTLE *turtles,
+		   char *answer)
 {
-  Cmodule_type two_modules[2];
-  unsigned long module_id;
-  int master;
-  CTURTLE turtle;
-  int i;
-
-  /* infinite loop - until signal 'exit' comes */
-  for(;;) {
-    if(verbose)
-      fprintf(stderr, "honda81 - start processing data.\n");  
+  int q, i;
 
-    num_queries = 0;
+  if(verbose)
+    fprintf(stderr, "honda81 - start processing data.\n");  
 
-    CSBeginTransmission();
+  num_queries = 0;
 
-    /* process the data */
-    while(CSGetData(&master, &module_id, two_modules, &turtle)) {
-      if(verbose) {
-	fprintf(stderr,"honda81 - comm. symbol has %d parameters:\n      ",
-		two_modules[0].num_params);
-	for(i=0; i<two_modules[0].num_params; i++)
-	  fprintf(stderr," %g", two_modules[0].params[i].value);
-	fprintf(stderr,"\n");
-	
-	fprintf(stderr,"\n");
-      }
+  for(q=0; q<nqueries; q++) {
+    if(verbose) {
+      fprintf(stderr,"honda81 - comm. symbol has %d parameters:\n      ",
+	      two_modules[2*q].num_params);
+      for(i=0; i<two_modules[2*q].num_params; i++)
+	fprintf(stderr," %g", two_modules[2*q].params[i].value);
+      fprintf(stderr,"\n");
 
-      StoreQuery(master, module_id, two_modules, &turtle);
+      fprintf(stderr,"\n");
     }
 
-    DetermineResponse();
-
-    /* End transmission returns 1 when the process is requested to exit */
-    if(CSEndTransmission()) break;
+    StoreQuery(q, two_modules + 2*q, turtles + q);
   }
+
+  DetermineResponse(two_modules, answer);
 }
  
 /****************************************************************************/
@@ -279,7 +413,8 @@ int main(int argc, char **argv)
 
   fprintf(stderr, "Field process %s successfully initialized.\n", process_name);
 
-  MainLoop();
+  /* until signal 'exit' comes */
+  CSMainLoopBatch(AnswerQueries);
 
   FreeFieldStructures();
 
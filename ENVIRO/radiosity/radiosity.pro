@@ -1,8 +1,9 @@
 TEMPLATE = app
 CONFIG   += console
-SOURCES  = radiosity.c scene3d.c sky.c matrix.c message.c
+SOURCES  = radiosity.c scene3d.c sky.c matrix.c cellpack.c message.c
 TARGET   = radiosity
-VPATH += ../../libs/comm
+VPATH += ../../libs/comm ../MonteCarlo
+INCLUDEPATH += ../MonteCarlo
 
 MY_BASE  = ../..
 MY_LIBS  = comm
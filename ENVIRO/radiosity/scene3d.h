@@ -18,6 +18,7 @@ primitive_type *AddObject(grid_type *grid, CTURTLE *tu,
                           Cmodule_type *next_symbol, int *top_mat,
                           int *bottom_mat);
 void FillGrid(grid_type *grid);
+void PackGrid(grid_type *grid);
 void OutputPrimitives(grid_type *grid);
 
 float IsIntersection(float *pt, float *dir, float mindist, primitive_type *prim,
@@ -1,6 +1,7 @@
 TEMPLATE = app
 CONFIG   += console
-SOURCES  = soil2d.c matrix.c triangulate.c soil3d.c targa.c message.c lodepng.c
+SOURCES  = soil2d.c matrix.c triangulate.c soil3d.c targa.c message.c lodepng.c \
+           envthreads.cpp
 TARGET   = soil
 VPATH += ../../libs/comm
 
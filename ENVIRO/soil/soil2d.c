@@ -6,6 +6,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <float.h>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -16,6 +17,7 @@
 #include "soil2d.h"
 #include "soil3d.h"
 #include "comm_lib.h"
+#include "envthreads.h"
 #include "matrix.h"
 // include local copy of lodepng because the version in libmisc.a is compiled with C++ and not compatible with soil2d.c (C)
 #include "lodepng.h"
@@ -55,6 +57,7 @@ char keep_depl_cells;
 /* diffusion parameters */
 int diff_steps;
 float diff_tolerance;
+int number_of_threads;
 
 /* to output files just at some specific points */
 struct ANIMINTERVAL {
@@ -1091,21 +1094,103 @@ void SetSourcesToValue(grid_type *grid, DATA_TYPE val) {
 }
 
 /****************************************************************************/
-/* when steps != -1, the simulation is carried for 'steps' steps. Otherwise
-   it runs as long as any of the new values is more than the 'tolerance' from
-   the previous value in a cell.
+/* The diffusion is computed in separate arrays which have one layer of
+   empty cells around the grid, so the inner loops need no tests for the
+   boundary. Rows of the grid are divided among threads. */
+
+#define MIN_CELLS_PER_THREAD 16384
+#define STALLED_SWEEPS 100 /* red-black sweeps without a smaller change */
+
+struct diffusion_type {
+  int size[3]; /* size of the grid without the border */
+  int ystep, zstep;
+  DATA_TYPE *val, *new_val;
+  DATA_TYPE *open; /* 1 in cells which are not obstacles, 0 otherwise */
+  DATA_TYPE *cnt;  /* number of open neighbours */
+  char *update;    /* 1 in cells whose value is computed */
+  DATA_TYPE omega;
+  int color; /* cells updated by red-black step, -1 for Jacobi step */
+  int num_threads;
+  DATA_TYPE *max_change; /* for each thread */
+};
+typedef struct diffusion_type diffusion_type;
+
+/****************************************************************************/
+/* sum of the open neighbours of cell i */
+#define NEIGHBOURS(d, v, i)                                                    \
+  ((d)->open[(i) - (d)->zstep] * (v)[(i) - (d)->zstep] +                       \
+   (d)->open[(i) + (d)->zstep] * (v)[(i) + (d)->zstep] +                       \
+   (d)->open[(i) - (d)->ystep] * (v)[(i) - (d)->ystep] +                       \
+   (d)->open[(i) + (d)->ystep] * (v)[(i) + (d)->ystep] +                       \
+   (d)->open[(i)-1] * (v)[(i)-1] + (d)->open[(i) + 1] * (v)[(i) + 1])
+
+/****************************************************************************/
+/* one diffusion step for rows of the grid assigned to the given thread */
+static void DiffuseRows(int thread, void *data) {
+  diffusion_type *d = (diffusion_type *)data;
+  int rows = d->size[Y] * d->size[Z];
+  int row, y, z, x, i, first;
+  DATA_TYPE *val = d->val, *new_val = d->new_val;
+  DATA_TYPE updated_val, change, max_change = 0;
+
+  for (row = rows * thread / d->num_threads;
+       row < rows * (thread + 1) / d->num_threads; row++) {
+    y = row % d->size[Y];
+    z = row / d->size[Y];
+    first = (z + 1) * d->zstep + (y + 1) * d->ystep + 1;
+
+    if (d->color < 0) {
+      /* Jacobi step from val to new_val */
+      for (i = first; i < first + d->size[X]; i++) {
+        updated_val = NEIGHBOURS(d, val, i) / d->cnt[i];
+        updated_val = (1 - d->omega) * val[i] + d->omega * updated_val;
+        new_val[i] = d->update[i] ? updated_val : val[i];
+      }
+    } else {
+      /* red-black step in val - cells of the other color are not
+         changed, so the rows are independent */
+      for (x = (d->color + y + z) % 2; x < d->size[X]; x += 2) {
+        i = first + x;
+        if (!d->update[i])
+          continue;
+
+        updated_val = NEIGHBOURS(d, val, i) / d->cnt[i];
+        updated_val = (1 - d->omega) * val[i] + d->omega * updated_val;
+
+        change = fabs((double)(updated_val - val[i]));
+        if (change > max_change)
+          max_change = change;
+        val[i] = updated_val;
+      }
+    }
+  }
+
+  d->max_change[thread] = max_change;
+}
+
+/****************************************************************************/
+static void FreeDiffusion(diffusion_type *d) {
+  free(d->val);
+  free(d->new_val);
+  free(d->open);
+  free(d->cnt);
+  free(d->update);
+  free(d->max_change);
+}
+
+/****************************************************************************/
+/* when steps != -1, the simulation is carried for 'steps' steps of Jacobi
+   iteration. Otherwise it runs red-black relaxation until the values are
+   estimated to be within the 'tolerance' from the converged field.
    */
 void SimulateDiffusion(grid_type *grid, int steps, DATA_TYPE tolerance) {
-  CELL_TYPE *new_data, *temp_ptr;
-  char first_z, last_z, first_y, last_y, first_x, last_x;
-  DATA_TYPE updated_val, old_val, new_val;
-  DATA_TYPE max_tolerance;
-  CELL_TYPE *ptr, *act_cell;
-  int x, y, z, cnt, i;
+  diffusion_type d;
+  DATA_TYPE max_tolerance, last_change = 0, min_change = FLT_MAX, ratio;
+  DATA_TYPE *temp_ptr;
+  CELL_TYPE *ptr;
+  int x, y, z, i, c, cells, padded;
   char completed;
-  int zstep = grid->size[X] * grid->size[Y];
-  int ystep = grid->size[X];
-  int step = 0;
+  int step = 0, stalled = 0;
 
   if (grid->size[Z] * grid->size[Y] * grid->size[X] <= 1) {
     fprintf(stderr,
@@ -1116,141 +1201,116 @@ void SimulateDiffusion(grid_type *grid, int steps, DATA_TYPE tolerance) {
   if (steps == 0)
     return;
 
-  /* another grid is used to store resulting values */
-  if ((new_data = (CELL_TYPE *)malloc(grid->size[X] * grid->size[Y] *
-                                      grid->size[Z] * sizeof(CELL_TYPE))) ==
-      NULL) {
+  for (c = X; c <= Z; c++)
+    d.size[c] = grid->size[c];
+  d.ystep = grid->size[X] + 2;
+  d.zstep = d.ystep * (grid->size[Y] + 2);
+  cells = grid->size[X] * grid->size[Y] * grid->size[Z];
+  padded = d.zstep * (grid->size[Z] + 2);
+
+  d.num_threads = number_of_threads;
+  if (d.num_threads > cells / MIN_CELLS_PER_THREAD)
+    d.num_threads = cells / MIN_CELLS_PER_THREAD;
+  if (d.num_threads < 1)
+    d.num_threads = 1;
+
+  d.val = (DATA_TYPE *)calloc(padded, sizeof(DATA_TYPE));
+  d.new_val = (DATA_TYPE *)calloc(padded, sizeof(DATA_TYPE));
+  d.open = (DATA_TYPE *)calloc(padded, sizeof(DATA_TYPE));
+  d.cnt = (DATA_TYPE *)calloc(padded, sizeof(DATA_TYPE));
+  d.update = (char *)calloc(padded, sizeof(char));
+  d.max_change = (DATA_TYPE *)malloc(d.num_threads * sizeof(DATA_TYPE));
+
+  if (d.val == NULL || d.new_val == NULL || d.open == NULL || d.cnt == NULL ||
+      d.update == NULL || d.max_change == NULL) {
     fprintf(stderr,
             "Soil diffusion - cannot allocate memory for the new grid!\n");
+    FreeDiffusion(&d);
     return;
   }
 
-  if (verbose)
-    fprintf(stderr, "Soil - starting diffusion: %d steps, tolerance %f\n",
-            steps, tolerance);
-
-  first_z = 1;
-  max_tolerance = tolerance;
+  /* copy the grid into the arrays */
+  ptr = grid->data;
+  for (z = 0; z < grid->size[Z]; z++)
+    for (y = 0; y < grid->size[Y]; y++)
+      for (x = 0; x < grid->size[X]; x++) {
+        i = (z + 1) * d.zstep + (y + 1) * d.ystep + x + 1;
+        d.val[i] = d.new_val[i] = ptr->val;
+        d.open[i] = ptr->flag != OBSTACLE;
+        d.update[i] = ptr->flag == DATA;
+        ptr++;
+      }
 
-  do {
-    completed = 1;
-    max_tolerance = 0;
+  for (z = 0; z < grid->size[Z]; z++)
+    for (y = 0; y < grid->size[Y]; y++)
+      for (x = 0; x < grid->size[X]; x++) {
+        i = (z + 1) * d.zstep + (y + 1) * d.ystep + x + 1;
+        d.cnt[i] = d.open[i - d.zstep] + d.open[i + d.zstep] +
+                   d.open[i - d.ystep] + d.open[i + d.ystep] + d.open[i - 1] +
+                   d.open[i + 1];
+      }
 
-    /* for all cells */
-    for (z = 0; z < grid->size[Z]; z++) {
-      last_z = z == (grid->size[Z] - 1);
+  d.omega = omega;
 
-      first_y = 1;
-      for (y = 0; y < grid->size[Y]; y++) {
-        last_y = y == (grid->size[Y] - 1);
+  if (verbose)
+    fprintf(stderr,
+            "Soil - starting diffusion: %d steps, tolerance %f, "
+            "%d thread(s)\n",
+            steps, tolerance, d.num_threads);
 
-        first_x = 1;
+  do {
+    max_tolerance = 0;
 
-        for (x = 0; x < grid->size[X]; x++) {
-          last_x = x == (grid->size[X] - 1);
-
-          act_cell = GetCell(grid, x, y, z);
-
-          /* check up to 6 possible face neighbors */
-          if (act_cell->flag == DATA) {
-            updated_val = 0.0;
-            cnt = 0;
-            if (!first_z) {
-              ptr = GetCell(grid, x, y, z - 1);
-              if (ptr->flag != OBSTACLE) {
-                updated_val += ptr->val;
-                cnt++;
-              }
-            }
-            if (!last_z) {
-              ptr = GetCell(grid, x, y, z + 1);
-              if (ptr->flag != OBSTACLE) {
-                updated_val += ptr->val;
-                cnt++;
-              }
-            }
-            if (!first_y) {
-              ptr = GetCell(grid, x, y - 1, z);
-              if (ptr->flag != OBSTACLE) {
-                updated_val += ptr->val;
-                cnt++;
-              }
-            }
-            if (!last_y) {
-              ptr = GetCell(grid, x, y + 1, z);
-              if (ptr->flag != OBSTACLE) {
-                updated_val += ptr->val;
-                cnt++;
-              }
-            }
-            if (!first_x) {
-              ptr = GetCell(grid, x - 1, y, z);
-              if (ptr->flag != OBSTACLE) {
-                updated_val += ptr->val;
-                cnt++;
-              }
-            }
-            if (!last_x) {
-              ptr = GetCell(grid, x + 1, y, z);
-              if (ptr->flag != OBSTACLE) {
-                updated_val += ptr->val;
-                cnt++;
-              }
-            }
+    if (steps == -1) {
+      for (d.color = 0; d.color <= 1; d.color++) {
+        RunThreads(d.num_threads, DiffuseRows, &d);
 
-            /* average values in the neighboring cells */
-            updated_val /= (DATA_TYPE)cnt;
-
-            /* omega controlls the speed of convergence */
-            updated_val =
-                (1 - omega) * (old_val = GetCell(grid, x, y, z)->val) +
-                omega * updated_val;
-
-            if (steps == -1) {
-              new_val = fabs((double)(updated_val - old_val));
-              if (new_val > tolerance) {
-                if (new_val > max_tolerance)
-                  max_tolerance = new_val;
-
-                new_val = updated_val;
-                completed = 0;
-              } else
-                new_val = old_val;
-            } else
-              new_val = updated_val;
-
-            /* keep the value within the range */
-            /*	  if(new_val > grid->max) new_val = grid->max;
-                  if(new_val < grid->min) new_val = grid->min; */
-          } else
-            new_val = act_cell->val;
-
-          new_data[z * zstep + y * ystep + x].val = new_val;
-          new_data[z * zstep + y * ystep + x].flag = act_cell->flag;
-          for (i = 0; i < MAXOBSTACLESINCELL; i++)
-            new_data[z * zstep + y * ystep + x].obstacle[i] =
-                act_cell->obstacle[i];
-
-          first_x = 0;
-        }
-        first_y = 0;
+        for (i = 0; i < d.num_threads; i++)
+          if (d.max_change[i] > max_tolerance)
+            max_tolerance = d.max_change[i];
       }
-      first_z = 0;
-    }
 
-    if (steps != -1)
+      /* the changes shrink by about the same ratio in each sweep, so
+         the values are about change * ratio / (1 - ratio) away from the
+         converged field */
+      ratio = last_change > 0 ? max_tolerance / last_change : 1;
+      completed = max_tolerance == 0 ||
+                  (ratio < 1 ? max_tolerance * ratio <= tolerance * (1 - ratio)
+                             : max_tolerance <= tolerance);
+      last_change = max_tolerance;
+
+      /* changes as small as the rounding errors do not shrink any more */
+      if (max_tolerance < min_change) {
+        min_change = max_tolerance;
+        stalled = 0;
+      } else if (++stalled == STALLED_SWEEPS)
+        completed = 1;
+    } else {
+      d.color = -1;
+      RunThreads(d.num_threads, DiffuseRows, &d);
+
       completed = --steps == 0;
 
-    /* switch the grids */
-    temp_ptr = grid->data;
-    grid->data = new_data;
-    new_data = temp_ptr;
+      /* switch the arrays */
+      temp_ptr = d.val;
+      d.val = d.new_val;
+      d.new_val = temp_ptr;
+    }
 
     if (verbose)
       fprintf(stderr, "Finished diffusion step %d. Max tolerance: %f.\n",
               ++step, max_tolerance);
   } while (!completed);
 
+  /* copy the values back */
+  ptr = grid->data;
+  for (z = 0; z < grid->size[Z]; z++)
+    for (y = 0; y < grid->size[Y]; y++)
+      for (x = 0; x < grid->size[X]; x++) {
+        ptr->val = d.val[(z + 1) * d.zstep + (y + 1) * d.ystep + x + 1];
+        ptr++;
+      }
+
   /* remove CONSUMER bit from each cell flag */
   ptr = grid->data;
 
@@ -1263,7 +1323,7 @@ void SimulateDiffusion(grid_type *grid, int steps, DATA_TYPE tolerance) {
         ptr++;
       }
 
-  free(new_data);
+  FreeDiffusion(&d);
 }
 
 /************************************************************************/
@@ -1325,6 +1385,7 @@ void ProcessArguments(int argc, char **argv) {
       "section material",            /* 17 */
       "output normals",              /* 18 */
       "keep depleted cells",         /* 19 */
+      "number of threads",           /* 20 */
       NULL                           /* the last item must be NULL! */
   };
   char *token, input_line[255];
@@ -1335,6 +1396,7 @@ void ProcessArguments(int argc, char **argv) {
   verbose = 0;
   depletion = 1;
   omega = 0.5;
+  number_of_threads = 1;
   obs_src = 0;
   output_type = POLYGONS;
   keep_depl_cells = 0;
@@ -1735,6 +1797,13 @@ void ProcessArguments(int argc, char **argv) {
         if (strcmp(token, "on") == 0)
           keep_depl_cells = 1;
         break;
+
+      case 20: /* number of threads, 0 for one per processor */
+        token = strtok(NULL, "x,; \t:\n");
+        if (token == NULL)
+          break;
+        number_of_threads = NumberOfThreads(token);
+        break;
       }
     }
   }
@@ -1762,6 +1831,7 @@ void ProcessArguments(int argc, char **argv) {
 
     fprintf(stderr, "Soil - diffusion: steps %d, tolerance %g\n", diff_steps,
             diff_tolerance);
+    fprintf(stderr, "Soil - number of threads: %d\n", number_of_threads);
 
     fprintf(stderr, "Soil - %d layers:\n       thicknesses:", num_layers);
     for (i = 0; i < num_layers; i++)
@@ -0,0 +1,31 @@
+#!/bin/sh
+# Renders each example serially and on several threads and checks that
+# the images are identical: the banded renderer must not change a pixel.
+#
+# Usage: ./checkthreads.sh [rayshade] [threads]
+
+RAYSHADE=${1:-rayshade}
+THREADS=${2:-4}
+TMP=${TMPDIR:-/tmp}/checkthreads.$$
+status=0
+
+mkdir -p $TMP || exit 1
+for scene in *.ray; do
+  case $scene in
+    *.def.ray) continue ;;
+  esac
+  name=`basename $scene .ray`
+  if ! $RAYSHADE -q -t 1 -O $TMP/$name.1 $scene 2>/dev/null ||
+     ! $RAYSHADE -q -t $THREADS -O $TMP/$name.$THREADS $scene 2>/dev/null
+  then
+    echo "$name: not rendered"
+    status=1
+  elif cmp -s $TMP/$name.1 $TMP/$name.$THREADS; then
+    echo "$name: identical"
+  else
+    echo "$name: threaded image differs from serial"
+    status=1
+  fi
+done
+rm -rf $TMP
+exit $status
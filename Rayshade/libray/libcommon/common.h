@@ -72,11 +72,21 @@ typedef char *voidstar;
 
 #define UNSET -1
 
+/*
+ * Storage class of the global variables that each rendering thread
+ * has its own copy of: counters, scratch values and the like.
+ */
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
 /*
  * Some systems, such as the RS6000, have fast fabs already defined.
  */
 #ifndef fabs
-extern Float RSabstmp;
+extern THREAD_LOCAL Float RSabstmp;
 #define fabs(x) ((RSabstmp = x) < 0 ? -RSabstmp : RSabstmp)
 #endif
 
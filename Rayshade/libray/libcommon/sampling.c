@@ -19,6 +19,14 @@
 
 SampleInfo Sampling; /* sampling information */
 
+/*
+ * State of the random number generator used in sampling.  Each thread
+ * has its own generator, which is reseeded for every pixel, so that the
+ * samples of a pixel do not depend on the thread rendering it or on
+ * what was rendered before.
+ */
+static THREAD_LOCAL unsigned long long SampleState;
+
 /*
  * Set sampling options.
  */
@@ -99,12 +107,39 @@ int sample;
   if (sample >= 0) {
     jit = 2. * Sampling.spacing;
 
-    pnt->x = nrand() * jit - 1.0 + (sample % Sampling.sidesamples) * jit;
-    pnt->y = nrand() * jit - 1.0 + (sample / Sampling.sidesamples) * jit;
+    pnt->x =
+        SampleRandom() * jit - 1.0 + (sample % Sampling.sidesamples) * jit;
+    pnt->y =
+        SampleRandom() * jit - 1.0 + (sample / Sampling.sidesamples) * jit;
     pnt->z = 0.0;
   } else {
-    pnt->x = nrand() * 2.0 - 1.0;
-    pnt->y = nrand() * 2.0 - 1.0;
+    pnt->x = SampleRandom() * 2.0 - 1.0;
+    pnt->y = SampleRandom() * 2.0 - 1.0;
     pnt->z = 0.0;
   }
 }
+
+/*
+ * Seed the generator of the calling thread from the pixel x, y and
+ * the kind of sampling n.
+ */
+void SampleSeed(int x, int y, int n) {
+  SampleState =
+      (((unsigned long long)(unsigned int)x << 32) | (unsigned int)y) *
+          0x9e3779b97f4a7c15ULL ^
+      (unsigned long long)(unsigned int)n * 0xc2b2ae3d27d4eb4fULL;
+}
+
+/*
+ * Return a uniformly distributed random number in [0, 1) from the
+ * generator of the calling thread (splitmix64).
+ */
+Float SampleRandom() {
+  unsigned long long z;
+
+  z = (SampleState += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  z ^= z >> 31;
+  return (Float)(z >> 11) * (1. / 9007199254740992.);
+}
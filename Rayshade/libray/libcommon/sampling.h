@@ -42,4 +42,6 @@ extern SampleInfo Sampling;
 
 extern void SamplingSetOptions(), UnitCirclePoint();
 extern void SamplingSetTime(Float starttime, Float shutter, int frame);
+extern void SampleSeed(int x, int y, int n);
+extern Float SampleRandom();
 #endif /* SAMPLING */
@@ -80,8 +80,8 @@ int noshadow;
    */
   vpos = -lp->radius + (ray->sample % Sampling.sidesamples) * jit;
   upos = -lp->radius + (ray->sample / Sampling.sidesamples) * jit;
-  vpos += nrand() * jit;
-  upos += nrand() * jit;
+  vpos += SampleRandom() * jit;
+  upos += SampleRandom() * jit;
   VecComb(upos, Uaxis, vpos, Vaxis, &newray.dir);
   VecAdd(ldir, newray.dir, &newray.dir);
   lightdist = VecNormalize(&newray.dir);
@@ -16,6 +16,7 @@
  *
  */
 #include "light.h"
+#include "libcommon/sampling.h"
 #include "jittered.h"
 #include "shadow.h"
 static LightMethods *iJitteredMethods = NULL;
@@ -52,13 +53,15 @@ void JitteredDirection(lp, pos, dir, dist) Jittered *lp;
 Vector *pos, *dir;
 Float *dist;
 {
+  Vector curpos;
+
   /*
    * Choose a location with the area define by corner, e1
    * and e2 at which this sample will be taken.
    */
-  VecAddScaled(lp->pos, nrand(), lp->e1, &lp->curpos);
-  VecAddScaled(lp->curpos, nrand(), lp->e2, &lp->curpos);
-  VecSub(lp->curpos, *pos, dir);
+  VecAddScaled(lp->pos, SampleRandom(), lp->e1, &curpos);
+  VecAddScaled(curpos, SampleRandom(), lp->e2, &curpos);
+  VecSub(curpos, *pos, dir);
   *dist = VecNormalize(dir);
 }
 
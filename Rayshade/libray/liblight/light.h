@@ -62,5 +62,6 @@ extern Light *LightCreate(LightRef light, LightMethods *meth, Color *color);
 extern void LightAllocateCache(), LightAddToDefined();
 extern int LightIntens(), LightDirection();
 extern void ShadowSetOptions(), ShadowStats();
+extern void ShadowSelectCache(int index);
 
 #endif /* LIGHT_H */
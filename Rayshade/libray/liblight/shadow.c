@@ -21,10 +21,16 @@
 #include "libobj/csg.h"
 #include "libobj/intersect.h"
 /*
- * Shadow stats.
+ * Shadow stats, counted by each thread.
  * External functions have read access via ShadowStats().
  */
-static unsigned long ShadowRays, ShadowHits, CacheMisses, CacheHits;
+static THREAD_LOCAL unsigned long ShadowRays, ShadowHits, CacheMisses,
+    CacheHits;
+/*
+ * Index of the first entry of the shadow caches used by the thread.
+ * Set by external modules via ShadowSelectCache().
+ */
+static THREAD_LOCAL int CacheIndex;
 /*
  * Options controlling how shadowing information is determined.
  * Set by external modules via ShadowSetOptions().
@@ -63,7 +69,7 @@ int noshadow;       /* If TRUE, no shadow ray is cast. */
 
   ShadowRays++;
   s = dist;
-  cp = &cache[ray->depth];
+  cp = &cache[CacheIndex + ray->depth];
   /*
    * Check shadow cache.  SHADOWCACHE() is implied.
    */
@@ -231,6 +237,12 @@ void ShadowStats(shadowrays, shadowhit, cachehit,
 void ShadowSetOptions(options) long options;
 { ShadowOptions = options; }
 
+/*
+ * Make the calling thread use the entries of the shadow caches from
+ * index on, one per ray depth.
+ */
+void ShadowSelectCache(int index) { CacheIndex = index; }
+
 void LightCacheHit(hitlist, cache) HitList *hitlist;
 ShadowCache *cache;
 {
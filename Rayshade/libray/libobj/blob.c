@@ -21,7 +21,7 @@
 static Methods *iBlobMethods = NULL;
 static char blobName[] = "blob";
 
-unsigned long BlobTests, BlobHits;
+THREAD_LOCAL unsigned long BlobTests, BlobHits;
 
 /*
  * Blob/Metaball Description
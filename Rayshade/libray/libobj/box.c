@@ -21,7 +21,7 @@
 static Methods *iBoxMethods = NULL;
 static char boxName[] = "box";
 
-unsigned long BoxTests, BoxHits;
+THREAD_LOCAL unsigned long BoxTests, BoxHits;
 
 Box *BoxCreate(v1, v2) Vector *v1, *v2;
 {
@@ -0,0 +1,354 @@
+/*
+ * bvh.c
+ *
+ * Bounding volume hierarchy aggregate.
+ *
+ * The hierarchy is built top-down with the surface area heuristic,
+ * evaluated over BVH_BINS bins of the objects' centers along each axis,
+ * and stored as an array of nodes which is traversed without recursion.
+ */
+#include "geom.h"
+#include "bvh.h"
+
+/*
+ * Number of bins the centers are sorted into when looking
+ * for the best split.
+ */
+#define BVH_BINS 16
+/*
+ * Relative costs of visiting a node and of intersecting an object.
+ */
+#define BVH_TRAVERSAL_COST 1.
+#define BVH_INTERSECT_COST 1.
+/*
+ * Nodes with more objects than BVH_LEAFSIZE are always split.  Nodes
+ * BVH_MAXDEPTH deep are never split, which bounds the traversal stack.
+ */
+#define BVH_LEAFSIZE 4
+#define BVH_MAXDEPTH 64
+
+static Methods *iBvhMethods = NULL;
+static char bvhName[] = "bvh";
+
+static int BvhBuild(), BvhBin(), BvhNodeHit();
+static Float BvhArea();
+
+Bvh *BvhCreate() { return (Bvh *)share_calloc(1, sizeof(Bvh)); }
+
+char *BvhName() { return bvhName; }
+
+/*
+ * Intersect ray with hierarchy, visiting the child on the side the
+ * ray comes from first.
+ */
+int BvhIntersect(bvh, ray, hitlist, mindist, maxdist) Bvh *bvh;
+Ray *ray;
+HitList *hitlist;
+Float mindist, *maxdist;
+{
+  Geom *obj;
+  BvhNode *node;
+  Float pos[3], dir[3], invdir[3];
+  int stack[BVH_MAXDEPTH + 1], top, i, n, hit;
+
+  hit = FALSE;
+  /*
+   * Check unbounded objects.
+   */
+  for (obj = bvh->unbounded; obj; obj = obj->next) {
+    if (intersect(obj, ray, hitlist, mindist, maxdist))
+      hit = TRUE;
+  }
+
+  if (bvh->nnodes == 0)
+    return hit;
+
+  pos[X] = ray->pos.x;
+  pos[Y] = ray->pos.y;
+  pos[Z] = ray->pos.z;
+  dir[X] = ray->dir.x;
+  dir[Y] = ray->dir.y;
+  dir[Z] = ray->dir.z;
+  for (i = 0; i < 3; i++)
+    invdir[i] = dir[i] == 0. ? 0. : 1. / dir[i];
+
+  stack[0] = 0;
+  top = 1;
+  while (top) {
+    n = stack[--top];
+    node = &bvh->nodes[n];
+    if (!BvhNodeHit(node, pos, dir, invdir, mindist, *maxdist))
+      continue;
+    if (node->count) {
+      for (i = node->index; i < node->index + node->count; i++) {
+        if (intersect(bvh->objs[i], ray, hitlist, mindist, maxdist))
+          hit = TRUE;
+      }
+    } else if (dir[node->axis] < 0.) {
+      stack[top++] = n + 1;
+      stack[top++] = node->index;
+    } else {
+      stack[top++] = node->index;
+      stack[top++] = n + 1;
+    }
+  }
+  return hit;
+}
+
+/*
+ * Check whether the ray passes through the node's bounding box
+ * between mindist and maxdist.
+ */
+static int BvhNodeHit(node, pos, dir, invdir, mindist, maxdist) BvhNode *node;
+Float pos[3], dir[3], invdir[3], mindist, maxdist;
+{
+  Float t0, t1, tmp;
+  int i;
+
+  for (i = 0; i < 3; i++) {
+    if (dir[i] == 0.) {
+      if (pos[i] < node->bounds[LOW][i] || pos[i] > node->bounds[HIGH][i])
+        return FALSE;
+      continue;
+    }
+    t0 = (node->bounds[LOW][i] - pos[i]) * invdir[i];
+    t1 = (node->bounds[HIGH][i] - pos[i]) * invdir[i];
+    if (t0 > t1) {
+      tmp = t0;
+      t0 = t1;
+      t1 = tmp;
+    }
+    if (t0 > mindist)
+      mindist = t0;
+    if (t1 < maxdist)
+      maxdist = t1;
+    if (mindist > maxdist)
+      return FALSE;
+  }
+  return TRUE;
+}
+
+int BvhConvert(bvh, objlist) Bvh *bvh;
+Geom *objlist;
+{
+  int num;
+
+  bvh->objects = objlist;
+  for (num = 0; objlist; objlist = objlist->next)
+    num += objlist->prims;
+
+  return num;
+}
+
+void BvhBounds(bvh, bounds) Bvh *bvh;
+Float bounds[2][3];
+{
+  Geom *obj;
+  Float(*center)[3];
+  int i, n;
+
+  bvh->unbounded =
+      GeomComputeAggregateBounds(&bvh->objects, bvh->unbounded, bvh->bounds);
+  BoundsCopy(bvh->bounds, bounds);
+
+  /*
+   * New frame...
+   * The objects may have moved, so rebuild the hierarchy.
+   */
+  if (bvh->nodes) {
+    free((voidstar)bvh->nodes);
+    free((voidstar)bvh->objs);
+    bvh->nodes = (BvhNode *)NULL;
+    bvh->objs = (Geom **)NULL;
+  }
+  bvh->nnodes = 0;
+
+  for (n = 0, obj = bvh->objects; obj; obj = obj->next)
+    n++;
+  if (n == 0)
+    return;
+
+  bvh->objs = (Geom **)share_malloc(n * sizeof(Geom *));
+  bvh->nodes = (BvhNode *)share_malloc((2 * n - 1) * sizeof(BvhNode));
+  center = (Float(*)[3])Malloc(n * sizeof(Float[3]));
+
+  for (n = 0, obj = bvh->objects; obj; obj = obj->next, n++) {
+    bvh->objs[n] = obj;
+    for (i = 0; i < 3; i++)
+      center[n][i] = 0.5 * (obj->bounds[LOW][i] + obj->bounds[HIGH][i]);
+  }
+
+  (void)BvhBuild(bvh, center, 0, n, 0);
+  free((voidstar)center);
+}
+
+/*
+ * Build the subtree of objects first to last-1, returning the index of
+ * its root.  The objects and their centers are reordered so that the
+ * objects of each subtree follow each other.
+ */
+static int BvhBuild(bvh, center, first, last, depth) Bvh *bvh;
+Float (*center)[3];
+int first, last, depth;
+{
+  BvhNode *node;
+  Float cbounds[2][3], binbounds[BVH_BINS][2][3], acc[2][3];
+  Float area[BVH_BINS], nodearea, cost, bestcost, leafcost;
+  int count[BVH_BINS], n, i, j, b, axis, bestaxis, bestbin, nleft, index;
+  Float tmp[3];
+  Geom *obj;
+
+  index = bvh->nnodes++;
+  node = &bvh->nodes[index];
+  n = last - first;
+
+  BoundsInit(node->bounds);
+  BoundsInit(cbounds);
+  for (i = first; i < last; i++) {
+    BoundsEnlarge(node->bounds, bvh->objs[i]->bounds);
+    for (j = 0; j < 3; j++) {
+      if (center[i][j] < cbounds[LOW][j])
+        cbounds[LOW][j] = center[i][j];
+      if (center[i][j] > cbounds[HIGH][j])
+        cbounds[HIGH][j] = center[i][j];
+    }
+  }
+
+  node->index = first;
+  node->count = n;
+  node->axis = X;
+  if (n == 1 || depth == BVH_MAXDEPTH)
+    return index;
+
+  /*
+   * Find the cheapest split of the bins along any axis.  The cost of
+   * a child is the number of its objects times its surface area,
+   * relative to that of the node.
+   */
+  bestcost = 0.;
+  bestaxis = bestbin = -1;
+  for (axis = 0; axis < 3; axis++) {
+    if (cbounds[HIGH][axis] <= cbounds[LOW][axis])
+      continue;
+    for (b = 0; b < BVH_BINS; b++) {
+      count[b] = 0;
+      BoundsInit(binbounds[b]);
+    }
+    for (i = first; i < last; i++) {
+      b = BvhBin(center[i][axis], cbounds, axis);
+      count[b]++;
+      BoundsEnlarge(binbounds[b], bvh->objs[i]->bounds);
+    }
+    /*
+     * Sweep from the right, recording the cost of the bins
+     * right of each split, then from the left.
+     */
+    BoundsInit(acc);
+    for (b = BVH_BINS - 1, j = 0; b > 0; b--) {
+      BoundsEnlarge(acc, binbounds[b]);
+      j += count[b];
+      area[b] = j ? j * BvhArea(acc) : 0.;
+    }
+    BoundsInit(acc);
+    for (b = 0, j = 0; b < BVH_BINS - 1; b++) {
+      BoundsEnlarge(acc, binbounds[b]);
+      j += count[b];
+      if (j == 0 || j == n)
+        continue;
+      cost = j * BvhArea(acc) + area[b + 1];
+      if (bestaxis < 0 || cost < bestcost) {
+        bestcost = cost;
+        bestaxis = axis;
+        bestbin = b;
+      }
+    }
+  }
+
+  /*
+   * All centers coincide; the objects cannot be told apart.
+   */
+  if (bestaxis < 0)
+    return index;
+
+  leafcost = BVH_INTERSECT_COST * n;
+  nodearea = BvhArea(node->bounds);
+  cost = BVH_TRAVERSAL_COST +
+         (nodearea > 0. ? BVH_INTERSECT_COST * bestcost / nodearea : leafcost);
+  if (n <= BVH_LEAFSIZE && leafcost <= cost)
+    return index;
+
+  /*
+   * Move the objects left of the split to the front.
+   */
+  nleft = first;
+  for (i = first; i < last; i++) {
+    if (BvhBin(center[i][bestaxis], cbounds, bestaxis) <= bestbin) {
+      obj = bvh->objs[i];
+      bvh->objs[i] = bvh->objs[nleft];
+      bvh->objs[nleft] = obj;
+      for (j = 0; j < 3; j++) {
+        tmp[j] = center[i][j];
+        center[i][j] = center[nleft][j];
+        center[nleft][j] = tmp[j];
+      }
+      nleft++;
+    }
+  }
+
+  node->count = 0;
+  node->axis = bestaxis;
+  (void)BvhBuild(bvh, center, first, nleft, depth + 1);
+  node->index = BvhBuild(bvh, center, nleft, last, depth + 1);
+  return index;
+}
+
+/*
+ * Bin a center falls into along the given axis.
+ */
+static int BvhBin(c, cbounds, axis) Float c, cbounds[2][3];
+int axis;
+{
+  int b;
+
+  b = (int)(BVH_BINS * (c - cbounds[LOW][axis]) /
+            (cbounds[HIGH][axis] - cbounds[LOW][axis]));
+  if (b >= BVH_BINS)
+    b = BVH_BINS - 1;
+  if (b < 0)
+    b = 0;
+  return b;
+}
+
+/*
+ * Half the surface area of a bounding box.
+ */
+static Float BvhArea(bounds) Float bounds[2][3];
+{
+  Float dx, dy, dz;
+
+  dx = bounds[HIGH][X] - bounds[LOW][X];
+  dy = bounds[HIGH][Y] - bounds[LOW][Y];
+  dz = bounds[HIGH][Z] - bounds[LOW][Z];
+  return dx * dy + dy * dz + dz * dx;
+}
+
+Methods *BvhMethods() {
+  if (iBvhMethods == (Methods *)NULL) {
+    iBvhMethods = MethodsCreate();
+    iBvhMethods->methods = BvhMethods;
+    iBvhMethods->create = (GeomCreateFunc *)BvhCreate;
+    iBvhMethods->intersect = BvhIntersect;
+    iBvhMethods->name = BvhName;
+    iBvhMethods->convert = BvhConvert;
+    iBvhMethods->bounds = BvhBounds;
+    iBvhMethods->checkbounds = FALSE;
+    iBvhMethods->closed = TRUE;
+  }
+  return iBvhMethods;
+}
+
+void BvhMethodRegister(meth) UserMethodType meth;
+{
+  if (iBvhMethods)
+    iBvhMethods->user = meth;
+}
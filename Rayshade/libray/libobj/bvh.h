@@ -0,0 +1,42 @@
+/*
+ * bvh.h
+ *
+ * Bounding volume hierarchy aggregate.
+ */
+#ifndef BVH_H
+#define BVH_H
+#include "intersect.h"
+
+#define GeomBvhCreate() GeomCreate((GeomRef)BvhCreate(), BvhMethods())
+
+/*
+ * Node of a bounding volume hierarchy.  The nodes are stored in
+ * depth-first order, so that the first child of an interior node
+ * is the node following it.
+ */
+typedef struct {
+  Float bounds[2][3]; /* Bounding box of node */
+  int index;          /* Second child, or first object of leaf */
+  int count;          /* # of objects in leaf, 0 if interior */
+  int axis;           /* Axis the children are split along */
+} BvhNode;
+
+/*
+ * Bounding volume hierarchy object
+ */
+typedef struct {
+  Float bounds[2][3];     /* Bounding box of object */
+  struct Geom *unbounded, /* unbounded objects */
+      *objects;           /* all bounded objects */
+  struct Geom **objs;     /* Bounded objects, in order of the leaves */
+  BvhNode *nodes;         /* Nodes of the hierarchy */
+  int nnodes;             /* # of nodes */
+} Bvh;
+
+extern char *BvhName();
+extern int BvhIntersect(), BvhConvert();
+extern void BvhBounds();
+extern Bvh *BvhCreate();
+extern Methods *BvhMethods();
+
+#endif /* BVH_H */
@@ -21,7 +21,7 @@
 static Methods *iConeMethods = NULL;
 static char coneName[] = "cone";
 
-unsigned long ConeTests, ConeHits;
+THREAD_LOCAL unsigned long ConeTests, ConeHits;
 
 Cone *ConeCreate(br, bot, ar, apex) Vector *bot, *apex;
 Float br, ar;
@@ -21,7 +21,7 @@
 static Methods *iCylinderMethods = NULL;
 static char cylName[] = "cylinder";
 
-unsigned long CylTests, CylHits;
+THREAD_LOCAL unsigned long CylTests, CylHits;
 
 Cylinder *CylinderCreate(r, bot, top) Float r;
 Vector *bot, *top;
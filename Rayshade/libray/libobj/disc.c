@@ -20,7 +20,7 @@
 static Methods *iDiscMethods = NULL;
 static char discName[] = "disc";
 
-unsigned long DiscTests, DiscHits;
+THREAD_LOCAL unsigned long DiscTests, DiscHits;
 
 Disc *DiscCreate(ro, ri, pos, norm) Float ro, ri;
 Vector *pos, *norm;
@@ -21,8 +21,13 @@
 static Methods *iGridMethods = NULL;
 static char gridName[] = "grid";
 
-static unsigned long raynumber = 1; /* Current "ray number". */
-                                    /* (should be "grid number") */
+/*
+ * Current "ray number" (should be "grid number") of each thread.
+ * The threads number their rays raystep apart, starting from different
+ * numbers (see GridSetRayNumbers()), so that an object marked with the
+ * number of one thread's ray is not skipped for the ray of another one.
+ */
+static THREAD_LOCAL unsigned long raynumber = 1, raystep = 1;
 static void engrid(), GridFreeVoxels();
 static int pos2grid(), CheckVoxel();
 
@@ -92,7 +97,8 @@ Float mindist, *maxdist;
   } else
     offset = mindist;
 
-  counter = raynumber++;
+  counter = raynumber;
+  raynumber += raystep;
 
   /*
    * tMaxX is the absolute distance from the ray origin we must move
@@ -259,16 +265,18 @@ Float mindist, *maxdist;
   do {
     obj = list->obj;
     /*
-     * If object's counter is greater than or equal to the
-     * number associated with the current grid,
-     * don't bother checking again.  In addition, if the
+     * If object's counter is equal to the number associated
+     * with the current grid, don't bother checking again.
+     * Another thread may overwrite the counter at any time,
+     * which only causes the object to be checked twice.
+     * In addition, if the
      * bounding box of the ray's extent in the voxel does
      * not intersect the bounding box of the object, don't bother.
      */
 #ifdef SHAREDMEM
-    if (*obj->counter < counter &&
+    if (*obj->counter != counter &&
 #else
-    if (obj->counter < counter &&
+    if (obj->counter != counter &&
 #endif
         obj->bounds[LOW][X] <= hx && obj->bounds[HIGH][X] >= lx &&
         obj->bounds[LOW][Y] <= hy && obj->bounds[HIGH][Y] >= ly &&
@@ -286,6 +294,20 @@ Float mindist, *maxdist;
   return hit;
 }
 
+/*
+ * Set the number of the next ray of the calling thread, and the
+ * difference between the numbers of its consecutive rays.
+ */
+void GridSetRayNumbers(unsigned long next, unsigned long step) {
+  raynumber = next;
+  raystep = step;
+}
+
+/*
+ * Return the number of the next ray of the calling thread.
+ */
+unsigned long GridNextRayNumber() { return raynumber; }
+
 int GridConvert(grid, objlist) Grid *grid;
 Geom *objlist;
 {
@@ -50,5 +50,7 @@ extern void *GirdBounds();
 extern int GridIntersect(), GridConvert();
 extern Grid *GridCreate(int x, int y, int z);
 extern Methods *GridMethods();
+extern void GridSetRayNumbers(unsigned long next, unsigned long step);
+extern unsigned long GridNextRayNumber();
 
 #endif /* GRID_H */
@@ -36,7 +36,7 @@ typedef struct {
 
 static hfTri *CreateHfTriangle(), *GetQueuedTri();
 
-unsigned long HFTests, HFHits;
+THREAD_LOCAL unsigned long HFTests, HFHits;
 
 Hf *HfCreate(filename) char *filename;
 {
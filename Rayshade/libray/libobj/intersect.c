@@ -19,10 +19,10 @@
 
 static void AddToHitList();
 /*
- * Number of bounding volume tests.
+ * Number of bounding volume tests, counted by each thread.
  * External modules have read access via IntersectStats().
  */
-static unsigned long BVTests;
+static THREAD_LOCAL unsigned long BVTests;
 
 /*
  * Intersect object & ray.  Return distance from "pos" along "ray" to
@@ -150,7 +150,7 @@ Geom *obj;
 }
 
 /*
- * Return intersection statistics.
+ * Return intersection statistics of the calling thread.
  * Currently, this is limited to the # of bounding volume test performed.
  */
 void IntersectStats(bvtests) unsigned long *bvtests;
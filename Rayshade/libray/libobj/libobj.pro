@@ -3,7 +3,7 @@ LANGUAGE = C
 CONFIG  += staticlib
 CONFIG -= qt
 TARGET   = rayobj
-SOURCES  = blob.c bounds.c box.c cone.c csg.c cylinder.c disc.c grid.c \
+SOURCES  = blob.c bounds.c box.c bvh.c cone.c csg.c cylinder.c disc.c grid.c \
 	 hf.c instance.c list.c intersect.c geom.c plane.c poly.c \
 	 roots.c sphere.c torus.c triangle.c
 HEADERS = 
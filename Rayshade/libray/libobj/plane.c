@@ -21,7 +21,7 @@
 static Methods *iPlaneMethods = NULL;
 static char planeName[] = "plane";
 
-unsigned long PlaneTests, PlaneHits;
+THREAD_LOCAL unsigned long PlaneTests, PlaneHits;
 
 /*
  * create plane primitive
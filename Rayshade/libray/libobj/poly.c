@@ -21,7 +21,7 @@
 static Methods *iPolygonMethods = NULL;
 static char polyName[] = "polygon";
 
-unsigned long PolyTests, PolyHits;
+THREAD_LOCAL unsigned long PolyTests, PolyHits;
 
 /*
  * Create a reference to a polygon with vertices equal to those
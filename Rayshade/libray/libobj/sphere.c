@@ -21,7 +21,7 @@
 static Methods *iSphereMethods = NULL;
 static char sphereName[] = "sphere";
 
-unsigned long SphTests, SphHits;
+THREAD_LOCAL unsigned long SphTests, SphHits;
 
 /*
  * Create & return reference to a sphere.
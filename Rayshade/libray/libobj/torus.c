@@ -20,7 +20,7 @@
 #include "roots.h"
 static Methods *iTorusMethods = NULL;
 static char torusName[] = "torus";
-unsigned long TorusTests, TorusHits;
+THREAD_LOCAL unsigned long TorusTests, TorusHits;
 
 /*
  * Create & return reference to a torus.
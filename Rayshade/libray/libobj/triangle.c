@@ -21,7 +21,7 @@
 static Methods *iTriangleMethods = NULL;
 static char triName[] = "triangle";
 
-unsigned long TriTests, TriHits;
+THREAD_LOCAL unsigned long TriTests, TriHits;
 
 static void TriangleSetdPdUV();
 
@@ -43,6 +43,8 @@
 
 #define REPORTFREQ 10 /* Frequency of status report */
 
+#define THREADS 1 /* Default # of rendering threads. */
+
 #define DEFREDCONT 0.2 /* Default contrast threshold values. */
 #define DEFGREENCONT 0.15
 #define DEFBLUECONT 0.3
@@ -4,7 +4,7 @@ CONFIG  += staticlib yacc_no_name_mangle
 CONFIG -= qt
 TARGET   = lshade
 SOURCES  = setup.c viewing.c shade.c picture.c  builtin.c symtab.c misc.c lightdef.c objdef.c options.c \
-		stats.c surfdef.c yacc.c lex.c
+		stats.c surfdef.c threads.c yacc.c lex.c
 HEADERS = ../config.h  funcdefs.h \
 		../patchlevel.h rayshade.h 
 
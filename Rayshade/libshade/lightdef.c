@@ -14,6 +14,7 @@
  * for any purpose.  It is provided solely "as is".
  *
  */
+#include <string.h>
 #include "rayshade.h"
 #include "options.h"
 #include "liblight/light.h"
@@ -65,14 +66,30 @@ void LightSetup() {
   /*
    * Now that we've parsed the input file, we know what
    * maxlevel is, and we can allocate the correct amount of
-   * space for each light source's cache.
+   * space for each light source's cache, one for each thread.
    */
   for (ltmp = Lights; ltmp; ltmp = ltmp->next) {
-    ltmp->cache = (ShadowCache *)Calloc((unsigned)Options.maxdepth + 1,
-                                        sizeof(ShadowCache));
+    ltmp->cache =
+        (ShadowCache *)Calloc((unsigned)(Options.maxdepth + 1) * Options.threads,
+                              sizeof(ShadowCache));
   }
 }
 
+/*
+ * Make the calling thread use the shadow caches of the given thread,
+ * and empty them, so that the shadows do not depend on what the thread
+ * rendered before.
+ */
+void LightSelectCache(int thread) {
+  Light *ltmp;
+  int depths = Options.maxdepth + 1;
+
+  ShadowSelectCache(thread * depths);
+  for (ltmp = Lights; ltmp; ltmp = ltmp->next)
+    if (ltmp->cache)
+      memset(ltmp->cache + thread * depths, 0, depths * sizeof(ShadowCache));
+}
+
 void AreaLightCreate(color, corner, u, usamp, v, vsamp, shadow) Color *color;
 Vector *corner, *u, *v;
 int usamp, vsamp, shadow;
@@ -2,5 +2,6 @@
 #define LIGHTDEF_H
 
 void LightSetup();
+void LightSelectCache(int thread);
 
 #endif
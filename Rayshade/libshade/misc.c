@@ -30,7 +30,7 @@
 #include "stats.h"
 #include "misc.h"
 #include "symtab.h"
-Float RSabstmp; /* Temporary value used by fabs macro.  Ugly. */
+THREAD_LOCAL Float RSabstmp; /* Temporary value used by fabs macro.  Ugly. */
 static void RSmessage();
 extern void yyparse();
 
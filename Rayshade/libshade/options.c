@@ -19,6 +19,7 @@
 #include "options.h"
 #include "stats.h"
 #include "viewing.h"
+#include "threads.h"
 
 RSOptions Options;
 
@@ -195,6 +196,16 @@ char **argv;
       argv += 3;
       argc -= 3;
       break;
+    case 't':
+      /*
+       * Number of rendering threads, one per processor if 0
+       */
+      Options.threads = atoi(argv[1]);
+      if (Options.threads < 1)
+        Options.threads = NumberOfProcessors();
+      argv++;
+      argc--;
+      break;
     case 'u':
       Options.cpp = !Options.cpp;
       break;
@@ -277,6 +288,13 @@ void RSOptionsList() {
     fprintf(Stats.fstats, "Shadow caching is disabled.\n");
   if (Options.totalframes != 1)
     fprintf(Stats.fstats, "Rendering %d frames.\n", Options.totalframes);
+  if (Options.threads > 1) {
+    if (Options.serial || Options.shutterspeed > 0.)
+      fprintf(Stats.fstats, "Rendering on one thread, the world is animated "
+                            "or has heightfields or blobs.\n");
+    else
+      fprintf(Stats.fstats, "Rendering on %d threads.\n", Options.threads);
+  }
 }
 
 static void usage() {
@@ -317,6 +335,7 @@ static void usage() {
   fprintf(stderr, "\t-S samples\t(Max density of samples^2 samples.)\n");
   fprintf(stderr, "\t-s \t\t(Don't cache shadowing information.)\n");
   fprintf(stderr, "\t-T r g b\t(Set contrast threshold (0. - 1.).)\n");
+  fprintf(stderr, "\t-t threads\t(Render on threads, 0 = one per processor.)\n");
   fprintf(stderr, "\t-V filename \t(Write verbose output to filename.)\n");
   fprintf(stderr, "\t-v \t\t(Verbose output.)\n");
   fprintf(stderr, "\t-W x x y y \t(Render subwindow.)\n");
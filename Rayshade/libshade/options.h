@@ -57,6 +57,8 @@ typedef struct RSOptions {
       endframe,        /* ending frame number */
       totalframes,     /* total # of frames */
       totalframes_set, /* set on command line? */
+      threads,         /* # of rendering threads */
+      serial,          /* world can only be rendered on one thread */
       cpp;             /* run CPP? */
 #ifdef URT
   int alpha;      /* Write alpha channel? */
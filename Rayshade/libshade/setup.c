@@ -79,6 +79,7 @@ void RSSetup() {
   Options.cpp = TRUE;
   Options.maxdepth = MAXDEPTH;
   Options.report_freq = REPORTFREQ;
+  Options.threads = THREADS;
   Options.jitter = TRUE;
   Options.samples = UNSET;
   Options.gaussian = GAUSSIAN;
@@ -22,21 +22,35 @@
 #include "stats.h"
 #include "misc.h"
 
-RSStats Stats;        /* Statistical information */
-Geom *GeomRep = NULL; /* Linked list of object representatives */
+THREAD_LOCAL RSStats Stats; /* Statistical information, per thread */
+Geom *GeomRep = NULL;       /* Linked list of object representatives */
+/*
+ * Intersection tests and hits of the object representatives, in the
+ * order of GeomRep, added from threads other than the main one.
+ */
+static int RepCount = 0;
+static unsigned long *RepTests = NULL, *RepHits = NULL;
 
 static void PrintGeomStats();
 
 void StatsPrint() {
   extern void PrintMemoryStats();
-  unsigned long TotalRays;
+  unsigned long TotalRays, shadowrays, shadowhits, cachehits, cachemisses,
+      bvtests;
 
 #ifndef LINDA
   RSGetCpuTime(&Stats.Utime, &Stats.Stime);
 #endif
-  ShadowStats(&Stats.ShadowRays, &Stats.ShadowHits, &Stats.CacheHits,
-              &Stats.CacheMisses);
-  IntersectStats(&Stats.BVTests);
+  /*
+   * Add the counts of the main thread to those of the other threads.
+   */
+  ShadowStats(&shadowrays, &shadowhits, &cachehits, &cachemisses);
+  IntersectStats(&bvtests);
+  Stats.ShadowRays += shadowrays;
+  Stats.ShadowHits += shadowhits;
+  Stats.CacheHits += cachehits;
+  Stats.CacheMisses += cachemisses;
+  Stats.BVTests += bvtests;
 
   TotalRays =
       Stats.EyeRays + Stats.ShadowRays + Stats.ReflectRays + Stats.RefractRays;
@@ -84,12 +98,17 @@ static void PrintGeomStats() {
   Geom *otmp;
   unsigned long tests, hits, totaltests, totalhits;
   char *name;
+  int i;
   extern void GeomStats();
 
   totaltests = totalhits = 0;
 
-  for (otmp = GeomRep; otmp; otmp = otmp->next) {
+  for (otmp = GeomRep, i = 0; otmp; otmp = otmp->next, i++) {
     GeomStats(otmp, &tests, &hits);
+    if (i < RepCount) {
+      tests += RepTests[i];
+      hits += RepHits[i];
+    }
     if (tests <= 0)
       continue;
     name = GeomName(otmp);
@@ -126,3 +145,56 @@ void StatsAddRep(obj) Geom *obj;
   otmp->next = GeomRep;
   GeomRep = otmp;
 }
+
+/*
+ * Save the counters of the calling thread in s.
+ */
+void StatsThreadSave(RSThreadStats *s) {
+  Geom *otmp;
+  int i;
+  extern void GeomStats();
+
+  s->stats = Stats;
+  ShadowStats(&s->stats.ShadowRays, &s->stats.ShadowHits, &s->stats.CacheHits,
+              &s->stats.CacheMisses);
+  IntersectStats(&s->stats.BVTests);
+
+  for (s->reps = 0, otmp = GeomRep; otmp; otmp = otmp->next)
+    s->reps++;
+  s->tests = (unsigned long *)Malloc((s->reps + 1) * sizeof(unsigned long));
+  s->hits = (unsigned long *)Malloc((s->reps + 1) * sizeof(unsigned long));
+  for (i = 0, otmp = GeomRep; otmp; otmp = otmp->next, i++)
+    GeomStats(otmp, &s->tests[i], &s->hits[i]);
+}
+
+/*
+ * Add the counters saved in s to those of the calling thread.
+ */
+void StatsThreadAdd(RSThreadStats *s) {
+  int i;
+
+  Stats.EyeRays += s->stats.EyeRays;
+  Stats.ShadowRays += s->stats.ShadowRays;
+  Stats.ReflectRays += s->stats.ReflectRays;
+  Stats.RefractRays += s->stats.RefractRays;
+  Stats.HitRays += s->stats.HitRays;
+  Stats.BVTests += s->stats.BVTests;
+  Stats.SuperSampled += s->stats.SuperSampled;
+  Stats.ShadowHits += s->stats.ShadowHits;
+  Stats.CacheHits += s->stats.CacheHits;
+  Stats.CacheMisses += s->stats.CacheMisses;
+
+  if (RepTests == (unsigned long *)NULL) {
+    RepCount = s->reps;
+    RepTests =
+        (unsigned long *)Calloc((unsigned)RepCount + 1, sizeof(unsigned long));
+    RepHits =
+        (unsigned long *)Calloc((unsigned)RepCount + 1, sizeof(unsigned long));
+  }
+  for (i = 0; i < s->reps && i < RepCount; i++) {
+    RepTests[i] += s->tests[i];
+    RepHits[i] += s->hits[i];
+  }
+  free((voidstar)s->tests);
+  free((voidstar)s->hits);
+}
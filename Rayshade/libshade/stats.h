@@ -36,7 +36,19 @@ typedef struct RSStats {
   FILE *fstats;          /* Stats/info file pointer. */
 } RSStats;
 
-extern RSStats Stats;
+/*
+ * Counters of a rendering thread, saved by StatsThreadSave() before the
+ * thread finishes and added to those of the main thread by
+ * StatsThreadAdd().
+ */
+typedef struct RSThreadStats {
+  RSStats stats;               /* Counters of the thread */
+  int reps;                    /* # of object representatives */
+  unsigned long *tests, *hits; /* Their intersection tests and hits */
+} RSThreadStats;
+
+extern THREAD_LOCAL RSStats Stats;
 extern void StatsPrint(), StatsAddRep(Geom *obj);
+extern void StatsThreadSave(RSThreadStats *s), StatsThreadAdd(RSThreadStats *s);
 
 #endif /* STATS_H */
@@ -0,0 +1,102 @@
+/*
+ * threads.c
+ *
+ * Running the renderer on several threads.
+ */
+#include <stdlib.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+/* windows.h clashes with the object types, so only error.h is included */
+#include "libcommon/error.h"
+#include "threads.h"
+
+typedef struct {
+  void (*work)(int thread, void *data);
+  void *data;
+  int thread;
+} ThreadArgs;
+
+/*
+ * Return the number of processors available, at least 1.
+ */
+int NumberOfProcessors(void) {
+#ifdef _WIN32
+  SYSTEM_INFO info;
+
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+  return n > 0 ? (int)n : 1;
+#endif
+}
+
+#ifdef _WIN32
+static DWORD WINAPI ThreadMain(LPVOID arg)
+#else
+static void *ThreadMain(void *arg)
+#endif
+{
+  ThreadArgs *args = (ThreadArgs *)arg;
+
+  (*args->work)(args->thread, args->data);
+  return 0;
+}
+
+/*
+ * Call work for threads 0 to num_threads-1, thread 0 being the calling
+ * one, and return when all of them are done.
+ */
+void RunThreads(int num_threads, void (*work)(int thread, void *data),
+                void *data) {
+  ThreadArgs *args;
+  int i;
+#ifdef _WIN32
+  HANDLE *threads;
+#else
+  pthread_t *threads;
+#endif
+
+  if (num_threads <= 1) {
+    (*work)(0, data);
+    return;
+  }
+
+  args = (ThreadArgs *)malloc(num_threads * sizeof(ThreadArgs));
+  threads = malloc(num_threads * sizeof(*threads));
+  if (args == NULL || threads == NULL)
+    RLerror(RL_PANIC, "Out of memory starting %d threads.\n", num_threads);
+
+  for (i = 1; i < num_threads; i++) {
+    args[i].work = work;
+    args[i].data = data;
+    args[i].thread = i;
+#ifdef _WIN32
+    if ((threads[i] = CreateThread(NULL, 0, ThreadMain, &args[i], 0, NULL)) ==
+        NULL)
+#else
+    if (pthread_create(&threads[i], NULL, ThreadMain, &args[i]) != 0)
+#endif
+      RLerror(RL_PANIC, "Cannot start rendering thread %d.\n", i);
+  }
+
+  (*work)(0, data);
+
+  for (i = 1; i < num_threads; i++) {
+#ifdef _WIN32
+    WaitForSingleObject(threads[i], INFINITE);
+    CloseHandle(threads[i]);
+#else
+    pthread_join(threads[i], NULL);
+#endif
+  }
+
+  free(threads);
+  free(args);
+}
@@ -0,0 +1,8 @@
+#ifndef THREADS_H
+#define THREADS_H
+
+int NumberOfProcessors(void);
+void RunThreads(int num_threads, void (*work)(int thread, void *data),
+                void *data);
+
+#endif
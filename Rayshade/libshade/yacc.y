@@ -41,6 +41,7 @@
 #include "libobj/cylinder.h"
 #include "libobj/disc.h"
 #include "libobj/grid.h"
+#include "libobj/bvh.h"
 #include "libobj/hf.h"
 #include "libobj/instance.h"
 #include "libobj/list.h"
@@ -123,7 +124,7 @@ extern Geom 	*GeomGetNamed(char *name);
 %token <d> tFLOAT
 %token <c> tSTRING tFILENAME
 %token tAPERTURE tAPPLYSURF
-%token tBACKGROUND tBLOB tBLOTCH tBOX tBUMP tCONE tCYL tDIRECTIONAL tCURSURF
+%token tBACKGROUND tBLOB tBLOTCH tBOX tBUMP tBVH tCONE tCYL tDIRECTIONAL tCURSURF
 %token tEXTENDED tEYEP tFBM tFBMBUMP tFOCALDIST tFOG tFOGDECK tFOV tGLOSS tGRID
 %token tHEIGHTFIELD tLIGHT tLIST tLOOKP tMARBLE tMAXDEPTH tMIST
 %token tJITTER tNOJITTER tDEFINE
@@ -152,7 +153,7 @@ extern Geom 	*GeomGetNamed(char *name);
 %type <obj> PrimType Primitive TransTextObj
 %type <obj> Csg Aggregate Object TransObj ObjType
 %type <obj> Blob Box Cone Cylinder Disc Opendisc HeightField Plane Poly
-%type <obj> Sphere Triangle Torus AggregateType List Grid AggregateCreate
+%type <obj> Sphere Triangle Torus AggregateType List Grid Bvh AggregateCreate
 %type <obj> NamedObject
 %type <surf> Surface OptSurface NamedSurf
 %type <surf> SurfSpec ModifyNamedSurf
@@ -230,9 +231,12 @@ TransObj	: Object Transforms
 					 * so we're only animated if it's one long,
 					 * or it's animated itself.
 					 */
-					if ($$->trans->assoc || $$->trans->next)
+					if ($$->trans->assoc || $$->trans->next) {
 						/* geometry is animated...*/
 						$$->animtrans = TRUE;
+						/* ...and resolved while rendering */
+						Options.serial = TRUE;
+					}
 				}
 			}
 		}
@@ -297,9 +301,11 @@ Texture		: tTEXTURE Texturetype Transforms
 					 * so we're only animated if it's one long,
 					 * or it's animated itself.
 					 */
-					if ($2->trans->assoc || $2->trans->next)
+					if ($2->trans->assoc || $2->trans->next) {
 						/* texture transformation is animated...*/
 						$2->animtrans = TRUE;
+						Options.serial = TRUE;
+					}
 				}
 				/*
 				 * Walk to the end of list of textures and
@@ -972,10 +978,13 @@ HeightField	: tHEIGHTFIELD Surface Filename
 			$$ = GeomHfCreate($3);
 			if ($$)
 				$$->surf = $2;
+			/* the triangle cache is shared */
+			Options.serial = TRUE;
 		}
 		| tHEIGHTFIELD Filename
 		{
 			$$ = GeomHfCreate($2);
+			Options.serial = TRUE;
 		}
 		;
 Poly		: tPOLY OptSurface Polypoints
@@ -1057,6 +1066,7 @@ AggregateCreate	: AggregateType
 		};
 AggregateType	: List
 		| Grid
+		| Bvh
 		| Csg
 		;
 List		: tLIST
@@ -1069,6 +1079,11 @@ Grid		: tGRID IExpr IExpr IExpr
 			$$ = GeomGridCreate($2, $3, $4);
 		}
 		;
+Bvh		: tBVH
+		{
+			$$ = GeomBvhCreate();
+		}
+		;
 Csg		: CombineOp
 		{
 			$$ = GeomCsgCreate($1);
@@ -1185,6 +1200,8 @@ Blob		: tBLOB OptSurface Expr MetaPoints
 			$$ = GeomBlobCreate($3, Metapoints, Npoints);
 			if ($$)
 				$$->surf = $2;
+			/* so are the intersection lists */
+			Options.serial = TRUE;
 			Metapoints = (MetaList *)NULL;
 			Npoints = 0;
 		}
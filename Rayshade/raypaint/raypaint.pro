@@ -12,7 +12,7 @@ else{
 CONFIG += no_lflags_merge
 LIBS += -lm -L/usr/X11/lib -lGL -lGLU -lglut  -Wl,--start-group  ../../.libraries/liblshade.a ../../.libraries/libraytext.a ../../.libraries/librayimage.a \
         ../../.libraries/libraycommon.a ../../.libraries/libraysurf.a \
-        ../../.libraries/librayobj.a ../../.libraries/libraylight.a -Wl,--end-group
+        ../../.libraries/librayobj.a ../../.libraries/libraylight.a -Wl,--end-group -lpthread
 }
 MY_BASE  = ../..
 MY_LIBS  = raytext lshade rayimage raycommon raysurf  rayobj raylight 
@@ -10,7 +10,7 @@ LIBS += -lm -lz
 }
 else{
 CONFIG += no_lflags_merge
-LIBS += -lm -L/usr/X11/lib -Wl,--start-group ../../.libraries/librayimage.a ../../.libraries/librayobj.a ../../.libraries/libraysurf.a ../../.libraries/libraylight.a ../../.libraries/libraycommon.a ../../.libraries/libraytext.a ../../.libraries/liblshade.a -lm -Wl,--end-group
+LIBS += -lm -L/usr/X11/lib -Wl,--start-group ../../.libraries/librayimage.a ../../.libraries/librayobj.a ../../.libraries/libraysurf.a ../../.libraries/libraylight.a ../../.libraries/libraycommon.a ../../.libraries/libraytext.a ../../.libraries/liblshade.a -lm -Wl,--end-group -lpthread
 }
 MY_BASE  = ../..
 MY_LIBS  = rayimage raycommon raysurf raytext rayobj raylight lshade
@@ -27,21 +27,64 @@
 #include "viewing.h"
 #include "options.h"
 #include "misc.h"
+#include "lightdef.h"
+#include "threads.h"
+#include "libobj/grid.h"
 
 #define UNSAMPLED -1
 #define SUPERSAMPLED -2
 
+/*
+ * The image is rendered in bands of BAND_ROWS rows.  The threads render
+ * BANDS_PER_THREAD bands each before the rows are written out.  A band
+ * rendered on its own thread starts from fresh samples of the row below
+ * it and its first row, where the serial order starts it from these
+ * rows as refined by the band before.  Where they differ, the band is
+ * rendered again from the rows of the serial order until it is back in
+ * step, so the image is the same as when rendered on one thread.
+ */
+#define BAND_ROWS 32
+#define BANDS_PER_THREAD 2
+
+/*
+ * Kinds of sampling, for seeding the random numbers of a pixel.
+ */
+#define SINGLE_SAMPLE 0
+#define FULL_SAMPLE 1
+
 typedef struct {
   Pixel *pix; /* Pixel values */
   int *samp;  /* Sample number */
 } Scanline;
 
+typedef struct {
+  Scanline scan0, scan1, scan2; /* Scanlines being refined */
+  unsigned long raynumber;      /* Number of the next ray in grids */
+  RSThreadStats stats;          /* Counters, if not the main thread */
+} Worker;
+
+typedef struct {
+  int first, count; /* First band and # of bands */
+  int threads;      /* # of threads rendering them */
+} Pass;
+
+typedef struct {
+  Scanline *state; /* scan0 and scan1 as each row was refined */
+  int rows;        /* # of rows refined */
+} Band;
+
 static int *SampleNumbers;
 static void RaytraceInit();
 
-static Ray TopRay; /* Top-level ray. */
+static THREAD_LOCAL Ray TopRay; /* Top-level ray of each thread. */
 Float SampleTime();
 
+static int Threads;        /* # of rendering threads */
+static Worker *Workers;    /* Their scanlines and counters */
+static Pixel *BandPixels;  /* Rendered rows of the bands of a pass */
+static Band *Bands;        /* Their states */
+static Scanline Carry[2];  /* State left by the last band of a pass */
+
 Pixel WhitePix = {1., 1., 1., 1.}, BlackPix = {0., 0., 0., 0.};
 
 /*
@@ -71,11 +114,19 @@ static int EightSamples[64] = {
 void AdaptiveRefineScanline(), FullySamplePixel(), FullySampleScanline(),
     SingleSampleScanline();
 static int ExcessiveContrast();
-static Scanline scan0, scan1, scan2;
+static void SampleScanline(int line, Scanline *data);
+static void RenderBands(int thread, void *data);
+static void RenderBand(Worker *w, Band *b, int first, int last, Pixel *pix,
+                       Scanline *from, int again);
+static void ResyncBands(Pass *pass);
+static Scanline *BandEnd(Band *b);
+static void AllocScanlines(Scanline *data, int n);
+static void CopyScanline(Scanline *to, Scanline *from);
+static int SameScanline(Scanline *a, Scanline *b);
 
 void raytrace() {
-  int y, *tmpsamp;
-  Pixel *tmppix;
+  Pass pass;
+  int y, lasty, bands, thread;
   Float usertime, systime, lasttime;
 
   /*
@@ -84,6 +135,57 @@ void raytrace() {
    */
   if (Options.framenum == Options.startframe)
     RaytraceInit();
+
+  bands = (Screen.ysize + BAND_ROWS - 1) / BAND_ROWS;
+  lasttime = 0;
+  for (pass.first = 0; pass.first < bands; pass.first += pass.count) {
+    pass.count = min(bands - pass.first, Threads * BANDS_PER_THREAD);
+    pass.threads = min(Threads, pass.count);
+    RunThreads(pass.threads, RenderBands, (void *)&pass);
+    for (thread = 1; thread < pass.threads; thread++)
+      StatsThreadAdd(&Workers[thread].stats);
+    if (pass.threads > 1)
+      ResyncBands(&pass);
+    if (pass.first + pass.count < bands) {
+      CopyScanline(&Carry[0], &BandEnd(&Bands[pass.count - 1])[0]);
+      CopyScanline(&Carry[1], &BandEnd(&Bands[pass.count - 1])[1]);
+    }
+
+    y = pass.first * BAND_ROWS;
+    lasty = min(y + pass.count * BAND_ROWS, Screen.ysize);
+    for (; y < lasty; y++) {
+      PictureWriteLine(BandPixels +
+                       (y - pass.first * BAND_ROWS) * Screen.xsize);
+
+      if ((y + Screen.miny) % Options.report_freq == 0) {
+        fprintf(Stats.fstats, "Finished line %d (%lu rays", y + Screen.miny,
+                Stats.EyeRays);
+        if (Options.verbose) {
+          /*
+           * Report total CPU and split times.
+           */
+          RSGetCpuTime(&usertime, &systime);
+          fprintf(Stats.fstats, ", %2.2f sec,", usertime + systime);
+          fprintf(Stats.fstats, " %2.2f split", usertime + systime - lasttime);
+          lasttime = usertime + systime;
+        }
+        fprintf(Stats.fstats, ")\n");
+        (void)fflush(Stats.fstats);
+      }
+    }
+  }
+}
+
+/*
+ * Render the bands of the pass given to the thread, bands
+ * thread, thread + pass->threads, ... of the pass.
+ */
+static void RenderBands(int thread, void *data) {
+  Pass *pass = (Pass *)data;
+  Worker *w = &Workers[thread];
+  Scanline *from;
+  int band, first, last;
+
   /*
    * The top-level ray TopRay always has as its origin the
    * eye position and as its medium NULL, indicating that it
@@ -94,63 +196,161 @@ void raytrace() {
   TopRay.media = (Medium *)0;
   TopRay.depth = 0;
 
-  /*
-   * Always fully sample the bottom and top rows and the left
-   * and right column of pixels.  This minimizes artifacts that
-   * may arise when piecing together images.
-   */
-  FullySampleScanline(0, &scan0);
+  GridSetRayNumbers(w->raynumber, (unsigned long)Threads);
+  for (band = thread; band < pass->count; band += pass->threads) {
+    first = (pass->first + band) * BAND_ROWS;
+    last = min(first + BAND_ROWS, Screen.ysize);
+    LightSelectCache(thread);
+    /*
+     * A single thread renders the bands in order, so each one can
+     * start from the rows the band before left.
+     */
+    from = (Scanline *)0;
+    if (pass->threads == 1 && first > 0)
+      from = band > 0 ? BandEnd(&Bands[band - 1]) : Carry;
+    RenderBand(w, &Bands[band], first, last,
+               BandPixels + band * BAND_ROWS * Screen.xsize, from, FALSE);
+  }
+  w->raynumber = GridNextRayNumber();
 
-  SingleSampleScanline(1, &scan1);
-  FullySamplePixel(0, 1, &scan1.pix[0], &scan1.samp[0]);
-  FullySamplePixel(Screen.xsize - 1, 1, &scan1.pix[Screen.xsize - 1],
-                   &scan1.samp[Screen.xsize - 1]);
+  if (thread > 0)
+    StatsThreadSave(&w->stats);
+}
 
-  lasttime = 0;
-  for (y = 1; y < Screen.ysize; y++) {
-    SingleSampleScanline(y + 1, &scan2);
-    FullySamplePixel(0, y + 1, &scan2.pix[0], &scan2.samp[0]);
-    FullySamplePixel(Screen.xsize - 1, y + 1, &scan2.pix[Screen.xsize - 1],
-                     &scan2.samp[Screen.xsize - 1]);
+/*
+ * Render the rows first to last-1 into pix.  The scanlines are sampled
+ * and refined as when the whole image is rendered at once, starting
+ * from the row below the band and the first row given in from, or from
+ * fresh samples of these rows if from is NULL.  Rows outside of the
+ * band are not written.  The state of scan0 and scan1 before each row
+ * is refined is kept in b.  If again is TRUE, b holds the states of an
+ * earlier rendering of the band, and the rendering stops as soon as it
+ * reaches one of them.
+ */
+static void RenderBand(Worker *w, Band *b, int first, int last, Pixel *pix,
+                       Scanline *from, int again) {
+  Scanline tmp, *state;
+  int x, y, start, end;
+
+  start = max(first, 1);
+  end = min(last, Screen.ysize - 1);
+
+  if (from) {
+    CopyScanline(&w->scan0, &from[0]);
+    CopyScanline(&w->scan1, &from[1]);
+  } else {
+    SampleScanline(start - 1, &w->scan0);
+    SampleScanline(start, &w->scan1);
+  }
+
+  for (y = start; y <= end; y++) {
+    state = &b->state[2 * (y - start)];
+    if (again && y > start && SameScanline(&w->scan0, &state[0]) &&
+        SameScanline(&w->scan1, &state[1]))
+      return; /* the rest of the band comes out the same */
+    CopyScanline(&state[0], &w->scan0);
+    CopyScanline(&state[1], &w->scan1);
+
+    SampleScanline(y + 1, &w->scan2);
 
     if (Sampling.sidesamples > 1)
-      AdaptiveRefineScanline(y, &scan0, &scan1, &scan2);
-
-    PictureWriteLine(scan0.pix);
-
-    tmppix = scan0.pix;
-    tmpsamp = scan0.samp;
-    scan0.pix = scan1.pix;
-    scan0.samp = scan1.samp;
-    scan1.pix = scan2.pix;
-    scan1.samp = scan2.samp;
-    scan2.pix = tmppix;
-    scan2.samp = tmpsamp;
-
-    if ((y + Screen.miny - 1) % Options.report_freq == 0) {
-      fprintf(Stats.fstats, "Finished line %d (%lu rays", y + Screen.miny - 1,
-              Stats.EyeRays);
-      if (Options.verbose) {
-        /*
-         * Report total CPU and split times.
-         */
-        RSGetCpuTime(&usertime, &systime);
-        fprintf(Stats.fstats, ", %2.2f sec,", usertime + systime);
-        fprintf(Stats.fstats, " %2.2f split", usertime + systime - lasttime);
-        lasttime = usertime + systime;
-      }
-      fprintf(Stats.fstats, ")\n");
-      (void)fflush(Stats.fstats);
+      AdaptiveRefineScanline(y, &w->scan0, &w->scan1, &w->scan2);
+
+    if (y - 1 >= first)
+      memcpy(pix + (y - 1 - first) * Screen.xsize, w->scan0.pix,
+             Screen.xsize * sizeof(Pixel));
+
+    tmp = w->scan0;
+    w->scan0 = w->scan1;
+    w->scan1 = w->scan2;
+    w->scan2 = tmp;
+  }
+  b->rows = end - start + 1;
+
+  if (last == Screen.ysize) {
+    /*
+     * Supersample last scanline.
+     */
+    for (x = 1; x < Screen.xsize - 1; x++) {
+      if (w->scan0.samp[x] != SUPERSAMPLED)
+        FullySamplePixel(x, Screen.ysize - 1, &w->scan0.pix[x],
+                         &w->scan0.samp[x]);
     }
+    memcpy(pix + (Screen.ysize - 1 - first) * Screen.xsize, w->scan0.pix,
+           Screen.xsize * sizeof(Pixel));
   }
-  /*
-   * Supersample last scanline.
-   */
-  for (y = 1; y < Screen.xsize - 1; y++) {
-    if (scan0.samp[y] != SUPERSAMPLED)
-      FullySamplePixel(y, Screen.ysize - 1, &scan0.pix[y], &scan0.samp[y]);
+}
+
+/*
+ * Render again each band of the pass that was not started from the
+ * rows left by the band before, from these rows.  The bands are checked
+ * in order, so a band rendered again is the one the next band is
+ * checked against.
+ */
+static void ResyncBands(Pass *pass) {
+  Worker *w = &Workers[0];
+  Scanline *from;
+  int band, first, last;
+
+  GridSetRayNumbers(w->raynumber, (unsigned long)Threads);
+  LightSelectCache(0);
+  for (band = 0; band < pass->count; band++) {
+    first = (pass->first + band) * BAND_ROWS;
+    if (first == 0)
+      continue;
+    last = min(first + BAND_ROWS, Screen.ysize);
+    from = band > 0 ? BandEnd(&Bands[band - 1]) : Carry;
+    if (!SameScanline(&from[0], &Bands[band].state[0]) ||
+        !SameScanline(&from[1], &Bands[band].state[1]))
+      RenderBand(w, &Bands[band], first, last,
+                 BandPixels + band * BAND_ROWS * Screen.xsize, from, TRUE);
+  }
+  w->raynumber = GridNextRayNumber();
+}
+
+/*
+ * Return scan0 and scan1 as the band left them for the next band,
+ * before the first row of the next band was refined.
+ */
+static Scanline *BandEnd(Band *b) { return &b->state[2 * (b->rows - 1)]; }
+
+static void AllocScanlines(Scanline *data, int n) {
+  Pixel *pix;
+  int *samp, i;
+
+  pix = (Pixel *)Malloc(n * Screen.xsize * sizeof(Pixel));
+  samp = (int *)Malloc(n * Screen.xsize * sizeof(int));
+  for (i = 0; i < n; i++) {
+    data[i].pix = pix + i * Screen.xsize;
+    data[i].samp = samp + i * Screen.xsize;
   }
-  PictureWriteLine(scan0.pix);
+}
+
+static void CopyScanline(Scanline *to, Scanline *from) {
+  memcpy(to->pix, from->pix, Screen.xsize * sizeof(Pixel));
+  memcpy(to->samp, from->samp, Screen.xsize * sizeof(int));
+}
+
+static int SameScanline(Scanline *a, Scanline *b) {
+  return memcmp(a->pix, b->pix, Screen.xsize * sizeof(Pixel)) == 0 &&
+         memcmp(a->samp, b->samp, Screen.xsize * sizeof(int)) == 0;
+}
+
+/*
+ * Always fully sample the bottom and top rows and the left
+ * and right column of pixels.  This minimizes artifacts that
+ * may arise when piecing together images.  The other pixels
+ * are sampled once.
+ */
+static void SampleScanline(int line, Scanline *data) {
+  if (line == 0) {
+    FullySampleScanline(0, data);
+    return;
+  }
+  SingleSampleScanline(line, data);
+  FullySamplePixel(0, line, &data->pix[0], &data->samp[0]);
+  FullySamplePixel(Screen.xsize - 1, line, &data->pix[Screen.xsize - 1],
+                   &data->samp[Screen.xsize - 1]);
 }
 
 void SingleSampleScanline(line, data) int line;
@@ -161,10 +361,11 @@ Scanline *data;
 
   yp = line + Screen.miny - 0.5 * Sampling.filterwidth;
   for (x = 0; x < Screen.xsize; x++) {
+    SampleSeed(x, line, 2 * Options.framenum + SINGLE_SAMPLE);
     /*
      * Pick a sample number...
      */
-    data->samp[x] = nrand() * Sampling.totsamples;
+    data->samp[x] = SampleRandom() * Sampling.totsamples;
     /*
      * Take sample corresponding to sample #.
      */
@@ -175,8 +376,8 @@ Scanline *data;
     upos = x + Screen.minx - 0.5 * Sampling.filterwidth +
            usamp * Sampling.filterdelta;
     if (Options.jitter) {
-      vpos += nrand() * Sampling.filterdelta;
-      upos += nrand() * Sampling.filterdelta;
+      vpos += SampleRandom() * Sampling.filterdelta;
+      upos += SampleRandom() * Sampling.filterdelta;
     }
     TopRay.time = SampleTime(SampleNumbers[data->samp[x]]);
     SampleScreen(upos, vpos, &TopRay, &data->pix[x],
@@ -227,6 +428,7 @@ int *prevsamp;
     pix->alpha *= Sampling.filter[x][y];
   }
 
+  SampleSeed(xp, yp, 2 * Options.framenum + FULL_SAMPLE);
   sampnum = 0;
   xp += Screen.minx;
   vpos = Screen.miny + yp - 0.5 * Sampling.filterwidth;
@@ -235,8 +437,8 @@ int *prevsamp;
     for (x = 0; x < Sampling.sidesamples; x++, upos += Sampling.filterdelta) {
       if (sampnum != *prevsamp) {
         if (Options.jitter) {
-          u = upos + nrand() * Sampling.filterdelta;
-          v = vpos + nrand() * Sampling.filterdelta;
+          u = upos + SampleRandom() * Sampling.filterdelta;
+          v = vpos + SampleRandom() * Sampling.filterdelta;
         } else {
           u = upos;
           v = vpos;
@@ -382,7 +584,7 @@ Float SampleTime(sampnum) int sampnum;
   if (Options.shutterspeed <= 0.)
     return Options.framestart;
   if (Options.jitter)
-    jitter = nrand();
+    jitter = SampleRandom();
   window = Options.shutterspeed / Sampling.totsamples;
   res = Options.framestart + window * (sampnum + jitter);
   TimeSet(res);
@@ -390,6 +592,7 @@ Float SampleTime(sampnum) int sampnum;
 }
 
 static void RaytraceInit() {
+  int thread, band;
 
   switch (Sampling.sidesamples) {
   case 1:
@@ -422,13 +625,47 @@ static void RaytraceInit() {
   }
 
   /*
-   * Allocate pixel arrays and arrays to store sampling info.
+   * Motion blur and animated transformations change the objects
+   * while rendering, and heightfields and blobs keep intersection
+   * data in the objects, so these can only be rendered on one thread.
+   */
+  if (Options.serial || Options.shutterspeed > 0.)
+    Threads = 1;
+  else
+    Threads = Options.threads;
+
+  /*
+   * Allocate pixel arrays and arrays to store sampling info,
+   * for each thread.
    */
-  scan0.pix = (Pixel *)Malloc(Screen.xsize * sizeof(Pixel));
-  scan1.pix = (Pixel *)Malloc(Screen.xsize * sizeof(Pixel));
-  scan2.pix = (Pixel *)Malloc(Screen.xsize * sizeof(Pixel));
+  Workers = (Worker *)Malloc(Threads * sizeof(Worker));
+  for (thread = 0; thread < Threads; thread++) {
+    Workers[thread].scan0.pix = (Pixel *)Malloc(Screen.xsize * sizeof(Pixel));
+    Workers[thread].scan1.pix = (Pixel *)Malloc(Screen.xsize * sizeof(Pixel));
+    Workers[thread].scan2.pix = (Pixel *)Malloc(Screen.xsize * sizeof(Pixel));
+
+    Workers[thread].scan0.samp = (int *)Malloc(Screen.xsize * sizeof(int));
+    Workers[thread].scan1.samp = (int *)Malloc(Screen.xsize * sizeof(int));
+    Workers[thread].scan2.samp = (int *)Malloc(Screen.xsize * sizeof(int));
+
+    /*
+     * Each thread numbers its rays in grids Threads apart.
+     */
+    Workers[thread].raynumber = thread + 1;
+  }
+
+  BandPixels = (Pixel *)Malloc(Threads * BANDS_PER_THREAD * BAND_ROWS *
+                               Screen.xsize * sizeof(Pixel));
 
-  scan0.samp = (int *)Malloc(Screen.xsize * sizeof(int));
-  scan1.samp = (int *)Malloc(Screen.xsize * sizeof(int));
-  scan2.samp = (int *)Malloc(Screen.xsize * sizeof(int));
+  /*
+   * A band refines at most BAND_ROWS + 1 rows.
+   */
+  Bands = (Band *)Malloc(Threads * BANDS_PER_THREAD * sizeof(Band));
+  for (band = 0; band < Threads * BANDS_PER_THREAD; band++) {
+    Bands[band].state =
+        (Scanline *)Malloc(2 * (BAND_ROWS + 1) * sizeof(Scanline));
+    AllocScanlines(Bands[band].state, 2 * (BAND_ROWS + 1));
+    Bands[band].rows = 0;
+  }
+  AllocScanlines(Carry, 2);
 }
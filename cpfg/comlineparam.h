@@ -102,6 +102,7 @@ struct COMLINEPARAM {
   char warnings;
   char debug;
   char checkEnvironment;
+  char referenceEval; /* evaluate expressions without compiling them */
   float xsize; /* window resolution */
   float ysize;
   float xpos; /* position of the drawing window */
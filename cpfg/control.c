@@ -2163,6 +2163,7 @@ static void ParseCommand(int argc, char **argv) {
   clp.debug = FALSE;
   clp.xsize = clp.ysize = 0;
   clp.checkEnvironment = 0;
+  clp.referenceEval = 0;
 
   clp.iscolormapfile = 0;
   for (temp = 0; temp < MAXCOLORMAPS; temp++)
@@ -2370,6 +2371,9 @@ static void ParseCommand(int argc, char **argv) {
             clp.savingMode = CONTINUOUS;
           if ((strcmp(opt, "trig") == 0) || (strcmp(opt, "triggered") == 0))
             clp.savingMode = TRIGGERED;
+        } else if (strcmp(argv[0], "-refeval") == 0) {
+          clp.referenceEval = 1;
+          VERBOSE("expressions evaluated without compiling\n");
         }
         break;
 
@@ -2550,7 +2554,7 @@ static char *makeSaveName(char *base, char *suffix) {
 static void Usage(void) {
   Message("Usage (version %g):\n%s ", (float)CPFG_VERSION / 1000.0,
           clp.programname);
-  Message("[-s'stringsize'] [-v] [-V] [-d] [-P preprocessor] [-a] "
+  Message("[-s'stringsize'] [-v] [-V] [-d] [-P preprocessor] [-a] [-refeval] "
 #ifdef CPFG_ENVIRONMENT
           "[-e environmentfile] "
 #endif
@@ -2576,6 +2580,8 @@ static void Usage(void) {
       " -d : debug mode on.\n"
       " -P preprocessor : changes default C preprocessor.\n"
       " -a : animate mode on (start with animate menu).\n"
+      " -refeval : evaluates expressions without compiling them (to compare\n"
+      "            results with the compiled expressions).\n"
 #ifdef CPFG_ENVIRONMENT
       " -e environmentfile: specifies parameters of plant-field "
       "communication.\n"
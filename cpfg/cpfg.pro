@@ -7,6 +7,7 @@ SOURCES  = background.c \
            blackbox.c \
            control.c \
            environment.c \
+           evalcode.c \
            general.c \
            generate.c \
            hash.c \
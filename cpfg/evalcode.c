@@ -0,0 +1,1109 @@
+/* ******************************************************************** *
+   Copyright (C) 1990-2022 University of Calgary
+  
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+  
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+  
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ******************************************************************** */
+
+
+
+/*
+MODULE:		evalcode.c
+PURPOSE: Compilation of postfix expressions (see generate.c: Eval)
+         into a linear program for a stack machine.
+
+The tree walker in EvalReference moves through the tokens in three loops:
+pushing the leaves, applying the operators while going up and checking
+whether the remaining operands of ||, && and ?: can be skipped. The
+position in the walk depends only on the structure of the tree and on the
+outcome of these checks, so the compiler follows the same walk once,
+emitting the pushes and operators as instructions and the checks as
+conditional jumps. Every (walk state, token) pair is emitted only once,
+later visits jump to it. The program thus gives exactly the results of
+the tree walker, including its handling of the skipped operands.
+*/
+
+#ifdef WIN32
+#include "warningset.h"
+#endif
+
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+#include "platform.h"
+#include "interpret.h"
+#include "control.h"
+#include "generate.h"
+#include "lsys_input_yacc.h"
+#include "utility.h"
+#include "evalcode.h"
+
+#if CPFG_VERSION >= 4000
+#include "splinefunC.h"
+#endif
+
+#if CPFG_VERSION >= 6400
+#include "curveXYZc.h"
+#endif
+
+#include "test_malloc.h"
+
+extern RECTANGLE viewWindow;
+extern VIEWPARAM viewparam;
+extern LSYSDATA *LsystemList;
+
+#ifdef JIM
+#define SymbolValue(symbol) (*((symbol)->values + (symbol)->offset))
+#else
+#define SymbolValue(symbol) ((symbol)->value)
+#endif
+
+/* instructions */
+typedef enum {
+  /* executed in RunExpression */
+  ecPUSHC, /* push constant */
+  ecPUSHV, /* push symbol value */
+  ecRETURN,
+  ecJUMP,
+  ecJNZ,     /* jump if top is true (as char), || skip */
+  ecJZ,      /* jump if top is false, && skip */
+  ecJZPUSH0, /* if top is false push 0 and jump, ?: condition */
+  ecJNZ2,    /* jump if the value below top is true, ?: skip */
+  /* binary operators with the second operand from the stack,
+     the instruction (C - constant) or a symbol (V) */
+  ecPLUS,
+  ecPLUSC,
+  ecPLUSV,
+  ecMINUS,
+  ecMINUSC,
+  ecMINUSV,
+  ecTIMES,
+  ecTIMESC,
+  ecTIMESV,
+  ecGT,
+  ecGTC,
+  ecGTV,
+  ecGE,
+  ecGEC,
+  ecGEV,
+  ecLT,
+  ecLTC,
+  ecLTV,
+  ecLE,
+  ecLEC,
+  ecLEV,
+  ecEQUAL,
+  ecEQUALC,
+  ecEQUALV,
+  /* the rest of the operators, executed in Apply */
+  ecOR,
+  ecAND,
+  ecNOTEQUAL,
+  ecUMINUS,
+  ecDIVIDE,
+  ecREM,
+  ecPOW,
+  ecNOT,
+  ecQUESTION,
+  ecSIGN,
+  ecSQRT,
+  ecATAN2,
+  ecTAN,
+  ecCOS,
+  ecSIN,
+  ecATAN,
+  ecACOS,
+  ecASIN,
+  ecEXP,
+  ecLOG,
+  ecFLOOR,
+  ecCEIL,
+  ecTRUNC,
+  ecFABS,
+  ecSRAND,
+  ecRAN,
+  ecNRAN,
+  ecBRAN,
+  ecBIRAN,
+  ecFUNC,
+  ecCURVEX,
+  ecCURVEY,
+  ecCURVEZ,
+  ecCURVEGAL,
+  ecGETDERIVLENGTH,
+  ecSETDERIVLENGTH,
+  ecVVXMIN,
+  ecVVXMAX,
+  ecVVYMIN,
+  ecVVYMAX,
+  ecVVZMIN,
+  ecVVZMAX,
+  ecVVSCALE,
+  ecDISPLAY,
+  ecARRAYREF,
+  ecARRAYLHS
+} ECodeOp;
+
+typedef struct {
+  int op;
+  int target; /* jumps */
+  union {
+    double value;   /* ecPUSHC */
+    Symbol *symbol; /* ecPUSHV and arrays */
+  } arg;
+} EInstr;
+
+struct ECode_s {
+  int length; /* 0 if not compiled */
+  EInstr *instr;
+};
+
+/* positions in the walk of EvalReference */
+typedef enum {
+  wsNONE,
+  wsLEAF,     /* pushing leaves */
+  wsUP,       /* going up, applying the operator above */
+  wsCHECK,    /* checking if the operands after the token can be skipped */
+  wsCONDJUMP, /* ?: after jumping from the condition */
+  wsCONDNEXT, /* ?: after not jumping */
+  wsSKIPPED,  /* the parent of the token was skipped */
+  wsNEXT      /* continuing with the next operand */
+} WalkState;
+
+typedef struct {
+  WalkState state;
+  EToken *token;
+  int position;
+} StateEntry;
+
+typedef struct {
+  EInstr *instr;
+  int length;
+  int size;
+  StateEntry *states;
+  int numStates;
+  int statesSize;
+  StateEntry *branches; /* position is the index of the jump */
+  int numBranches;
+  int branchesSize;
+  int failed;
+} Compiler;
+
+/*********************************************************************/
+static void *Grow(void *array, int *size, int elemSize) {
+  *size = (*size == 0) ? 32 : 2 * (*size);
+  return Realloc(array, (size_t)(*size) * elemSize);
+}
+
+/*********************************************************************/
+static int EmitInstr(Compiler *c, int op) {
+  if (c->length == c->size)
+    c->instr = (EInstr *)Grow(c->instr, &c->size, sizeof(EInstr));
+  c->instr[c->length].op = op;
+  c->instr[c->length].target = -1;
+  c->instr[c->length].arg.symbol = NULL;
+  return c->length++;
+}
+
+/*********************************************************************/
+static StateEntry *AddEntry(StateEntry **array, int *count, int *size,
+                            WalkState state, EToken *token, int position) {
+  if (*count == *size)
+    *array = (StateEntry *)Grow(*array, size, sizeof(StateEntry));
+  (*array)[*count].state = state;
+  (*array)[*count].token = token;
+  (*array)[*count].position = position;
+  return *array + (*count)++;
+}
+
+/*********************************************************************/
+static int FindState(const Compiler *c, WalkState state, const EToken *token) {
+  int i;
+  for (i = 0; i < c->numStates; i++)
+    if (c->states[i].state == state && c->states[i].token == token)
+      return c->states[i].position;
+  return -1;
+}
+
+/*********************************************************************/
+static void EmitBranch(Compiler *c, int op, WalkState state, EToken *token) {
+  int jump = EmitInstr(c, op);
+  AddEntry(&c->branches, &c->numBranches, &c->branchesSize, state, token,
+           jump);
+}
+
+/*********************************************************************/
+/* the instruction applying an operator token, -1 if not supported    */
+/*********************************************************************/
+static int OperatorCode(int token) {
+  switch (token) {
+  case tOR:
+    return ecOR;
+  case tAND:
+    return ecAND;
+  case tGT:
+    return ecGT;
+  case tGE:
+    return ecGE;
+  case tLT:
+    return ecLT;
+  case tLE:
+    return ecLE;
+  case tEQUAL:
+    return ecEQUAL;
+  case tNOTEQUAL:
+    return ecNOTEQUAL;
+  case tPLUS:
+    return ecPLUS;
+  case tMINUS:
+    return ecMINUS;
+  case tUMINUS:
+    return ecUMINUS;
+  case tTIMES:
+    return ecTIMES;
+  case tDIVIDE:
+    return ecDIVIDE;
+  case tREM:
+    return ecREM;
+  case tPOW:
+    return ecPOW;
+  case tNOT:
+    return ecNOT;
+  case tQUESTION:
+    return ecQUESTION;
+  case tSIGN:
+    return ecSIGN;
+  case tSQRT:
+    return ecSQRT;
+  case tATAN2:
+    return ecATAN2;
+  case tTAN:
+    return ecTAN;
+  case tCOS:
+    return ecCOS;
+  case tSIN:
+    return ecSIN;
+  case tATAN:
+    return ecATAN;
+  case tACOS:
+    return ecACOS;
+  case tASIN:
+    return ecASIN;
+  case tEXP:
+    return ecEXP;
+  case tLOG:
+    return ecLOG;
+  case tFLOOR:
+    return ecFLOOR;
+  case tCEIL:
+    return ecCEIL;
+  case tTRUNC:
+    return ecTRUNC;
+  case tFABS:
+    return ecFABS;
+  case tSRAND:
+    return ecSRAND;
+  case tRAN:
+    return ecRAN;
+  case tNRAN:
+    return ecNRAN;
+  case tBRAN:
+    return ecBRAN;
+  case tBIRAN:
+    return ecBIRAN;
+#if CPFG_VERSION >= 4000
+  case tFUNC:
+    return ecFUNC;
+#endif
+#if CPFG_VERSION >= 6400
+  case tCURVEX:
+    return ecCURVEX;
+  case tCURVEY:
+    return ecCURVEY;
+  case tCURVEZ:
+    return ecCURVEZ;
+  case tCURVEGAL:
+    return ecCURVEGAL;
+#endif
+#if CPFG_VERSION >= 6500
+  case tGETDERIVLENGTH:
+    return ecGETDERIVLENGTH;
+  case tSETDERIVLENGTH:
+    return ecSETDERIVLENGTH;
+#endif
+#if CPFG_VERSION >= 6600
+  case tVVXMIN:
+    return ecVVXMIN;
+  case tVVXMAX:
+    return ecVVXMAX;
+  case tVVYMIN:
+    return ecVVYMIN;
+  case tVVYMAX:
+    return ecVVYMAX;
+  case tVVZMIN:
+    return ecVVZMIN;
+  case tVVZMAX:
+    return ecVVZMAX;
+  case tVVSCALE:
+    return ecVVSCALE;
+  case tDISPLAY:
+    return ecDISPLAY;
+#endif
+  case tARRAYREF:
+    return ecARRAYREF;
+  case tARRAYLHS:
+    return ecARRAYLHS;
+  }
+  /* strings, addresses, I/O and the rest are left to EvalReference */
+  return -1;
+}
+
+/*********************************************************************/
+static void EmitLeaf(Compiler *c, EToken *token) {
+  int i;
+
+  if (token->token == tSTRING || token->token == tNAMELVAL ||
+      token->symbol == NULL) {
+    c->failed = 1;
+    return;
+  }
+  if (token->token == tVALUE) {
+    i = EmitInstr(c, ecPUSHC);
+    c->instr[i].arg.value = SymbolValue(token->symbol);
+  } else {
+    i = EmitInstr(c, ecPUSHV);
+    c->instr[i].arg.symbol = token->symbol;
+  }
+}
+
+/*********************************************************************/
+static void EmitOperator(Compiler *c, EToken *token) {
+  int op = OperatorCode(token->token);
+  int i;
+
+  if (op < 0) {
+    c->failed = 1;
+    return;
+  }
+  i = EmitInstr(c, op);
+  c->instr[i].arg.symbol = token->symbol;
+}
+
+/*********************************************************************/
+/* the operand of ?: following the one ending with the token          */
+/*********************************************************************/
+static EToken *NextOperand(EToken *token) {
+  EToken *ptr = token->nextParam;
+  while (ptr->up != token->up)
+    ptr = ptr->up;
+  return ptr;
+}
+
+/*********************************************************************/
+/* Emits the instructions from the given position in the walk until   */
+/* the return or a jump to a position already emitted. The cases      */
+/* follow the loops of EvalReference.                                 */
+/*********************************************************************/
+static void EmitWalk(Compiler *c, WalkState state, EToken *token) {
+  EToken *ptr;
+  int position;
+
+  while (state != wsNONE && !c->failed) {
+    position = FindState(c, state, token);
+    if (position >= 0) {
+      const int jump = EmitInstr(c, ecJUMP);
+      c->instr[jump].target = position;
+      return;
+    }
+    AddEntry(&c->states, &c->numStates, &c->statesSize, state, token,
+             c->length);
+
+    switch (state) {
+    case wsLEAF:
+      EmitLeaf(c, token);
+      if (token->nextParam != NULL)
+        token = token->nextParam;
+      else
+        state = wsUP;
+      break;
+
+    case wsUP:
+      ptr = token->up;
+      if (ptr == NULL) {
+        EmitInstr(c, ecRETURN);
+        return;
+      }
+      EmitOperator(c, ptr);
+      token = ptr;
+      if (token->nextParam != NULL)
+        state = wsCHECK;
+      break;
+
+    case wsCHECK:
+      switch (token->up->token) {
+      case tOR:
+        EmitBranch(c, ecJNZ, wsSKIPPED, token);
+        break;
+      case tAND:
+        EmitBranch(c, ecJZ, wsSKIPPED, token);
+        break;
+      case tQUESTION:
+        if (token->nextParam != NULL) {
+          EmitBranch(c, ecJZPUSH0, wsCONDJUMP, token);
+          state = wsCONDNEXT;
+          continue;
+        }
+        break;
+      }
+      state = wsNEXT;
+      break;
+
+    case wsCONDJUMP:
+      /* continuing with the next operand */
+      token = NextOperand(token);
+      if (token->nextParam == NULL)
+        EmitBranch(c, ecJNZ2, wsSKIPPED, token);
+      state = wsNEXT;
+      break;
+
+    case wsCONDNEXT:
+      if (NextOperand(token)->nextParam == NULL)
+        EmitBranch(c, ecJNZ2, wsSKIPPED, token);
+      state = wsNEXT;
+      break;
+
+    case wsSKIPPED:
+      token = token->up;
+      if (token->up == NULL) {
+        EmitInstr(c, ecRETURN);
+        return;
+      }
+      state = wsCHECK;
+      break;
+
+    case wsNEXT:
+      if (token->nextParam == NULL)
+        state = wsUP;
+      else {
+        token = token->nextParam;
+        state = wsLEAF;
+      }
+      break;
+
+    case wsNONE:
+      break;
+    }
+  }
+}
+
+/*********************************************************************/
+/* Applies an operator to the stack. Returns the new top index.       */
+/* The same operations as in EvalReference.                           */
+/*********************************************************************/
+static int Apply(const EInstr *instr, double *stack, int stitem) {
+  double temp, temp2;
+  double args[MAXPARMS];
+  int argcount, x;
+  Array *arrayPtr;
+  double *arrayValues;
+
+  switch (instr->op) {
+  case ecOR:
+    temp = stack[stitem--];
+    stack[stitem] = (stack[stitem] || temp);
+    break;
+  case ecAND:
+    temp = stack[stitem--];
+    stack[stitem] = (stack[stitem] && temp);
+    break;
+  case ecGT:
+    temp = stack[stitem--];
+    stack[stitem] = (stack[stitem] > temp);
+    break;
+  case ecGE:
+    temp = stack[stitem--];
+    stack[stitem] = (stack[stitem] >= temp);
+    break;
+  case ecLT:
+    temp = stack[stitem--];
+    stack[stitem] = (stack[stitem] < temp);
+    break;
+  case ecLE:
+    temp = stack[stitem--];
+    stack[stitem] = (stack[stitem] <= temp);
+    break;
+  case ecEQUAL:
+    temp = stack[stitem--];
+    stack[stitem] = (stack[stitem] == temp);
+    break;
+  case ecNOTEQUAL:
+    temp = stack[stitem--];
+    stack[stitem] = (stack[stitem] != temp);
+    break;
+  case ecPLUS:
+    temp = stack[stitem--];
+    stack[stitem] += temp;
+    break;
+  case ecMINUS:
+    temp = stack[stitem--];
+    stack[stitem] -= temp;
+    break;
+  case ecUMINUS:
+    stack[stitem] *= (-1.0);
+    break;
+  case ecTIMES:
+    temp = stack[stitem--];
+    stack[stitem] *= temp;
+    break;
+  case ecDIVIDE:
+    temp = stack[stitem--];
+    if (temp == 0.0) {
+      Message("Warning: division by 0.\n");
+      temp = 1.0;
+    }
+    stack[stitem] /= temp;
+    break;
+  case ecREM:
+    temp = stack[stitem--];
+    stack[stitem] = (double)((int)stack[stitem] % (int)temp);
+    break;
+  case ecPOW:
+    temp = stack[stitem--];
+    stack[stitem] = pow(stack[stitem], temp);
+    break;
+  case ecNOT:
+    stack[stitem] = (!stack[stitem]);
+    break;
+  case ecQUESTION:
+    temp = stack[stitem--];
+    temp2 = stack[stitem--];
+    stack[stitem] = (stack[stitem]) ? temp2 : temp;
+    break;
+  case ecSIGN:
+    stack[stitem] =
+        ((stack[stitem] == 0.0) ? 0.0 : ((stack[stitem] > 0.0) ? 1.0 : -1.0));
+    break;
+  case ecSQRT:
+    stack[stitem] = sqrt(stack[stitem]);
+    break;
+  case ecATAN2:
+    temp = stack[stitem--];
+    stack[stitem] = R_TO_D(atan2(temp, stack[stitem]));
+    break;
+  case ecTAN:
+    stack[stitem] = tan(D_TO_R(stack[stitem]));
+    break;
+  case ecCOS:
+    stack[stitem] = cos(D_TO_R(stack[stitem]));
+    break;
+  case ecSIN:
+    stack[stitem] = sin(D_TO_R(stack[stitem]));
+    break;
+  case ecATAN:
+    stack[stitem] = R_TO_D(atan(stack[stitem]));
+    break;
+  case ecACOS:
+    stack[stitem] = R_TO_D(acos(stack[stitem]));
+    break;
+  case ecASIN:
+    stack[stitem] = R_TO_D(asin(stack[stitem]));
+    break;
+  case ecEXP:
+    stack[stitem] = exp(stack[stitem]);
+    break;
+  case ecLOG:
+    stack[stitem] = log(stack[stitem]);
+    break;
+  case ecFLOOR:
+    stack[stitem] = floor(stack[stitem]);
+    break;
+  case ecCEIL:
+    stack[stitem] = ceil(stack[stitem]);
+    break;
+  case ecTRUNC:
+    stack[stitem] = floor(stack[stitem] + 0.5);
+    break;
+  case ecFABS:
+    stack[stitem] = fabs(stack[stitem]);
+    break;
+  case ecSRAND:
+    Do_srand((long int)stack[stitem]);
+    stack[stitem] = 0.0f;
+    break;
+  case ecRAN:
+    stack[stitem] = Do_ran(stack[stitem]);
+    break;
+  case ecNRAN:
+    temp = stack[stitem--];
+    stack[stitem] = Do_nrand(stack[stitem], temp);
+    break;
+  case ecBRAN:
+    temp = stack[stitem--];
+    stack[stitem] = Do_bran(stack[stitem], temp);
+    break;
+  case ecBIRAN:
+    temp = stack[stitem--];
+    stack[stitem] = Do_biran((int)(stack[stitem]), temp);
+    break;
+#if CPFG_VERSION >= 4000
+  case ecFUNC:
+    temp = stack[stitem--];
+    stack[stitem] = SplineFuncValue((int)stack[stitem], temp);
+    break;
+#endif
+#if CPFG_VERSION >= 6400
+  case ecCURVEX:
+    temp = stack[stitem--];
+    stack[stitem] = CurveCXS((int)stack[stitem], 0, temp, 0, 0);
+    break;
+  case ecCURVEY:
+    temp = stack[stitem--];
+    stack[stitem] = CurveCYS((int)stack[stitem], 0, temp, 0, 0);
+    break;
+  case ecCURVEZ:
+    temp = stack[stitem--];
+    stack[stitem] = CurveCZS((int)stack[stitem], 0, temp, 0, 0);
+    break;
+  case ecCURVEGAL:
+    stack[stitem] = CurveGAL((int)stack[stitem]);
+    break;
+#endif
+#if CPFG_VERSION >= 6500
+  case ecGETDERIVLENGTH:
+    assert(NULL != LsystemList);
+    stack[stitem] = LsystemList->n;
+    break;
+  case ecSETDERIVLENGTH:
+    assert(NULL != LsystemList);
+    LsystemList->n = (int)stack[stitem];
+    stack[stitem] = 0;
+    break;
+#endif
+#if CPFG_VERSION >= 6600
+  case ecVVXMIN:
+    stack[stitem] = viewWindow.left + viewparam.xPan;
+    break;
+  case ecVVXMAX:
+    stack[stitem] = viewWindow.right + viewparam.xPan;
+    break;
+  case ecVVYMIN:
+    stack[stitem] = viewWindow.bottom + viewparam.yPan;
+    break;
+  case ecVVYMAX:
+    stack[stitem] = viewWindow.top + viewparam.yPan;
+    break;
+  case ecVVZMIN:
+    stack[stitem] = viewparam.front_dist;
+    break;
+  case ecVVZMAX:
+    stack[stitem] = viewparam.back_dist;
+    break;
+  case ecVVSCALE:
+    stack[stitem] = viewparam.scale;
+    break;
+  case ecDISPLAY:
+    DisplayFrame(stack[stitem]);
+    break;
+#endif
+  case ecARRAYREF:
+  case ecARRAYLHS:
+    arrayPtr = instr->arg.symbol->arrayData;
+#ifdef JIM
+    arrayValues = &SymbolValue(instr->arg.symbol);
+#else
+    arrayValues = arrayPtr->values;
+#endif
+    temp = 0;
+    argcount = (int)stack[stitem--];
+    for (x = argcount - 1; x >= 0; x--) {
+      args[x] = stack[stitem--];
+      if (args[x] >= arrayPtr->size[x] || args[x] < 0) {
+        Message("Warning: Subscript # %d = %.0f out of range for %s; using "
+                "%d\n",
+                x + 1, args[x], instr->arg.symbol->label,
+                (args[x] < 0) ? 0 : arrayPtr->size[x] - 1);
+        args[x] = (args[x] < 0) ? 0 : arrayPtr->size[x] - 1;
+      }
+    }
+    for (x = 1; x < argcount; x++)
+      temp = (temp + args[x - 1]) * arrayPtr->size[x];
+    if (instr->op == ecARRAYLHS)
+      stack[++stitem] = temp + args[argcount - 1];
+    else
+      stack[++stitem] = *(arrayValues + (int)(temp + args[argcount - 1]));
+    break;
+  }
+  return stitem;
+}
+
+/*********************************************************************/
+/* Number of operands if the operator at position last can be folded: */
+/* it has no side effects and its operands are constants, of which    */
+/* only the first one may be a jump target. 0 otherwise.              */
+/*********************************************************************/
+static int FoldableOperands(const EInstr *instr, const char *isTarget,
+                            int last) {
+  int operands, i;
+
+  switch (instr[last].op) {
+  case ecOR:
+  case ecAND:
+  case ecGT:
+  case ecGE:
+  case ecLT:
+  case ecLE:
+  case ecEQUAL:
+  case ecNOTEQUAL:
+  case ecPLUS:
+  case ecMINUS:
+  case ecTIMES:
+  case ecDIVIDE:
+  case ecREM:
+  case ecPOW:
+  case ecATAN2:
+    operands = 2;
+    break;
+  case ecQUESTION:
+    operands = 3;
+    break;
+  case ecUMINUS:
+  case ecNOT:
+  case ecSIGN:
+  case ecSQRT:
+  case ecTAN:
+  case ecCOS:
+  case ecSIN:
+  case ecATAN:
+  case ecACOS:
+  case ecASIN:
+  case ecEXP:
+  case ecLOG:
+  case ecFLOOR:
+  case ecCEIL:
+  case ecTRUNC:
+  case ecFABS:
+    operands = 1;
+    break;
+  default:
+    return 0;
+  }
+  if (last < operands)
+    return 0;
+  for (i = last - operands; i < last; i++) {
+    if (instr[i].op != ecPUSHC)
+      return 0;
+    if (i > last - operands && isTarget[i])
+      return 0;
+  }
+  /* keep the warning and do not divide by 0 */
+  if (instr[last].op == ecDIVIDE && instr[last - 1].arg.value == 0.0)
+    return 0;
+  if (instr[last].op == ecREM && (int)instr[last - 1].arg.value == 0)
+    return 0;
+  return operands;
+}
+
+/*********************************************************************/
+/* flags of the positions jumped to                                  */
+/*********************************************************************/
+static char *JumpTargets(const Compiler *c) {
+  char *isTarget = (char *)Malloc(c->length);
+  int i;
+
+  memset(isTarget, 0, c->length);
+  for (i = 0; i < c->length; i++)
+    if (c->instr[i].target >= 0)
+      isTarget[c->instr[i].target] = 1;
+  return isTarget;
+}
+
+/*********************************************************************/
+static void Relocate(Compiler *c, const int *newPosition, int length) {
+  int i;
+
+  for (i = 0; i < length; i++)
+    if (c->instr[i].target >= 0)
+      c->instr[i].target = newPosition[c->instr[i].target];
+  c->length = length;
+}
+
+/*********************************************************************/
+/* Replaces operators applied to constants by their values            */
+/*********************************************************************/
+static void FoldConstants(Compiler *c) {
+  char *isTarget;  /* by original position */
+  char *outTarget; /* by position after folding */
+  int *newPosition;
+  double stack[4];
+  int i, j, n, operands;
+
+  isTarget = JumpTargets(c);
+  outTarget = (char *)Malloc(c->length);
+  newPosition = (int *)Malloc(sizeof(int) * c->length);
+
+  /* compact in place, n <= i */
+  n = 0;
+  for (i = 0; i < c->length; i++) {
+    c->instr[n] = c->instr[i];
+    outTarget[n] = isTarget[i];
+    newPosition[i] = n;
+    if (!isTarget[i] &&
+        (operands = FoldableOperands(c->instr, outTarget, n)) > 0) {
+      for (j = 0; j < operands; j++)
+        stack[j + 1] = c->instr[n - operands + j].arg.value;
+      Apply(c->instr + n, stack, operands);
+      n -= operands;
+      c->instr[n].op = ecPUSHC;
+      c->instr[n].target = -1;
+      c->instr[n].arg.value = stack[1];
+      newPosition[i] = n;
+    }
+    ++n;
+  }
+  Relocate(c, newPosition, n);
+
+  Free(isTarget);
+  Free(outTarget);
+  Free(newPosition);
+}
+
+/*********************************************************************/
+/* the operator taking the pushed value from the instruction, -1 if  */
+/* there is none                                                      */
+/*********************************************************************/
+static int FusedCode(int op, int push) {
+  static const int fused[][3] = {
+      {ecPLUS, ecPLUSC, ecPLUSV},    {ecMINUS, ecMINUSC, ecMINUSV},
+      {ecTIMES, ecTIMESC, ecTIMESV}, {ecGT, ecGTC, ecGTV},
+      {ecGE, ecGEC, ecGEV},          {ecLT, ecLTC, ecLTV},
+      {ecLE, ecLEC, ecLEV},          {ecEQUAL, ecEQUALC, ecEQUALV}};
+  int i;
+
+  if (push != ecPUSHC && push != ecPUSHV)
+    return -1;
+  for (i = 0; i < (int)(sizeof(fused) / sizeof(fused[0])); i++)
+    if (fused[i][0] == op)
+      return fused[i][(push == ecPUSHC) ? 1 : 2];
+  return -1;
+}
+
+/*********************************************************************/
+/* Merges the push of the second operand into binary operators, so    */
+/* that e.g. x*2+y takes three instructions instead of five           */
+/*********************************************************************/
+static void FuseOperands(Compiler *c) {
+  char *isTarget;
+  int *newPosition;
+  int i, n, op;
+
+  isTarget = JumpTargets(c);
+  newPosition = (int *)Malloc(sizeof(int) * c->length);
+
+  n = 0;
+  for (i = 0; i < c->length; i++) {
+    newPosition[i] = n;
+    if (n > 0 && !isTarget[i] && !isTarget[i - 1] &&
+        (op = FusedCode(c->instr[i].op, c->instr[n - 1].op)) >= 0) {
+      /* the push is replaced, its argument stays */
+      c->instr[n - 1].op = op;
+      newPosition[i] = n - 1;
+      continue;
+    }
+    c->instr[n++] = c->instr[i];
+  }
+  Relocate(c, newPosition, n);
+
+  Free(isTarget);
+  Free(newPosition);
+}
+
+/*********************************************************************/
+ECode *CompileExpression(EToken *expression) {
+  Compiler c;
+  StateEntry branch;
+  ECode *code;
+  int position;
+
+  if ((code = (ECode *)Malloc(sizeof(ECode))) == NULL) {
+    Warning("Expression code allocation failed", INTERNAL_LVL);
+    return NULL;
+  }
+  memset(&c, 0, sizeof(c));
+  code->length = 0;
+  code->instr = NULL;
+
+  EmitWalk(&c, wsLEAF, expression);
+  /* emit the targets of the conditional jumps */
+  while (c.numBranches > 0 && !c.failed) {
+    branch = c.branches[--c.numBranches];
+    position = FindState(&c, branch.state, branch.token);
+    if (position < 0) {
+      position = c.length;
+      EmitWalk(&c, branch.state, branch.token);
+    }
+    c.instr[branch.position].target = position;
+  }
+
+  if (!c.failed) {
+    FoldConstants(&c);
+    FuseOperands(&c);
+    code->length = c.length;
+    code->instr = c.instr;
+    c.instr = NULL;
+  }
+  Free(c.instr);
+  Free(c.states);
+  Free(c.branches);
+  return code;
+}
+
+/*********************************************************************/
+int ExpressionCompiled(const ECode *code) {
+  return code != NULL && code->length > 0;
+}
+
+/* With GCC and clang every instruction jumps directly to the next one
+   (labels as values). The branch predictor copes with that much better
+   than with the single jump of the switch when many different expressions
+   are evaluated. */
+#ifdef __GNUC__
+#define THREADED_DISPATCH
+#endif
+
+#ifdef THREADED_DISPATCH
+#define INSTR(op) op##_label:
+#define DISPATCH()                                                             \
+  if (instr->op < ecOR)                                                        \
+    goto *dispatch[instr->op];                                                 \
+  goto apply
+#define NEXT_INSTR()                                                           \
+  ++instr;                                                                     \
+  DISPATCH()
+#define JUMP_INSTR()                                                           \
+  instr = code->instr + instr->target;                                         \
+  DISPATCH()
+#else
+#define INSTR(op) case op:
+#define NEXT_INSTR()                                                           \
+  ++instr;                                                                     \
+  continue
+#define JUMP_INSTR()                                                           \
+  instr = code->instr + instr->target;                                         \
+  continue
+#endif
+
+/* binary operator with the second operand from the stack,
+   the instruction or a symbol */
+#define BINARY_INSTR(OP, STATEMENT)                                            \
+  INSTR(ec##OP)                                                                \
+  temp = stack[stitem--];                                                      \
+  STATEMENT;                                                                   \
+  NEXT_INSTR();                                                                \
+  INSTR(ec##OP##C)                                                             \
+  temp = instr->arg.value;                                                     \
+  STATEMENT;                                                                   \
+  NEXT_INSTR();                                                                \
+  INSTR(ec##OP##V)                                                             \
+  temp = SymbolValue(instr->arg.symbol);                                       \
+  STATEMENT;                                                                   \
+  NEXT_INSTR();
+
+/*********************************************************************/
+double RunExpression(const ECode *code) {
+  double stack[MAXPARMLEN]; /* the same as in EvalReference */
+  int stitem = 0;
+  const EInstr *instr = code->instr;
+  double temp;
+  char skip;
+#ifdef THREADED_DISPATCH
+  static const void *const dispatch[ecOR] = {
+      &&ecPUSHC_label,  &&ecPUSHV_label,  &&ecRETURN_label, &&ecJUMP_label,
+      &&ecJNZ_label,    &&ecJZ_label,     &&ecJZPUSH0_label, &&ecJNZ2_label,
+      &&ecPLUS_label,   &&ecPLUSC_label,  &&ecPLUSV_label,  &&ecMINUS_label,
+      &&ecMINUSC_label, &&ecMINUSV_label, &&ecTIMES_label,  &&ecTIMESC_label,
+      &&ecTIMESV_label, &&ecGT_label,     &&ecGTC_label,    &&ecGTV_label,
+      &&ecGE_label,     &&ecGEC_label,    &&ecGEV_label,    &&ecLT_label,
+      &&ecLTC_label,    &&ecLTV_label,    &&ecLE_label,     &&ecLEC_label,
+      &&ecLEV_label,    &&ecEQUAL_label,  &&ecEQUALC_label, &&ecEQUALV_label};
+
+  DISPATCH();
+#else
+  for (;;) {
+    switch (instr->op) {
+#endif
+  INSTR(ecPUSHC)
+  stack[++stitem] = instr->arg.value;
+  NEXT_INSTR();
+  INSTR(ecPUSHV)
+  stack[++stitem] = SymbolValue(instr->arg.symbol);
+  NEXT_INSTR();
+  INSTR(ecRETURN)
+  return stack[stitem];
+  INSTR(ecJUMP)
+  JUMP_INSTR();
+  INSTR(ecJNZ)
+  /* as char, like the skip flag of EvalReference */
+  skip = stack[stitem];
+  if (skip) {
+    JUMP_INSTR();
+  }
+  NEXT_INSTR();
+  INSTR(ecJZ)
+  if (!stack[stitem]) {
+    JUMP_INSTR();
+  }
+  NEXT_INSTR();
+  INSTR(ecJZPUSH0)
+  if (!stack[stitem]) {
+    stack[++stitem] = 0; /* a dummy value */
+    JUMP_INSTR();
+  }
+  NEXT_INSTR();
+  INSTR(ecJNZ2)
+  if (stack[stitem - 1]) {
+    JUMP_INSTR();
+  }
+  NEXT_INSTR();
+  BINARY_INSTR(PLUS, stack[stitem] += temp)
+  BINARY_INSTR(MINUS, stack[stitem] -= temp)
+  BINARY_INSTR(TIMES, stack[stitem] *= temp)
+  BINARY_INSTR(GT, stack[stitem] = (stack[stitem] > temp))
+  BINARY_INSTR(GE, stack[stitem] = (stack[stitem] >= temp))
+  BINARY_INSTR(LT, stack[stitem] = (stack[stitem] < temp))
+  BINARY_INSTR(LE, stack[stitem] = (stack[stitem] <= temp))
+  BINARY_INSTR(EQUAL, stack[stitem] = (stack[stitem] == temp))
+#ifdef THREADED_DISPATCH
+apply:
+#else
+    default:
+#endif
+  stitem = Apply(instr, stack, stitem);
+  NEXT_INSTR();
+#ifndef THREADED_DISPATCH
+    }
+  }
+#endif
+}
+
+/*********************************************************************/
+void FreeExpressionCode(ECode *code) {
+  if (code == NULL)
+    return;
+  Free(code->instr);
+  code->instr = NULL;
+  Free(code);
+  code = NULL;
+}
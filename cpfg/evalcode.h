@@ -0,0 +1,51 @@
+/* ******************************************************************** *
+   Copyright (C) 1990-2022 University of Calgary
+  
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+  
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+  
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ******************************************************************** */
+
+
+
+#ifndef __EVALCODE_H__
+#define __EVALCODE_H__
+/*
+MODULE:		evalcode.h
+PURPOSE: Expressions compiled to a linear program for a stack machine.
+         The program performs the same operations, in the same order,
+         as the traversal of the postfix token tree in EvalReference,
+         with symbol slots resolved and constant subexpressions folded
+         when the expression is compiled.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct EToken_s;
+typedef struct ECode_s ECode;
+
+/* returns the program for the expression starting at the given token.
+   Expressions using strings, addresses or I/O functions are not
+   compiled: ExpressionCompiled returns 0 for them. Returns NULL if
+   the program cannot be allocated */
+ECode *CompileExpression(struct EToken_s *expression);
+int ExpressionCompiled(const ECode *code);
+double RunExpression(const ECode *code);
+void FreeExpressionCode(ECode *code);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -135,6 +135,7 @@ APPLYPROD) i.  If a production exists, append the predecessor into string2 and
 #include "curveXYZc.h"
 #endif
 
+#include "evalcode.h"
 #include "test_malloc.h"
 
 extern int animateFlag;
@@ -186,6 +187,8 @@ static void FreeSymbolSpace(Symbol *symbolPtr);
 static void FreeSymbolTableSpace(SymbolTable *symbolTablePtr);
 void FreeArraySpace(Array *arrayPtr);
 static Production *FindProd(char *curPtr, LSYSDATA *LsysPtr);
+static void PrepareMatching(LSYSDATA *LsysPtr);
+static void FreeMatchFilters(LSYSDATA *LsysPtr);
 #ifndef JIM
 static void CheckPred(char *strtPtr, char *curPtr, LSYSDATA *LsystemListPtr,
                       LSYSDATA **currentLsystem);
@@ -397,6 +400,8 @@ int ReadLsystem(char *filename) {
     return 0;
   }
 
+  PrepareMatching(LsystemList);
+
   VERBOSE("FINISHED READING PRODUCTION FILE.\nRUNNING\n");
 
   if (clp.warnings) {
@@ -605,6 +610,7 @@ static LSYSDATA *FreeLsystemSpace(LSYSDATA *LsystemListPtr) {
     FreeProductionSpace(&currentLsystem->Decomposition);
 
     FreeStringSpace(currentLsystem->axiom);
+    FreeMatchFilters(currentLsystem);
     /* loop over productions */
     for (i = 0; i < 128; i++) {
       nextProduction = currentLsystem->firstProd[i];
@@ -676,6 +682,8 @@ void FreeExpressionSpace(EToken *tokenPtr) {
 
   Free(tokenPtr->tokenString);
   tokenPtr->tokenString = NULL;
+  FreeExpressionCode(tokenPtr->code);
+  tokenPtr->code = NULL;
   Free(tokenPtr);
   tokenPtr = NULL;
 }
@@ -1192,6 +1200,446 @@ void Derive(LSYSDATA *LsystemListPtr, char **string1,
     ProcessEnvironment(*string2, drawparamPtr, viewparamPtr);
 }
 
+/*********************************************************************/
+/* Productions are matched against the modules around the current   */
+/* position. The modules of the predecessor and of the left and      */
+/* right context (with ignored symbols and branches skipped) are     */
+/* collected only once, as far as the candidate productions need     */
+/* them, so the string is not scanned again for each candidate.      */
+/*********************************************************************/
+
+#define MAXMATCHMODULES 32
+
+typedef struct {
+  char *ptr; /* position of the module in the string */
+  char symbol;
+  int parameters;
+  int length;
+} MatchModule;
+
+typedef struct {
+  MatchModule module[MAXMATCHMODULES];
+  int count;
+  char *next; /* where the scan continues */
+  char end;   /* end of the string or substring reached */
+} MatchScan;
+
+/* Productions of one strict predecessor symbol, in the order of       */
+/* declaration. Bit i of a mask stands for production i: the masks of  */
+/* a symbol select the productions that can match when the nearest     */
+/* module of the left (right) context is that symbol. The mask of      */
+/* symbol 0 is used when there is no such module. Productions that are */
+/* not constrained by the module are in every mask.                    */
+
+#define MASKBITS (8 * (int)sizeof(unsigned long))
+#define MASKBIT(mask, i) (((mask)[(i) / MASKBITS] >> ((i) % MASKBITS)) & 1UL)
+
+typedef struct MatchFilter_s {
+  int count;
+  int words; /* length of one mask */
+  Production **prod;
+  unsigned long *left;  /* 128 masks */
+  unsigned long *right; /* 128 masks */
+  char useLeft;         /* some production is constrained */
+  char useRight;
+} MatchFilter;
+
+typedef struct {
+  char *position; /* module to be rewritten */
+  char *rightStart; /* the right context depends on the predecessor length */
+  MatchScan pred;
+  MatchScan left;
+  MatchScan right;
+  Production *first;  /* without a filter, all productions are tried */
+  MatchFilter *filter;
+  unsigned long *leftMask;
+  unsigned long *rightMask;
+  int candidate; /* index of the last production tried */
+} MatchContext;
+
+/*********************************************************************/
+/* Function: CountMatchModules                                       */
+/* Returns the number of modules in the list or -1 if it is too long */
+/* or contains a symbol from excluded.                               */
+/*********************************************************************/
+
+static int CountMatchModules(Module *modulePtr, const char *excluded) {
+  int count = 0;
+
+  while (modulePtr != NULL) {
+    if (count == MAXMATCHMODULES || strchr(excluded, modulePtr->symbol) != NULL)
+      return -1;
+    ++count;
+    modulePtr = modulePtr->nextModule;
+  }
+  return count;
+}
+
+/*********************************************************************/
+/* Function: SetMatchFilterBits                                      */
+/* Puts production i in the mask of the symbol, or in all masks if   */
+/* symbol is negative.                                               */
+/*********************************************************************/
+
+static void SetMatchFilterBits(unsigned long *masks, int words, int i,
+                               int symbol) {
+  int c;
+
+  for (c = 0; c < 128; c++)
+    if (symbol < 0 || c == symbol)
+      masks[c * words + i / MASKBITS] |= 1UL << (i % MASKBITS);
+}
+
+/*********************************************************************/
+/* Function: BuildMatchFilter                                        */
+/* Returns the filter of the productions in the list, or NULL if no  */
+/* production can be skipped by it.                                  */
+/*********************************************************************/
+
+static MatchFilter *BuildMatchFilter(Production *first) {
+  MatchFilter *filter;
+  Production *prodPtr;
+  int count = 0, useLeft = 0, useRight = 0, i;
+
+  for (prodPtr = first; prodPtr != NULL; prodPtr = prodPtr->nextProduction) {
+    ++count;
+    if (prodPtr->predModules >= 0 && prodPtr->lconModules > 0)
+      useLeft = 1;
+    if (prodPtr->predModules == 1 && prodPtr->rconModules > 0)
+      useRight = 1;
+  }
+  if (count < 2 || (!useLeft && !useRight))
+    return NULL;
+
+  if ((filter = (MatchFilter *)Malloc(sizeof(MatchFilter))) == NULL)
+    return NULL;
+  filter->count = count;
+  filter->words = (count + MASKBITS - 1) / MASKBITS;
+  filter->prod = (Production **)Malloc(count * sizeof(Production *));
+  filter->left = (unsigned long *)Malloc(128 * filter->words *
+                                         sizeof(unsigned long));
+  filter->right = (unsigned long *)Malloc(128 * filter->words *
+                                          sizeof(unsigned long));
+  if (filter->prod == NULL || filter->left == NULL || filter->right == NULL) {
+    Free(filter->prod);
+    Free(filter->left);
+    Free(filter->right);
+    Free(filter);
+    return NULL;
+  }
+  memset(filter->left, 0, 128 * filter->words * sizeof(unsigned long));
+  memset(filter->right, 0, 128 * filter->words * sizeof(unsigned long));
+  filter->useLeft = useLeft;
+  filter->useRight = useRight;
+
+  for (i = 0, prodPtr = first; prodPtr != NULL;
+       ++i, prodPtr = prodPtr->nextProduction) {
+    filter->prod[i] = prodPtr;
+    /* the nearest module of the left context is its first one */
+    SetMatchFilterBits(filter->left, filter->words, i,
+                       prodPtr->predModules >= 0 && prodPtr->lconModules > 0
+                           ? (int)prodPtr->lCon->symbol
+                           : -1);
+    /* the right context follows the first module only if the strict
+       predecessor has just one */
+    SetMatchFilterBits(filter->right, filter->words, i,
+                       prodPtr->predModules == 1 && prodPtr->rconModules > 0
+                           ? (int)prodPtr->rCon->symbol
+                           : -1);
+  }
+  return filter;
+}
+
+/*********************************************************************/
+/* Function: PrepareMatching                                         */
+/* Sets the number of modules matched by MatchDiff for all L-system  */
+/* productions. Right contexts with branches or '=' are left to      */
+/* RconDiff, as their scan depends on the context.                   */
+/* Builds the filters of productions for each symbol.                */
+/*********************************************************************/
+
+static void PrepareMatching(LSYSDATA *LsysPtr) {
+  Production *prodPtr;
+  int i;
+
+  for (; LsysPtr != NULL; LsysPtr = LsysPtr->nextLsystem)
+    for (i = 0; i < 128; i++) {
+      for (prodPtr = LsysPtr->firstProd[i]; prodPtr != NULL;
+           prodPtr = prodPtr->nextProduction) {
+        prodPtr->predModules = CountMatchModules(prodPtr->pred, "");
+        prodPtr->rconModules = CountMatchModules(prodPtr->rCon, "[=");
+        prodPtr->lconModules = CountMatchModules(prodPtr->lCon, "");
+        if (clp.debug)
+          Message("Production for %c matched by modules: %d %d %d\n", i,
+                  prodPtr->predModules, prodPtr->rconModules,
+                  prodPtr->lconModules);
+      }
+      LsysPtr->matchFilter[i] = BuildMatchFilter(LsysPtr->firstProd[i]);
+    }
+}
+
+/*********************************************************************/
+static void FreeMatchFilters(LSYSDATA *LsysPtr) {
+  int i;
+
+  for (i = 0; i < 128; i++)
+    if (LsysPtr->matchFilter[i] != NULL) {
+      Free(LsysPtr->matchFilter[i]->prod);
+      Free(LsysPtr->matchFilter[i]->left);
+      Free(LsysPtr->matchFilter[i]->right);
+      Free(LsysPtr->matchFilter[i]);
+      LsysPtr->matchFilter[i] = NULL;
+    }
+}
+
+/*********************************************************************/
+static void StartScan(MatchScan *scan, char *start) {
+  scan->count = 0;
+  scan->next = start;
+  scan->end = 0;
+}
+
+/*********************************************************************/
+static void AddScanned(MatchScan *scan, char *ptr) {
+  MatchModule *module = scan->module + scan->count++;
+  StringModule ts;
+
+  module->ptr = ptr;
+  module->symbol = NextStringModuleForMatch(&ptr, &ts);
+  module->parameters = ts.parameters;
+  module->length = ts.length;
+}
+
+/*********************************************************************/
+/* Function: ScanPred                                                */
+/* Collects n modules following the current position, as PredDiff.  */
+/* Returns 0 if the end of string is reached first.                  */
+/*********************************************************************/
+
+static int ScanPred(MatchScan *scan, int n,
+                    __attribute__((unused)) LSYSDATA *LsysPtr) {
+  while (scan->count < n) {
+    if (scan->end || *scan->next == '\0') {
+      scan->end = 1;
+      return 0;
+    }
+    AddScanned(scan, scan->next);
+    scan->next += scan->module[scan->count - 1].length;
+  }
+  return 1;
+}
+
+/*********************************************************************/
+/* Function: ScanRight                                               */
+/* Collects n modules of the right context, skipping ignored symbols */
+/* and branches, as RconDiff for contexts without '[' and '='.       */
+/*********************************************************************/
+
+static int ScanRight(MatchScan *scan, int n, LSYSDATA *LsysPtr) {
+  char *strPtr = scan->next;
+
+  while (scan->count < n && !scan->end) {
+    /* for a ring L-system, continue from the left end */
+    if (LsysPtr->ring &&
+        ((*strPtr == '\0') || ((*strPtr == '%') && (*(strPtr + 1) == '(')))) {
+      strPtr--;
+      while ((*strPtr != '\0') &&
+             ((*strPtr != '%') || (*(strPtr + 1) != '('))) {
+        if (*strPtr == ')')
+          strPtr = movestringleft(strPtr);
+        strPtr--;
+      }
+      strPtr++;
+    }
+    if ((*strPtr == '\0') || ((*strPtr == '%') && (*(strPtr + 1) == '(')))
+      scan->end = 1;
+    else if (LsysPtr->ignore[(int)(*strPtr)]) {
+      strPtr++;
+      if (*strPtr == '(')
+        strPtr = moveright(strPtr);
+    } else if (*strPtr == '[')
+      strPtr = skipright(strPtr + 1) + 1;
+    else {
+      AddScanned(scan, strPtr);
+      strPtr += scan->module[scan->count - 1].length;
+    }
+  }
+  scan->next = strPtr;
+  return scan->count >= n;
+}
+
+/*********************************************************************/
+/* Function: ScanLeft                                                */
+/* Collects n modules of the left context, nearest first, skipping   */
+/* ignored symbols and branches, as LconDiff.                        */
+/*********************************************************************/
+
+static int ScanLeft(MatchScan *scan, int n, LSYSDATA *LsysPtr) {
+  char *strPtr = scan->next;
+
+  while (scan->count < n && !scan->end) {
+    /* for a ring L-system, continue from the right end */
+    if (LsysPtr->ring &&
+        ((*strPtr == '\0') || ((*strPtr == '%') && (*(strPtr + 1) == '(')))) {
+      strPtr++;
+      while ((*strPtr != '\0') &&
+             ((*strPtr != '%') || (*(strPtr + 1) != '('))) {
+        strPtr++;
+        if (*strPtr == '(')
+          strPtr = moveright(strPtr);
+      }
+      strPtr--;
+    }
+
+    if (*strPtr == ')')
+      strPtr = movestringleft(strPtr);
+
+    switch (*strPtr) {
+    case ']':
+      strPtr = skipleft(strPtr);
+      break;
+    case '[':
+      strPtr--;
+      break;
+    default:
+      if ((*strPtr == '\0') || ((*strPtr == '%') && (*(strPtr + 1) == '(')))
+        scan->end = 1;
+      else {
+        if (!LsysPtr->ignore[(int)(*strPtr)])
+          AddScanned(scan, strPtr);
+        strPtr--;
+      }
+      break;
+    }
+  }
+  scan->next = strPtr;
+  return scan->count >= n;
+}
+
+/*********************************************************************/
+/* Function: StartMatching                                           */
+/* Prepares matching of the productions at curPtr. If they have a    */
+/* filter, the nearest modules of the contexts are scanned to select */
+/* the productions that can match.                                   */
+/*********************************************************************/
+
+static void StartMatching(MatchContext *context, char *curPtr,
+                          LSYSDATA *LsysPtr) {
+  MatchFilter *filter = LsysPtr->matchFilter[(int)(*curPtr)];
+  MatchModule *first;
+
+  context->position = curPtr;
+  context->rightStart = NULL;
+  StartScan(&context->pred, curPtr);
+  StartScan(&context->left, curPtr - 1);
+  context->first = LsysPtr->firstProd[(int)(*curPtr)];
+  context->filter = filter;
+  context->candidate = -1;
+  if (filter == NULL)
+    return;
+
+  context->leftMask = filter->left;
+  if (filter->useLeft && ScanLeft(&context->left, 1, LsysPtr))
+    context->leftMask += filter->words * (int)context->left.module[0].symbol;
+
+  context->rightMask = filter->right;
+  if (filter->useRight && ScanPred(&context->pred, 1, LsysPtr)) {
+    /* MatchDiff continues this scan for one-module predecessors */
+    first = context->pred.module;
+    context->rightStart = first->ptr + first->length;
+    StartScan(&context->right, context->rightStart);
+    if (ScanRight(&context->right, 1, LsysPtr))
+      context->rightMask +=
+          filter->words * (int)context->right.module[0].symbol;
+  }
+}
+
+/*********************************************************************/
+/* Function: NextCandidate                                           */
+/* Returns the production following prodPtr (or the first one if it  */
+/* is NULL) that can match, in the order of declaration.             */
+/*********************************************************************/
+
+static Production *NextCandidate(MatchContext *context, Production *prodPtr) {
+  MatchFilter *filter = context->filter;
+  int i;
+
+  if (filter == NULL)
+    return prodPtr == NULL ? context->first : prodPtr->nextProduction;
+
+  for (i = context->candidate + 1; i < filter->count; i++)
+    if (MASKBIT(context->leftMask, i) && MASKBIT(context->rightMask, i)) {
+      context->candidate = i;
+      return filter->prod[i];
+    }
+  context->candidate = filter->count;
+  return NULL;
+}
+
+/*********************************************************************/
+/* Function: ScannedDiff                                             */
+/* Compares the modules of a production with the scanned ones and    */
+/* records the matched positions. The scan is extended only up to    */
+/* the first discrepancy. Returns 0 if they match.                   */
+/*********************************************************************/
+
+typedef int (*MatchScanner)(MatchScan *scan, int n, LSYSDATA *LsysPtr);
+
+static int ScannedDiff(Module *modulePtr, MatchScan *scan, MatchScanner scanner,
+                       LSYSDATA *LsysPtr) {
+  MatchModule *module;
+  int i;
+
+  for (i = 0; modulePtr != NULL; modulePtr = modulePtr->nextModule, ++i) {
+    if (!scanner(scan, i + 1, LsysPtr))
+      return 1;
+    module = scan->module + i;
+    if (modulePtr->symbol != module->symbol ||
+        modulePtr->parameters != module->parameters)
+      return 1;
+    modulePtr->matchedSymbol = module->ptr;
+  }
+  return 0;
+}
+
+/*********************************************************************/
+/* Function: MatchDiff                                               */
+/* Checks the strict predecessor, the right context and the left     */
+/* context of the production, in this order, as PredDiff, RconDiff   */
+/* and LconDiff. Returns 0 if they match.                            */
+/*********************************************************************/
+
+static int MatchDiff(Production *prodPtr, MatchContext *context,
+                     LSYSDATA *LsysPtr) {
+  MatchModule *last;
+  char *rightStart;
+  int preflength;
+
+  if (prodPtr->predModules < 0 || prodPtr->lconModules < 0)
+    return PredDiff(prodPtr->pred, context->position, &preflength) ||
+           RconDiff(prodPtr->rCon, context->position + preflength, LsysPtr) ||
+           LconDiff(prodPtr->lCon, context->position - 1, LsysPtr);
+
+  if (ScannedDiff(prodPtr->pred, &context->pred, ScanPred, LsysPtr))
+    return 1;
+  last = context->pred.module + prodPtr->predModules - 1;
+  rightStart = last->ptr + last->length;
+
+  if (prodPtr->rconModules < 0) {
+    if (RconDiff(prodPtr->rCon, rightStart, LsysPtr))
+      return 1;
+  } else if (prodPtr->rconModules > 0) {
+    if (context->rightStart != rightStart) {
+      context->rightStart = rightStart;
+      StartScan(&context->right, rightStart);
+    }
+    if (ScannedDiff(prodPtr->rCon, &context->right, ScanRight, LsysPtr))
+      return 1;
+  }
+
+  return ScannedDiff(prodPtr->lCon, &context->left, ScanLeft, LsysPtr);
+}
+
 /*********************************************************************/
 /* Function: FindProd                                                */
 /* Given a pointer to a string and a set of productions, return the  */
@@ -1201,10 +1649,12 @@ void Derive(LSYSDATA *LsystemListPtr, char **string1,
 
 static Production *FindProd(char *curPtr, LSYSDATA *LsysPtr) {
   Production *prodPtr;
-  int preflength; /* length of prefix string matched */
+  MatchContext context; /* modules around curPtr */
+
+  StartMatching(&context, curPtr, LsysPtr);
 
   /* start at first possible match */
-  prodPtr = LsysPtr->firstProd[(int)(*curPtr)];
+  prodPtr = NextCandidate(&context, NULL);
 
   while (prodPtr != NULL) {
 
@@ -1214,11 +1664,9 @@ static Production *FindProd(char *curPtr, LSYSDATA *LsysPtr) {
        as a byproduct).  If there is no match, consider next production.
             If there is a match, return the pointer to the production.  */
 
-    if (PredDiff(prodPtr->pred, curPtr, &preflength) ||
-        RconDiff(prodPtr->rCon, curPtr + preflength, LsysPtr) ||
-        LconDiff(prodPtr->lCon, curPtr - 1, LsysPtr) ||
+    if (MatchDiff(prodPtr, &context, LsysPtr) ||
         CondDiff(prodPtr, curPtr, LsysPtr))
-      prodPtr = prodPtr->nextProduction;
+      prodPtr = NextCandidate(&context, prodPtr);
     else
       return (prodPtr);
   }
@@ -2991,6 +3439,25 @@ void AppendParameter(char **str, double value) {
   }
 }
 
+/*********************************************************************/
+/* Evaluate the expression. It is compiled at the first evaluation,
+   expressions that cannot be compiled (or whose program could not be
+   allocated) and all expressions in the -refeval mode are evaluated by
+   walking the tokens (EvalReference) */
+/*********************************************************************/
+double Eval(EToken *expression) {
+  if (expression == NULL)
+    return 0.0;
+
+  if (!clp.referenceEval) {
+    if (expression->code == NULL)
+      expression->code = CompileExpression(expression);
+    if (ExpressionCompiled(expression->code))
+      return RunExpression(expression->code);
+  }
+  return EvalReference(expression);
+}
+
 /*********************************************************************/
 /* Evaluate the postfix expression
    Each token (EToken) has two pointers - 'nextParam' pointing to a
@@ -3014,7 +3481,7 @@ void AppendParameter(char **str, double value) {
                       ---> 5 ----> k -->NULL
 */
 /*********************************************************************/
-double Eval(EToken *expression) {
+double EvalReference(EToken *expression) {
   double stack[MAXPARMLEN]; /* Stack for evaluating postfix expression */
   int stitem;               /* index for stack */
 
@@ -3910,6 +4377,7 @@ EToken *BuildExprList(EToken *fcToken, Parameter *params, int argcount) {
     tokenPtr = tokenPtr->nextParam;
     tokenPtr->nextParam = NULL;
     tokenPtr->up = fcToken;
+    tokenPtr->code = NULL;
     tokenPtr->symbol =
         SymbolTableAdd(Strdup(constantToken), count, currentSymbolTable);
     tokenPtr->token = tVALUE;
@@ -4255,9 +4723,10 @@ static char *skipleft(char *s) {
 static void FindApplProductions(char *curPtr, LSYSDATA *LsysPtr,
                                 Production *applSetPtr[], float *totalprobPtr) {
   Production *prodPtr;
-  int preflength; /* length of prefix string matched */
+  MatchContext context; /* modules around curPtr */
 
-  prodPtr = LsysPtr->firstProd[(int)(*curPtr)];
+  StartMatching(&context, curPtr, LsysPtr);
+  prodPtr = NextCandidate(&context, NULL);
 
   /*
   Check each production for the match.  If there is a match, place
@@ -4270,15 +4739,13 @@ static void FindApplProductions(char *curPtr, LSYSDATA *LsysPtr,
   *totalprobPtr = 0.0;
 
   while (prodPtr != NULL) {
-    if (!PredDiff(prodPtr->pred, curPtr, &preflength) &&
-        !RconDiff(prodPtr->rCon, curPtr + preflength, LsysPtr) &&
-        !LconDiff(prodPtr->lCon, curPtr - 1, LsysPtr) &&
+    if (!MatchDiff(prodPtr, &context, LsysPtr) &&
         !CondDiff(prodPtr, curPtr, LsysPtr)) {
       *totalprobPtr += prodPtr->prob = Eval(prodPtr->probExpression);
       *applSetPtr = prodPtr;
       ++applSetPtr;
     }
-    prodPtr = prodPtr->nextProduction;
+    prodPtr = NextCandidate(&context, prodPtr);
   }
   /*
   Terminate the sequence of applicable productions by NULL.
@@ -138,6 +138,7 @@ struct EToken_s {
   char *tokenString;          /* The token string for debuggery */
   struct EToken_s *nextParam; /* next parameter on the same level */
   struct EToken_s *up;        /* up one level (function symbol) */
+  struct ECode_s *code;       /* compiled expression starting here */
 };
 
 typedef struct EToken_s EToken;
@@ -235,6 +236,12 @@ struct Production_s {
   SymbolInstance *instance; /* instance for symbol table values */
 #endif
   Symbol *symbolTable; /* list of symbols */
+  /* numbers of modules matched against the context collected once per
+     position (see PrepareMatching), -1 if matched by PredDiff, RconDiff
+     or LconDiff */
+  int predModules;
+  int rconModules;
+  int lconModules;
   struct Production_s *nextProduction;
 };
 
@@ -284,6 +291,8 @@ struct LSYSDATA_s {
   int ring;                   /* Is the L-system a ring or string? */
   Production *firstProd[128]; /* a lookup table to find the first
                       possibly applicable production in the set */
+  struct MatchFilter_s *matchFilter[128]; /* productions of firstProd that
+                      can be skipped without matching (see PrepareMatching) */
   struct LSYSDATA_s *nextLsystem;
   char *name;       /* identifying name of the L-system */
   char ignore[128]; /* a lookup table of the characters to be
@@ -339,6 +348,7 @@ Parameter *BuildParameterList(Parameter *parameterList, EToken *expression,
 EToken *BuildExprList(EToken *fcToken, Parameter *param, int argcount);
 Statement *BuildStatementList(Statement *list1, Statement *list2);
 double Eval(EToken *expression);
+double EvalReference(EToken *expression);
 void EvaluateEndEach(LSYSDATA *lsysPtr);
 void EvaluateEndStatements(const LSYSDATA *lsysPtr);
 void EvaluateStartEach(LSYSDATA *lsysPtr);
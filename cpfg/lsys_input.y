@@ -446,6 +446,7 @@ Label : tLSTART {bufferIndex = 0;} Characters tEOL
 			LsysPtr->ignore[i] = 0;
 			/* Set production pointer table */
 			LsysPtr->firstProd[i] = NULL;
+			LsysPtr->matchFilter[i] = NULL;
 		}
 
 		/* initialize token for constants */
@@ -1758,6 +1759,7 @@ static EToken *NewToken(void)
 	tokenPtr->tokenString = NULL;
 	tokenPtr->nextParam = NULL;
 	tokenPtr->up = NULL;
+	tokenPtr->code = NULL;
 	return tokenPtr;
 }
 
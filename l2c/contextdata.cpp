@@ -28,6 +28,10 @@
 
 extern FILE *fOut;
 
+// set when a production queries the new string
+// (InNewLeftContext/InNewRightContext)
+bool bNewContextQueries = false;
+
 void ContextData::Copy(const ContextData *pSrc) {
   _pCntxt = pSrc->_pCntxt;
   _pNewCntxt = pSrc->_pNewCntxt;
@@ -162,11 +166,13 @@ void GenerateInLeftContext(FormalModuleDtList *pContextModules) {
 }
 
 void GenerateInNewRightContext(const FormalModuleDtList *pContextModules) {
+  bNewContextQueries = true;
   fprintf(fOut, "( RNContextReset() && ");
   GenerateInContext(pContextModules);
 }
 
 void GenerateInNewLeftContext(FormalModuleDtList *pContextModules) {
+  bNewContextQueries = true;
   pContextModules->Reverse();
   fprintf(fOut, "( LNContextReset() && ");
   GenerateInContext(pContextModules);
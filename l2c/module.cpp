@@ -27,6 +27,7 @@ extern FILE *fOut;
 extern int ModuleCounter();
 extern bool bModulesOnly;
 extern int _considerGroupId;
+extern bool bNewContextQueries;
 
 ModuleTable moduleTable;
 
@@ -135,11 +136,27 @@ void ModuleDeclaration::BuildModuleParamsStructure() const {
           ModuleIdType(), _Ident, StructArrSize(ModuleParamsStructName()));
   fprintf(fOut, "struct %s { %s arr[__%s_ParamsStructSize]; };",
           ModuleParamsStructArrName(), ModuleIdType(), _Ident);
+  // parameters are accessed in place, so the padding
+  // must be enough to keep them aligned
+  fprintf(fOut,
+          "static_assert(sizeof(%s) %% alignof(%s) == 0, "
+          "\"parameters of module %s need stronger alignment "
+          "than %s\");",
+          MainAlignType(), ModuleParamsStructName(), _Ident, MainAlignType());
 }
 
 void ModuleDeclaration::DumpSize(FILE *fp) const {
   fprintf(fp, "{ \"%s\", ", _Ident);
-  fprintf(fp, "sizeof(%s) }", ModuleParamsStructArrName());
+  fprintf(fp, "sizeof(%s), ", ModuleParamsStructArrName());
+  // the parameters as laid out in the module: from the first
+  // one up to the trailing id, with the padding between them
+  if (0 == _Params.count)
+    fputs("0", fp);
+  else
+    fprintf(fp, "offsetof(%s, data.moduleId2) - offsetof(%s, data.%s)",
+            ModuleParamsStructName(), ModuleParamsStructName(),
+            ModuleParamName(0));
+  fputs(" }", fp);
 #ifdef GENERATE_COMMENTS
   fprintf(fp, "/* %s_id = %d */", _Ident, _id);
 #endif
@@ -208,64 +225,43 @@ void StartGenerateProduce(const char *idnt) {
   assert(NULL != fOut);
   assert(NULL == pMDecl);
   pMDecl = &(moduleTable.Find(idnt));
-#ifdef NO_MEMCOPY
-  fprintf(fOut,
-          "{ %s* p%sparams = "
-          "reinterpret_cast<%s*>(GetNextModuleSpot(sizeof(%s))); ",
-          pMDecl->ModuleParamsStructName(), idnt,
-          pMDecl->ModuleParamsStructName(), pMDecl->ModuleParamsStructName());
-  fprintf(fOut,
-          "p%sparams->idarr[0] = %s_id; "
-          "p%sparams->idarr[sizeof(%s)/sizeof(%s)-1] = %s_id; ",
-          idnt, idnt, idnt, pMDecl->ModuleParamsStructName(),
-          "__lc_ModuleIdType", idnt);
-#else
+  // the parameters are evaluated into a local structure
+  // and the spot in the successor storage is only taken
+  // when they are all known: an expression may produce
+  // modules itself and make the storage grow
+  fprintf(fOut, "{ __%s_ParamsStruct_ %sParams; ", idnt, idnt);
+  fprintf(fOut, "%sParams.data.moduleId = %s_id; ", idnt, idnt);
+  curprm = 0;
+}
+
+static void StoreProducedModule(const char *idnt) {
   fprintf(fOut,
-          "{"
           "__%s_ParamsStructArr_* p%sparams = "
           "reinterpret_cast<__%s_ParamsStructArr_*>(GetNextModuleSpot(sizeof(__"
           "%s_ParamsStructArr_)));",
           idnt, idnt, idnt, idnt);
-  fprintf(fOut, "__%s_ParamsStruct_ %sParams; %sParams.data.moduleId = %s_id; ",
+  fprintf(fOut, "memcpy(p%sparams, &%sParams, sizeof(__%s_ParamsStruct_));",
+          idnt, idnt, idnt);
+  fprintf(fOut,
+          "p%sparams->arr[0] = p%sparams->arr[__%s_ParamsStructSize-1] = %s_id;",
           idnt, idnt, idnt, idnt);
-#endif
-  curprm = 0;
 }
 
 void StartPropensity() {
   fputs("{ ", fOut);
   StartGenerateProduce("Propensity");
-#ifdef NO_MEMCOPY
-  fputs("pPropensityparams->data.Param0 = ", fOut);
-#else
   fputs("PropensityParams.data.Param0 = ", fOut);
-#endif
 }
 
 void StartGProduce() {
-#ifdef NO_MEMCOPY
   fputs("; ", fOut);
-#else
-  fputs("; memcpy(pPropensityparams, &PropensityParams, "
-        "sizeof(__Propensity_ParamsStruct_)); ",
-        fOut);
-#endif
-  fputs("pPropensityparams->arr[0] = "
-        "pPropensityparams->arr[__Propensity_ParamsStructSize-1] = "
-        "Propensity_id; }",
-        fOut);
+  StoreProducedModule("Propensity");
+  fputs("}", fOut);
   pMDecl = NULL;
 }
 
 void EndGenerateProduce() {
-#ifndef NO_MEMCOPY
-  fprintf(fOut, "memcpy(p%sparams, &%sParams, sizeof(__%s_ParamsStruct_));",
-          pMDecl->Ident(), pMDecl->Ident(), pMDecl->Ident());
-#endif
-  fprintf(
-      fOut,
-      "p%sparams->arr[0] = p%sparams->arr[__%s_ParamsStructSize-1] = %s_id;",
-      pMDecl->Ident(), pMDecl->Ident(), pMDecl->Ident(), pMDecl->Ident());
+  StoreProducedModule(pMDecl->Ident());
   fprintf(fOut, "} ");
   if (curprm != pMDecl->Params().count)
     l2cerror("Invalid number of parameters in module %s", pMDecl->Ident());
@@ -275,11 +271,7 @@ void EndGenerateProduce() {
 void ParameterCast() {
   if (pMDecl->Params().count > 0) {
     if (curprm < pMDecl->Params().count)
-#ifdef NO_MEMCOPY
-      fprintf(fOut, "p%sparams->data.Param%d = (", pMDecl->Ident(), curprm);
-#else
       fprintf(fOut, "%sParams.data.Param%d = (", pMDecl->Ident(), curprm);
-#endif
     else
       l2cerror("Too many parameters in module %s", pMDecl->Ident());
   }
@@ -583,6 +575,9 @@ void GenerateFixed() {
   if (!ringlsys)
     fputs("int RingLsystem() { return 0; }\n", fOut);
 
+  fprintf(fOut, "int NewContextQueries() { return %d; }\n",
+          bNewContextQueries ? 1 : 0);
+
   const int MaxGrp = groups.size() - 1;
   fprintf(fOut, "int NumOfTables() { return %d; }\n", MaxGrp + 1);
 
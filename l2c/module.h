@@ -57,14 +57,16 @@ public:
     return bf;
   }
 
+  // size in module ids, rounded up to a multiple of
+  // __lc_MainAlignType so that the next module is aligned
   const char *StructArrSize(const char *szStructName) const {
     const int BfSize = 512;
     static char bf[BfSize];
     sprintf(bf,
-            "sizeof(%s) %% sizeof(%s) == 0 ? "
-            "sizeof(%s) / sizeof(%s) : sizeof(%s) / sizeof(%s) + 1",
-            szStructName, ModuleIdType(), szStructName, ModuleIdType(),
-            szStructName, ModuleIdType());
+            "(sizeof(%s) + sizeof(%s) - 1) / sizeof(%s) * "
+            "(sizeof(%s) / sizeof(%s))",
+            szStructName, MainAlignType(), MainAlignType(), MainAlignType(),
+            ModuleIdType());
     return bf;
   }
 
@@ -85,6 +87,7 @@ private:
     return bf;
   }
   const char *ModuleIdType() const { return "__lc_ModuleIdType"; }
+  const char *MainAlignType() const { return "__lc_MainAlignType"; }
   const char *ModuleIdName() const { return "moduleId"; }
   void BuildGetModuleFuncPrototype() const;
   void BuildModuleParamsStructure() const;
@@ -55,6 +55,7 @@ RA_Connection::RA_Connection(void) {
   addr_length = 0;
   sock = -1;
   messagePipe = NULL;
+  streaming = false;
   keep_connection_open = false;
 }
 
@@ -271,12 +272,17 @@ int RA_Connection::Connect(const char *new_host_name, const int new_port_num,
   if (version_reply == 0)
     return 5;
   std::string ra_server_version = version_reply->data;
-  delete version_reply;
   std::string our_version = "protocol 4.3";
   if (ra_server_version != our_version) {
     fprintf(stderr, "raserver is talking in an old protocol.\n");
+    delete version_reply;
     return 5;
   }
+  // extensions of the protocol follow the version
+  long n = our_version.length() + 1;
+  streaming = version_reply->length > n &&
+              xstrcmp("stream", version_reply->data + n) == 0;
+  delete version_reply;
   // versions match...
   // send a LOGIN request to the server
   Message request;
@@ -67,6 +67,7 @@ public:
     char *                 login_name ;
     char *                 password ;
     MessagePipe *          messagePipe;
+    bool                   streaming ; // server can stream files
 
    // -- methods --
     // [Pascal] Should be private ?
@@ -89,7 +89,11 @@ enum RA_Message_Type
     raq( VERSION ),
     raq( GET_UUID ),         raq( LOOKUP_UUID ),    raq( RECONCILE_UUIDS ),
     raq( SEARCH_BEGIN ),     raq( SEARCH_CONTINUE ),raq( SEARCH_END ),
-    raq( FIX_OOFS )
+    raq( FIX_OOFS ),
+    // streamed file transfers, only used if the server lists "stream"
+    // after its version
+    raq( FETCH_STREAM ),     raq( PUT_STREAM ),     RA_STREAM_FRAME,
+    RA_STREAM_END
 };
 #undef raq
 
@@ -32,6 +32,112 @@
 #include "xmemory.h"
 #include "xstring.h"
 
+/******************************************************************************
+ *
+ * int fetch_stream( RA_Connection * connection,
+ *                   const char * remote_fname,
+ *                   const char * local_fname,
+ *                   FILE * fp)
+ *
+ *   - copies a remote file streamed by the server to the local file
+ *     local_fname, or to fp if local_fname is NULL, writing the data
+ *     as it arrives
+ *   - local_fname is only replaced, and fp only extended, once all of
+ *     the file arrived
+ *   - the connection must be open, and the server must stream files
+ *
+ *   - returns:  0 = success
+ *               1 = failure
+ *
+ */
+
+static int fetch_stream(RA_Connection *connection, const char *remote_fname,
+                        const char *local_fname, FILE *fp) {
+  Message request(RA_FETCH_STREAM_REQUEST, remote_fname,
+                  xstrlen(remote_fname) + 1);
+  if (connection->messagePipe->send_message(request)) {
+    RA::error_code = RA_FETCH_FAILED;
+    connection->Disconnect();
+    return 1;
+  }
+
+  // wait for the reply, 'y' followed by the 8 byte size of the file
+  Message *response =
+      connection->messagePipe->get_message(RA_FETCH_STREAM_RESPONSE);
+  if (response == NULL || response->length < 1 || response->data[0] != 'y') {
+    RA::error_code = RA_FETCH_FAILED;
+    delete response;
+    connection->Disconnect();
+    return 1;
+  }
+  if (response->length >= 9) {
+    long long size = 0;
+    for (int i = 8; i >= 1; i--)
+      size = size * 256 + (unsigned char)response->data[i];
+    debug_printf("RA::Fetch_file() receiving %lld bytes\n", size);
+  }
+  delete response;
+
+  // open the destination file (local file); the data is received
+  // even if it cannot be written, so that the connection stays usable.
+  // It is received into a temporary file next to local_fname (or the
+  // file it links to), which replaces it only once all of the data
+  // arrived, and into fp from the current position, which is truncated
+  // again on failure
+  int fd;
+  char *dest_fname = NULL, *tmp_fname = NULL;
+  off_t start = 0;
+  if (local_fname != NULL) {
+    dest_fname = realpath(local_fname, NULL);
+    if (dest_fname != NULL)
+      local_fname = dest_fname;
+    tmp_fname = dsprintf("%s.rafetch%ld", local_fname, (long)getpid());
+    unlink(tmp_fname);
+    fd = open(tmp_fname, O_WRONLY | O_CREAT | O_EXCL,
+              S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+    if (fd == -1)
+      perror("RA::Fetch_File:open()");
+  } else {
+    fflush(fp);
+    fd = fileno(fp);
+    start = lseek(fd, 0, SEEK_CUR);
+  }
+
+  int result = connection->messagePipe->receive_stream(RA_STREAM_FRAME,
+                                                       RA_STREAM_END, fd);
+  if (result == 3 && fd != -1)
+    perror("RA::Fetch_File:write()");
+  if (tmp_fname != NULL) {
+    if (fd != -1 && close(fd) == -1 && result == 0) {
+      perror("RA::Fetch_File:close()");
+      result = 3;
+    }
+    if (fd != -1 && result == 0 && rename(tmp_fname, local_fname) == -1) {
+      perror("RA::Fetch_File:rename()");
+      result = 3;
+    }
+    if (fd == -1 || result != 0)
+      unlink(tmp_fname);
+    xfree(tmp_fname);
+    free(dest_fname);
+  } else if (fd != -1 && result != 0 && start != -1) {
+    if (ftruncate(fd, start) == 0)
+      lseek(fd, start, SEEK_SET);
+  }
+
+  if (fd == -1 || result != 0) {
+    RA::error_code = RA_FETCH_FAILED;
+    connection->Disconnect();
+    return 1;
+  }
+
+  if (fp != NULL)
+    fseek(fp, 0, SEEK_SET);
+  connection->Disconnect();
+
+  return 0;
+}
+
 /******************************************************************************
  *
  * int Fetch_file( RA_Host * host,
@@ -65,6 +171,10 @@ int RA::Fetch_file(RA_Connection *connection, const char *remote_fname,
   if (connection->reconnect())
     return 1;
 
+  // stream the file, if the server can
+  if (connection->streaming)
+    return fetch_stream(connection, remote_fname, local_fname, NULL);
+
   // create a request message
 
   debug_printf("create a request message : %s \n", remote_fname);
@@ -194,6 +304,10 @@ int RA::Fetch_file(RA_Connection *connection, const char *remote_fname,
   if (connection->reconnect())
     return 1;
 
+  // stream the file, if the server can
+  if (connection->streaming)
+    return fetch_stream(connection, remote_fname, NULL, fp);
+
   // create a request message
   Message request;
   request.code = RA_FETCH_FILE_REQUEST;
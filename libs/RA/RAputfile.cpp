@@ -33,6 +33,82 @@
 #include "xmemory.h"
 #include "xstring.h"
 
+/******************************************************************************
+ *
+ * int put_stream( const char * src_fname,
+ *                 RA_Connection * connection,
+ *                 const char * dst_fname);
+ *
+ * - streams a local file 'src_fname' to the server into 'dst_fname',
+ *   without reading all of it into memory
+ * - the connection must be open, and the server must stream files
+ *
+ * - returns the same as RA::Put_file()
+ *
+ */
+
+static int put_stream(const char *src_fname, RA_Connection *connection,
+                      const char *dst_fname) {
+  int fd = open(src_fname, O_RDONLY);
+  if (fd == -1) {
+    RA::error_code = RA_OPEN_FAILED;
+    connection->Disconnect();
+    return 1;
+  }
+
+  Message request(RA_PUT_STREAM_REQUEST, dst_fname, xstrlen(dst_fname) + 1);
+  if (connection->messagePipe->send_message(request)) {
+    close(fd);
+    RA::error_code = RA_SOCKET_ERROR;
+    connection->Disconnect();
+    return 2;
+  }
+
+  // the server first tells whether it could open the destination file
+  Message *response =
+      connection->messagePipe->get_message(RA_PUT_STREAM_RESPONSE);
+  if (response == NULL) {
+    close(fd);
+    RA::error_code = RA_SERVER_ERROR;
+    connection->Disconnect();
+    return 3;
+  }
+  if (response->data[0] == 'n') {
+    close(fd);
+    delete response;
+    connection->Disconnect();
+    return 1;
+  }
+  delete response;
+
+  // send the file
+  if (connection->messagePipe->send_stream(RA_STREAM_FRAME, RA_STREAM_END,
+                                           fd)) {
+    close(fd);
+    RA::error_code = RA_SOCKET_ERROR;
+    connection->Disconnect();
+    return 2;
+  }
+  close(fd);
+
+  // and then whether it wrote all of it
+  response = connection->messagePipe->get_message(RA_PUT_STREAM_RESPONSE);
+  if (response == NULL) {
+    RA::error_code = RA_SERVER_ERROR;
+    connection->Disconnect();
+    return 3;
+  }
+
+  int result = 0;
+  if (response->data[0] == 'n')
+    result = 1;
+
+  delete response;
+  connection->Disconnect();
+
+  return result;
+}
+
 /******************************************************************************
  *
  * int RA::Put_file( const char * src_fname,
@@ -64,6 +140,10 @@ int RA::Put_file(const char *src_fname, RA_Connection *connection,
   if (connection->reconnect())
     return -5;
 
+  // stream the file, if the server can
+  if (connection->streaming)
+    return put_stream(src_fname, connection, dst_fname);
+
   Message request;
   request.code = RA_PUTFILE_REQUEST;
   // read the file into message data
@@ -7,3 +7,19 @@ MY_BASE  = ../..
 MY_LIBS  = 
 include( $${MY_BASE}/common.pri )
 
+
+# 'make check' builds and runs the socket and the ring buffer tests
+unix {
+  TEST_SOURCES = $$PWD/communication.c $$PWD/comm_master.c \
+                 $$PWD/comm_slave.c $$PWD/compression.c $$PWD/message.c
+  TEST_DEFINES = -DVLAB_LINUX
+  macx:TEST_DEFINES = -DVLAB_MACX
+
+  check.target = check
+  check.commands = \
+    $$QMAKE_CC $$TEST_DEFINES -o test $$PWD/test.c $$TEST_SOURCES && \
+    $$QMAKE_CC $$TEST_DEFINES -o ringtest $$PWD/ringtest.c $$TEST_SOURCES && \
+    ./test && ./ringtest
+
+  QMAKE_EXTRA_TARGETS += check
+}
@@ -89,6 +89,8 @@ int  CMTerminate(void);
 void CSInitialize(int *argc, char ***argv);
 int  CSBeginTransmission(void);
 void CSMainLoop(int (*AnswerQuery)(Cmodule_type *, CTURTLE *));
+void CSMainLoopBatch(void (*AnswerQueries)(int, Cmodule_type *, CTURTLE *,
+                                           char *));
 int  CSEndTransmission(void);
 void CSTerminate(void);
 
@@ -108,6 +108,8 @@ void CMFreeStructures(void) {
       env_field[index].formats.scale_factor = NULL;
     }
 
+    FreeBinaryFrames(env_field + index);
+
     ReleaseSharedMemory(env_field + index);
 
     /* release semaphores */
@@ -562,6 +564,8 @@ int CMInitialize(void) {
 #endif
       env_field[i].shmid = -1;
       env_field[i].shmadd = NULL;
+      env_field[i].ring = NULL;
+      env_field[i].spill = NULL;
       env_field[i].in_fp = NULL;
       env_field[i].out_fp = NULL;
       env_field[i].formats.position = NULL;
@@ -570,6 +574,10 @@ int CMInitialize(void) {
       env_field[i].formats.up = NULL;
       env_field[i].formats.line_width = NULL;
       env_field[i].formats.scale_factor = NULL;
+      env_field[i].frame = NULL;
+      env_field[i].in_frame_buf = NULL;
+      env_field[i].answers = NULL;
+      FreeBinaryFrames(env_field + i);
     }
   } else
     CMFreeStructures();
@@ -813,6 +821,79 @@ int CMSendBinaryData(int index, char *item, int item_size, int nitems) {
   return ret;
 }
 
+/****************************************************************************/
+/* returns 0 when OK */
+static int SendBinaryRecord(int index, int type, char *record, int length) {
+  /* test whether enough room first */
+  if (SaveBinaryRecord(env_field + index, type, record, length, 1) == 0) {
+    /* send the chunk */
+    env_field[index].out_flag &= ~LAST_CHUNK; /* reset LAST_CHUNK */
+    if (!EndTransmission(index, 0))
+      Message("%s - cannot end transmission for the chunk. "
+              "expect trouble.\n",
+              process_name);
+
+    if (!BeginTransmission(index))
+      Message("%s - cannot begin transmission for the next chunk. "
+              "expect trouble.\n",
+              process_name);
+
+    env_field[index].out_flag &= ~FIRST_CHUNK; /* reset FIRST_CHUNK */
+
+    SaveBinaryRecord(env_field + index, type, record, length, 1);
+    env_field[index].out_num++;
+  }
+
+  return 0;
+}
+
+/****************************************************************************/
+/* The query as a binary record. Graphics of the following module
+   is never required (see BinaryQueriesAllowed). */
+static int SaveBinaryQuery(int index, unsigned long distance,
+                           Cmodule_type *two_modules, CTURTLE *turtle) {
+  char record[MAX_RECORD_LENGTH];
+  char *ptr, *mask;
+  turtle_format_type *formats = &env_field[index].formats;
+
+  ptr = PutBinaryInt(record, distance);
+  ptr = PutBinaryModule(ptr, two_modules, 1);
+  if (env_field[index].following_module)
+    ptr = PutBinaryModule(ptr, two_modules + 1, 1);
+
+  /* turtle parameters given in the environment file */
+  mask = ptr++;
+  *mask = 0;
+  if (formats->position != NULL) {
+    *mask |= TURTLE_POSITION;
+    ptr = PutBinaryFloats(ptr, turtle->position, 3);
+  }
+  if (formats->heading != NULL) {
+    *mask |= TURTLE_HEADING;
+    ptr = PutBinaryFloats(ptr, turtle->heading, 3);
+  }
+  if (formats->left != NULL) {
+    *mask |= TURTLE_LEFT;
+    ptr = PutBinaryFloats(ptr, turtle->left, 3);
+  }
+  if (formats->up != NULL) {
+    *mask |= TURTLE_UP;
+    ptr = PutBinaryFloats(ptr, turtle->up, 3);
+  }
+  if (formats->line_width != NULL) {
+    *mask |= TURTLE_LINE_WIDTH;
+    ptr = PutBinaryFloats(ptr, &turtle->line_width, 1);
+  }
+  if (formats->scale_factor != NULL) {
+    *mask |= TURTLE_SCALE_FACTOR;
+    ptr = PutBinaryFloats(ptr, &turtle->scale_factor, 1);
+  }
+
+  SendBinaryRecord(index, RECORD_QUERY, record, (int)(ptr - record));
+
+  return 0;
+}
+
 /****************************************************************************/
 /* string - pointer to the original string
    distance - distance from the string beginning
@@ -829,6 +910,9 @@ int SaveCommunicationItem(int index, unsigned long distance,
   if (two_modules == NULL)
     return 0;
 
+  if (env_field[index].binary_queries)
+    return SaveBinaryQuery(index, distance, two_modules, turtle);
+
   if (env_field[index].data_out) {
     env_field[index].data_out = 0;
 
@@ -921,12 +1005,55 @@ int SaveCommunicationItem(int index, unsigned long distance,
   return env_field[index].data_out;
 }
 
+/****************************************************************************/
+/* returns 0 at the end of the frame */
+static int LoadBinaryReply(int index, unsigned long *dist,
+                           Cmodule_type *comm_module) {
+  Cmodule_type module;
+  unsigned long flag;
+  char *record;
+  int type, length, i;
+
+  while ((record = LoadBinaryRecord(env_field + index, &type, &length)) !=
+         NULL)
+    switch (type) {
+    case RECORD_REPLY:
+      if (length < 4 || GetBinaryModule(GetBinaryInt(record, dist),
+                                        record + length, &module) == NULL) {
+        Message("%s - invalid module received from the environment.\n",
+                process_name);
+        return 0;
+      }
+
+      if (env_field[index].verbose)
+        Message("%s - received module from slave: %lu\n", process_name,
+                *dist);
+
+      for (i = 0; i < module.num_params; i++)
+        comm_module->params[i] = module.params[i];
+      comm_module->num_params = module.num_params;
+      return 1;
+
+    case RECORD_CONTROL:
+      if (length < 4)
+        return 0;
+      GetBinaryInt(record, &flag);
+      env_field[index].in_flag = (int)flag;
+      return 0;
+    }
+
+  return 0;
+}
+
 /****************************************************************************/
 static int LoadCommunicationItem(int index, unsigned long *dist,
                                  Cmodule_type *comm_module) {
   char *str, *ptr, *end, *token;
   int num;
 
+  if (LoadBinaryFrame(env_field + index))
+    return LoadBinaryReply(index, dist, comm_module);
+
   /* get the distance from the begining of the string */
   if ((token = LoadOneToken(env_field + index, " ,;:\n")) == NULL)
     return 0;
@@ -1025,10 +1152,18 @@ static int LetSlaveRunAndWait(int index) {
     semop(env_field[index].semid, &sops, 1);
 #endif
     /* waiting for some input from the field process */
+
+#ifndef WIN32
+    /* the slave has found the ring buffers and switched to them */
+    if (env_field[index].ring != NULL &&
+        __atomic_load_n(&env_field[index].ring->attached, __ATOMIC_SEQ_CST))
+      env_field[index].ring_ready = 1;
+#endif
     break;
 
   case COMM_PIPES:
   case COMM_SOCKETS:
+  case COMM_RING:
     /* nothing */
     break;
   }
@@ -1037,6 +1172,20 @@ static int LetSlaveRunAndWait(int index) {
   return 1;
 }
 
+/****************************************************************************/
+/* called before a new transmission (not a chunk) - the slave switches at
+   the end of the previous one */
+static void SwitchToRing(int index) {
+  if (env_field[index].comm_type != COMM_MEMORY ||
+      !env_field[index].ring_ready)
+    return;
+
+  env_field[index].comm_type = COMM_RING;
+
+  if (env_field[index].verbose)
+    Message("%s - switching to ring buffers.\n", process_name);
+}
+
 
 /****************************************************************************/
 /* returns 0 when no more modules from the slave - at present */
@@ -1187,6 +1336,7 @@ static int BeginTransmission(int index) {
 
   env_field[index].out_num = 0;
   env_field[index].out_flag = FIRST_CHUNK | LAST_CHUNK;
+  env_field[index].frame_length = 0;
 
   if (env_field[index].verbose)
     Message("%s - begin transmission (index %d).\n", process_name, index);
@@ -1207,6 +1357,7 @@ static int BeginTransmission(int index) {
 
   case COMM_PIPES:
   case COMM_SOCKETS:
+  case COMM_RING:
     /* nothing */
     break;
   }
@@ -1218,8 +1369,10 @@ static int BeginTransmission(int index) {
 int CMBeginTransmission(void) {
   int index;
 
-  for (index = 0; index < num_fields; index++)
+  for (index = 0; index < num_fields; index++) {
+    SwitchToRing(index);
     BeginTransmission(index);
+  }
 
   return 1;
 }
@@ -1230,6 +1383,7 @@ static int BeginTransmissionIn(int index) {
     return 1;
 
   env_field[index].in_num = 0;
+  env_field[index].in_binary = 0;
 
   if (env_field[index].verbose)
     Message("%s - setting counter of modules from slave to 0.\n", process_name);
@@ -1258,25 +1412,35 @@ static int EndTransmissionIn(int index) {
 /****************************************************************************/
 static int EndTransmission(int index, int current_step) {
   char buff[40], item[50];
+  char *ptr;
 
   if ((index < 0) || (index >= num_fields))
     return 0;
   if (env_field[index].specified == 0)
     return 0;
 
-  if (env_field[index].data_out) {
-    env_field[index].data_out = 0;
-
-    strcpy(item, DATA_END);
-    strcat(item, "\n");
-  } else
-    item[0] = '\0';
-
-  /* send the data */
-  sprintf(buff, "%sControl: %d %d\n", item, env_field[index].out_flag,
-          current_step);
-
-  SaveOneItem(env_field + index, buff, 0);
+  if (env_field[index].binary_queries) {
+    /* the control record ends the frame */
+    ptr = PutBinaryInt(buff, env_field[index].out_flag);
+    ptr = PutBinaryInt(ptr, current_step);
+    SaveBinaryRecord(env_field + index, RECORD_CONTROL, buff,
+                     (int)(ptr - buff), 0);
+    SaveBinaryFrame(env_field + index);
+  } else {
+    if (env_field[index].data_out) {
+      env_field[index].data_out = 0;
+
+      strcpy(item, DATA_END);
+      strcat(item, "\n");
+    } else
+      item[0] = '\0';
+
+    /* send the data */
+    sprintf(buff, "%sControl: %d %d\n", item, env_field[index].out_flag,
+            current_step);
+
+    SaveOneItem(env_field + index, buff, 0);
+  }
 
   if (env_field[index].verbose)
     Message("%s - end transmission (index %d).\n", process_name, index);
@@ -1320,6 +1484,8 @@ static int Terminate(int index) {
   env_field[index].out_num = 0;
   env_field[index].out_flag = PROCESS_EXIT;
 
+  SwitchToRing(index);
+
   switch (env_field[index].comm_type) {
   case COMM_MEMORY:
     env_field[index].shstringend = 0;
@@ -1337,6 +1503,7 @@ static int Terminate(int index) {
 
   case COMM_PIPES:
   case COMM_SOCKETS:
+  case COMM_RING:
     /* nothing */
     break;
   }
@@ -1354,6 +1521,10 @@ static int Terminate(int index) {
     /* wait for the response - environment sends a character */
     fread(&c, 1, 1, env_field[index].in_fp);
     break;
+
+  case COMM_RING:
+    RingRead(env_field + index, &c, 1);
+    break;
   }
 
   return 1;
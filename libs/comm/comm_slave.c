@@ -52,6 +52,7 @@ static void CSFreeStructures(void) {
       env_field[index].host = NULL;
     }
 
+    FreeBinaryFrames(env_field + index);
     ReleaseSharedMemory(env_field + index);
 
     env_field[index].specified = 0;
@@ -78,6 +79,8 @@ int CSInitializeStructures(void) {
 #endif
       env_field[i].shmid = -1;
       env_field[i].shmadd = NULL;
+      env_field[i].ring = NULL;
+      env_field[i].spill = NULL;
       env_field[i].in_fp = NULL;
       env_field[i].out_fp = NULL;
       env_field[i].formats.position = NULL;
@@ -86,6 +89,10 @@ int CSInitializeStructures(void) {
       env_field[i].formats.up = NULL;
       env_field[i].formats.line_width = NULL;
       env_field[i].formats.scale_factor = NULL;
+      env_field[i].frame = NULL;
+      env_field[i].in_frame_buf = NULL;
+      env_field[i].answers = NULL;
+      FreeBinaryFrames(env_field + i);
     }
   } else
     CSFreeStructures();
@@ -270,6 +277,9 @@ static int BeginTransmissionIn(int index) {
     return 1;
 
   env_field[index].in_num = 0;
+  env_field[index].in_binary = 0;
+  env_field[index].batch = NULL;
+  env_field[index].batch_answers = 0;
   return 1;
 }
 
@@ -302,6 +312,7 @@ static int BeginTransmissionOut(int index) {
 
   env_field[index].out_flag = FIRST_CHUNK | LAST_CHUNK;
   env_field[index].out_num = 0;
+  env_field[index].frame_length = 0;
 
   switch (env_field[index].comm_type) {
   case COMM_MEMORY:
@@ -351,26 +362,77 @@ static int EndTransmissionIn(int index) {
   return 1;
 }
 
+/****************************************************************************/
+/* the replies to batch records as arrays in one record, written straight
+   into the frame */
+static void SaveAnswers(int index) {
+  field_type *field = env_field + index;
+  char *ptr, *distances, *counts, *values, *answer;
+  int i, n;
+
+  if (field->answers_count == 0)
+    return;
+
+  if ((ptr = ReserveBinaryRecord(field, RECORD_ANSWERS,
+                                 4 + field->answers_length)) != NULL) {
+    ptr = PutBinaryInt(ptr, field->answers_count);
+    distances = ptr;
+    counts = distances + 4 * field->answers_count;
+    values = counts + field->answers_count;
+
+    /* answers are stored as distance, count and parameters */
+    answer = field->answers;
+    for (i = 0; i < field->answers_count; i++) {
+      memcpy(distances + 4 * i, answer, 4);
+      counts[i] = answer[4];
+      n = (unsigned char)answer[4];
+      memcpy(values, answer + 5, 4 * n);
+      values += 4 * n;
+      answer += 5 + 4 * n;
+    }
+  }
+
+  field->answers_count = field->answers_length = 0;
+}
+
 /****************************************************************************/
 static int EndTransmissionOut(int index) {
 #ifndef WIN32
   struct sembuf sops;
 #endif
   char buff[1048], item[50];
+  char *ptr;
 
   if (env_field[index].specified == 0)
     return 0;
 
-  if (env_field[index].data_out) {
-    env_field[index].data_out = 0;
-
-    strcpy(item, DATA_END);
-    strcat(item, "\n");
-  } else
-    item[0] = '\0';
-
-  sprintf(buff, "%sControl: %d\n", item, env_field[index].out_flag);
-  SaveOneItem(env_field + index, buff, 0);
+  if (env_field[index].binary_queries) {
+    SaveAnswers(index);
+
+    /* the control record ends the frame */
+    ptr = PutBinaryInt(buff, env_field[index].out_flag);
+    ptr = PutBinaryInt(ptr, 0);
+    SaveBinaryRecord(env_field + index, RECORD_CONTROL, buff,
+                     (int)(ptr - buff), 0);
+    SaveBinaryFrame(env_field + index);
+  } else {
+    if (env_field[index].data_out) {
+      env_field[index].data_out = 0;
+
+      strcpy(item, DATA_END);
+      strcat(item, "\n");
+    } else
+      item[0] = '\0';
+
+    if (BinaryQueriesAllowed(env_field + index))
+      /* tell the master that binary frames and batch records are
+         understood */
+      sprintf(buff, "%sControl: %d %d\n", item, env_field[index].out_flag,
+              BATCH_PROTOCOL);
+    else
+      sprintf(buff, "%sControl: %d\n", item, env_field[index].out_flag);
+    SaveOneItem(env_field + index, buff, 0);
+  }
 
   switch (env_field[index].comm_type) {
   case COMM_FILES:
@@ -421,6 +483,16 @@ int CSEndTransmission(void) {
     EndTransmissionIn(index);
     EndTransmissionOut(index);
 
+    /* the master switches to the ring buffers before its next
+       transmission */
+    if (env_field[index].comm_type == COMM_MEMORY &&
+        env_field[index].ring != NULL) {
+      env_field[index].comm_type = COMM_RING;
+
+      if (env_field[index].verbose)
+        Message("%s - switching to ring buffers.\n", process_name);
+    }
+
     if ((env_field[index].in_flag & PROCESS_EXIT) == 0)
       exit = 0; /* only if all masters send exit, it dies */
   }
@@ -429,19 +501,11 @@ int CSEndTransmission(void) {
 }
 
 /****************************************************************************/
-/* returns 0 when Control line not encountered, 1 when there is more data
-   on the input for the same master (2 for the next master), and 3 when the
-   input has finished.
+/* returns 1 when there is more data on the input for the same master
+   (2 for the next master), and 3 when the input has finished.
    */
-int GetControlStatus(char *token, int *index) {
-  int current_step;
-
-  if (strncmp(token, "Control", 7) != 0)
-    return 0;
-
-  current_step = 0;
-  sscanf(token + 8, "%d %d", &env_field[*index].in_flag, &current_step);
-
+static int ControlStatus(int flag, int current_step, int *index) {
+  env_field[*index].in_flag = flag;
   env_field[*index].current_step = current_step;
 
   if ((env_field[*index].in_flag & (LAST_CHUNK | PROCESS_EXIT)) != 0) {
@@ -470,6 +534,23 @@ int GetControlStatus(char *token, int *index) {
   return 1;
 }
 
+/****************************************************************************/
+/* returns 0 when Control line not encountered, otherwise the same as
+   ControlStatus.
+   */
+int GetControlStatus(char *token, int *index) {
+  int flag, current_step;
+
+  if (strncmp(token, "Control", 7) != 0)
+    return 0;
+
+  flag = env_field[*index].in_flag;
+  current_step = 0;
+  sscanf(token + 8, "%d %d", &flag, &current_step);
+
+  return ControlStatus(flag, current_step, index);
+}
+
 /****************************************************************************/
 /* returns 0 when DATA_END encountered or data are not expected. */
 int CSGetString(int *master, char *str, int length) {
@@ -599,15 +680,221 @@ int CSSendBinaryData(int index, char *item, int item_size, int nitems) {
   return ret;
 }
 
+/****************************************************************************/
+/* returns 0 if the query is not valid or does not fit in the record */
+static int GetBinaryQuery(int index, char *record, int length,
+                          unsigned long *distance, Cmodule_type *two_modules,
+                          CTURTLE *turtle) {
+  turtle_format_type *formats = &env_field[index].formats;
+  char *ptr, *end = record + length;
+  int mask, i, size;
+
+  if (length < 4)
+    return 0;
+  ptr = GetBinaryInt(record, distance);
+  if ((ptr = GetBinaryModule(ptr, end, &two_modules[0])) == NULL)
+    return 0;
+  if (env_field[index].following_module) {
+    if ((ptr = GetBinaryModule(ptr, end, &two_modules[1])) == NULL)
+      return 0;
+  } else
+    two_modules[1].symbol[0] = 0;
+
+  /* all parameters of the query are set */
+  for (i = 0; i < two_modules[0].num_params; i++)
+    two_modules[0].params[i].set = 1;
+
+  if (ptr >= end)
+    return 0;
+  mask = (unsigned char)*(ptr++);
+  size = 0;
+  if (mask & TURTLE_POSITION)
+    size += 12;
+  if (mask & TURTLE_HEADING)
+    size += 12;
+  if (mask & TURTLE_LEFT)
+    size += 12;
+  if (mask & TURTLE_UP)
+    size += 12;
+  if (mask & TURTLE_LINE_WIDTH)
+    size += 4;
+  if (mask & TURTLE_SCALE_FACTOR)
+    size += 4;
+  if (end - ptr < size)
+    return 0;
+  if (mask & TURTLE_POSITION)
+    ptr = GetBinaryFloats(ptr, turtle->position, 3);
+  if (mask & TURTLE_HEADING)
+    ptr = GetBinaryFloats(ptr, turtle->heading, 3);
+  if (mask & TURTLE_LEFT)
+    ptr = GetBinaryFloats(ptr, turtle->left, 3);
+  if (mask & TURTLE_UP)
+    ptr = GetBinaryFloats(ptr, turtle->up, 3);
+  if (mask & TURTLE_LINE_WIDTH)
+    ptr = GetBinaryFloats(ptr, &turtle->line_width, 1);
+  if (mask & TURTLE_SCALE_FACTOR)
+    ptr = GetBinaryFloats(ptr, &turtle->scale_factor, 1);
+
+  turtle->positionC = formats->positionC;
+  turtle->headingC = formats->headingC;
+  turtle->leftC = formats->leftC;
+  turtle->upC = formats->upC;
+  turtle->line_widthC = formats->line_widthC;
+  turtle->scale_factorC = formats->scale_factorC;
+
+  return 1;
+}
+
+/****************************************************************************/
+/* Sets up reading of a batch record. Returns 0 if the record is not
+   valid. */
+static int LoadBatchRecord(int index, char *record, int length) {
+  field_type *field = env_field + index;
+  char *ptr, *end = record + length;
+  unsigned long count;
+  long params = 0, following = 0, size;
+  int mask, i;
+
+  if (length < 5)
+    return 0;
+  ptr = GetBinaryInt(record, &count);
+  mask = (unsigned char)*(ptr++);
+
+  /* distances and numbers of parameters */
+  if (count > (unsigned long)(end - ptr) / 5)
+    return 0;
+  field->batch_distances = ptr;
+  field->batch_counts = ptr + 4 * count;
+  ptr = field->batch_counts + count;
+  for (i = 0; i < (int)count; i++)
+    if ((unsigned char)field->batch_counts[i] > CMAXPARAMS)
+      return 0;
+    else
+      params += (unsigned char)field->batch_counts[i];
+
+  if (mask & TURTLE_FOLLOWING) {
+    if (count > (unsigned long)(end - ptr) / (CMAXSYMBOLLEN + 1))
+      return 0;
+    field->batch_symbols = ptr;
+    field->batch_following = ptr + CMAXSYMBOLLEN * count;
+    ptr = field->batch_following + count;
+    for (i = 0; i < (int)count; i++)
+      if ((unsigned char)field->batch_following[i] > CMAXPARAMS)
+        return 0;
+      else
+        following += (unsigned char)field->batch_following[i];
+  }
+
+  size = 4 * (params + following);
+  if (mask & TURTLE_POSITION)
+    size += 12 * count;
+  if (mask & TURTLE_HEADING)
+    size += 12 * count;
+  if (mask & TURTLE_LEFT)
+    size += 12 * count;
+  if (mask & TURTLE_UP)
+    size += 12 * count;
+  if (mask & TURTLE_LINE_WIDTH)
+    size += 4 * count;
+  if (mask & TURTLE_SCALE_FACTOR)
+    size += 4 * count;
+  if (end - ptr < size)
+    return 0;
+
+  field->batch_params = ptr;
+  field->batch_following_params = ptr + 4 * params;
+  field->batch_turtle = field->batch_following_params + 4 * following;
+  field->batch_count = (int)count;
+  field->batch_next = 0;
+  field->batch_mask = mask;
+  field->batch = record;
+
+  return 1;
+}
+
+/****************************************************************************/
+/* the next query of the batch record, returns 0 at its end */
+static int GetBatchQuery(int index, unsigned long *distance,
+                         Cmodule_type *two_modules, CTURTLE *turtle) {
+  field_type *field = env_field + index;
+  turtle_format_type *formats = &field->formats;
+  int i, j, count = field->batch_count;
+  char *ptr;
+
+  if ((i = field->batch_next) >= count)
+    return 0;
+  field->batch_next++;
+
+  GetBinaryInt(field->batch_distances + 4 * i, distance);
+
+  strcpy(two_modules[0].symbol, "E");
+  two_modules[0].num_params = (unsigned char)field->batch_counts[i];
+  for (j = 0; j < two_modules[0].num_params; j++) {
+    field->batch_params = GetBinaryFloats(
+        field->batch_params, &two_modules[0].params[j].value, 1);
+    two_modules[0].params[j].set = 1;
+  }
+
+  two_modules[1].symbol[0] = 0;
+  two_modules[1].num_params = 0;
+  if (field->batch_mask & TURTLE_FOLLOWING) {
+    memcpy(two_modules[1].symbol, field->batch_symbols + CMAXSYMBOLLEN * i,
+           CMAXSYMBOLLEN);
+    two_modules[1].symbol[CMAXSYMBOLLEN] = 0;
+    two_modules[1].num_params = (unsigned char)field->batch_following[i];
+    for (j = 0; j < two_modules[1].num_params; j++) {
+      field->batch_following_params =
+          GetBinaryFloats(field->batch_following_params,
+                          &two_modules[1].params[j].value, 1);
+      two_modules[1].params[j].set = 1;
+    }
+  }
+
+  /* the turtle parameters are in arrays of the same kind */
+  ptr = field->batch_turtle;
+  if (field->batch_mask & TURTLE_POSITION) {
+    GetBinaryFloats(ptr + 12 * i, turtle->position, 3);
+    ptr += 12 * count;
+  }
+  if (field->batch_mask & TURTLE_HEADING) {
+    GetBinaryFloats(ptr + 12 * i, turtle->heading, 3);
+    ptr += 12 * count;
+  }
+  if (field->batch_mask & TURTLE_LEFT) {
+    GetBinaryFloats(ptr + 12 * i, turtle->left, 3);
+    ptr += 12 * count;
+  }
+  if (field->batch_mask & TURTLE_UP) {
+    GetBinaryFloats(ptr + 12 * i, turtle->up, 3);
+    ptr += 12 * count;
+  }
+  if (field->batch_mask & TURTLE_LINE_WIDTH) {
+    GetBinaryFloats(ptr + 4 * i, &turtle->line_width, 1);
+    ptr += 4 * count;
+  }
+  if (field->batch_mask & TURTLE_SCALE_FACTOR)
+    GetBinaryFloats(ptr + 4 * i, &turtle->scale_factor, 1);
+
+  turtle->positionC = formats->positionC;
+  turtle->headingC = formats->headingC;
+  turtle->leftC = formats->leftC;
+  turtle->upC = formats->upC;
+  turtle->line_widthC = formats->line_widthC;
+  turtle->scale_factorC = formats->scale_factorC;
+
+  return 1;
+}
+
 /****************************************************************************/
 /* returns 0 if no data avaliable */
 
 int CSGetData(int *master, unsigned long *distance, Cmodule_type *two_modules,
               CTURTLE *turtle) {
   int i, c;
-  char *ptr, *token;
+  char *ptr, *token, *record;
   unsigned char flags;
-  int index;
+  int index, type, length;
+  unsigned long flag, step;
 
   index = current_index;
 
@@ -635,15 +922,67 @@ int CSGetData(int *master, unsigned long *distance, Cmodule_type *two_modules,
   }
 
   for (;;) {
-    if ((token = LoadOneToken(env_field + index, "\n")) == NULL)
-      return 0;
+    if (env_field[index].batch != NULL) {
+      if (GetBatchQuery(index, distance, two_modules, turtle)) {
+        *master = index;
+        return 1;
+      }
+      env_field[index].batch = NULL;
+    }
 
-    if (env_field[index].verbose)
-      Message("%s - received token from master: %s\n", process_name, token);
+    if (LoadBinaryFrame(env_field + index)) {
+      if ((record = LoadBinaryRecord(env_field + index, &type, &length)) ==
+          NULL) {
+        if (env_field[index].comm_type != COMM_RING)
+          return 0;
+        /* a master streaming through the ring sends a long transmission
+           in several frames, only the last one ends with the control
+           record */
+        env_field[index].in_binary = 0;
+        env_field[index].in_num = 0;
+        continue;
+      }
 
-    if ((c = GetControlStatus(token, &index)) == 0)
-      /* control line not encountered */
-      break;
+      if (type == RECORD_QUERY) {
+        if (!GetBinaryQuery(index, record, length, distance, two_modules,
+                            turtle)) {
+          Message("%s - invalid query received from master!\n",
+                  process_name);
+          return 0;
+        }
+        *master = index;
+        return 1;
+      }
+
+      if (type == RECORD_BATCH) {
+        if (!LoadBatchRecord(index, record, length)) {
+          Message("%s - invalid batch of queries received from master!\n",
+                  process_name);
+          return 0;
+        }
+        /* the replies are sent as a batch as well */
+        env_field[index].batch_answers = 1;
+        continue;
+      }
+
+      if (type != RECORD_CONTROL || length < 8)
+        continue;
+
+      ptr = GetBinaryInt(record, &flag);
+      GetBinaryInt(ptr, &step);
+      c = ControlStatus((int)flag, (int)step, &index);
+    } else {
+      if ((token = LoadOneToken(env_field + index, "\n")) == NULL)
+        return 0;
+
+      if (env_field[index].verbose)
+        Message("%s - received token from master: %s\n", process_name,
+                token);
+
+      if ((c = GetControlStatus(token, &index)) == 0)
+        /* control line not encountered */
+        break;
+    }
 
     if (c == 3) {
       /* end of the last chunk from the last master */
@@ -760,11 +1099,58 @@ int CSGetData(int *master, unsigned long *distance, Cmodule_type *two_modules,
   return 1;
 }
 
+/****************************************************************************/
+/* adds the reply to the answers of the batch records */
+static void SaveAnswer(int index, unsigned long dist,
+                       Cmodule_type *comm_symbol) {
+  field_type *field = env_field + index;
+  int i, n = comm_symbol->num_params, length = 5 + 4 * n, size;
+  char *ptr;
+
+  /* the answers must fit in the chunk */
+  if (field->answers_count > 0 &&
+      !BinaryRecordFits(field, 4 + field->answers_length + length)) {
+    field->out_flag &= ~LAST_CHUNK; /* reset LAST_CHUNK */
+    EndTransmissionOut(index);
+
+    BeginTransmissionOut(index);
+    field->out_flag &= ~FIRST_CHUNK; /* reset FIRST_CHUNK */
+    field->out_num++;
+  }
+
+  if ((size = field->answers_length + length) > field->answers_size) {
+    if (size < 2 * field->answers_size)
+      size = 2 * field->answers_size;
+    if (size < 4096)
+      size = 4096;
+
+    if ((ptr = (char *)realloc(field->answers, size)) == NULL) {
+      Message("%s - cannot allocate memory for replies!\n", process_name);
+      return;
+    }
+    field->answers = ptr;
+    field->answers_size = size;
+  }
+
+  ptr = PutBinaryInt(field->answers + field->answers_length, dist);
+  *(ptr++) = (char)n;
+  for (i = 0; i < n; i++) {
+    /* parameters not set are read as 0 by the master, as in text */
+    if (!comm_symbol->params[i].set)
+      comm_symbol->params[i].value = 0;
+    ptr = PutBinaryFloats(ptr, &comm_symbol->params[i].value, 1);
+  }
+
+  field->answers_count++;
+  field->answers_length += length;
+}
+
 /****************************************************************************/
 void CSSendData(int index, unsigned long dist, Cmodule_type *comm_symbol) {
   int i;
   char buff[256];
   char item[5000];
+  char *ptr;
 
   if (env_field[index].specified == 0)
     return;
@@ -772,6 +1158,32 @@ void CSSendData(int index, unsigned long dist, Cmodule_type *comm_symbol) {
   if (comm_symbol->num_params > 0) {
     env_field[index].out_num++;
 
+    if (env_field[index].batch_answers) {
+      SaveAnswer(index, dist, comm_symbol);
+      return;
+    }
+
+    if (env_field[index].binary_queries) {
+      ptr = PutBinaryInt(item, dist);
+      ptr = PutBinaryModule(ptr, comm_symbol, 0);
+
+      /* save record */
+      if (SaveBinaryRecord(env_field + index, RECORD_REPLY, item,
+                           (int)(ptr - item), 1) == 0) {
+        /* not enough room, send the chunk */
+        env_field[index].out_flag &= ~LAST_CHUNK; /* reset LAST_CHUNK */
+        EndTransmissionOut(index);
+
+        BeginTransmissionOut(index);
+        env_field[index].out_flag &= ~FIRST_CHUNK; /* reset FIRST_CHUNK */
+
+        SaveBinaryRecord(env_field + index, RECORD_REPLY, item,
+                         (int)(ptr - item), 1);
+        env_field[index].out_num++;
+      }
+      return;
+    }
+
     sprintf(item, "%lu E(", dist);
 
     for (i = 0; i < comm_symbol->num_params;) {
@@ -817,6 +1229,11 @@ void CSTerminate(void) {
       fwrite(&c, 1, 1, env_field[index].out_fp);
       fflush(env_field[index].out_fp);
       break;
+
+    case COMM_RING:
+      c = 1;
+      RingWrite(env_field + index, &c, 1);
+      break;
     }
   }
 
@@ -845,6 +1262,75 @@ void CSMainLoop(int (*AnswerQuery)(Cmodule_type *, CTURTLE *)) {
   }
 }
 
+/****************************************************************************/
+/* Batched variant of CSMainLoop. All queries of a transmission are read
+   first and passed to AnswerQueries at once, so that the environment can
+   process them in one pass. two_modules contains the two modules of each
+   query (2*nqueries items) and turtles one turtle per query. AnswerQueries
+   sets answer[i] to nonzero if two_modules[2*i] should be sent back.
+   Not usable by programs exchanging strings or graphics data with the
+   master. */
+void CSMainLoopBatch(void (*AnswerQueries)(int nqueries,
+                                           Cmodule_type *two_modules,
+                                           CTURTLE *turtles, char *answer)) {
+  Cmodule_type *two_modules = NULL;
+  CTURTLE *turtles = NULL;
+  unsigned long *module_ids = NULL;
+  int *masters = NULL;
+  char *answer = NULL;
+  int size = 0, nqueries, i;
+
+  for (;;) {
+    CSBeginTransmission();
+
+    /* collect all the queries */
+    nqueries = 0;
+    for (;;) {
+      if (nqueries == size) {
+        size = (size == 0) ? 256 : 2 * size;
+        two_modules = (Cmodule_type *)realloc(
+            two_modules, 2 * size * sizeof(Cmodule_type));
+        turtles = (CTURTLE *)realloc(turtles, size * sizeof(CTURTLE));
+        module_ids = (unsigned long *)realloc(module_ids,
+                                              size * sizeof(unsigned long));
+        masters = (int *)realloc(masters, size * sizeof(int));
+        answer = (char *)realloc(answer, size);
+
+        if ((two_modules == NULL) || (turtles == NULL) ||
+            (module_ids == NULL) || (masters == NULL) || (answer == NULL)) {
+          Message("%s - cannot allocate memory for queries!\n",
+                  process_name);
+          exit(0);
+        }
+      }
+
+      if (!CSGetData(masters + nqueries, module_ids + nqueries,
+                     two_modules + 2 * nqueries, turtles + nqueries))
+        break;
+      nqueries++;
+    }
+
+    /* answer them together */
+    if (nqueries > 0) {
+      memset(answer, 0, nqueries);
+      (*AnswerQueries)(nqueries, two_modules, turtles, answer);
+
+      for (i = 0; i < nqueries; i++)
+        if (answer[i])
+          CSSendData(masters[i], module_ids[i], two_modules + 2 * i);
+    }
+
+    if (CSEndTransmission())
+      break;
+  }
+
+  free(two_modules);
+  free(turtles);
+  free(module_ids);
+  free(masters);
+  free(answer);
+}
+
 /****************************************************************************/
 void CSInitialize(int *argc, char ***argv) {
   char c;
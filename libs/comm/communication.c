@@ -25,6 +25,11 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#ifdef VLAB_LINUX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
 #endif
 
 #include "comm_lib.h"
@@ -49,18 +54,26 @@ int confirm_socket = -1;
 /****************************************************************************/
 int InitializeSharedMemory(field_type *env_field) {
 #ifndef WIN32
+  struct shmid_ds info;
+  shared_ring_type *ring;
+
+  env_field->ring = NULL;
+  env_field->ring_ready = 0;
+
   switch (env_field->specified) {
   case MASTER:
     /* release the shared memory */
     shmctl(env_field->shmid, IPC_RMID, NULL);
 
-    /* set up the shared memory */
-    if ((env_field->shmid =
-             shmget(env_field->unique_key - 1, sizeof(shared_memory_type),
-                    IPC_CREAT | 0600)) != -1)
+    /* set up the shared memory with the ring buffers */
+    if ((env_field->shmid = shmget(
+             env_field->unique_key - 1,
+             sizeof(shared_memory_type) + sizeof(shared_ring_type),
+             IPC_CREAT | 0600)) != -1)
       break;
     /* otherwise try without IPC_CREAT flag */
   case SLAVE:
+    /* masters not providing the rings create just the fields */
     if ((env_field->shmid = shmget(env_field->unique_key - 1,
                                    sizeof(shared_memory_type), 0600)) == -1) {
       Message("%s - shared memory access failed!\n", process_name);
@@ -75,6 +88,25 @@ int InitializeSharedMemory(field_type *env_field) {
     return 0;
   }
 
+  if (shmctl(env_field->shmid, IPC_STAT, &info) != 0 ||
+      info.shm_segsz < sizeof(shared_memory_type) + sizeof(shared_ring_type))
+    return 1;
+
+  ring = (shared_ring_type *)(env_field->shmadd + 1);
+
+  if (env_field->specified == MASTER) {
+    memset(ring, 0, sizeof(shared_ring_type));
+    ring->magic = RING_MAGIC;
+    env_field->ring = ring;
+  } else if (ring->magic == RING_MAGIC) {
+    /* the master switches to the ring after the first transmission */
+    __atomic_store_n(&ring->attached, 1, __ATOMIC_SEQ_CST);
+    env_field->ring = ring;
+
+    if (env_field->verbose)
+      Message("%s - ring buffers in shared memory found.\n", process_name);
+  }
+
   return 1;
 
 #else
@@ -96,6 +128,13 @@ void ReleaseSharedMemory(field_type *env_field) {
     env_field->shmadd = NULL;
   }
 
+  env_field->ring = NULL;
+  if (env_field->spill != NULL) {
+    free(env_field->spill);
+    env_field->spill = NULL;
+  }
+  env_field->spill_start = env_field->spill_end = env_field->spill_size = 0;
+
   if (env_field->specified == MASTER) {
     /* master releases the memory */
     if (env_field->shmid != -1) {
@@ -214,6 +253,270 @@ void ReleaseSemaphores(field_type *env_field) {
 #endif /* WIN32 */
 }
 
+#ifndef WIN32
+/****************************************************************************/
+/* Ring buffers. Each ring has one writer and one reader, so the head and
+   tail are just published with release stores. A process that has nothing
+   to do spins for a while and then sleeps on its event counter; the other
+   process increments the counter and wakes it after changing a ring.
+*/
+static void WaitOnEvent(volatile unsigned int *event, unsigned int value) {
+#ifdef VLAB_LINUX
+  syscall(SYS_futex, event, FUTEX_WAIT, value, NULL, NULL, 0);
+#else
+  if (*event == value)
+    usleep(50);
+#endif
+}
+
+/****************************************************************************/
+static void WakeOnEvent(volatile unsigned int *event) {
+#ifdef VLAB_LINUX
+  syscall(SYS_futex, event, FUTEX_WAKE, 1, NULL, NULL, 0);
+#else
+  (void)event;
+#endif
+}
+
+/****************************************************************************/
+static ring_type *InRing(field_type *env_field) {
+  return env_field->specified == MASTER ? &env_field->ring->from_ring
+                                        : &env_field->ring->to_ring;
+}
+
+/****************************************************************************/
+static ring_type *OutRing(field_type *env_field) {
+  return env_field->specified == MASTER ? &env_field->ring->to_ring
+                                        : &env_field->ring->from_ring;
+}
+
+/****************************************************************************/
+/* wakes up the other process if it is sleeping */
+static void RingNotify(field_type *env_field) {
+  shared_ring_type *ring = env_field->ring;
+  int other = env_field->specified == MASTER ? 1 : 0;
+
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  if (__atomic_load_n(&ring->sleeping[other], __ATOMIC_SEQ_CST)) {
+    __atomic_add_fetch(&ring->event[other], 1, __ATOMIC_SEQ_CST);
+    WakeOnEvent(&ring->event[other]);
+  }
+}
+
+/****************************************************************************/
+static void RingWait(field_type *env_field, int (*Ready)(field_type *)) {
+  shared_ring_type *ring = env_field->ring;
+  int side = env_field->specified == MASTER ? 0 : 1;
+  unsigned int event;
+  int i;
+
+  for (i = 0; i < RING_SPINS; i++)
+    if (Ready(env_field))
+      return;
+
+  for (;;) {
+    event = __atomic_load_n(&ring->event[side], __ATOMIC_SEQ_CST);
+    __atomic_store_n(&ring->sleeping[side], 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (Ready(env_field))
+      break;
+    WaitOnEvent(&ring->event[side], event);
+  }
+
+  __atomic_store_n(&ring->sleeping[side], 0, __ATOMIC_SEQ_CST);
+}
+
+/****************************************************************************/
+/* master - moves the replies from the ring to the spill buffer, so the
+   slave is not blocked while the master is still sending queries */
+static void RingSpill(field_type *env_field) {
+  ring_type *in = InRing(env_field);
+  unsigned int head, tail;
+  int length, size, n;
+  char *ptr;
+
+  tail = in->tail;
+  head = __atomic_load_n(&in->head, __ATOMIC_ACQUIRE);
+  if ((length = (int)(head - tail)) == 0)
+    return;
+
+  if (env_field->spill_start == env_field->spill_end)
+    env_field->spill_start = env_field->spill_end = 0;
+
+  if ((size = env_field->spill_end + length) > env_field->spill_size) {
+    if (size < 2 * env_field->spill_size)
+      size = 2 * env_field->spill_size;
+
+    if ((ptr = (char *)realloc(env_field->spill, size)) == NULL) {
+      Message("%s - cannot allocate buffer for replies.\n", process_name);
+      return;
+    }
+    env_field->spill = ptr;
+    env_field->spill_size = size;
+  }
+
+  while (length > 0) {
+    n = RING_LENGTH - (int)(tail & (RING_LENGTH - 1));
+    if (n > length)
+      n = length;
+    memcpy(env_field->spill + env_field->spill_end,
+           in->data + (tail & (RING_LENGTH - 1)), n);
+    env_field->spill_end += n;
+    tail += n;
+    length -= n;
+  }
+
+  __atomic_store_n(&in->tail, tail, __ATOMIC_RELEASE);
+  RingNotify(env_field);
+}
+
+/****************************************************************************/
+static int RingHasInput(field_type *env_field) {
+  ring_type *in = InRing(env_field);
+
+  return env_field->spill_start < env_field->spill_end ||
+         __atomic_load_n(&in->head, __ATOMIC_ACQUIRE) != in->tail;
+}
+
+/****************************************************************************/
+static int RingHasRoom(field_type *env_field) {
+  ring_type *out = OutRing(env_field);
+
+  if (env_field->specified == MASTER)
+    RingSpill(env_field);
+
+  return out->head - __atomic_load_n(&out->tail, __ATOMIC_ACQUIRE) <
+         RING_LENGTH;
+}
+
+/****************************************************************************/
+/* waits for the input and returns the number of bytes available at *ptr */
+static int RingInput(field_type *env_field, char **ptr) {
+  ring_type *in = InRing(env_field);
+  unsigned int tail;
+  int length;
+
+  if (env_field->spill_start == env_field->spill_end)
+    RingWait(env_field, RingHasInput);
+
+  if (env_field->spill_start < env_field->spill_end) {
+    *ptr = env_field->spill + env_field->spill_start;
+    return env_field->spill_end - env_field->spill_start;
+  }
+
+  tail = in->tail;
+  length = (int)(__atomic_load_n(&in->head, __ATOMIC_ACQUIRE) - tail);
+  if (length > RING_LENGTH - (int)(tail & (RING_LENGTH - 1)))
+    length = RING_LENGTH - (int)(tail & (RING_LENGTH - 1));
+
+  *ptr = in->data + (tail & (RING_LENGTH - 1));
+  return length;
+}
+
+/****************************************************************************/
+static void RingConsume(field_type *env_field, int length) {
+  ring_type *in = InRing(env_field);
+
+  if (env_field->spill_start < env_field->spill_end) {
+    env_field->spill_start += length;
+    return;
+  }
+
+  __atomic_store_n(&in->tail, in->tail + length, __ATOMIC_RELEASE);
+  RingNotify(env_field);
+}
+
+/****************************************************************************/
+/* returns the number of bytes read */
+int RingRead(field_type *env_field, char *data, int length) {
+  int n, read = 0;
+  char *ptr;
+
+  while (read < length) {
+    if ((n = RingInput(env_field, &ptr)) > length - read)
+      n = length - read;
+    memcpy(data + read, ptr, n);
+    RingConsume(env_field, n);
+    read += n;
+  }
+
+  return read;
+}
+
+/****************************************************************************/
+/* reads one line, like fgets */
+char *RingGets(field_type *env_field, char *line, int size) {
+  int n, read = 0;
+  char *ptr, *end;
+
+  while (read < size - 1) {
+    if ((n = RingInput(env_field, &ptr)) > size - 1 - read)
+      n = size - 1 - read;
+    if ((end = (char *)memchr(ptr, '\n', n)) != NULL)
+      n = (int)(end - ptr) + 1;
+
+    memcpy(line + read, ptr, n);
+    RingConsume(env_field, n);
+    read += n;
+
+    if (end != NULL)
+      break;
+  }
+  line[read] = '\0';
+
+  return line;
+}
+
+/****************************************************************************/
+/* returns the next byte of the input without removing it */
+int RingPeek(field_type *env_field) {
+  char *ptr;
+
+  RingInput(env_field, &ptr);
+  return (unsigned char)*ptr;
+}
+
+/****************************************************************************/
+/* returns the number of bytes written */
+int RingWrite(field_type *env_field, char *data, int length) {
+  ring_type *out = OutRing(env_field);
+  unsigned int head;
+  int n, written = 0;
+
+  while (written < length) {
+    head = out->head;
+    n = RING_LENGTH - (int)(head - __atomic_load_n(&out->tail,
+                                                    __ATOMIC_ACQUIRE));
+    if (n == 0) {
+      /* let the reader know about the data written so far */
+      RingNotify(env_field);
+      RingWait(env_field, RingHasRoom);
+      continue;
+    }
+
+    if (n > RING_LENGTH - (int)(head & (RING_LENGTH - 1)))
+      n = RING_LENGTH - (int)(head & (RING_LENGTH - 1));
+    if (n > length - written)
+      n = length - written;
+
+    memcpy(out->data + (head & (RING_LENGTH - 1)), data + written, n);
+    __atomic_store_n(&out->head, head + n, __ATOMIC_RELEASE);
+    written += n;
+  }
+
+  RingNotify(env_field);
+  return written;
+}
+
+#else
+/* shared memory is not used under Win32 */
+int RingRead(field_type *env_field, char *data, int length) { return 0; }
+int RingWrite(field_type *env_field, char *data, int length) { return 0; }
+char *RingGets(field_type *env_field, char *line, int size) { return NULL; }
+int RingPeek(field_type *env_field) { return EOF; }
+#endif /* WIN32 */
+
 /****************************************************************************/
 /* code to establish a socket; originally from bzs@bu-cs.bu.edu
    Returns the socket's fd or -1 when it fails. */
@@ -531,6 +834,47 @@ end:
   return beg;
 }
 
+/****************************************************************************/
+static int OpenInputFile(field_type *env_field) {
+#ifdef WIN32
+  /* Taken from the Windows code. I have no clue what
+   * this does. -- bjl */
+  {
+    HANDLE hFile = INVALID_HANDLE_VALUE;
+    while (INVALID_HANDLE_VALUE == hFile) {
+      hFile = CreateFile(env_field->in_name, GENERIC_READ, 0, NULL,
+                         OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+      Sleep(20);
+    }
+    CloseHandle(hFile);
+  }
+#endif
+  /* open the data file */
+  if ((env_field->in_fp = fopen(env_field->in_name, "r")) == NULL) {
+    Message("%s - field process cannot open data file %s.\n", process_name,
+            env_field->in_name);
+    return 0;
+  }
+  return 1;
+}
+
+/****************************************************************************/
+/* control line received by the master */
+static void MasterControlLine(field_type *env_field, char *line) {
+  int protocol = 0;
+
+  sscanf(line + 8, "%d %d", &env_field->in_flag, &protocol);
+
+  /* the slave understands binary frames */
+  if (!env_field->binary_queries && protocol >= BINARY_PROTOCOL &&
+      BinaryQueriesAllowed(env_field)) {
+    env_field->binary_queries = 1;
+
+    if (env_field->verbose)
+      Message("%s - switching to binary queries.\n", process_name);
+  }
+}
+
 /****************************************************************************/
 char *LoadOneToken(field_type *env_field, char *sep) {
   return LoadOneDataItem(env_field, sep, NULL, -1);
@@ -554,7 +898,7 @@ char *LoadOneDataItem(field_type *env_field, char *sep, char *data,
 
     if (env_field->specified == MASTER)
       if (strncmp(env_field->act_ptr, "Control", 7) == 0) {
-        sscanf(env_field->act_ptr + 8, "%d", &env_field->in_flag);
+        MasterControlLine(env_field, env_field->act_ptr);
         return NULL;
       }
 
@@ -575,28 +919,11 @@ char *LoadOneDataItem(field_type *env_field, char *sep, char *data,
     /* no break ! */
   case COMM_FILES:
   case COMM_PIPES:
+  case COMM_RING:
     if (env_field->in_num++ == 0) {
-      if (env_field->comm_type == COMM_FILES) {
-#ifdef WIN32
-        /* Taken from the Windows code. I have no clue what
-         * this does. -- bjl */
-        {
-          HANDLE hFile = INVALID_HANDLE_VALUE;
-          while (INVALID_HANDLE_VALUE == hFile) {
-            hFile = CreateFile(env_field->in_name, GENERIC_READ, 0, NULL,
-                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-            Sleep(20);
-          }
-          CloseHandle(hFile);
-        }
-#endif
-        /* open the data file */
-        if ((env_field->in_fp = fopen(env_field->in_name, "r")) == NULL) {
-          Message("%s - field process cannot open data file %s.\n",
-                  process_name, env_field->in_name);
+      if (env_field->comm_type == COMM_FILES)
+        if (!OpenInputFile(env_field))
           return NULL;
-        }
-      }
     } else if (length < 0)
       /* get another token from the current line */
       if ((token = skiptok(&env_field->act_ptr, sep)) != NULL)
@@ -617,19 +944,25 @@ char *LoadOneDataItem(field_type *env_field, char *sep, char *data,
 
       if (length < 0) {
         /* read another line from the file */
-        assert(NULL != env_field->in_fp);
-        if (fgets(env_field->line, sizeof(env_field->line), env_field->in_fp) ==
-            NULL) {
-          Message("%s - didn't manage to read a line.\n", process_name);
-          return NULL;
+        if (env_field->comm_type == COMM_RING)
+          RingGets(env_field, env_field->line, sizeof(env_field->line));
+        else {
+          assert(NULL != env_field->in_fp);
+          if (fgets(env_field->line, sizeof(env_field->line),
+                    env_field->in_fp) == NULL) {
+            Message("%s - didn't manage to read a line.\n", process_name);
+            return NULL;
+          }
         }
         token = env_field->line;
       } else {
         if (data == NULL)
           return NULL;
 
-        assert(NULL != env_field->in_fp);
-        if (fread(data, 1, length, env_field->in_fp) != (unsigned int)length) {
+        if (env_field->comm_type == COMM_RING)
+          RingRead(env_field, data, length);
+        else if (fread(data, 1, length, env_field->in_fp) !=
+                 (unsigned int)length) {
           Message("%s - didn't manage to read %d bytes.\n", process_name,
                   length);
           return NULL;
@@ -644,7 +977,7 @@ char *LoadOneDataItem(field_type *env_field, char *sep, char *data,
 
       if (env_field->specified == MASTER)
         if (strncmp(token, "Control", 7) == 0) {
-          sscanf(token + 8, "%d", &env_field->in_flag);
+          MasterControlLine(env_field, token);
           if (env_field->comm_type == COMM_FILES) {
             if (NULL != env_field->in_fp) {
               fclose(env_field->in_fp);
@@ -707,6 +1040,14 @@ int SaveOneDataItem(field_type *env_field, char *data, int length, char test) {
     }
     break;
 
+  case COMM_RING:
+    /* no chunks, the writer waits for room in the ring */
+    if (length < 0)
+      length = strlen(data);
+
+    RingWrite(env_field, data, length);
+    break;
+
   case COMM_SOCKETS:
 #ifdef WIN32
     assert(!"Sockets not implemented under Win32");
@@ -749,6 +1090,342 @@ int SaveOneDataItem(field_type *env_field, char *data, int length, char test) {
   return 1;
 }
 
+/****************************************************************************/
+/* Binary frames. A transmission is sent as FRAME_START, the length of the
+   records and the records, each one being its type, length and data. It is
+   used only when the field exchanges just queries and replies and the slave
+   has announced that it understands frames in its control line. Numbers are
+   little endian, so remote processes understand each other. A master
+   streaming through the ring may split a transmission into several frames,
+   the control record ends the last one.
+*/
+int BinaryQueriesAllowed(field_type *env_field) {
+  int i;
+
+  if (!env_field->binary_allowed || env_field->strings_only ||
+      env_field->binary_data)
+    return 0;
+
+  /* graphics of interpreted modules are sent as strings */
+  if (env_field->following_module)
+    for (i = 0; i < 256; i++)
+      if (env_field->interpreted_modules[i] != 0)
+        return 0;
+
+  return 1;
+}
+
+/****************************************************************************/
+char *PutBinaryInt(char *ptr, unsigned long value) {
+  ptr[0] = (char)(value & 0xff);
+  ptr[1] = (char)((value >> 8) & 0xff);
+  ptr[2] = (char)((value >> 16) & 0xff);
+  ptr[3] = (char)((value >> 24) & 0xff);
+  return ptr + 4;
+}
+
+/****************************************************************************/
+char *GetBinaryInt(char *ptr, unsigned long *value) {
+  unsigned char *u = (unsigned char *)ptr;
+
+  *value = (unsigned long)u[0] | ((unsigned long)u[1] << 8) |
+           ((unsigned long)u[2] << 16) | ((unsigned long)u[3] << 24);
+  return ptr + 4;
+}
+
+/****************************************************************************/
+char *PutBinaryFloats(char *ptr, float *values, int n) {
+  unsigned int bits;
+  int i;
+
+  for (i = 0; i < n; i++) {
+    memcpy(&bits, values + i, 4);
+    ptr = PutBinaryInt(ptr, bits);
+  }
+  return ptr;
+}
+
+/****************************************************************************/
+char *GetBinaryFloats(char *ptr, float *values, int n) {
+  unsigned long value;
+  unsigned int bits;
+  int i;
+
+  for (i = 0; i < n; i++) {
+    ptr = GetBinaryInt(ptr, &value);
+    bits = (unsigned int)value;
+    memcpy(values + i, &bits, 4);
+  }
+  return ptr;
+}
+
+/****************************************************************************/
+/* all_set - the parameters are sent as set (queries) */
+char *PutBinaryModule(char *ptr, Cmodule_type *module, char all_set) {
+  int i, len;
+
+  len = (int)strlen(module->symbol);
+  *(ptr++) = (char)len;
+  memcpy(ptr, module->symbol, len);
+  ptr += len;
+
+  *(ptr++) = (char)module->num_params;
+  for (i = 0; i < module->num_params; i++) {
+    *(ptr++) = all_set ? 1 : module->params[i].set;
+    ptr = PutBinaryFloats(ptr, &module->params[i].value, 1);
+  }
+  return ptr;
+}
+
+/****************************************************************************/
+/* end - the end of the record. Returns NULL if the module is not valid or
+   does not fit in the record */
+char *GetBinaryModule(char *ptr, char *end, Cmodule_type *module) {
+  int i, len;
+
+  if (ptr >= end || (len = (unsigned char)*(ptr++)) > CMAXSYMBOLLEN ||
+      end - ptr < len + 1)
+    return NULL;
+  memcpy(module->symbol, ptr, len);
+  module->symbol[len] = '\0';
+  ptr += len;
+
+  if ((module->num_params = (unsigned char)*(ptr++)) > CMAXPARAMS ||
+      end - ptr < 5 * module->num_params)
+    return NULL;
+  for (i = 0; i < module->num_params; i++) {
+    module->params[i].set = *(ptr++);
+    ptr = GetBinaryFloats(ptr, &module->params[i].value, 1);
+  }
+  return ptr;
+}
+
+/****************************************************************************/
+/* Returns 0 when a record of the given length should not be added before
+   the frame is sent (the same limits as for text items). */
+int BinaryRecordFits(field_type *env_field, int length) {
+  int size, frame_length;
+
+  if ((frame_length = env_field->frame_length) < FRAME_HEADER)
+    frame_length = FRAME_HEADER;
+
+  switch (env_field->comm_type) {
+  case COMM_RING:
+    return 1;
+
+  case COMM_MEMORY:
+    size = env_field->specified == MASTER ? TO_FIELD_LENGTH : FROM_FIELD_LENGTH;
+    return frame_length + RECORD_HEADER + length + 25 < size - 1;
+  }
+
+  return env_field->out_num <= env_field->max_queries_in_file;
+}
+
+/****************************************************************************/
+/* Adds a record of the given length to the outgoing frame and returns
+   the place for its data, so it can be written in directly. NULL if the
+   frame cannot be allocated. */
+char *ReserveBinaryRecord(field_type *env_field, int type, int length) {
+  int size;
+  char *ptr;
+
+  if (env_field->frame_length < FRAME_HEADER)
+    env_field->frame_length = FRAME_HEADER;
+
+  size = env_field->frame_length + RECORD_HEADER + length;
+  if (size > env_field->frame_size) {
+    if (size < 2 * env_field->frame_size)
+      size = 2 * env_field->frame_size;
+    if (size < 4096)
+      size = 4096;
+
+    if ((ptr = (char *)realloc(env_field->frame, size)) == NULL) {
+      Message("%s - cannot allocate binary frame.\n", process_name);
+      return NULL;
+    }
+    env_field->frame = ptr;
+    env_field->frame_size = size;
+  }
+
+  ptr = env_field->frame + env_field->frame_length;
+  *(ptr++) = (char)type;
+  ptr = PutBinaryInt(ptr, length);
+  env_field->frame_length += RECORD_HEADER + length;
+
+  return ptr;
+}
+
+/****************************************************************************/
+/* Adds a record to the outgoing frame. With test, returns 0 when the frame
+   should be sent first (see BinaryRecordFits). */
+int SaveBinaryRecord(field_type *env_field, int type, char *data, int length,
+                     char test) {
+  char *ptr;
+
+  if (test && !BinaryRecordFits(env_field, length))
+    return 0;
+
+  if ((ptr = ReserveBinaryRecord(env_field, type, length)) == NULL)
+    return 0;
+  memcpy(ptr, data, length);
+
+  return 1;
+}
+
+/****************************************************************************/
+/* sends the frame as one data item */
+int SaveBinaryFrame(field_type *env_field) {
+  int ret;
+
+  if (env_field->frame_length < FRAME_HEADER)
+    return 1;
+
+  env_field->frame[0] = FRAME_START;
+  PutBinaryInt(env_field->frame + 1, env_field->frame_length - FRAME_HEADER);
+
+  ret = SaveOneDataItem(env_field, env_field->frame, env_field->frame_length, 0);
+  env_field->frame_length = FRAME_HEADER;
+
+  return ret;
+}
+
+/****************************************************************************/
+/* Called before reading the input of a transmission. Returns 1 if the input
+   is a binary frame (reading it in), 0 if it is text. The slave replies in
+   the same format. */
+int LoadBinaryFrame(field_type *env_field) {
+  char header[FRAME_HEADER], *ptr;
+  unsigned long length;
+  int c;
+
+  if (env_field->in_binary)
+    return 1;
+  if (env_field->in_num != 0 || !BinaryQueriesAllowed(env_field))
+    return 0;
+
+  if (env_field->specified == SLAVE)
+    env_field->binary_queries = 0;
+
+  switch (env_field->comm_type) {
+  case COMM_MEMORY:
+    ptr = env_field->specified == MASTER ? env_field->shmadd->from_field
+                                         : env_field->shmadd->to_field;
+    if (*ptr != FRAME_START)
+      return 0;
+
+    GetBinaryInt(ptr + 1, &length);
+    env_field->in_frame = ptr + FRAME_HEADER;
+    break;
+
+  default:
+    if (env_field->comm_type == COMM_FILES)
+      if (!OpenInputFile(env_field))
+        return 0;
+
+    if (env_field->comm_type == COMM_RING)
+      c = RingPeek(env_field);
+    else if ((c = getc(env_field->in_fp)) != EOF)
+      ungetc(c, env_field->in_fp);
+
+    if (c != FRAME_START) {
+      /* text continues from the open file */
+      env_field->in_num = 1;
+      env_field->act_ptr = NULL;
+      return 0;
+    }
+
+    if (env_field->comm_type == COMM_RING)
+      RingRead(env_field, header, FRAME_HEADER);
+    else if (fread(header, 1, FRAME_HEADER, env_field->in_fp) !=
+             FRAME_HEADER) {
+      Message("%s - cannot read the binary frame.\n", process_name);
+      return 0;
+    }
+    GetBinaryInt(header + 1, &length);
+
+    if ((int)length > env_field->in_frame_size) {
+      if ((ptr = (char *)realloc(env_field->in_frame_buf, length)) == NULL) {
+        Message("%s - cannot allocate binary frame.\n", process_name);
+        return 0;
+      }
+      env_field->in_frame_buf = ptr;
+      env_field->in_frame_size = (int)length;
+    }
+
+    if (env_field->comm_type == COMM_RING)
+      RingRead(env_field, env_field->in_frame_buf, (int)length);
+    else if (fread(env_field->in_frame_buf, 1, length, env_field->in_fp) !=
+             length) {
+      Message("%s - cannot read the binary frame.\n", process_name);
+      return 0;
+    }
+    env_field->in_frame = env_field->in_frame_buf;
+    break;
+  }
+
+  env_field->in_frame_length = (int)length;
+  env_field->in_frame_pos = 0;
+  env_field->in_binary = 1;
+  env_field->in_num = 1;
+
+  if (env_field->specified == SLAVE)
+    env_field->binary_queries = 1;
+
+  return 1;
+}
+
+/****************************************************************************/
+/* returns NULL at the end of the frame */
+char *LoadBinaryRecord(field_type *env_field, int *type, int *length) {
+  char *ptr;
+  unsigned long len;
+
+  if (env_field->in_frame_pos + RECORD_HEADER > env_field->in_frame_length)
+    return NULL;
+
+  ptr = env_field->in_frame + env_field->in_frame_pos;
+  *type = (unsigned char)*ptr;
+  GetBinaryInt(ptr + 1, &len);
+
+  if (env_field->in_frame_pos + RECORD_HEADER + (long)len >
+      env_field->in_frame_length) {
+    Message("%s - corrupted binary frame.\n", process_name);
+    env_field->in_frame_pos = env_field->in_frame_length;
+    return NULL;
+  }
+
+  env_field->in_frame_pos += RECORD_HEADER + (int)len;
+  *length = (int)len;
+  return ptr + RECORD_HEADER;
+}
+
+/****************************************************************************/
+void FreeBinaryFrames(field_type *env_field) {
+  if (env_field->frame != NULL) {
+    free(env_field->frame);
+    env_field->frame = NULL;
+  }
+  env_field->frame_length = env_field->frame_size = 0;
+
+  if (env_field->in_frame_buf != NULL) {
+    free(env_field->in_frame_buf);
+    env_field->in_frame_buf = NULL;
+  }
+  env_field->in_frame_size = 0;
+  env_field->in_frame = NULL;
+  env_field->in_binary = 0;
+  env_field->binary_queries = 0;
+
+  if (env_field->answers != NULL) {
+    free(env_field->answers);
+    env_field->answers = NULL;
+  }
+  env_field->answers_count = 0;
+  env_field->answers_length = env_field->answers_size = 0;
+  env_field->batch = NULL;
+  env_field->batch_answers = 0;
+}
+
 /****************************************************************************/
 /* counts number of parameters in a printf-like format string */
 static int CountParameters(char *str, int *skip) {
@@ -800,6 +1477,7 @@ int ReadInEnvironmentalFile(field_type *env_field, char *filename) {
       "binary data",         /* 12 */
       "interpreted modules", /* 13  - new version of 'when interpret' */
       "following module",    /* 14 */
+      "binary queries",      /* 15 */
       NULL                   /* the last item must be NULL! */
   };
 #define LINELEN 4096
@@ -821,6 +1499,9 @@ int ReadInEnvironmentalFile(field_type *env_field, char *filename) {
   env_field->strings_only = 0;
   env_field->following_module = 1;
   env_field->binary_data = 0;
+  env_field->binary_allowed = 1;
+  env_field->binary_queries = 0;
+  env_field->in_binary = 0;
   env_field->max_queries_in_file = MAX_QUERIES_IN_PIPE;
   env_field->comm_spec_file = NULL;
 
@@ -1099,6 +1780,13 @@ int ReadInEnvironmentalFile(field_type *env_field, char *filename) {
         env_field->following_module = 0;
       break;
 
+    case 15: /* binary queries */
+      if ((token = strtok(NULL, "\n ")) == NULL)
+        break;
+      if (strcmp(token, "off") == 0)
+        env_field->binary_allowed = 0;
+      break;
+
     default:
       Message("%s - environment file: unknown keyword %s.\n", process_name,
               token);
@@ -27,6 +27,8 @@
 #define COMM_FILES  1
 #define COMM_PIPES  2
 #define COMM_SOCKETS 3
+#define COMM_RING    4 /* memory used as a pair of ring buffers - switched
+			  to from COMM_MEMORY when both processes support it */
 
 /************************************************************************/
 /* semaphores  - used for memory or files communication */
@@ -73,6 +75,35 @@ struct shared_memory_type {
 
 typedef struct shared_memory_type shared_memory_type;
 
+/* ring buffers - appended to shared_memory_type by the master. The
+   processes stream queries and replies through them instead of passing
+   the whole fields with semaphores. A slave that finds them sets
+   'attached' and both processes switch to COMM_RING after the first
+   transmission. */
+
+#define RING_MAGIC  0x52696e67
+#define RING_LENGTH 65536  /* must be a power of 2 */
+#define RING_SPINS  2000   /* checks before a process goes to sleep */
+
+struct ring_type {
+  volatile unsigned int head;  /* bytes written, advanced by the writer */
+  volatile unsigned int tail;  /* bytes read, advanced by the reader */
+  char data[RING_LENGTH];
+};
+
+typedef struct ring_type ring_type;
+
+struct shared_ring_type {
+  volatile unsigned int magic;
+  volatile unsigned int attached;    /* set by the slave */
+  volatile unsigned int event[2];    /* master and slave sleep on these */
+  volatile unsigned int sleeping[2];
+  ring_type to_ring;
+  ring_type from_ring;
+};
+
+typedef struct shared_ring_type shared_ring_type;
+
 /* files */
 
 #define FILENAME_TO_FIELD   ".to_field"
@@ -81,6 +112,38 @@ typedef struct shared_memory_type shared_memory_type;
 #define DATA_BEGIN "Dbegin"
 #define DATA_END   "Dend"
 
+/* binary frames - used instead of text lines when both processes
+   support them (see BinaryQueriesAllowed) */
+#define BINARY_PROTOCOL 1 /* version announced in slave's control lines */
+#define BATCH_PROTOCOL  2 /* the slave reads batch records as well */
+
+#define FRAME_START   2 /* cannot start a line of the text protocol */
+#define FRAME_HEADER  5 /* FRAME_START and the length of the records */
+#define RECORD_HEADER 5 /* type and length of the data */
+#define MAX_RECORD_LENGTH 512
+
+/* record types */
+#define RECORD_QUERY   'Q' /* distance, one or two modules, turtle */
+#define RECORD_REPLY   'R' /* distance, module */
+#define RECORD_CONTROL 'C' /* flag, current step */
+#define RECORD_BATCH   'B' /* all queries of a step as arrays: count, turtle
+                              mask, distances, numbers of parameters,
+                              following symbols and their numbers of
+                              parameters (TURTLE_FOLLOWING), parameters,
+                              following parameters and turtle parameters */
+#define RECORD_ANSWERS 'A' /* replies to batch records as arrays: count,
+                              distances, numbers of parameters and
+                              parameters */
+
+/* turtle parameters present in a query */
+#define TURTLE_POSITION     1
+#define TURTLE_HEADING      2
+#define TURTLE_LEFT         4
+#define TURTLE_UP           8
+#define TURTLE_LINE_WIDTH   16
+#define TURTLE_SCALE_FACTOR 32
+#define TURTLE_FOLLOWING    128 /* batch records - following modules sent */
+
 
 /* structure for all necessary environmental parameters 
    Same for both master and slave although svale doesn't need all parameters.
@@ -175,6 +238,10 @@ struct field_type
   shared_memory_type  *shmadd;     /* address of shared memory  */
   int  shstringend;     /* index of the active end of the shared string */
   int  out_end;         /* index of the active end of the shared string */
+  shared_ring_type *ring; /* ring buffers, NULL if not available */
+  char ring_ready;      /* master - the slave is using the ring */
+  char *spill;          /* master - replies read while waiting for room */
+  int  spill_start, spill_end, spill_size;
 
 #ifdef XXX
   int (*SetCommModulePars)(unsigned long distance,
@@ -184,6 +251,27 @@ struct field_type
 #endif
   char *act_ptr;        /* used for reading in the text information */
 
+  char binary_allowed;  /* "binary queries:" in the environment file */
+  char binary_queries;  /* queries and replies sent in binary frames */
+  char in_binary;       /* the current input is a binary frame */
+  char *frame;          /* outgoing binary frame */
+  int  frame_length, frame_size;
+  char *in_frame;       /* records of the incoming binary frame */
+  int  in_frame_length, in_frame_pos;
+  char *in_frame_buf;   /* space for in_frame if not in shared memory */
+  int  in_frame_size;
+
+  /* slave - batch record being read, arrays of the record */
+  char *batch;          /* NULL when no batch record is read */
+  int  batch_count, batch_next, batch_mask;
+  char *batch_distances, *batch_counts, *batch_symbols, *batch_following;
+  char *batch_params, *batch_following_params, *batch_turtle;
+  /* slave - replies to batch records, sent in one record */
+  char batch_answers;   /* the queries came in batch records */
+  char *answers;        /* distance, number of parameters and parameters
+                           of each reply */
+  int  answers_count, answers_length, answers_size;
+
 };
 
 typedef struct field_type field_type;
@@ -202,6 +290,11 @@ void ReleaseSharedMemory(field_type *env_field);
 int InitializeSemaphores(field_type *env_field);
 void ReleaseSemaphores(field_type *env_field);
 
+int RingRead(field_type *env_field, char *data, int length);
+int RingWrite(field_type *env_field, char *data, int length);
+char *RingGets(field_type *env_field, char *line, int size);
+int RingPeek(field_type *env_field);
+
 int SocketRead(int s, char *buf, int n);
 int SocketWrite(int s, char *buf, int n);
 int *EstablishSocket(field_type *env_field, char *host);
@@ -215,6 +308,22 @@ char *LoadOneDataItem(field_type *env_field, char *sep, char *data,
 int SaveOneItem(field_type *env_field, char *string, char test);
 int SaveOneDataItem(field_type *env_field, char *data, int length, char test);
 
+int BinaryQueriesAllowed(field_type *env_field);
+char *PutBinaryInt(char *ptr, unsigned long value);
+char *GetBinaryInt(char *ptr, unsigned long *value);
+char *PutBinaryFloats(char *ptr, float *values, int n);
+char *GetBinaryFloats(char *ptr, float *values, int n);
+char *PutBinaryModule(char *ptr, Cmodule_type *module, char all_set);
+char *GetBinaryModule(char *ptr, char *end, Cmodule_type *module);
+int BinaryRecordFits(field_type *env_field, int length);
+char *ReserveBinaryRecord(field_type *env_field, int type, int length);
+int SaveBinaryRecord(field_type *env_field, int type, char *data, int length,
+                     char test);
+int SaveBinaryFrame(field_type *env_field);
+int LoadBinaryFrame(field_type *env_field);
+char *LoadBinaryRecord(field_type *env_field, int *type, int *length);
+void FreeBinaryFrames(field_type *env_field);
+
 #else
 	#error File already included
 #endif
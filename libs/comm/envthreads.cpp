@@ -0,0 +1,41 @@
+/*
+  Running the computation of an environmental program on several threads
+*/
+
+#include <stdlib.h>
+
+#include <thread>
+#include <vector>
+
+#include "envthreads.h"
+
+/****************************************************************************/
+int NumberOfProcessors(void) {
+  unsigned int n = std::thread::hardware_concurrency();
+
+  return (n > 0 ? (int)n : 1);
+}
+
+/****************************************************************************/
+/* returns the value of the "number of threads" directive given in 'token',
+   0 or less means one thread per processor */
+int NumberOfThreads(const char *token) {
+  int n = atoi(token);
+
+  return (n > 0 ? n : NumberOfProcessors());
+}
+
+/****************************************************************************/
+/* calls work for threads 0 to num_threads-1, thread 0 is the calling one,
+   and returns when all of them are done */
+void RunThreads(int num_threads, void (*work)(int thread, void *data),
+                void *data) {
+  std::vector<std::thread> threads;
+  int i;
+
+  for (i = 1; i < num_threads; i++)
+    threads.push_back(std::thread(work, i, data));
+  work(0, data);
+  for (i = 0; i < (int)threads.size(); i++)
+    threads[i].join();
+}
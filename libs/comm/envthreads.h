@@ -0,0 +1,25 @@
+/*
+  Running the computation of an environmental program on several threads.
+  Like message.c, envthreads.cpp is not part of the communication library,
+  the programs which need it compile it with their own sources.
+*/
+
+#ifndef __ENVTHREADS_H__
+#define __ENVTHREADS_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int NumberOfProcessors(void);
+int NumberOfThreads(const char *token);
+void RunThreads(int num_threads, void (*work)(int thread, void *data),
+                void *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#else
+#error File already included
+#endif
@@ -0,0 +1,209 @@
+/*
+  Streams queries and replies between a forked master and slave through
+  the ring buffers (COMM_RING) and checks that every item arrives
+  unchanged. The text and the binary frame are both longer than a ring,
+  so the writers wrap around and wait for room, the master spills replies
+  while it is still sending, and the processes sleep on their events.
+
+  Built and run by 'make check' in this directory, or build with:
+    cc -DVLAB_LINUX -o ringtest ringtest.c communication.c comm_master.c \
+       comm_slave.c compression.c message.c
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/ipc.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "comm_lib.h"
+#include "communication.h"
+
+#define TEXT_QUERIES   3000 /* about 3 rings of text */
+#define BINARY_QUERIES 2500 /* about 2 rings of records */
+
+static int failed = 0;
+
+static void Check(int ok, const char *what) {
+  if (!ok) {
+    fprintf(stderr, "FAILED: %s (%s)\n", what, process_name);
+    failed = 1;
+  }
+}
+
+/****************************************************************************/
+static void SetModule(Cmodule_type *module, int i) {
+  int j;
+
+  memset(module, 0, sizeof(Cmodule_type));
+  strcpy(module->symbol, i % 2 ? "E1" : "EA20");
+  module->num_params = 1 + i % 4;
+  for (j = 0; j < module->num_params; j++) {
+    module->params[j].value = (float)i + 0.25f * j;
+    module->params[j].set = 1;
+  }
+}
+
+/****************************************************************************/
+static int SameModule(Cmodule_type *a, Cmodule_type *b) {
+  int j;
+
+  if (strcmp(a->symbol, b->symbol) != 0 || a->num_params != b->num_params)
+    return 0;
+  for (j = 0; j < a->num_params; j++)
+    if (a->params[j].value != b->params[j].value)
+      return 0;
+  return 1;
+}
+
+/****************************************************************************/
+/* answers every text query with its number and then every binary query
+   with a reply record holding the same distance and module */
+static void Slave(field_type *env_field) {
+  Cmodule_type module, expected;
+  char reply[64], *token, *ptr, *end;
+  unsigned long distance;
+  int i, type, length;
+
+  for (i = 0; i < TEXT_QUERIES; i++) {
+    token = LoadOneToken(env_field, " \n");
+    Check(token != NULL && strcmp(token, "query") == 0, "load text query");
+    token = LoadOneToken(env_field, " \n");
+    Check(token != NULL && atoi(token) == i, "load query number");
+    token = LoadOneToken(env_field, " \n");
+    Check(token != NULL && strlen(token) == 40 + (size_t)i % 17,
+          "load query padding");
+
+    sprintf(reply, "reply %d\n", i);
+    SaveOneItem(env_field, reply, 0);
+  }
+
+  env_field->in_num = 0;
+  Check(LoadBinaryFrame(env_field), "load query frame");
+
+  for (i = 0; (ptr = LoadBinaryRecord(env_field, &type, &length)) != NULL;
+       i++) {
+    end = ptr + length;
+    Check(type == RECORD_QUERY, "query record type");
+    ptr = GetBinaryInt(ptr, &distance);
+    Check(distance == (unsigned long)i, "query distance");
+    Check((ptr = GetBinaryModule(ptr, end, &module)) == end, "query module");
+
+    SetModule(&expected, i);
+    Check(SameModule(&module, &expected), "query module contents");
+
+    ptr = PutBinaryInt(reply, distance);
+    ptr = PutBinaryModule(ptr, &module, 0);
+    SaveBinaryRecord(env_field, RECORD_REPLY, reply, (int)(ptr - reply), 0);
+  }
+  Check(i == BINARY_QUERIES, "number of query records");
+
+  SaveBinaryFrame(env_field);
+}
+
+/****************************************************************************/
+/* sends all the queries before reading any reply */
+static void Master(field_type *env_field) {
+  Cmodule_type module, expected;
+  char query[128], *token, *ptr, *end;
+  unsigned long distance;
+  int i, type, length;
+
+  /* let the slave go to sleep waiting for the first query */
+  usleep(100000);
+
+  for (i = 0; i < TEXT_QUERIES; i++) {
+    sprintf(query, "query %d %.*s\n", i, 40 + i % 17,
+            "0123456789012345678901234567890123456789012345678901234567");
+    SaveOneItem(env_field, query, 0);
+  }
+
+  for (i = 0; i < TEXT_QUERIES; i++) {
+    token = LoadOneToken(env_field, " \n");
+    Check(token != NULL && strcmp(token, "reply") == 0, "load text reply");
+    token = LoadOneToken(env_field, " \n");
+    Check(token != NULL && atoi(token) == i, "load reply number");
+  }
+
+  for (i = 0; i < BINARY_QUERIES; i++) {
+    SetModule(&module, i);
+    ptr = PutBinaryInt(query, i);
+    ptr = PutBinaryModule(ptr, &module, 1);
+    SaveBinaryRecord(env_field, RECORD_QUERY, query, (int)(ptr - query), 0);
+  }
+  SaveBinaryFrame(env_field);
+
+  env_field->in_num = 0;
+  Check(LoadBinaryFrame(env_field), "load reply frame");
+
+  for (i = 0; (ptr = LoadBinaryRecord(env_field, &type, &length)) != NULL;
+       i++) {
+    end = ptr + length;
+    Check(type == RECORD_REPLY, "reply record type");
+    ptr = GetBinaryInt(ptr, &distance);
+    Check(distance == (unsigned long)i, "reply distance");
+    Check(GetBinaryModule(ptr, end, &module) == end, "reply module");
+
+    SetModule(&expected, i);
+    Check(SameModule(&module, &expected), "reply module contents");
+  }
+  Check(i == BINARY_QUERIES, "number of reply records");
+}
+
+/****************************************************************************/
+int main(void) {
+  field_type field;
+  shared_ring_type *ring;
+  pid_t pid;
+  int status;
+
+  ring = (shared_ring_type *)mmap(NULL, sizeof(shared_ring_type),
+                                  PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (ring == MAP_FAILED) {
+    perror("mmap");
+    return 1;
+  }
+  memset(ring, 0, sizeof(shared_ring_type));
+  ring->magic = RING_MAGIC;
+  ring->attached = 1;
+
+  memset(&field, 0, sizeof(field));
+  field.comm_type = COMM_RING;
+  field.ring = ring;
+  field.binary_allowed = 1;
+
+  if ((pid = fork()) < 0) {
+    perror("fork");
+    return 1;
+  }
+
+  if (pid == 0) {
+    strcpy(process_name, "slave");
+    field.specified = SLAVE;
+    Slave(&field);
+    FreeBinaryFrames(&field);
+    _exit(failed);
+  }
+
+  strcpy(process_name, "master");
+  field.specified = MASTER;
+  field.ring_ready = 1;
+  Master(&field);
+  FreeBinaryFrames(&field);
+  free(field.spill);
+
+  Check(waitpid(pid, &status, 0) == pid && WIFEXITED(status) &&
+            WEXITSTATUS(status) == 0,
+        "slave exit status");
+  Check(ring->sleeping[0] == 0 && ring->sleeping[1] == 0, "processes awake");
+
+  munmap(ring, sizeof(shared_ring_type));
+
+  if (!failed)
+    printf("ring communication: OK\n");
+  return failed;
+}
@@ -0,0 +1,72 @@
+/*
+  Sends a few items over a pair of connected sockets using the socket
+  communication type and checks that they are read back unchanged.
+
+  Built and run by 'make check' in this directory, or build with:
+    cc -o test test.c communication.c comm_master.c comm_slave.c \
+       compression.c message.c
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+
+#include "comm_lib.h"
+#include "communication.h"
+
+static int failed = 0;
+
+static void Check(int ok, const char *what) {
+  if (!ok) {
+    fprintf(stderr, "FAILED: %s\n", what);
+    failed = 1;
+  }
+}
+
+int main(void) {
+  field_type out, in;
+  int s[2];
+  char data[8] = {1, 2, 3, 4, 0, 5, 6, 7}, buf[8];
+  char *token;
+
+  strcpy(process_name, "test");
+
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, s) < 0) {
+    perror("socketpair");
+    return 1;
+  }
+
+  memset(&out, 0, sizeof(out));
+  out.specified = SLAVE;
+  out.comm_type = COMM_SOCKETS;
+  out.max_queries_in_file = 1000;
+  out.out_fp = fdopen(s[0], "w");
+
+  memset(&in, 0, sizeof(in));
+  in.specified = SLAVE;
+  in.comm_type = COMM_SOCKETS;
+  in.in_fp = fdopen(s[1], "r");
+
+  Check(SaveOneItem(&out, "first second\n", 1) != 0, "save string");
+  Check(SaveOneDataItem(&out, data, sizeof(data), 1) != 0, "save data");
+  Check(SaveOneItem(&out, "third\n", 1) != 0, "save last string");
+  fflush(out.out_fp);
+
+  token = LoadOneToken(&in, " \n");
+  Check(token != NULL && strcmp(token, "first") == 0, "load first token");
+  token = LoadOneToken(&in, " \n");
+  Check(token != NULL && strcmp(token, "second") == 0, "load second token");
+  Check(LoadOneDataItem(&in, NULL, buf, sizeof(buf)) == buf &&
+            memcmp(buf, data, sizeof(data)) == 0,
+        "load data");
+  token = LoadOneToken(&in, " \n");
+  Check(token != NULL && strcmp(token, "third") == 0, "load last token");
+
+  fclose(out.out_fp);
+  fclose(in.in_fp);
+
+  if (!failed)
+    printf("socket communication: OK\n");
+  return failed;
+}
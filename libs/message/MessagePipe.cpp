@@ -17,18 +17,109 @@
 
 
 
+#include <errno.h>
 #include <iostream>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
 
 #include "MessagePipe.h"
 #include "debug.h"
 #include "xmemory.h"
 #include "xstring.h"
 
+// size of the frames of a stream, all but the last one are this long
+static const long FRAME_SIZE = 1024 * 1024;
+
+// the buffer is grown to at least this size when receiving a stream
+static const long STREAM_BUFFER_SIZE = 65536;
+
+/******************************************************************************
+ *
+ * puts the code and the length of a message into an 8 byte header
+ * (assuming code and length have at most 4 bytes)
+ *
+ */
+
+static void put_header(unsigned char *buf, Code code, long length) {
+  buf[0] = (code / (1)) % 256;
+  buf[1] = (code / (256)) % 256;
+  buf[2] = (code / (256 * 256)) % 256;
+  buf[3] = (code / (256 * 256 * 256)) % 256;
+
+  buf[4] = (length / (1)) % 256;
+  buf[5] = (length / (256)) % 256;
+  buf[6] = (length / (256 * 256)) % 256;
+  buf[7] = (length / (256 * 256 * 256)) % 256;
+}
+
+/******************************************************************************
+ *
+ * extracts the code and the length of a message from an 8 byte header
+ *
+ */
+
+static void get_header(const unsigned char *buf, Code &code, long &length) {
+  code = buf[0] + buf[1] * 256 + buf[2] * 256 * 256 + buf[3] * 256 * 256 * 256;
+  length =
+      buf[4] + buf[5] * 256 + buf[6] * 256 * 256 + buf[7] * 256 * 256 * 256;
+}
+
+/******************************************************************************
+ *
+ * writes all the data described by iov to fd
+ *
+ * - returns:  0 - success
+ *            !0 - error
+ *
+ */
+
+static int write_iov(int fd, struct iovec *iov, int n) {
+  while (n > 0) {
+    ssize_t w = writev(fd, iov, n);
+    if (w == -1) {
+      if (errno == EINTR)
+        continue;
+      return 1;
+    }
+    // skip what was written
+    while (n > 0 && (size_t)w >= iov->iov_len) {
+      w -= iov->iov_len;
+      iov++;
+      n--;
+    }
+    if (n > 0) {
+      iov->iov_base = (char *)iov->iov_base + w;
+      iov->iov_len -= w;
+    }
+  }
+  return 0;
+}
+
+/******************************************************************************
+ *
+ * writes n bytes of data to fd
+ *
+ * - returns:  0 - success
+ *            !0 - error
+ *
+ */
+
+static int write_all(int fd, const void *data, long n) {
+  struct iovec iov;
+  iov.iov_base = (void *)data;
+  iov.iov_len = n;
+  return write_iov(fd, &iov, 1);
+}
+
 /******************************************************************************
  *
  * Constructor for MessagePipe
@@ -68,51 +159,193 @@ MessagePipe::~MessagePipe() {
  */
 
 int MessagePipe::send_message(const Message &msg) {
-  // prepare the total length of the information to be transmitted
-  long datasize = 4 /*sizeof code*/ + 4 /*sizeof length*/ + msg.length;
-
-  // allocate room for the data in buffer
-  unsigned char *buf = (unsigned char *)xmalloc(datasize);
-
-  // put the code of the message into the buffer (assuming code has at
-  // most 4 bytes)
-  buf[0] = (msg.code / (1)) % 256;
-  buf[1] = (msg.code / (256)) % 256;
-  buf[2] = (msg.code / (256 * 256)) % 256;
-  buf[3] = (msg.code / (256 * 256 * 256)) % 256;
-
-  // put the code of the length into the buffer (assuming the length
-  // has at most 4 bytes)
-  buf[4] = (msg.length / (1)) % 256;
-  buf[5] = (msg.length / (256)) % 256;
-  buf[6] = (msg.length / (256 * 256)) % 256;
-  buf[7] = (msg.length / (256 * 256 * 256)) % 256;
-
-  // copy the actual data into the buffer
-  if (msg.length > 0)
-    memcpy(buf + 8, msg.data, msg.length);
-
-  // now output the code onto the socket
-  long nWritten = 0;
-  unsigned char *ptr = buf;
-  while (nWritten < datasize) {
-    int n = write(sock, ptr, datasize - nWritten);
-
-
-    if (n == -1) {
-      // problem with writing the data to the socket
-      fprintf(stderr, "MessageQueue:send_message():write() error\n");
-      xfree(buf);
-      return 1;
-    }
-    nWritten += n;
-    ptr = ptr + n;
+  unsigned char header[8];
+  put_header(header, msg.code, msg.length);
+
+  // write the header and the data together, without copying the data
+  struct iovec iov[2];
+  iov[0].iov_base = header;
+  iov[0].iov_len = sizeof(header);
+  iov[1].iov_base = msg.data;
+  iov[1].iov_len = msg.length > 0 ? msg.length : 0;
+
+  if (write_iov(sock, iov, 2)) {
+    // problem with writing the data to the socket
+    fprintf(stderr, "MessageQueue:send_message():write() error\n");
+    return 1;
   }
 
-  xfree(buf);
   return 0;
 }
 
+/******************************************************************************
+ *
+ * int MessagePipe::send_stream( Code frame, Code end, int fd)
+ *
+ * - sends everything that can be read from fd through the socket, in
+ *   messages with code 'frame' of FRAME_SIZE bytes (the last one can be
+ *   shorter), followed by a message with code 'end', which is "y" if all
+ *   of fd was sent and "n" if reading it failed
+ * - the size of the data is not limited by the 4 byte length of messages
+ * - regular files are sent with sendfile() where it is available, other
+ *   data is read into a buffer and sent together with the frame header
+ *
+ * - returns:  0 - success
+ *            !0 - error writing to the socket
+ *
+ */
+
+int MessagePipe::send_stream(Code frame, Code end, int fd) {
+  unsigned char header[8];
+  struct iovec iov[2];
+  bool ok = true;
+
+#ifdef __linux__
+  struct stat st;
+  off_t offset = lseek(fd, 0, SEEK_CUR);
+  if (offset != -1 && fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+    long long remaining = st.st_size - offset;
+    while (remaining > 0) {
+      long length = remaining < FRAME_SIZE ? (long)remaining : FRAME_SIZE;
+      put_header(header, frame, length);
+      if (write_all(sock, header, sizeof(header)))
+        return 1;
+
+      long sent = 0;
+      while (sent < length) {
+        ssize_t n = sendfile(sock, fd, NULL, length - sent);
+        if (n == -1 && errno == EINTR)
+          continue;
+        if (n <= 0)
+          break;
+        sent += n;
+      }
+
+      if (sent < length) {
+        // the file got shorter or could not be read: complete the
+        // frame so that the other side stays in sync, and fail
+        static const char zeros[4096] = {0};
+        while (sent < length) {
+          long n = length - sent < (long)sizeof(zeros) ? length - sent
+                                                       : (long)sizeof(zeros);
+          if (write_all(sock, zeros, n))
+            return 1;
+          sent += n;
+        }
+        ok = false;
+        break;
+      }
+      remaining -= length;
+    }
+    return send_message(Message(end, ok ? "y" : "n", 2));
+  }
+#endif
+
+  char *data = (char *)xmalloc(FRAME_SIZE);
+  while (1) {
+    // fill a whole frame, unless the data ends
+    long length = 0;
+    while (length < FRAME_SIZE) {
+      ssize_t n = read(fd, data + length, FRAME_SIZE - length);
+      if (n == -1 && errno == EINTR)
+        continue;
+      if (n < 0)
+        ok = false;
+      if (n <= 0)
+        break;
+      length += n;
+    }
+
+    if (length > 0) {
+      put_header(header, frame, length);
+      iov[0].iov_base = header;
+      iov[0].iov_len = sizeof(header);
+      iov[1].iov_base = data;
+      iov[1].iov_len = length;
+      if (write_iov(sock, iov, 2)) {
+        xfree(data);
+        return 1;
+      }
+    }
+
+    if (length < FRAME_SIZE)
+      break;
+  }
+  xfree(data);
+
+  return send_message(Message(end, ok ? "y" : "n", 2));
+}
+
+/******************************************************************************
+ *
+ * int MessagePipe::receive_stream( Code frame, Code end, int fd)
+ *
+ * - receives the data sent by send_stream( frame, end, ...) and writes
+ *   it to fd as it arrives, so that it is never held in memory at once
+ * - other messages arriving in the meantime are put in the queue
+ * - if writing to fd fails, the rest of the data is still received, but
+ *   not written
+ *
+ * - returns:  0 - success
+ *             1 - error reading from the socket
+ *             2 - the other side could not read all of its data
+ *             3 - error writing to fd
+ *
+ */
+
+int MessagePipe::receive_stream(Code frame, Code end, int fd) {
+  int result = 0;
+
+  while (1) {
+    // frames may have been queued with the message preceding them, they
+    // come before anything in the buffer
+    Message *m = messageQueue.findAndRemove(frame);
+    if (m == NULL)
+      m = messageQueue.findAndRemove(end);
+    if (m != NULL) {
+      if (m->code == end) {
+        if (result == 0 && (m->length < 1 || m->data[0] != 'y'))
+          result = 2;
+        delete m;
+        return result;
+      }
+      if (result == 0 && write_all(fd, m->data, m->length))
+        result = 3;
+      delete m;
+      continue;
+    }
+
+    // read the header of the next message
+    while (nBytes < 8)
+      if (fill_buffer())
+        return 1;
+    Code c;
+    long l;
+    get_header(buffer, c, l);
+    consume(8);
+
+    if (c == frame) {
+      // pass the data of the frame on as it comes
+      while (l > 0) {
+        if (nBytes == 0 && fill_buffer())
+          return 1;
+        long n = nBytes < l ? nBytes : l;
+        if (result == 0 && write_all(fd, buffer, n))
+          result = 3;
+        consume(n);
+        l -= n;
+      }
+    } else {
+      // some other message (or the end), queue it
+      while (nBytes < l)
+        if (fill_buffer())
+          return 1;
+      messageQueue.addMessage(new Message(c, (char *)buffer, l));
+      consume(l);
+    }
+  }
+}
+
 /******************************************************************************
  *
  * Message * MessagePipe::get_message( Code code)
@@ -170,21 +403,105 @@ Message *MessagePipe::get_first_message(void) {
 
 /******************************************************************************
  *
- * int MessagePipe::receive_messages( void)
+ * int MessagePipe::fill_buffer( void)
  *
- * - reads a message from the socket and puts it in the message queue
+ * - reads more data from the socket at the end of the buffer, growing
+ *   the buffer if it is full
  *
  * - returns:   0 = success
  *             !0 = error
  *
  */
 
-int MessagePipe::receive_messages(void) {
-  int done = 0;
+int MessagePipe::fill_buffer(void) {
+  if (buffSize < STREAM_BUFFER_SIZE || nBytes == buffSize) {
+    buffSize =
+        buffSize < STREAM_BUFFER_SIZE ? STREAM_BUFFER_SIZE : 2 * buffSize;
+    buffer = (unsigned char *)xrealloc(buffer, buffSize);
+  }
+
+  ssize_t count;
+  do {
+    count = read(sock, buffer + nBytes, buffSize - nBytes);
+  } while (count == -1 && errno == EINTR);
+
+  if (count <= 0) {
+    fprintf(stderr, "MessagePipe:fill_buffer():read(): \n"
+                    "              - the other side is not responding\n");
+    close(sock);
+    sock = -1;
+    return 1;
+  }
+
+  nBytes += count;
+  return 0;
+}
+
+/******************************************************************************
+ *
+ * removes the first n bytes from the buffer
+ *
+ */
+
+void MessagePipe::consume(long n) {
+  memmove(buffer, buffer + n, nBytes - n);
+  nBytes -= n;
+}
+
+/******************************************************************************
+ *
+ * int MessagePipe::parse_messages( void)
+ *
+ * - moves the complete messages in the buffer to the message queue
+ *
+ * - returns:   the number of messages moved
+ *
+ */
+
+int MessagePipe::parse_messages(void) {
+  int count = 0;
   Code c = 0;
   long l = 0;
 
-  while (!done) {
+  // extract all messages from the raw data
+  while (nBytes >= 8) {
+
+    // extract the code and the length of the message from the buffer
+    get_header(buffer, c, l);
+
+    // now we have the length of the message. Do we have
+    // that much data in the buffer?
+    if (nBytes - 8 < l) {
+      break;
+    }
+
+    // create and add a message to the message queue
+    messageQueue.addMessage(new Message(c, (char *)buffer + 8, l));
+
+    // shift the buffer to delete the current message
+    consume(8 + l);
+    count++;
+  } // while( nbytes >= sizeof( size_t) + sizeof( uchar_t))
+
+  return count;
+}
+
+/******************************************************************************
+ *
+ * int MessagePipe::receive_messages( void)
+ *
+ * - reads a message from the socket and puts it in the message queue
+ * - messages already complete in the buffer (e.g. left there by
+ *   receive_stream) are queued without reading
+ *
+ * - returns:   0 = success
+ *             !0 = error
+ *
+ */
+
+int MessagePipe::receive_messages(void) {
+  // at least one message in the queue?
+  while (parse_messages() == 0) {
     // read incoming data from the socket
     // unsigned char newData[8192];
     unsigned char newData[4096];
@@ -210,37 +527,7 @@ int MessagePipe::receive_messages(void) {
     // append the new data at the end of the buffer
     memcpy(buffer + nBytes, newData, count);
     nBytes += count;
-
-    // extract all messages from the raw data
-    while (nBytes >= 8) {
-
-      // extract the code of the message from the buffer
-      c = buffer[0] + buffer[1] * 256 + buffer[2] * 256 * 256 +
-          buffer[3] * 256 * 256 * 256;
-
-      //	  debug_printf("c : %d\n",c);
-
-      // extract the length of data
-      l = buffer[4] + buffer[5] * 256 + buffer[6] * 256 * 256 +
-          buffer[7] * 256 * 256 * 256;
-
-      // now we have the length of the message. Do we have
-      // that much data in the buffer?
-      if (nBytes - 8 < l) {
-        break;
-      }
-
-      // create and add a message to the message queue
-      messageQueue.addMessage(new Message(c, (char *)buffer + 8, l));
-
-      // shift the buffer to delete the current message
-      memmove(buffer, buffer + 8 + l, nBytes - 8 - l);
-      nBytes -= 8 + l;
-
-      // and set a flag that we have at least one message
-      done = 1;
-    } // while( nbytes >= sizeof( size_t) + sizeof( uchar_t))
-  }   // while( ! done)
+  } // while( parse_messages() == 0)
 
   // return success
   return 0;
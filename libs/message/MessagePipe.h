@@ -35,6 +35,10 @@ public:
     Message *           get_first_message ( void);
     Message *                 get_message ( Code c);
 
+    // streamed transfer of data of any size, in frames
+    int                       send_stream ( Code frame, Code end, int fd);
+    int                    receive_stream ( Code frame, Code end, int fd);
+
 private:
 
     int                              sock ;
@@ -44,6 +48,9 @@ private:
     long                           nBytes ;
 
     int                  receive_messages ( void);
+    int                    parse_messages ( void);
+    int                       fill_buffer ( void);
+    void                          consume ( long n);
 };
 
 #endif
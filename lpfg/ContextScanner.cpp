@@ -12,10 +12,10 @@
 
 #include "ContextScanner.h"
 
-RightContextScanner *pgRContextScanner = NULL;
-LeftContextScanner *pgLContextScanner = NULL;
-RightContextScanner *pgRNContextScanner = NULL;
-LeftContextScanner *pgLNContextScanner = NULL;
+thread_local RightContextScanner *pgRContextScanner = NULL;
+thread_local LeftContextScanner *pgLContextScanner = NULL;
+thread_local RightContextScanner *pgRNContextScanner = NULL;
+thread_local LeftContextScanner *pgLNContextScanner = NULL;
 
 ContextScanner::ContextScanner(const LEngine &lengine,
                                LstringIterator &iterator, bool bRing,
@@ -43,18 +43,28 @@ bool RightContextScanner::Accept(__lc_ModuleIdType moduleId) {
   }
 
   size_t lastPosition = _iterator.Position();
+  // long runs of ignored modules are skipped using the index
+  // of the string, unless the module sought is ignored itself.
+  // It is consulted once when a run is entered, and not in
+  // rings, where a scan could then pass lastPosition
+  const bool bIndexed =
+      !_bRing && _lengine.Considered(moduleId, ConsiderGroup());
+  bool bLookup = bIndexed;
   while (_iterator.GetModuleId() != moduleId) {
     if (_iterator.AtEnd()) {
       return false;
     } else if (!_lengine.Considered(_iterator.GetModuleId(), ConsiderGroup())) {
-      _iterator.Advance(_bRing);
+      if (!bLookup || !_iterator.SkipIgnored(ConsiderGroup())) {
+        _iterator.Advance(_bRing);
+        bLookup = false;
+      }
     } else if (SB_id == _iterator.GetModuleId()) {
       // Skip the branch
-      _iterator.Advance(_bRing);
-      if (!_iterator.FindEOB(_bRing))
+      if (!_iterator.SkipBranch(_bRing))
         return false;
       else
         _iterator.Advance(_bRing);
+      bLookup = bIndexed;
     } else {
       break;
     }
@@ -83,10 +93,17 @@ bool LeftContextScanner::Accept(__lc_ModuleIdType moduleId) {
   _iterator.Back(_bRing);
 
   size_t lastPosition = _iterator.Position();
+  // long runs of ignored modules are skipped
+  // as in RightContextScanner::Accept
+  const bool bIndexed =
+      !_bRing && _lengine.Considered(moduleId, ConsiderGroup());
+  bool bLookup = bIndexed;
 
   while (_iterator.GetModuleId() != moduleId) {
     // skip ignored/not considered modules
     if (!_lengine.Considered(_iterator.GetModuleId(), ConsiderGroup())) {
+      if (!bLookup || !_iterator.SkipIgnoredBack(ConsiderGroup()))
+        bLookup = false;
       if (!_iterator.Back(_bRing))
         return false;
     }
@@ -96,16 +113,15 @@ bool LeftContextScanner::Accept(__lc_ModuleIdType moduleId) {
       // skip SB
       if (!_iterator.Back(_bRing))
         return false;
+      bLookup = bIndexed;
     }
     // if EB found
     else if (EB_id == _iterator.GetModuleId()) {
-      // and not at the beginning of the string
-      if (!_iterator.Back(_bRing)) {
-        return false;
-      }
-      if (!_iterator.FindBOB(_bRing))
+      // skip the branch
+      if (!_iterator.SkipBranchBack(_bRing))
         return false;
       _iterator.Back(_bRing);
+      bLookup = bIndexed;
     } else {
       break;
     }
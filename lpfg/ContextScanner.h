@@ -85,9 +85,9 @@ public:
   bool Advance() { return true; }
 };
 
-extern RightContextScanner *pgRContextScanner;
-extern LeftContextScanner *pgLContextScanner;
-extern RightContextScanner *pgRNContextScanner;
-extern LeftContextScanner *pgLNContextScanner;
+extern thread_local RightContextScanner *pgRContextScanner;
+extern thread_local LeftContextScanner *pgLContextScanner;
+extern thread_local RightContextScanner *pgRNContextScanner;
+extern thread_local LeftContextScanner *pgLNContextScanner;
 
 #endif
@@ -6,42 +6,104 @@
  *
  * ********************************************************************/
 
-#include <fstream>
-
-#include <Windows.h>
+#include <ostream>
 
 #include "PerformanceMonitor.h"
 
-LARGE_INTEGER PerformanceMonitor::sFrequency;
+bool PerformanceMonitor::sEnabled = false;
 PerformanceMonitor::GroupData PerformanceMonitor::groupData[];
+thread_local size_t PerformanceMonitor::sModules = 0;
+thread_local size_t PerformanceMonitor::sProductions = 0;
 
-PerformanceMonitor::Init::Init() {
-  ::QueryPerformanceFrequency(&(PerformanceMonitor::sFrequency));
-}
+// explicit Start/Stop may be called from any thread
+static thread_local std::chrono::steady_clock::time_point
+    lastStartTime[PerformanceMonitor::kMaxGroups];
 
-PerformanceMonitor::Init sInit;
+static const char *groupNames[PerformanceMonitor::kMaxGroups] = {
+    "simulation",
+    "match",
+    "environment",
+    "drawGL",
+    "derive",
+    "decompose",
+    "interpret",
+    "outputObj",
+    "outputPOVRay",
+    "outputRayshade",
+    "outputPostscript"};
 
 void PerformanceMonitor::Start(int iGroup) {
-  ::QueryPerformanceCounter(&(groupData[iGroup].mLastStartTime));
+  if (sEnabled)
+    lastStartTime[iGroup] = Clock::now();
 }
 
 void PerformanceMonitor::Stop(int iGroup) {
-  LARGE_INTEGER stopTime;
-  ::QueryPerformanceCounter(&stopTime);
-  LARGE_INTEGER delta;
-  delta.QuadPart =
-      stopTime.QuadPart - groupData[iGroup].mLastStartTime.QuadPart;
-  groupData[iGroup].mTotalTime.QuadPart += delta.QuadPart;
+  if (sEnabled)
+    AddTime(iGroup, Clock::now() - lastStartTime[iGroup]);
+}
+
+void PerformanceMonitor::AddTime(int iGroup, Clock::duration delta) {
+  groupData[iGroup].mTotalTime +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(delta).count();
+  ++groupData[iGroup].mCalls;
+}
+
+void PerformanceMonitor::Count(int iGroup, size_t modules, size_t bytes,
+                               size_t productions) {
+  if (!sEnabled)
+    return;
+  groupData[iGroup].mModules += modules;
+  groupData[iGroup].mBytes += bytes;
+  groupData[iGroup].mProductions += productions;
 }
 
 void PerformanceMonitor::Report(std::ostream &target) {
   for (int iGroup = 0; iGroup < kMaxGroups; ++iGroup) {
     double fTime = TimeGroup(iGroup);
-    target << "Group: " << iGroup << " --> " << fTime << " s\n";
+    target << "Group: " << iGroup << " (" << GroupName(iGroup) << ") --> "
+           << fTime << " s\n";
+  }
+}
+
+void PerformanceMonitor::ReportJSON(std::ostream &target) {
+  target << "{\n  \"groups\": [\n";
+  for (int iGroup = 0; iGroup < kMaxGroups; ++iGroup) {
+    const GroupData &data = groupData[iGroup];
+    target << "    { \"id\": " << iGroup << ", \"name\": \""
+           << GroupName(iGroup) << "\", \"time\": " << TimeGroup(iGroup)
+           << ", \"calls\": " << data.mCalls;
+    if (HasCounts(iGroup))
+      target << ", \"modules\": " << data.mModules
+             << ", \"bytes\": " << data.mBytes
+             << ", \"productions\": " << data.mProductions;
+    target << " }";
+    if (iGroup + 1 < kMaxGroups)
+      target << ',';
+    target << '\n';
+  }
+  target << "  ]\n}\n";
+}
+
+void PerformanceMonitor::ReportCSV(std::ostream &target) {
+  target << "id,name,time,calls,modules,bytes,productions\n";
+  for (int iGroup = 0; iGroup < kMaxGroups; ++iGroup) {
+    const GroupData &data = groupData[iGroup];
+    target << iGroup << ',' << GroupName(iGroup) << ',' << TimeGroup(iGroup)
+           << ',' << data.mCalls << ',';
+    // the counts are left empty for groups without them
+    if (HasCounts(iGroup))
+      target << data.mModules << ',' << data.mBytes << ','
+             << data.mProductions;
+    else
+      target << ",,";
+    target << '\n';
   }
 }
 
 double PerformanceMonitor::TimeGroup(int iGroup) {
-  return static_cast<double>(groupData[iGroup].mTotalTime.QuadPart) /
-         static_cast<double>(sFrequency.QuadPart);
+  return static_cast<double>(groupData[iGroup].mTotalTime) * 1e-9;
+}
+
+const char *PerformanceMonitor::GroupName(int iGroup) {
+  return groupNames[iGroup];
 }
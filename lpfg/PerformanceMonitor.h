@@ -9,67 +9,136 @@
 #ifndef __PERFORMANCEMONITOR_H__
 #define __PERFORMANCEMONITOR_H__
 
-#ifdef WIN32
-#include <Windows.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
 
 #define TIME_THIS(group) PerformanceMonitor::TimeThis timeThis(group)
-//#define TIME_THIS(group) void(group)
 
 class PerformanceMonitor {
 public:
+  // timing groups. The numbers of the first four
+  // are used by Interface::StartPerformance and the FPS output
+  enum Group {
+    pmSimulation = 0, // the whole simulation (DeriveString)
+    pmMatch,          // production matching, Start/StopPerformance
+    pmEnvironment,    // environmental step
+    pmDrawGL,         // drawing in the OpenGL window
+    pmDerive,         // derivation steps
+    pmDecompose,      // decomposition after each step
+    pmInterpret,      // interpretation to text file
+    pmOutputObj,
+    pmOutputPOVRay,
+    pmOutputRayshade,
+    pmOutputPostscript,
+    kMaxGroups
+  };
+
+  // timing is off by default, so that TIME_THIS
+  // costs a single test when not in timed mode
+  static void Enable(bool bEnable) { sEnabled = bEnable; }
+  static bool Enabled() { return sEnabled; }
+
   static void Start(int iGroup);
   static void Stop(int iGroup);
+  // adds to the counts of a group: modules processed,
+  // bytes of the L-string and productions applied
+  static void Count(int iGroup, size_t modules, size_t bytes,
+                    size_t productions);
+  // the simulation only records time, it is all of the
+  // other groups. Matching counts the modules matched against
+  // a group of productions and the predecessors tried
+  static bool HasCounts(int iGroup) { return iGroup != pmSimulation; }
+  // tallies modules processed and rules applied by the
+  // current thread for the innermost CountThis
+  static void Tally(size_t modules, size_t productions) {
+    if (sEnabled) {
+      sModules += modules;
+      sProductions += productions;
+    }
+  }
 
+  // human readable report
   static void Report(std::ostream &target);
+  // machine readable reports, one entry per group
+  static void ReportJSON(std::ostream &target);
+  static void ReportCSV(std::ostream &target);
 
   static double TimeGroup(int iGroup);
+  static const char *GroupName(int iGroup);
 
-  class Init {
+  class TimeThis {
   public:
-    Init();
-  };
+    TimeThis(int iGroup) : miGroup(iGroup), mbOn(Enabled()) {
+      if (mbOn)
+        mStartTime = Clock::now();
+    }
+    ~TimeThis() { Stop(); }
+    // ends the timing before the end of the scope
+    void Stop() {
+      if (mbOn)
+        PerformanceMonitor::AddTime(miGroup, Clock::now() - mStartTime);
+      mbOn = false;
+    }
+    // starts timing again after Stop
+    void Restart() {
+      if (!mbOn && Enabled()) {
+        mbOn = true;
+        mStartTime = Clock::now();
+      }
+    }
 
-  struct GroupData {
-    GroupData() { mTotalTime.QuadPart = 0L; }
-    LARGE_INTEGER mTotalTime;
-    LARGE_INTEGER mLastStartTime;
+  private:
+    int miGroup;
+    bool mbOn;
+    std::chrono::steady_clock::time_point mStartTime;
   };
 
-  class TimeThis {
+  // adds what was tallied while in scope to a group,
+  // together with the size of the L-string set by Bytes
+  class CountThis {
   public:
-    TimeThis(int iGroup) : miGroup(iGroup) {
-      PerformanceMonitor::Start(miGroup);
+    CountThis(int iGroup, size_t bytes = 0)
+        : miGroup(iGroup), mBytes(bytes), mModules(sModules),
+          mProductions(sProductions) {
+      sModules = sProductions = 0;
+    }
+    ~CountThis() {
+      Count(miGroup, sModules, mBytes, sProductions);
+      sModules = mModules;
+      sProductions = mProductions;
     }
-    ~TimeThis() { PerformanceMonitor::Stop(miGroup); }
+    void Bytes(size_t bytes) { mBytes = bytes; }
 
   private:
     int miGroup;
+    size_t mBytes;
+    // tallies of the enclosing scope
+    size_t mModules, mProductions;
   };
 
 private:
-  static LARGE_INTEGER sFrequency;
+  typedef std::chrono::steady_clock Clock;
 
-  static Init sInit;
-  static const int kMaxGroups = 10;
+  static void AddTime(int iGroup, Clock::duration delta);
 
-  static GroupData groupData[kMaxGroups];
-};
-
-#else // WIN32
-
-#define TIME_THIS(group) void(group)
+  // updated concurrently by parallel derivation
+  struct GroupData {
+    std::atomic<long long> mTotalTime; // in nanoseconds
+    std::atomic<long long> mCalls;
+    std::atomic<long long> mModules;
+    std::atomic<long long> mBytes;
+    std::atomic<long long> mProductions;
+  };
 
-class PerformanceMonitor {
-public:
-  static void Start(int iGroup) { (void)iGroup; }
-  static void Stop(int iGroup) { (void)iGroup; }
-  static void Report(std::ostream &target) { (void)target; }
-  static double TimeGroup(int iGroup) {
-    (void)iGroup;
-    return 0;
-  }
+  static bool sEnabled;
+  static GroupData groupData[kMaxGroups];
+  static thread_local size_t sModules, sProductions;
 };
 
+#else
+#ifdef WARN_MULTINC
+#warning File already included
 #endif
-
 #endif
@@ -1,108 +1,108 @@
 #ifndef __STDMODS_H__
 #define __STDMODS_H__
 
-   const __lc_ModuleIdType SB_id = 0;struct __SB_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __SB_ParamsStructSize = sizeof(__SB_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__SB_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__SB_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __SB_ParamsStructArr_ { __lc_ModuleIdType arr[__SB_ParamsStructSize]; };
-   const __lc_ModuleIdType EB_id = 1;struct __EB_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __EB_ParamsStructSize = sizeof(__EB_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__EB_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__EB_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __EB_ParamsStructArr_ { __lc_ModuleIdType arr[__EB_ParamsStructSize]; };
-   const __lc_ModuleIdType F_id = 2;struct __F_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __F_ParamsStructSize = sizeof(__F_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__F_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__F_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __F_ParamsStructArr_ { __lc_ModuleIdType arr[__F_ParamsStructSize]; };
-   const __lc_ModuleIdType f_id = 3;struct __f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __f_ParamsStructSize = sizeof(__f_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__f_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__f_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __f_ParamsStructArr_ { __lc_ModuleIdType arr[__f_ParamsStructSize]; };
-   const __lc_ModuleIdType Left_id = 4;struct __Left_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Left_ParamsStructSize = sizeof(__Left_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Left_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Left_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Left_ParamsStructArr_ { __lc_ModuleIdType arr[__Left_ParamsStructSize]; };
-   const __lc_ModuleIdType Right_id = 5;struct __Right_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Right_ParamsStructSize = sizeof(__Right_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Right_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Right_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Right_ParamsStructArr_ { __lc_ModuleIdType arr[__Right_ParamsStructSize]; };
-   const __lc_ModuleIdType Down_id = 6;struct __Down_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Down_ParamsStructSize = sizeof(__Down_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Down_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Down_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Down_ParamsStructArr_ { __lc_ModuleIdType arr[__Down_ParamsStructSize]; };
-   const __lc_ModuleIdType Up_id = 7;struct __Up_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Up_ParamsStructSize = sizeof(__Up_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Up_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Up_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Up_ParamsStructArr_ { __lc_ModuleIdType arr[__Up_ParamsStructSize]; };
-   const __lc_ModuleIdType RollL_id = 8;struct __RollL_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __RollL_ParamsStructSize = sizeof(__RollL_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__RollL_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__RollL_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __RollL_ParamsStructArr_ { __lc_ModuleIdType arr[__RollL_ParamsStructSize]; };
-   const __lc_ModuleIdType RollR_id = 9;struct __RollR_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __RollR_ParamsStructSize = sizeof(__RollR_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__RollR_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__RollR_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __RollR_ParamsStructArr_ { __lc_ModuleIdType arr[__RollR_ParamsStructSize]; };
-   const __lc_ModuleIdType IncColor_id = 10;struct __IncColor_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __IncColor_ParamsStructSize = sizeof(__IncColor_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__IncColor_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__IncColor_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __IncColor_ParamsStructArr_ { __lc_ModuleIdType arr[__IncColor_ParamsStructSize]; };
-   const __lc_ModuleIdType DecColor_id = 11;struct __DecColor_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __DecColor_ParamsStructSize = sizeof(__DecColor_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__DecColor_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__DecColor_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __DecColor_ParamsStructArr_ { __lc_ModuleIdType arr[__DecColor_ParamsStructSize]; };
-   const __lc_ModuleIdType SetColor_id = 12;struct __SetColor_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __SetColor_ParamsStructSize = sizeof(__SetColor_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__SetColor_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__SetColor_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __SetColor_ParamsStructArr_ { __lc_ModuleIdType arr[__SetColor_ParamsStructSize]; };
-   const __lc_ModuleIdType SetWidth_id = 13;struct __SetWidth_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __SetWidth_ParamsStructSize = sizeof(__SetWidth_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__SetWidth_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__SetWidth_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __SetWidth_ParamsStructArr_ { __lc_ModuleIdType arr[__SetWidth_ParamsStructSize]; };
-   const __lc_ModuleIdType Label_id = 14;struct __Label_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_Text Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Label_ParamsStructSize = sizeof(__Label_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Label_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Label_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Label_ParamsStructArr_ { __lc_ModuleIdType arr[__Label_ParamsStructSize]; };
-   const __lc_ModuleIdType TurnAround_id = 15;struct __TurnAround_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __TurnAround_ParamsStructSize = sizeof(__TurnAround_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__TurnAround_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__TurnAround_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __TurnAround_ParamsStructArr_ { __lc_ModuleIdType arr[__TurnAround_ParamsStructSize]; };
-   const __lc_ModuleIdType Cut_id = 16;struct __Cut_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __Cut_ParamsStructSize = sizeof(__Cut_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Cut_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Cut_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Cut_ParamsStructArr_ { __lc_ModuleIdType arr[__Cut_ParamsStructSize]; };
-     const __lc_ModuleIdType GetPos_id = 17;struct __GetPos_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  float Param2;  __lc_ModuleIdType moduleId2; } data; }; const int __GetPos_ParamsStructSize = sizeof(__GetPos_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__GetPos_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__GetPos_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __GetPos_ParamsStructArr_ { __lc_ModuleIdType arr[__GetPos_ParamsStructSize]; };
-     const __lc_ModuleIdType GetHead_id = 18;struct __GetHead_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  float Param2;  __lc_ModuleIdType moduleId2; } data; }; const int __GetHead_ParamsStructSize = sizeof(__GetHead_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__GetHead_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__GetHead_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __GetHead_ParamsStructArr_ { __lc_ModuleIdType arr[__GetHead_ParamsStructSize]; };
-     const __lc_ModuleIdType GetLeft_id = 19;struct __GetLeft_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  float Param2;  __lc_ModuleIdType moduleId2; } data; }; const int __GetLeft_ParamsStructSize = sizeof(__GetLeft_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__GetLeft_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__GetLeft_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __GetLeft_ParamsStructArr_ { __lc_ModuleIdType arr[__GetLeft_ParamsStructSize]; };
-     const __lc_ModuleIdType GetUp_id = 20;struct __GetUp_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  float Param2;  __lc_ModuleIdType moduleId2; } data; }; const int __GetUp_ParamsStructSize = sizeof(__GetUp_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__GetUp_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__GetUp_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __GetUp_ParamsStructArr_ { __lc_ModuleIdType arr[__GetUp_ParamsStructSize]; };
-   const __lc_ModuleIdType Circle_id = 21;struct __Circle_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Circle_ParamsStructSize = sizeof(__Circle_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Circle_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Circle_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Circle_ParamsStructArr_ { __lc_ModuleIdType arr[__Circle_ParamsStructSize]; };
-     const __lc_ModuleIdType MoveTo_id = 22;struct __MoveTo_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  float Param2;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveTo_ParamsStructSize = sizeof(__MoveTo_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__MoveTo_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__MoveTo_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __MoveTo_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveTo_ParamsStructSize]; };
-   const __lc_ModuleIdType Sphere_id = 23;struct __Sphere_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Sphere_ParamsStructSize = sizeof(__Sphere_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Sphere_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Sphere_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Sphere_ParamsStructArr_ { __lc_ModuleIdType arr[__Sphere_ParamsStructSize]; };
-        const __lc_ModuleIdType SetHead_id = 24;struct __SetHead_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  float Param2;  float Param3;  float Param4;  float Param5;  __lc_ModuleIdType moduleId2; } data; }; const int __SetHead_ParamsStructSize = sizeof(__SetHead_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__SetHead_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__SetHead_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __SetHead_ParamsStructArr_ { __lc_ModuleIdType arr[__SetHead_ParamsStructSize]; };
-   const __lc_ModuleIdType Sphere0_id = 25;struct __Sphere0_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __Sphere0_ParamsStructSize = sizeof(__Sphere0_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Sphere0_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Sphere0_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Sphere0_ParamsStructArr_ { __lc_ModuleIdType arr[__Sphere0_ParamsStructSize]; };
-   const __lc_ModuleIdType Circle0_id = 26;struct __Circle0_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __Circle0_ParamsStructSize = sizeof(__Circle0_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Circle0_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Circle0_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Circle0_ParamsStructArr_ { __lc_ModuleIdType arr[__Circle0_ParamsStructSize]; };
-    const __lc_ModuleIdType Line2f_id = 27;struct __Line2f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2tf Param0;  V2tf Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Line2f_ParamsStructSize = sizeof(__Line2f_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Line2f_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Line2f_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Line2f_ParamsStructArr_ { __lc_ModuleIdType arr[__Line2f_ParamsStructSize]; };
-    const __lc_ModuleIdType Line2d_id = 28;struct __Line2d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2td Param0;  V2td Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Line2d_ParamsStructSize = sizeof(__Line2d_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Line2d_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Line2d_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Line2d_ParamsStructArr_ { __lc_ModuleIdType arr[__Line2d_ParamsStructSize]; };
-    const __lc_ModuleIdType Line3f_id = 29;struct __Line3f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  V3tf Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Line3f_ParamsStructSize = sizeof(__Line3f_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Line3f_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Line3f_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Line3f_ParamsStructArr_ { __lc_ModuleIdType arr[__Line3f_ParamsStructSize]; };
-    const __lc_ModuleIdType Line3d_id = 30;struct __Line3d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3td Param0;  V3td Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Line3d_ParamsStructSize = sizeof(__Line3d_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Line3d_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Line3d_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Line3d_ParamsStructArr_ { __lc_ModuleIdType arr[__Line3d_ParamsStructSize]; };
-   const __lc_ModuleIdType LineTo2f_id = 31;struct __LineTo2f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __LineTo2f_ParamsStructSize = sizeof(__LineTo2f_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__LineTo2f_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__LineTo2f_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __LineTo2f_ParamsStructArr_ { __lc_ModuleIdType arr[__LineTo2f_ParamsStructSize]; };
-   const __lc_ModuleIdType LineTo2d_id = 32;struct __LineTo2d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2td Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __LineTo2d_ParamsStructSize = sizeof(__LineTo2d_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__LineTo2d_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__LineTo2d_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __LineTo2d_ParamsStructArr_ { __lc_ModuleIdType arr[__LineTo2d_ParamsStructSize]; };
-   const __lc_ModuleIdType LineTo3f_id = 33;struct __LineTo3f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __LineTo3f_ParamsStructSize = sizeof(__LineTo3f_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__LineTo3f_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__LineTo3f_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __LineTo3f_ParamsStructArr_ { __lc_ModuleIdType arr[__LineTo3f_ParamsStructSize]; };
-   const __lc_ModuleIdType LineTo3d_id = 34;struct __LineTo3d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3td Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __LineTo3d_ParamsStructSize = sizeof(__LineTo3d_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__LineTo3d_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__LineTo3d_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __LineTo3d_ParamsStructArr_ { __lc_ModuleIdType arr[__LineTo3d_ParamsStructSize]; };
-   const __lc_ModuleIdType LineRel2f_id = 35;struct __LineRel2f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __LineRel2f_ParamsStructSize = sizeof(__LineRel2f_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__LineRel2f_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__LineRel2f_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __LineRel2f_ParamsStructArr_ { __lc_ModuleIdType arr[__LineRel2f_ParamsStructSize]; };
-   const __lc_ModuleIdType LineRel2d_id = 36;struct __LineRel2d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2td Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __LineRel2d_ParamsStructSize = sizeof(__LineRel2d_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__LineRel2d_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__LineRel2d_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __LineRel2d_ParamsStructArr_ { __lc_ModuleIdType arr[__LineRel2d_ParamsStructSize]; };
-   const __lc_ModuleIdType LineRel3f_id = 37;struct __LineRel3f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __LineRel3f_ParamsStructSize = sizeof(__LineRel3f_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__LineRel3f_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__LineRel3f_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __LineRel3f_ParamsStructArr_ { __lc_ModuleIdType arr[__LineRel3f_ParamsStructSize]; };
-   const __lc_ModuleIdType LineRel3d_id = 38;struct __LineRel3d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3td Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __LineRel3d_ParamsStructSize = sizeof(__LineRel3d_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__LineRel3d_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__LineRel3d_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __LineRel3d_ParamsStructArr_ { __lc_ModuleIdType arr[__LineRel3d_ParamsStructSize]; };
-    const __lc_ModuleIdType Surface_id = 39;struct __Surface_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Surface_ParamsStructSize = sizeof(__Surface_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Surface_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Surface_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Surface_ParamsStructArr_ { __lc_ModuleIdType arr[__Surface_ParamsStructSize]; };
-   const __lc_ModuleIdType RollToVert_id = 40;struct __RollToVert_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __RollToVert_ParamsStructSize = sizeof(__RollToVert_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__RollToVert_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__RollToVert_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __RollToVert_ParamsStructArr_ { __lc_ModuleIdType arr[__RollToVert_ParamsStructSize]; };
-    const __lc_ModuleIdType SetElasticity_id = 41;struct __SetElasticity_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __SetElasticity_ParamsStructSize = sizeof(__SetElasticity_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__SetElasticity_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__SetElasticity_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __SetElasticity_ParamsStructArr_ { __lc_ModuleIdType arr[__SetElasticity_ParamsStructSize]; };
-   const __lc_ModuleIdType IncElasticity_id = 42;struct __IncElasticity_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __IncElasticity_ParamsStructSize = sizeof(__IncElasticity_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__IncElasticity_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__IncElasticity_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __IncElasticity_ParamsStructArr_ { __lc_ModuleIdType arr[__IncElasticity_ParamsStructSize]; };
-   const __lc_ModuleIdType DecElasticity_id = 43;struct __DecElasticity_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __DecElasticity_ParamsStructSize = sizeof(__DecElasticity_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__DecElasticity_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__DecElasticity_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __DecElasticity_ParamsStructArr_ { __lc_ModuleIdType arr[__DecElasticity_ParamsStructSize]; };
-   const __lc_ModuleIdType CurrentContour_id = 44;struct __CurrentContour_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __CurrentContour_ParamsStructSize = sizeof(__CurrentContour_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__CurrentContour_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__CurrentContour_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __CurrentContour_ParamsStructArr_ { __lc_ModuleIdType arr[__CurrentContour_ParamsStructSize]; };
-   const __lc_ModuleIdType StartGC_id = 45;struct __StartGC_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __StartGC_ParamsStructSize = sizeof(__StartGC_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__StartGC_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__StartGC_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __StartGC_ParamsStructArr_ { __lc_ModuleIdType arr[__StartGC_ParamsStructSize]; };
-   const __lc_ModuleIdType PointGC_id = 46;struct __PointGC_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __PointGC_ParamsStructSize = sizeof(__PointGC_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__PointGC_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__PointGC_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __PointGC_ParamsStructArr_ { __lc_ModuleIdType arr[__PointGC_ParamsStructSize]; };
-   const __lc_ModuleIdType EndGC_id = 47;struct __EndGC_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __EndGC_ParamsStructSize = sizeof(__EndGC_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__EndGC_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__EndGC_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __EndGC_ParamsStructArr_ { __lc_ModuleIdType arr[__EndGC_ParamsStructSize]; };
-   const __lc_ModuleIdType Mesh_id = 48;struct __Mesh_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Mesh_ParamsStructSize = sizeof(__Mesh_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Mesh_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Mesh_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Mesh_ParamsStructArr_ { __lc_ModuleIdType arr[__Mesh_ParamsStructSize]; };
-   const __lc_ModuleIdType E1_id = 49;struct __E1_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __E1_ParamsStructSize = sizeof(__E1_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__E1_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__E1_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __E1_ParamsStructArr_ { __lc_ModuleIdType arr[__E1_ParamsStructSize]; };
-   const __lc_ModuleIdType MoveTo2f_id = 50;struct __MoveTo2f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveTo2f_ParamsStructSize = sizeof(__MoveTo2f_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__MoveTo2f_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__MoveTo2f_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __MoveTo2f_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveTo2f_ParamsStructSize]; };
-   const __lc_ModuleIdType MoveTo2d_id = 51;struct __MoveTo2d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2td Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveTo2d_ParamsStructSize = sizeof(__MoveTo2d_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__MoveTo2d_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__MoveTo2d_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __MoveTo2d_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveTo2d_ParamsStructSize]; };
-   const __lc_ModuleIdType MoveTo3f_id = 52;struct __MoveTo3f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveTo3f_ParamsStructSize = sizeof(__MoveTo3f_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__MoveTo3f_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__MoveTo3f_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __MoveTo3f_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveTo3f_ParamsStructSize]; };
-   const __lc_ModuleIdType MoveTo3d_id = 53;struct __MoveTo3d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3td Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveTo3d_ParamsStructSize = sizeof(__MoveTo3d_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__MoveTo3d_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__MoveTo3d_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __MoveTo3d_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveTo3d_ParamsStructSize]; };
-    const __lc_ModuleIdType E2_id = 54;struct __E2_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __E2_ParamsStructSize = sizeof(__E2_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__E2_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__E2_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __E2_ParamsStructArr_ { __lc_ModuleIdType arr[__E2_ParamsStructSize]; };
-   const __lc_ModuleIdType SP_id = 55;struct __SP_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __SP_ParamsStructSize = sizeof(__SP_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__SP_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__SP_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __SP_ParamsStructArr_ { __lc_ModuleIdType arr[__SP_ParamsStructSize]; };
-   const __lc_ModuleIdType EP_id = 56;struct __EP_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __EP_ParamsStructSize = sizeof(__EP_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__EP_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__EP_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __EP_ParamsStructArr_ { __lc_ModuleIdType arr[__EP_ParamsStructSize]; };
-   const __lc_ModuleIdType PP_id = 57;struct __PP_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __PP_ParamsStructSize = sizeof(__PP_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__PP_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__PP_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __PP_ParamsStructArr_ { __lc_ModuleIdType arr[__PP_ParamsStructSize]; };
-    const __lc_ModuleIdType Rhombus_id = 58;struct __Rhombus_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Rhombus_ParamsStructSize = sizeof(__Rhombus_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Rhombus_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Rhombus_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Rhombus_ParamsStructArr_ { __lc_ModuleIdType arr[__Rhombus_ParamsStructSize]; };
-    const __lc_ModuleIdType Triangle_id = 59;struct __Triangle_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Triangle_ParamsStructSize = sizeof(__Triangle_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Triangle_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Triangle_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Triangle_ParamsStructArr_ { __lc_ModuleIdType arr[__Triangle_ParamsStructSize]; };
-   const __lc_ModuleIdType MouseIns_id = 60;struct __MouseIns_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __MouseIns_ParamsStructSize = sizeof(__MouseIns_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__MouseIns_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__MouseIns_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __MouseIns_ParamsStructArr_ { __lc_ModuleIdType arr[__MouseIns_ParamsStructSize]; };
-     const __lc_ModuleIdType BlendedContour_id = 61;struct __BlendedContour_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  int Param1;  float Param2;  __lc_ModuleIdType moduleId2; } data; }; const int __BlendedContour_ParamsStructSize = sizeof(__BlendedContour_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__BlendedContour_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__BlendedContour_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __BlendedContour_ParamsStructArr_ { __lc_ModuleIdType arr[__BlendedContour_ParamsStructSize]; };
-   const __lc_ModuleIdType CurrentTexture_id = 62;struct __CurrentTexture_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __CurrentTexture_ParamsStructSize = sizeof(__CurrentTexture_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__CurrentTexture_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__CurrentTexture_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __CurrentTexture_ParamsStructArr_ { __lc_ModuleIdType arr[__CurrentTexture_ParamsStructSize]; };
-   const __lc_ModuleIdType TextureVCoeff_id = 63;struct __TextureVCoeff_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __TextureVCoeff_ParamsStructSize = sizeof(__TextureVCoeff_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__TextureVCoeff_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__TextureVCoeff_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __TextureVCoeff_ParamsStructArr_ { __lc_ModuleIdType arr[__TextureVCoeff_ParamsStructSize]; };
-   const __lc_ModuleIdType Orient_id = 64;struct __Orient_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __Orient_ParamsStructSize = sizeof(__Orient_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Orient_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Orient_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Orient_ParamsStructArr_ { __lc_ModuleIdType arr[__Orient_ParamsStructSize]; };
-    const __lc_ModuleIdType ScaleContour_id = 65;struct __ScaleContour_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __ScaleContour_ParamsStructSize = sizeof(__ScaleContour_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__ScaleContour_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__ScaleContour_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __ScaleContour_ParamsStructArr_ { __lc_ModuleIdType arr[__ScaleContour_ParamsStructSize]; };
-   const __lc_ModuleIdType Elasticity_id = 66;struct __Elasticity_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Elasticity_ParamsStructSize = sizeof(__Elasticity_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Elasticity_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Elasticity_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Elasticity_ParamsStructArr_ { __lc_ModuleIdType arr[__Elasticity_ParamsStructSize]; };
-   const __lc_ModuleIdType DSurface_id = 67;struct __DSurface_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  SurfaceObj Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __DSurface_ParamsStructSize = sizeof(__DSurface_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__DSurface_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__DSurface_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __DSurface_ParamsStructArr_ { __lc_ModuleIdType arr[__DSurface_ParamsStructSize]; };
-   const __lc_ModuleIdType G_id = 68;struct __G_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __G_ParamsStructSize = sizeof(__G_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__G_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__G_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __G_ParamsStructArr_ { __lc_ModuleIdType arr[__G_ParamsStructSize]; };
-   const __lc_ModuleIdType g_id = 69;struct __g_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __g_ParamsStructSize = sizeof(__g_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__g_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__g_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __g_ParamsStructArr_ { __lc_ModuleIdType arr[__g_ParamsStructSize]; };
-   const __lc_ModuleIdType MouseInsPos_id = 70;struct __MouseInsPos_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  MouseStatus Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MouseInsPos_ParamsStructSize = sizeof(__MouseInsPos_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__MouseInsPos_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__MouseInsPos_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __MouseInsPos_ParamsStructArr_ { __lc_ModuleIdType arr[__MouseInsPos_ParamsStructSize]; };
-      const __lc_ModuleIdType Surface3_id = 71;struct __Surface3_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  float Param1;  float Param2;  float Param3;  __lc_ModuleIdType moduleId2; } data; }; const int __Surface3_ParamsStructSize = sizeof(__Surface3_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Surface3_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Surface3_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Surface3_ParamsStructArr_ { __lc_ModuleIdType arr[__Surface3_ParamsStructSize]; };
-   const __lc_ModuleIdType ContourSides_id = 72;struct __ContourSides_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __ContourSides_ParamsStructSize = sizeof(__ContourSides_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__ContourSides_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__ContourSides_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __ContourSides_ParamsStructArr_ { __lc_ModuleIdType arr[__ContourSides_ParamsStructSize]; };
-   const __lc_ModuleIdType InitSurface_id = 73;struct __InitSurface_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __InitSurface_ParamsStructSize = sizeof(__InitSurface_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__InitSurface_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__InitSurface_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __InitSurface_ParamsStructArr_ { __lc_ModuleIdType arr[__InitSurface_ParamsStructSize]; };
-     const __lc_ModuleIdType SurfacePoint_id = 74;struct __SurfacePoint_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  int Param1;  int Param2;  __lc_ModuleIdType moduleId2; } data; }; const int __SurfacePoint_ParamsStructSize = sizeof(__SurfacePoint_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__SurfacePoint_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__SurfacePoint_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __SurfacePoint_ParamsStructArr_ { __lc_ModuleIdType arr[__SurfacePoint_ParamsStructSize]; };
-   const __lc_ModuleIdType DrawSurface_id = 75;struct __DrawSurface_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __DrawSurface_ParamsStructSize = sizeof(__DrawSurface_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__DrawSurface_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__DrawSurface_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __DrawSurface_ParamsStructArr_ { __lc_ModuleIdType arr[__DrawSurface_ParamsStructSize]; };
-   const __lc_ModuleIdType Propensity_id = 76;struct __Propensity_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Propensity_ParamsStructSize = sizeof(__Propensity_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Propensity_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Propensity_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Propensity_ParamsStructArr_ { __lc_ModuleIdType arr[__Propensity_ParamsStructSize]; };
-   const __lc_ModuleIdType CircleFront_id = 77;struct __CircleFront_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __CircleFront_ParamsStructSize = sizeof(__CircleFront_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__CircleFront_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__CircleFront_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __CircleFront_ParamsStructArr_ { __lc_ModuleIdType arr[__CircleFront_ParamsStructSize]; };
-   const __lc_ModuleIdType CircleFront0_id = 78;struct __CircleFront0_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __CircleFront0_ParamsStructSize = sizeof(__CircleFront0_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__CircleFront0_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__CircleFront0_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __CircleFront0_ParamsStructArr_ { __lc_ModuleIdType arr[__CircleFront0_ParamsStructSize]; };
-   const __lc_ModuleIdType SetUPrecision_id = 79;struct __SetUPrecision_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __SetUPrecision_ParamsStructSize = sizeof(__SetUPrecision_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__SetUPrecision_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__SetUPrecision_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __SetUPrecision_ParamsStructArr_ { __lc_ModuleIdType arr[__SetUPrecision_ParamsStructSize]; };
-   const __lc_ModuleIdType SetVPrecision_id = 80;struct __SetVPrecision_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __SetVPrecision_ParamsStructSize = sizeof(__SetVPrecision_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__SetVPrecision_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__SetVPrecision_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __SetVPrecision_ParamsStructArr_ { __lc_ModuleIdType arr[__SetVPrecision_ParamsStructSize]; };
-     const __lc_ModuleIdType LineTo_id = 81;struct __LineTo_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  float Param2;  __lc_ModuleIdType moduleId2; } data; }; const int __LineTo_ParamsStructSize = sizeof(__LineTo_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__LineTo_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__LineTo_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __LineTo_ParamsStructArr_ { __lc_ModuleIdType arr[__LineTo_ParamsStructSize]; };
-    const __lc_ModuleIdType BSurface_id = 82;struct __BSurface_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __BSurface_ParamsStructSize = sizeof(__BSurface_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__BSurface_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__BSurface_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __BSurface_ParamsStructArr_ { __lc_ModuleIdType arr[__BSurface_ParamsStructSize]; };
-   const __lc_ModuleIdType MoveRel2f_id = 83;struct __MoveRel2f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveRel2f_ParamsStructSize = sizeof(__MoveRel2f_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__MoveRel2f_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__MoveRel2f_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __MoveRel2f_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveRel2f_ParamsStructSize]; };
-   const __lc_ModuleIdType MoveRel2d_id = 84;struct __MoveRel2d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2td Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveRel2d_ParamsStructSize = sizeof(__MoveRel2d_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__MoveRel2d_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__MoveRel2d_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __MoveRel2d_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveRel2d_ParamsStructSize]; };
-   const __lc_ModuleIdType MoveRel3f_id = 85;struct __MoveRel3f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveRel3f_ParamsStructSize = sizeof(__MoveRel3f_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__MoveRel3f_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__MoveRel3f_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __MoveRel3f_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveRel3f_ParamsStructSize]; };
-   const __lc_ModuleIdType MoveRel3d_id = 86;struct __MoveRel3d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3td Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveRel3d_ParamsStructSize = sizeof(__MoveRel3d_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__MoveRel3d_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__MoveRel3d_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __MoveRel3d_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveRel3d_ParamsStructSize]; };
-   const __lc_ModuleIdType DBSurfaceS_id = 87;struct __DBSurfaceS_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  BsurfaceObjS Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __DBSurfaceS_ParamsStructSize = sizeof(__DBSurfaceS_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__DBSurfaceS_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__DBSurfaceS_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __DBSurfaceS_ParamsStructArr_ { __lc_ModuleIdType arr[__DBSurfaceS_ParamsStructSize]; };
-   const __lc_ModuleIdType DBSurfaceM_id = 88;struct __DBSurfaceM_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  BsurfaceObjM Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __DBSurfaceM_ParamsStructSize = sizeof(__DBSurfaceM_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__DBSurfaceM_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__DBSurfaceM_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __DBSurfaceM_ParamsStructArr_ { __lc_ModuleIdType arr[__DBSurfaceM_ParamsStructSize]; };
-   const __lc_ModuleIdType Camera_id = 89;struct __Camera_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __Camera_ParamsStructSize = sizeof(__Camera_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Camera_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Camera_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Camera_ParamsStructArr_ { __lc_ModuleIdType arr[__Camera_ParamsStructSize]; };
-   const __lc_ModuleIdType EA20_id = 90;struct __EA20_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  EA20Array Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __EA20_ParamsStructSize = sizeof(__EA20_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__EA20_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__EA20_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __EA20_ParamsStructArr_ { __lc_ModuleIdType arr[__EA20_ParamsStructSize]; };
-    const __lc_ModuleIdType Rotate_id = 91;struct __Rotate_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Rotate_ParamsStructSize = sizeof(__Rotate_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Rotate_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Rotate_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Rotate_ParamsStructArr_ { __lc_ModuleIdType arr[__Rotate_ParamsStructSize]; };
-    const __lc_ModuleIdType RotateHLU_id = 92;struct __RotateHLU_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __RotateHLU_ParamsStructSize = sizeof(__RotateHLU_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__RotateHLU_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__RotateHLU_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __RotateHLU_ParamsStructArr_ { __lc_ModuleIdType arr[__RotateHLU_ParamsStructSize]; };
-    const __lc_ModuleIdType RotateXYZ_id = 93;struct __RotateXYZ_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __RotateXYZ_ParamsStructSize = sizeof(__RotateXYZ_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__RotateXYZ_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__RotateXYZ_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __RotateXYZ_ParamsStructArr_ { __lc_ModuleIdType arr[__RotateXYZ_ParamsStructSize]; };
-   const __lc_ModuleIdType Terrain_id = 94;struct __Terrain_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  CameraPosition Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Terrain_ParamsStructSize = sizeof(__Terrain_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Terrain_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Terrain_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Terrain_ParamsStructArr_ { __lc_ModuleIdType arr[__Terrain_ParamsStructSize]; };
-    const __lc_ModuleIdType PovRayStart_id = 95;struct __PovRayStart_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_Text Param0;  POVRayMeshMode Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __PovRayStart_ParamsStructSize = sizeof(__PovRayStart_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__PovRayStart_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__PovRayStart_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __PovRayStart_ParamsStructArr_ { __lc_ModuleIdType arr[__PovRayStart_ParamsStructSize]; };
-   const __lc_ModuleIdType SetHead3f_id = 96;struct __SetHead3f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __SetHead3f_ParamsStructSize = sizeof(__SetHead3f_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__SetHead3f_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__SetHead3f_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __SetHead3f_ParamsStructArr_ { __lc_ModuleIdType arr[__SetHead3f_ParamsStructSize]; };
-   const __lc_ModuleIdType SetTropismDirection3f_id = 97;struct __SetTropismDirection3f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __SetTropismDirection3f_ParamsStructSize = sizeof(__SetTropismDirection3f_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__SetTropismDirection3f_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__SetTropismDirection3f_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __SetTropismDirection3f_ParamsStructArr_ { __lc_ModuleIdType arr[__SetTropismDirection3f_ParamsStructSize]; };
-   const __lc_ModuleIdType CircleB_id = 98;struct __CircleB_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __CircleB_ParamsStructSize = sizeof(__CircleB_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__CircleB_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__CircleB_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __CircleB_ParamsStructArr_ { __lc_ModuleIdType arr[__CircleB_ParamsStructSize]; };
-   const __lc_ModuleIdType CircleFrontB_id = 99;struct __CircleFrontB_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __CircleFrontB_ParamsStructSize = sizeof(__CircleFrontB_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__CircleFrontB_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__CircleFrontB_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __CircleFrontB_ParamsStructArr_ { __lc_ModuleIdType arr[__CircleFrontB_ParamsStructSize]; };
-   const __lc_ModuleIdType SetCoordinateSystem_id = 100;struct __SetCoordinateSystem_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __SetCoordinateSystem_ParamsStructSize = sizeof(__SetCoordinateSystem_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__SetCoordinateSystem_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__SetCoordinateSystem_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __SetCoordinateSystem_ParamsStructArr_ { __lc_ModuleIdType arr[__SetCoordinateSystem_ParamsStructSize]; };
-      const __lc_ModuleIdType Mesh3_id = 101;struct __Mesh3_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  float Param1;  float Param2;  float Param3;  __lc_ModuleIdType moduleId2; } data; }; const int __Mesh3_ParamsStructSize = sizeof(__Mesh3_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__Mesh3_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__Mesh3_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __Mesh3_ParamsStructArr_ { __lc_ModuleIdType arr[__Mesh3_ParamsStructSize]; };
-   const __lc_ModuleIdType ContourNormal_id = 102;struct __ContourNormal_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __ContourNormal_ParamsStructSize = sizeof(__ContourNormal_ParamsStruct_) % sizeof(__lc_ModuleIdType) == 0 ? sizeof(__ContourNormal_ParamsStruct_) / sizeof(__lc_ModuleIdType) : sizeof(__ContourNormal_ParamsStruct_) / sizeof(__lc_ModuleIdType) + 1;struct __ContourNormal_ParamsStructArr_ { __lc_ModuleIdType arr[__ContourNormal_ParamsStructSize]; };
+   const __lc_ModuleIdType SB_id = 0;struct __SB_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __SB_ParamsStructSize = (sizeof(__SB_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __SB_ParamsStructArr_ { __lc_ModuleIdType arr[__SB_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__SB_ParamsStruct_) == 0, "parameters of module SB need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType EB_id = 1;struct __EB_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __EB_ParamsStructSize = (sizeof(__EB_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __EB_ParamsStructArr_ { __lc_ModuleIdType arr[__EB_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__EB_ParamsStruct_) == 0, "parameters of module EB need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType F_id = 2;struct __F_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __F_ParamsStructSize = (sizeof(__F_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __F_ParamsStructArr_ { __lc_ModuleIdType arr[__F_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__F_ParamsStruct_) == 0, "parameters of module F need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType f_id = 3;struct __f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __f_ParamsStructSize = (sizeof(__f_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __f_ParamsStructArr_ { __lc_ModuleIdType arr[__f_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__f_ParamsStruct_) == 0, "parameters of module f need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType Left_id = 4;struct __Left_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Left_ParamsStructSize = (sizeof(__Left_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Left_ParamsStructArr_ { __lc_ModuleIdType arr[__Left_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Left_ParamsStruct_) == 0, "parameters of module Left need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType Right_id = 5;struct __Right_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Right_ParamsStructSize = (sizeof(__Right_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Right_ParamsStructArr_ { __lc_ModuleIdType arr[__Right_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Right_ParamsStruct_) == 0, "parameters of module Right need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType Down_id = 6;struct __Down_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Down_ParamsStructSize = (sizeof(__Down_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Down_ParamsStructArr_ { __lc_ModuleIdType arr[__Down_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Down_ParamsStruct_) == 0, "parameters of module Down need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType Up_id = 7;struct __Up_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Up_ParamsStructSize = (sizeof(__Up_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Up_ParamsStructArr_ { __lc_ModuleIdType arr[__Up_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Up_ParamsStruct_) == 0, "parameters of module Up need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType RollL_id = 8;struct __RollL_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __RollL_ParamsStructSize = (sizeof(__RollL_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __RollL_ParamsStructArr_ { __lc_ModuleIdType arr[__RollL_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__RollL_ParamsStruct_) == 0, "parameters of module RollL need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType RollR_id = 9;struct __RollR_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __RollR_ParamsStructSize = (sizeof(__RollR_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __RollR_ParamsStructArr_ { __lc_ModuleIdType arr[__RollR_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__RollR_ParamsStruct_) == 0, "parameters of module RollR need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType IncColor_id = 10;struct __IncColor_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __IncColor_ParamsStructSize = (sizeof(__IncColor_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __IncColor_ParamsStructArr_ { __lc_ModuleIdType arr[__IncColor_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__IncColor_ParamsStruct_) == 0, "parameters of module IncColor need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType DecColor_id = 11;struct __DecColor_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __DecColor_ParamsStructSize = (sizeof(__DecColor_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __DecColor_ParamsStructArr_ { __lc_ModuleIdType arr[__DecColor_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__DecColor_ParamsStruct_) == 0, "parameters of module DecColor need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType SetColor_id = 12;struct __SetColor_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __SetColor_ParamsStructSize = (sizeof(__SetColor_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __SetColor_ParamsStructArr_ { __lc_ModuleIdType arr[__SetColor_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__SetColor_ParamsStruct_) == 0, "parameters of module SetColor need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType SetWidth_id = 13;struct __SetWidth_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __SetWidth_ParamsStructSize = (sizeof(__SetWidth_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __SetWidth_ParamsStructArr_ { __lc_ModuleIdType arr[__SetWidth_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__SetWidth_ParamsStruct_) == 0, "parameters of module SetWidth need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType Label_id = 14;struct __Label_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_Text Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Label_ParamsStructSize = (sizeof(__Label_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Label_ParamsStructArr_ { __lc_ModuleIdType arr[__Label_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Label_ParamsStruct_) == 0, "parameters of module Label need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType TurnAround_id = 15;struct __TurnAround_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __TurnAround_ParamsStructSize = (sizeof(__TurnAround_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __TurnAround_ParamsStructArr_ { __lc_ModuleIdType arr[__TurnAround_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__TurnAround_ParamsStruct_) == 0, "parameters of module TurnAround need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType Cut_id = 16;struct __Cut_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __Cut_ParamsStructSize = (sizeof(__Cut_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Cut_ParamsStructArr_ { __lc_ModuleIdType arr[__Cut_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Cut_ParamsStruct_) == 0, "parameters of module Cut need stronger alignment than __lc_MainAlignType");
+     const __lc_ModuleIdType GetPos_id = 17;struct __GetPos_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  float Param2;  __lc_ModuleIdType moduleId2; } data; }; const int __GetPos_ParamsStructSize = (sizeof(__GetPos_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __GetPos_ParamsStructArr_ { __lc_ModuleIdType arr[__GetPos_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__GetPos_ParamsStruct_) == 0, "parameters of module GetPos need stronger alignment than __lc_MainAlignType");
+     const __lc_ModuleIdType GetHead_id = 18;struct __GetHead_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  float Param2;  __lc_ModuleIdType moduleId2; } data; }; const int __GetHead_ParamsStructSize = (sizeof(__GetHead_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __GetHead_ParamsStructArr_ { __lc_ModuleIdType arr[__GetHead_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__GetHead_ParamsStruct_) == 0, "parameters of module GetHead need stronger alignment than __lc_MainAlignType");
+     const __lc_ModuleIdType GetLeft_id = 19;struct __GetLeft_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  float Param2;  __lc_ModuleIdType moduleId2; } data; }; const int __GetLeft_ParamsStructSize = (sizeof(__GetLeft_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __GetLeft_ParamsStructArr_ { __lc_ModuleIdType arr[__GetLeft_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__GetLeft_ParamsStruct_) == 0, "parameters of module GetLeft need stronger alignment than __lc_MainAlignType");
+     const __lc_ModuleIdType GetUp_id = 20;struct __GetUp_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  float Param2;  __lc_ModuleIdType moduleId2; } data; }; const int __GetUp_ParamsStructSize = (sizeof(__GetUp_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __GetUp_ParamsStructArr_ { __lc_ModuleIdType arr[__GetUp_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__GetUp_ParamsStruct_) == 0, "parameters of module GetUp need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType Circle_id = 21;struct __Circle_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Circle_ParamsStructSize = (sizeof(__Circle_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Circle_ParamsStructArr_ { __lc_ModuleIdType arr[__Circle_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Circle_ParamsStruct_) == 0, "parameters of module Circle need stronger alignment than __lc_MainAlignType");
+     const __lc_ModuleIdType MoveTo_id = 22;struct __MoveTo_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  float Param2;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveTo_ParamsStructSize = (sizeof(__MoveTo_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __MoveTo_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveTo_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__MoveTo_ParamsStruct_) == 0, "parameters of module MoveTo need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType Sphere_id = 23;struct __Sphere_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Sphere_ParamsStructSize = (sizeof(__Sphere_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Sphere_ParamsStructArr_ { __lc_ModuleIdType arr[__Sphere_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Sphere_ParamsStruct_) == 0, "parameters of module Sphere need stronger alignment than __lc_MainAlignType");
+        const __lc_ModuleIdType SetHead_id = 24;struct __SetHead_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  float Param2;  float Param3;  float Param4;  float Param5;  __lc_ModuleIdType moduleId2; } data; }; const int __SetHead_ParamsStructSize = (sizeof(__SetHead_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __SetHead_ParamsStructArr_ { __lc_ModuleIdType arr[__SetHead_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__SetHead_ParamsStruct_) == 0, "parameters of module SetHead need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType Sphere0_id = 25;struct __Sphere0_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __Sphere0_ParamsStructSize = (sizeof(__Sphere0_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Sphere0_ParamsStructArr_ { __lc_ModuleIdType arr[__Sphere0_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Sphere0_ParamsStruct_) == 0, "parameters of module Sphere0 need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType Circle0_id = 26;struct __Circle0_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __Circle0_ParamsStructSize = (sizeof(__Circle0_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Circle0_ParamsStructArr_ { __lc_ModuleIdType arr[__Circle0_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Circle0_ParamsStruct_) == 0, "parameters of module Circle0 need stronger alignment than __lc_MainAlignType");
+    const __lc_ModuleIdType Line2f_id = 27;struct __Line2f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2tf Param0;  V2tf Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Line2f_ParamsStructSize = (sizeof(__Line2f_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Line2f_ParamsStructArr_ { __lc_ModuleIdType arr[__Line2f_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Line2f_ParamsStruct_) == 0, "parameters of module Line2f need stronger alignment than __lc_MainAlignType");
+    const __lc_ModuleIdType Line2d_id = 28;struct __Line2d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2td Param0;  V2td Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Line2d_ParamsStructSize = (sizeof(__Line2d_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Line2d_ParamsStructArr_ { __lc_ModuleIdType arr[__Line2d_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Line2d_ParamsStruct_) == 0, "parameters of module Line2d need stronger alignment than __lc_MainAlignType");
+    const __lc_ModuleIdType Line3f_id = 29;struct __Line3f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  V3tf Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Line3f_ParamsStructSize = (sizeof(__Line3f_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Line3f_ParamsStructArr_ { __lc_ModuleIdType arr[__Line3f_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Line3f_ParamsStruct_) == 0, "parameters of module Line3f need stronger alignment than __lc_MainAlignType");
+    const __lc_ModuleIdType Line3d_id = 30;struct __Line3d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3td Param0;  V3td Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Line3d_ParamsStructSize = (sizeof(__Line3d_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Line3d_ParamsStructArr_ { __lc_ModuleIdType arr[__Line3d_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Line3d_ParamsStruct_) == 0, "parameters of module Line3d need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType LineTo2f_id = 31;struct __LineTo2f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __LineTo2f_ParamsStructSize = (sizeof(__LineTo2f_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __LineTo2f_ParamsStructArr_ { __lc_ModuleIdType arr[__LineTo2f_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__LineTo2f_ParamsStruct_) == 0, "parameters of module LineTo2f need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType LineTo2d_id = 32;struct __LineTo2d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2td Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __LineTo2d_ParamsStructSize = (sizeof(__LineTo2d_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __LineTo2d_ParamsStructArr_ { __lc_ModuleIdType arr[__LineTo2d_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__LineTo2d_ParamsStruct_) == 0, "parameters of module LineTo2d need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType LineTo3f_id = 33;struct __LineTo3f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __LineTo3f_ParamsStructSize = (sizeof(__LineTo3f_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __LineTo3f_ParamsStructArr_ { __lc_ModuleIdType arr[__LineTo3f_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__LineTo3f_ParamsStruct_) == 0, "parameters of module LineTo3f need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType LineTo3d_id = 34;struct __LineTo3d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3td Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __LineTo3d_ParamsStructSize = (sizeof(__LineTo3d_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __LineTo3d_ParamsStructArr_ { __lc_ModuleIdType arr[__LineTo3d_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__LineTo3d_ParamsStruct_) == 0, "parameters of module LineTo3d need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType LineRel2f_id = 35;struct __LineRel2f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __LineRel2f_ParamsStructSize = (sizeof(__LineRel2f_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __LineRel2f_ParamsStructArr_ { __lc_ModuleIdType arr[__LineRel2f_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__LineRel2f_ParamsStruct_) == 0, "parameters of module LineRel2f need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType LineRel2d_id = 36;struct __LineRel2d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2td Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __LineRel2d_ParamsStructSize = (sizeof(__LineRel2d_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __LineRel2d_ParamsStructArr_ { __lc_ModuleIdType arr[__LineRel2d_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__LineRel2d_ParamsStruct_) == 0, "parameters of module LineRel2d need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType LineRel3f_id = 37;struct __LineRel3f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __LineRel3f_ParamsStructSize = (sizeof(__LineRel3f_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __LineRel3f_ParamsStructArr_ { __lc_ModuleIdType arr[__LineRel3f_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__LineRel3f_ParamsStruct_) == 0, "parameters of module LineRel3f need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType LineRel3d_id = 38;struct __LineRel3d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3td Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __LineRel3d_ParamsStructSize = (sizeof(__LineRel3d_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __LineRel3d_ParamsStructArr_ { __lc_ModuleIdType arr[__LineRel3d_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__LineRel3d_ParamsStruct_) == 0, "parameters of module LineRel3d need stronger alignment than __lc_MainAlignType");
+    const __lc_ModuleIdType Surface_id = 39;struct __Surface_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Surface_ParamsStructSize = (sizeof(__Surface_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Surface_ParamsStructArr_ { __lc_ModuleIdType arr[__Surface_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Surface_ParamsStruct_) == 0, "parameters of module Surface need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType RollToVert_id = 40;struct __RollToVert_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __RollToVert_ParamsStructSize = (sizeof(__RollToVert_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __RollToVert_ParamsStructArr_ { __lc_ModuleIdType arr[__RollToVert_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__RollToVert_ParamsStruct_) == 0, "parameters of module RollToVert need stronger alignment than __lc_MainAlignType");
+    const __lc_ModuleIdType SetElasticity_id = 41;struct __SetElasticity_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __SetElasticity_ParamsStructSize = (sizeof(__SetElasticity_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __SetElasticity_ParamsStructArr_ { __lc_ModuleIdType arr[__SetElasticity_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__SetElasticity_ParamsStruct_) == 0, "parameters of module SetElasticity need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType IncElasticity_id = 42;struct __IncElasticity_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __IncElasticity_ParamsStructSize = (sizeof(__IncElasticity_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __IncElasticity_ParamsStructArr_ { __lc_ModuleIdType arr[__IncElasticity_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__IncElasticity_ParamsStruct_) == 0, "parameters of module IncElasticity need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType DecElasticity_id = 43;struct __DecElasticity_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __DecElasticity_ParamsStructSize = (sizeof(__DecElasticity_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __DecElasticity_ParamsStructArr_ { __lc_ModuleIdType arr[__DecElasticity_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__DecElasticity_ParamsStruct_) == 0, "parameters of module DecElasticity need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType CurrentContour_id = 44;struct __CurrentContour_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __CurrentContour_ParamsStructSize = (sizeof(__CurrentContour_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __CurrentContour_ParamsStructArr_ { __lc_ModuleIdType arr[__CurrentContour_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__CurrentContour_ParamsStruct_) == 0, "parameters of module CurrentContour need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType StartGC_id = 45;struct __StartGC_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __StartGC_ParamsStructSize = (sizeof(__StartGC_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __StartGC_ParamsStructArr_ { __lc_ModuleIdType arr[__StartGC_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__StartGC_ParamsStruct_) == 0, "parameters of module StartGC need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType PointGC_id = 46;struct __PointGC_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __PointGC_ParamsStructSize = (sizeof(__PointGC_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __PointGC_ParamsStructArr_ { __lc_ModuleIdType arr[__PointGC_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__PointGC_ParamsStruct_) == 0, "parameters of module PointGC need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType EndGC_id = 47;struct __EndGC_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __EndGC_ParamsStructSize = (sizeof(__EndGC_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __EndGC_ParamsStructArr_ { __lc_ModuleIdType arr[__EndGC_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__EndGC_ParamsStruct_) == 0, "parameters of module EndGC need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType Mesh_id = 48;struct __Mesh_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Mesh_ParamsStructSize = (sizeof(__Mesh_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Mesh_ParamsStructArr_ { __lc_ModuleIdType arr[__Mesh_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Mesh_ParamsStruct_) == 0, "parameters of module Mesh need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType E1_id = 49;struct __E1_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __E1_ParamsStructSize = (sizeof(__E1_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __E1_ParamsStructArr_ { __lc_ModuleIdType arr[__E1_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__E1_ParamsStruct_) == 0, "parameters of module E1 need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType MoveTo2f_id = 50;struct __MoveTo2f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveTo2f_ParamsStructSize = (sizeof(__MoveTo2f_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __MoveTo2f_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveTo2f_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__MoveTo2f_ParamsStruct_) == 0, "parameters of module MoveTo2f need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType MoveTo2d_id = 51;struct __MoveTo2d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2td Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveTo2d_ParamsStructSize = (sizeof(__MoveTo2d_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __MoveTo2d_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveTo2d_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__MoveTo2d_ParamsStruct_) == 0, "parameters of module MoveTo2d need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType MoveTo3f_id = 52;struct __MoveTo3f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveTo3f_ParamsStructSize = (sizeof(__MoveTo3f_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __MoveTo3f_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveTo3f_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__MoveTo3f_ParamsStruct_) == 0, "parameters of module MoveTo3f need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType MoveTo3d_id = 53;struct __MoveTo3d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3td Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveTo3d_ParamsStructSize = (sizeof(__MoveTo3d_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __MoveTo3d_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveTo3d_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__MoveTo3d_ParamsStruct_) == 0, "parameters of module MoveTo3d need stronger alignment than __lc_MainAlignType");
+    const __lc_ModuleIdType E2_id = 54;struct __E2_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __E2_ParamsStructSize = (sizeof(__E2_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __E2_ParamsStructArr_ { __lc_ModuleIdType arr[__E2_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__E2_ParamsStruct_) == 0, "parameters of module E2 need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType SP_id = 55;struct __SP_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __SP_ParamsStructSize = (sizeof(__SP_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __SP_ParamsStructArr_ { __lc_ModuleIdType arr[__SP_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__SP_ParamsStruct_) == 0, "parameters of module SP need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType EP_id = 56;struct __EP_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __EP_ParamsStructSize = (sizeof(__EP_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __EP_ParamsStructArr_ { __lc_ModuleIdType arr[__EP_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__EP_ParamsStruct_) == 0, "parameters of module EP need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType PP_id = 57;struct __PP_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __PP_ParamsStructSize = (sizeof(__PP_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __PP_ParamsStructArr_ { __lc_ModuleIdType arr[__PP_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__PP_ParamsStruct_) == 0, "parameters of module PP need stronger alignment than __lc_MainAlignType");
+    const __lc_ModuleIdType Rhombus_id = 58;struct __Rhombus_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Rhombus_ParamsStructSize = (sizeof(__Rhombus_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Rhombus_ParamsStructArr_ { __lc_ModuleIdType arr[__Rhombus_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Rhombus_ParamsStruct_) == 0, "parameters of module Rhombus need stronger alignment than __lc_MainAlignType");
+    const __lc_ModuleIdType Triangle_id = 59;struct __Triangle_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Triangle_ParamsStructSize = (sizeof(__Triangle_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Triangle_ParamsStructArr_ { __lc_ModuleIdType arr[__Triangle_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Triangle_ParamsStruct_) == 0, "parameters of module Triangle need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType MouseIns_id = 60;struct __MouseIns_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __MouseIns_ParamsStructSize = (sizeof(__MouseIns_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __MouseIns_ParamsStructArr_ { __lc_ModuleIdType arr[__MouseIns_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__MouseIns_ParamsStruct_) == 0, "parameters of module MouseIns need stronger alignment than __lc_MainAlignType");
+     const __lc_ModuleIdType BlendedContour_id = 61;struct __BlendedContour_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  int Param1;  float Param2;  __lc_ModuleIdType moduleId2; } data; }; const int __BlendedContour_ParamsStructSize = (sizeof(__BlendedContour_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __BlendedContour_ParamsStructArr_ { __lc_ModuleIdType arr[__BlendedContour_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__BlendedContour_ParamsStruct_) == 0, "parameters of module BlendedContour need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType CurrentTexture_id = 62;struct __CurrentTexture_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __CurrentTexture_ParamsStructSize = (sizeof(__CurrentTexture_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __CurrentTexture_ParamsStructArr_ { __lc_ModuleIdType arr[__CurrentTexture_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__CurrentTexture_ParamsStruct_) == 0, "parameters of module CurrentTexture need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType TextureVCoeff_id = 63;struct __TextureVCoeff_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __TextureVCoeff_ParamsStructSize = (sizeof(__TextureVCoeff_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __TextureVCoeff_ParamsStructArr_ { __lc_ModuleIdType arr[__TextureVCoeff_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__TextureVCoeff_ParamsStruct_) == 0, "parameters of module TextureVCoeff need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType Orient_id = 64;struct __Orient_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __Orient_ParamsStructSize = (sizeof(__Orient_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Orient_ParamsStructArr_ { __lc_ModuleIdType arr[__Orient_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Orient_ParamsStruct_) == 0, "parameters of module Orient need stronger alignment than __lc_MainAlignType");
+    const __lc_ModuleIdType ScaleContour_id = 65;struct __ScaleContour_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __ScaleContour_ParamsStructSize = (sizeof(__ScaleContour_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __ScaleContour_ParamsStructArr_ { __lc_ModuleIdType arr[__ScaleContour_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__ScaleContour_ParamsStruct_) == 0, "parameters of module ScaleContour need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType Elasticity_id = 66;struct __Elasticity_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Elasticity_ParamsStructSize = (sizeof(__Elasticity_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Elasticity_ParamsStructArr_ { __lc_ModuleIdType arr[__Elasticity_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Elasticity_ParamsStruct_) == 0, "parameters of module Elasticity need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType DSurface_id = 67;struct __DSurface_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  SurfaceObj Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __DSurface_ParamsStructSize = (sizeof(__DSurface_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __DSurface_ParamsStructArr_ { __lc_ModuleIdType arr[__DSurface_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__DSurface_ParamsStruct_) == 0, "parameters of module DSurface need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType G_id = 68;struct __G_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __G_ParamsStructSize = (sizeof(__G_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __G_ParamsStructArr_ { __lc_ModuleIdType arr[__G_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__G_ParamsStruct_) == 0, "parameters of module G need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType g_id = 69;struct __g_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __g_ParamsStructSize = (sizeof(__g_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __g_ParamsStructArr_ { __lc_ModuleIdType arr[__g_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__g_ParamsStruct_) == 0, "parameters of module g need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType MouseInsPos_id = 70;struct __MouseInsPos_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  MouseStatus Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MouseInsPos_ParamsStructSize = (sizeof(__MouseInsPos_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __MouseInsPos_ParamsStructArr_ { __lc_ModuleIdType arr[__MouseInsPos_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__MouseInsPos_ParamsStruct_) == 0, "parameters of module MouseInsPos need stronger alignment than __lc_MainAlignType");
+      const __lc_ModuleIdType Surface3_id = 71;struct __Surface3_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  float Param1;  float Param2;  float Param3;  __lc_ModuleIdType moduleId2; } data; }; const int __Surface3_ParamsStructSize = (sizeof(__Surface3_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Surface3_ParamsStructArr_ { __lc_ModuleIdType arr[__Surface3_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Surface3_ParamsStruct_) == 0, "parameters of module Surface3 need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType ContourSides_id = 72;struct __ContourSides_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __ContourSides_ParamsStructSize = (sizeof(__ContourSides_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __ContourSides_ParamsStructArr_ { __lc_ModuleIdType arr[__ContourSides_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__ContourSides_ParamsStruct_) == 0, "parameters of module ContourSides need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType InitSurface_id = 73;struct __InitSurface_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __InitSurface_ParamsStructSize = (sizeof(__InitSurface_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __InitSurface_ParamsStructArr_ { __lc_ModuleIdType arr[__InitSurface_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__InitSurface_ParamsStruct_) == 0, "parameters of module InitSurface need stronger alignment than __lc_MainAlignType");
+     const __lc_ModuleIdType SurfacePoint_id = 74;struct __SurfacePoint_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  int Param1;  int Param2;  __lc_ModuleIdType moduleId2; } data; }; const int __SurfacePoint_ParamsStructSize = (sizeof(__SurfacePoint_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __SurfacePoint_ParamsStructArr_ { __lc_ModuleIdType arr[__SurfacePoint_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__SurfacePoint_ParamsStruct_) == 0, "parameters of module SurfacePoint need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType DrawSurface_id = 75;struct __DrawSurface_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __DrawSurface_ParamsStructSize = (sizeof(__DrawSurface_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __DrawSurface_ParamsStructArr_ { __lc_ModuleIdType arr[__DrawSurface_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__DrawSurface_ParamsStruct_) == 0, "parameters of module DrawSurface need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType Propensity_id = 76;struct __Propensity_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Propensity_ParamsStructSize = (sizeof(__Propensity_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Propensity_ParamsStructArr_ { __lc_ModuleIdType arr[__Propensity_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Propensity_ParamsStruct_) == 0, "parameters of module Propensity need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType CircleFront_id = 77;struct __CircleFront_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __CircleFront_ParamsStructSize = (sizeof(__CircleFront_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __CircleFront_ParamsStructArr_ { __lc_ModuleIdType arr[__CircleFront_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__CircleFront_ParamsStruct_) == 0, "parameters of module CircleFront need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType CircleFront0_id = 78;struct __CircleFront0_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __CircleFront0_ParamsStructSize = (sizeof(__CircleFront0_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __CircleFront0_ParamsStructArr_ { __lc_ModuleIdType arr[__CircleFront0_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__CircleFront0_ParamsStruct_) == 0, "parameters of module CircleFront0 need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType SetUPrecision_id = 79;struct __SetUPrecision_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __SetUPrecision_ParamsStructSize = (sizeof(__SetUPrecision_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __SetUPrecision_ParamsStructArr_ { __lc_ModuleIdType arr[__SetUPrecision_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__SetUPrecision_ParamsStruct_) == 0, "parameters of module SetUPrecision need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType SetVPrecision_id = 80;struct __SetVPrecision_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __SetVPrecision_ParamsStructSize = (sizeof(__SetVPrecision_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __SetVPrecision_ParamsStructArr_ { __lc_ModuleIdType arr[__SetVPrecision_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__SetVPrecision_ParamsStruct_) == 0, "parameters of module SetVPrecision need stronger alignment than __lc_MainAlignType");
+     const __lc_ModuleIdType LineTo_id = 81;struct __LineTo_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  float Param1;  float Param2;  __lc_ModuleIdType moduleId2; } data; }; const int __LineTo_ParamsStructSize = (sizeof(__LineTo_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __LineTo_ParamsStructArr_ { __lc_ModuleIdType arr[__LineTo_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__LineTo_ParamsStruct_) == 0, "parameters of module LineTo need stronger alignment than __lc_MainAlignType");
+    const __lc_ModuleIdType BSurface_id = 82;struct __BSurface_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __BSurface_ParamsStructSize = (sizeof(__BSurface_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __BSurface_ParamsStructArr_ { __lc_ModuleIdType arr[__BSurface_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__BSurface_ParamsStruct_) == 0, "parameters of module BSurface need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType MoveRel2f_id = 83;struct __MoveRel2f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveRel2f_ParamsStructSize = (sizeof(__MoveRel2f_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __MoveRel2f_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveRel2f_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__MoveRel2f_ParamsStruct_) == 0, "parameters of module MoveRel2f need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType MoveRel2d_id = 84;struct __MoveRel2d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V2td Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveRel2d_ParamsStructSize = (sizeof(__MoveRel2d_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __MoveRel2d_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveRel2d_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__MoveRel2d_ParamsStruct_) == 0, "parameters of module MoveRel2d need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType MoveRel3f_id = 85;struct __MoveRel3f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveRel3f_ParamsStructSize = (sizeof(__MoveRel3f_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __MoveRel3f_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveRel3f_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__MoveRel3f_ParamsStruct_) == 0, "parameters of module MoveRel3f need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType MoveRel3d_id = 86;struct __MoveRel3d_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3td Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __MoveRel3d_ParamsStructSize = (sizeof(__MoveRel3d_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __MoveRel3d_ParamsStructArr_ { __lc_ModuleIdType arr[__MoveRel3d_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__MoveRel3d_ParamsStruct_) == 0, "parameters of module MoveRel3d need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType DBSurfaceS_id = 87;struct __DBSurfaceS_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  BsurfaceObjS Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __DBSurfaceS_ParamsStructSize = (sizeof(__DBSurfaceS_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __DBSurfaceS_ParamsStructArr_ { __lc_ModuleIdType arr[__DBSurfaceS_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__DBSurfaceS_ParamsStruct_) == 0, "parameters of module DBSurfaceS need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType DBSurfaceM_id = 88;struct __DBSurfaceM_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  BsurfaceObjM Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __DBSurfaceM_ParamsStructSize = (sizeof(__DBSurfaceM_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __DBSurfaceM_ParamsStructArr_ { __lc_ModuleIdType arr[__DBSurfaceM_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__DBSurfaceM_ParamsStruct_) == 0, "parameters of module DBSurfaceM need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType Camera_id = 89;struct __Camera_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_ModuleIdType moduleId2; } data; }; const int __Camera_ParamsStructSize = (sizeof(__Camera_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Camera_ParamsStructArr_ { __lc_ModuleIdType arr[__Camera_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Camera_ParamsStruct_) == 0, "parameters of module Camera need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType EA20_id = 90;struct __EA20_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  EA20Array Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __EA20_ParamsStructSize = (sizeof(__EA20_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __EA20_ParamsStructArr_ { __lc_ModuleIdType arr[__EA20_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__EA20_ParamsStruct_) == 0, "parameters of module EA20 need stronger alignment than __lc_MainAlignType");
+    const __lc_ModuleIdType Rotate_id = 91;struct __Rotate_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __Rotate_ParamsStructSize = (sizeof(__Rotate_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Rotate_ParamsStructArr_ { __lc_ModuleIdType arr[__Rotate_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Rotate_ParamsStruct_) == 0, "parameters of module Rotate need stronger alignment than __lc_MainAlignType");
+    const __lc_ModuleIdType RotateHLU_id = 92;struct __RotateHLU_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __RotateHLU_ParamsStructSize = (sizeof(__RotateHLU_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __RotateHLU_ParamsStructArr_ { __lc_ModuleIdType arr[__RotateHLU_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__RotateHLU_ParamsStruct_) == 0, "parameters of module RotateHLU need stronger alignment than __lc_MainAlignType");
+    const __lc_ModuleIdType RotateXYZ_id = 93;struct __RotateXYZ_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  float Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __RotateXYZ_ParamsStructSize = (sizeof(__RotateXYZ_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __RotateXYZ_ParamsStructArr_ { __lc_ModuleIdType arr[__RotateXYZ_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__RotateXYZ_ParamsStruct_) == 0, "parameters of module RotateXYZ need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType Terrain_id = 94;struct __Terrain_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  CameraPosition Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __Terrain_ParamsStructSize = (sizeof(__Terrain_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Terrain_ParamsStructArr_ { __lc_ModuleIdType arr[__Terrain_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Terrain_ParamsStruct_) == 0, "parameters of module Terrain need stronger alignment than __lc_MainAlignType");
+    const __lc_ModuleIdType PovRayStart_id = 95;struct __PovRayStart_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  __lc_Text Param0;  POVRayMeshMode Param1;  __lc_ModuleIdType moduleId2; } data; }; const int __PovRayStart_ParamsStructSize = (sizeof(__PovRayStart_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __PovRayStart_ParamsStructArr_ { __lc_ModuleIdType arr[__PovRayStart_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__PovRayStart_ParamsStruct_) == 0, "parameters of module PovRayStart need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType SetHead3f_id = 96;struct __SetHead3f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __SetHead3f_ParamsStructSize = (sizeof(__SetHead3f_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __SetHead3f_ParamsStructArr_ { __lc_ModuleIdType arr[__SetHead3f_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__SetHead3f_ParamsStruct_) == 0, "parameters of module SetHead3f need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType SetTropismDirection3f_id = 97;struct __SetTropismDirection3f_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __SetTropismDirection3f_ParamsStructSize = (sizeof(__SetTropismDirection3f_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __SetTropismDirection3f_ParamsStructArr_ { __lc_ModuleIdType arr[__SetTropismDirection3f_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__SetTropismDirection3f_ParamsStruct_) == 0, "parameters of module SetTropismDirection3f need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType CircleB_id = 98;struct __CircleB_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __CircleB_ParamsStructSize = (sizeof(__CircleB_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __CircleB_ParamsStructArr_ { __lc_ModuleIdType arr[__CircleB_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__CircleB_ParamsStruct_) == 0, "parameters of module CircleB need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType CircleFrontB_id = 99;struct __CircleFrontB_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __CircleFrontB_ParamsStructSize = (sizeof(__CircleFrontB_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __CircleFrontB_ParamsStructArr_ { __lc_ModuleIdType arr[__CircleFrontB_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__CircleFrontB_ParamsStruct_) == 0, "parameters of module CircleFrontB need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType SetCoordinateSystem_id = 100;struct __SetCoordinateSystem_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  float Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __SetCoordinateSystem_ParamsStructSize = (sizeof(__SetCoordinateSystem_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __SetCoordinateSystem_ParamsStructArr_ { __lc_ModuleIdType arr[__SetCoordinateSystem_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__SetCoordinateSystem_ParamsStruct_) == 0, "parameters of module SetCoordinateSystem need stronger alignment than __lc_MainAlignType");
+      const __lc_ModuleIdType Mesh3_id = 101;struct __Mesh3_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  int Param0;  float Param1;  float Param2;  float Param3;  __lc_ModuleIdType moduleId2; } data; }; const int __Mesh3_ParamsStructSize = (sizeof(__Mesh3_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __Mesh3_ParamsStructArr_ { __lc_ModuleIdType arr[__Mesh3_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__Mesh3_ParamsStruct_) == 0, "parameters of module Mesh3 need stronger alignment than __lc_MainAlignType");
+   const __lc_ModuleIdType ContourNormal_id = 102;struct __ContourNormal_ParamsStruct_ { struct Data { __lc_ModuleIdType moduleId;  V3tf Param0;  __lc_ModuleIdType moduleId2; } data; }; const int __ContourNormal_ParamsStructSize = (sizeof(__ContourNormal_ParamsStruct_) + sizeof(__lc_MainAlignType) - 1) / sizeof(__lc_MainAlignType) * (sizeof(__lc_MainAlignType) / sizeof(__lc_ModuleIdType));struct __ContourNormal_ParamsStructArr_ { __lc_ModuleIdType arr[__ContourNormal_ParamsStructSize]; };static_assert(sizeof(__lc_MainAlignType) % alignof(__ContourNormal_ParamsStruct_) == 0, "parameters of module ContourNormal need stronger alignment than __lc_MainAlignType");
 
 #endif
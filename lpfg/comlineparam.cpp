@@ -26,6 +26,7 @@
 #include "contourarr.h"
 #include "funcs.h"
 #include "envparams.h"
+#include "PerformanceMonitor.h"
 #include <string.h>
 
 const int eDefaultSize =
@@ -64,6 +65,7 @@ ComndLineParam::ComndLineParam() {
   _CheckNumeric(false);
   _SetLDll(false);
   _SetModeFlag(false, moCompileOnly);
+  _derivationThreads = 1;
   _wndOptions = 0;
   _initRect.left = _initRect.right = _initRect.top = _initRect.bottom =
       eDefaultSize;
@@ -242,6 +244,12 @@ void ComndLineParam::_ParseOption(char **argv, int &i) {
     _SetModeFlag(true, moCleanEA20);
   else if (!(strcmp("-dtfes", opt)))
     _SetModeFlag(true, moToStringEveryStep);
+  else if (!(strcmp("-incr", opt)))
+    _SetModeFlag(true, moIncremental);
+  else if (!(strcmp("-threads", opt)))
+    _SetDerivationThreads(i, argv);
+  else if (!(strcmp("-nocache", opt)))
+    _SetModeFlag(true, moNoDllCache);
   else
     Utils::Message("Unrecognized command line option: %s\n", argv[i]);
 }
@@ -348,7 +356,19 @@ void ComndLineParam::_SetDll(int &i, char **argv) {
   _SetLDll(true);
 }
 
+void ComndLineParam::_SetDerivationThreads(int &i, char **argv) {
+  ++i;
+  _derivationThreads = atoi(argv[i]);
+  // 0 means: use all available cores
+  if (_derivationThreads < 0) {
+    Utils::Message("Invalid number of threads: %s. Ignored\n", argv[i]);
+    _derivationThreads = 1;
+  }
+}
+
 void ComndLineParam::Apply() {
+  PerformanceMonitor::Enable(TimedMode());
+
   if (ColormapMode() && ColormapfileSpecified()) {
     try {
       gl.LoadColormap(_colorfile);
@@ -113,6 +113,9 @@ public:
   bool InterpretToFile() const { return _IsModeFlagSet(moInterpretToFile); }
   bool CleanEA20() const { return _IsModeFlagSet(moCleanEA20); }
   bool ToStringEveryStep() const { return _IsModeFlagSet(moToStringEveryStep); }
+  bool IncrementalMode() const { return _IsModeFlagSet(moIncremental); }
+  int DerivationThreads() const { return _derivationThreads; }
+  bool NoDllCache() const { return _IsModeFlagSet(moNoDllCache); }
 
   // Pascal
   void SetTexturefile(const char *f) { _SetTexturefile(f); }
@@ -153,6 +156,8 @@ private:
     moInterpretToFile = 1 << 15,
     moCleanEA20 = 1 << 16,
     moToStringEveryStep = 1 << 17,
+    moIncremental = 1 << 18,
+    moNoDllCache = 1 << 19,
   };
   unsigned int _fMode;
 
@@ -201,6 +206,8 @@ private:
   std::string _path;
   void _SetDll(int &, char **);
   std::string _dll;
+  void _SetDerivationThreads(int &, char **);
+  int _derivationThreads;
 
   void _SetWindowRelSize(int &, char **);
   void _SetWindowRelPosition(int &, char **);
@@ -0,0 +1,123 @@
+/* ******************************************************************** *
+   Copyright (C) 1990-2022 University of Calgary
+  
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+  
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+  
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ******************************************************************** */
+
+
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "dllcache.h"
+#include "lpfgparams.h"
+#include "utils.h"
+
+namespace {
+// 64-bit FNV-1a
+const unsigned long long kFNVOffset = 14695981039346656037ULL;
+const unsigned long long kFNVPrime = 1099511628211ULL;
+} // namespace
+
+DllCache::DllCache(const char *preprocessed) {
+  if (0 == preprocessed)
+    return;
+  const std::string dir = _Directory();
+  if (dir.empty())
+    return;
+  Hash hash = kFNVOffset;
+  // the L-system, with the lpfg headers it includes
+  if (!_HashFile(preprocessed, hash))
+    return;
+  // the translator and the compiler settings
+  const std::string translator = _FindInPath("l2c");
+  const std::string script = _FindInPath(LPFGParams::CompileScript);
+  if (translator.empty() || script.empty())
+    return;
+  if (!_HashFile(translator, hash) || !_HashFile(script, hash) ||
+      !_HashFile(_Makefile(), hash))
+    return;
+
+  char bf[32];
+  sprintf(bf, "%016llx", hash);
+  _entry = dir + bf;
+  // keep the extension of the compiled L-system
+  const char *ext = strrchr(LPFGParams::CompiledLsys, '.');
+  if (0 != ext)
+    _entry.append(ext);
+}
+
+bool DllCache::Fetch(const char *trg) const {
+  if (!Valid())
+    return false;
+  {
+    std::ifstream src(_entry.c_str(), std::ios::binary);
+    if (!src.is_open())
+      return false;
+  }
+  Utils::RemoveFile(trg);
+  if (_CopyFile(_entry, trg))
+    return true;
+  Utils::RemoveFile(trg);
+  return false;
+}
+
+void DllCache::Store(const char *src) const {
+  if (!Valid())
+    return;
+  // copy under a temporary name first so that
+  // other processes never see a partial entry
+  const std::string tmp = _TempName(_entry);
+  if (!_CopyFile(src, tmp) || !_Rename(tmp, _entry))
+    Utils::RemoveFile(tmp.c_str());
+}
+
+bool DllCache::_HashFile(const std::string &fname, Hash &hash) {
+  std::ifstream src(fname.c_str(), std::ios::binary);
+  if (!src.is_open())
+    return false;
+  char bf[16384];
+  while (src.read(bf, sizeof(bf)) || src.gcount() > 0) {
+    const std::streamsize n = src.gcount();
+    for (std::streamsize i = 0; i < n; ++i) {
+      hash ^= static_cast<unsigned char>(bf[i]);
+      hash *= kFNVPrime;
+    }
+  }
+  // separate the files
+  hash ^= 0xff;
+  hash *= kFNVPrime;
+  return true;
+}
+
+bool DllCache::_CopyFile(const std::string &src, const std::string &trg) {
+  std::ifstream in(src.c_str(), std::ios::binary);
+  if (!in.is_open())
+    return false;
+  std::ofstream out(trg.c_str(), std::ios::binary);
+  if (!out.is_open())
+    return false;
+  out << in.rdbuf();
+  out.close();
+  return !out.fail();
+}
+
+#ifdef _WINDOWS
+#include "dllcacheWin.imp"
+#endif
+
+#ifdef LINUX
+#include "dllcacheLnx.imp"
+#endif
@@ -0,0 +1,61 @@
+/* ******************************************************************** *
+   Copyright (C) 1990-2022 University of Calgary
+  
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+  
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+  
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ******************************************************************** */
+
+
+
+#ifndef __DLLCACHE_H__
+#define __DLLCACHE_H__
+
+#include <string>
+
+// Cache of compiled L-systems in the user's cache directory.
+// Entries are keyed by the hash of the preprocessed L-system,
+// the translator and the makefile used to compile it, so an
+// unchanged model is connected without being translated
+// and compiled again.
+class DllCache {
+public:
+  // no cache if preprocessed is 0
+  DllCache(const char *preprocessed);
+  // false if there is no cache directory
+  // or the key could not be computed
+  bool Valid() const { return !_entry.empty(); }
+  // copies the cached L-system to trg, false if not in the cache
+  bool Fetch(const char *trg) const;
+  // adds the compiled L-system to the cache
+  void Store(const char *src) const;
+
+private:
+  typedef unsigned long long Hash;
+  static bool _HashFile(const std::string &, Hash &);
+  static bool _CopyFile(const std::string &, const std::string &);
+
+  // platform dependent
+  static std::string _Directory();
+  static std::string _FindInPath(const char *);
+  static std::string _Makefile();
+  static std::string _TempName(const std::string &);
+  static bool _Rename(const std::string &, const std::string &);
+
+  std::string _entry;
+};
+
+#else
+#ifdef WARN_MULTINC
+#warning File already included
+#endif
+#endif
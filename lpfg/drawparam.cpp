@@ -92,7 +92,8 @@ const char *DrawParams::_strLabels[] = {"#",
                                         "mesh:",
                                         "animated mesh:",
                                         "capped cylinders:",
-                                        "wireframe line width:"};
+                                        "wireframe line width:",
+                                        "rayshade aggregate:"};
 
 DrawParams::DrawParams() { Default(); }
 
@@ -109,6 +110,7 @@ void DrawParams::Default(
   _dparams._postscriptGradient = DParams::gradientOff;
   _dparams._postscriptGradientAmount = 0.0f;
   _dparams._wireframeLineWidth = 1.0f;
+  _dparams._rayshadeAggregate = DParams::raGrid;
   _vparams._scale = DefaultZoom;
   _vparams._minzoom = DefaultMinZoom;
   _vparams._maxzoom = DefaultMaxZoom;
@@ -375,6 +377,11 @@ bool DrawParams::Load(const char *fname) {
           _Error(line, src);
         }
         break;
+      case lRayshadeAggregate:
+        if (!_ReadRayshadeAggregate(line + cntn)) {
+          _Error(line, src);
+        }
+        break;
       }
     }
 
@@ -1103,6 +1110,19 @@ bool DrawParams::_ReadCappedCylinders(const char *line) {
   return true;
 }
 
+bool DrawParams::_ReadRayshadeAggregate(const char *line) {
+  line = Utils::SkipBlanks(line);
+  if (0 == strcmp(line, "grid"))
+    _dparams._rayshadeAggregate = DParams::raGrid;
+  else if (0 == strcmp(line, "bvh"))
+    _dparams._rayshadeAggregate = DParams::raBvh;
+  else {
+    Utils::Message("Error in rayshade aggregate: command: must be grid or bvh");
+    return false;
+  }
+  return true;
+}
+
 bool DrawParams::_ReadPostscriptGradient(const char *line) {
   int type;
   float amount;
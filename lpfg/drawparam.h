@@ -49,6 +49,7 @@ enum PostscriptGradient {
   gradientBottomToTop
 };
 enum CappedCylinders { cappedCylindersOn, cappedCylindersOff };
+enum RayshadeAggregate { raGrid, raBvh };
 } // namespace DParams
 
 class DrawParams : public ConfigFile {
@@ -81,6 +82,9 @@ public:
   float WireframeLineWidth() const {
     return _dparams._wireframeLineWidth;
   }
+  DParams::RayshadeAggregate RayshadeAggregate() const {
+    return _dparams._rayshadeAggregate;
+  }
 
   void NoTrigger() { _dparams._rov = DParams::rovOff; }
   bool ZBuffer() const { return _IsFlagSet(flZBuffer); }
@@ -240,6 +244,7 @@ private:
   bool _ReadMesh(const char*) const; // MC - Dec. 2020 - read OBJ mesh files
   bool _ReadAnimatedMesh(const char*) const;
   bool _ReadWireframeLineWidth(const char*);
+  bool _ReadRayshadeAggregate(const char *);
 
   struct DrawingParams {
     DParams::LineStyle _linestyle;
@@ -255,6 +260,7 @@ private:
     Font _font;
     int _antialiasingSamples;
     float _wireframeLineWidth;
+    DParams::RayshadeAggregate _rayshadeAggregate;
   };
   DrawingParams _dparams;
 
@@ -322,6 +328,7 @@ private:
     lAnimatedMesh,
     lCappedCylinders,
     lWireframeLineWidth,
+    lRayshadeAggregate,
     elCount
   };
 
@@ -0,0 +1,414 @@
+/* ******************************************************************** *
+   Copyright (C) 1990-2022 University of Calgary
+  
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+  
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+  
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ******************************************************************** */
+
+
+
+
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+#include "asrt.h"
+#include "envchannel.h"
+#include "exception.h"
+#include "process.h"
+#include "semaphore.h"
+#include "utils.h"
+
+void EnvironmentChannel::Start(Process &process, const char *cmndline) {
+  process.Start(cmndline);
+}
+
+void EnvironmentChannel::PutInt(std::string &record, unsigned long value) {
+  record += static_cast<char>(value & 0xff);
+  record += static_cast<char>((value >> 8) & 0xff);
+  record += static_cast<char>((value >> 16) & 0xff);
+  record += static_cast<char>((value >> 24) & 0xff);
+}
+
+void EnvironmentChannel::PutFloat(std::string &record, float value) {
+  unsigned int bits;
+  memcpy(&bits, &value, sizeof(float));
+  PutInt(record, bits);
+}
+
+unsigned long EnvironmentChannel::GetInt(const char *ptr) {
+  const unsigned char *p = reinterpret_cast<const unsigned char *>(ptr);
+  return static_cast<unsigned long>(p[0]) |
+         (static_cast<unsigned long>(p[1]) << 8) |
+         (static_cast<unsigned long>(p[2]) << 16) |
+         (static_cast<unsigned long>(p[3]) << 24);
+}
+
+float EnvironmentChannel::GetFloat(const char *ptr) {
+  const unsigned int bits = static_cast<unsigned int>(GetInt(ptr));
+  float value;
+  memcpy(&value, &bits, sizeof(float));
+  return value;
+}
+
+void EnvironmentChannel::Begin() {
+  _first = true;
+  _records = 0;
+  _pending.clear();
+  _protocol = _announced;
+  _frame.assign(eFrameHeader, 0);
+  _BeginTransmission();
+  _Open();
+}
+
+void EnvironmentChannel::Write(const std::string &record) {
+  ASSERT(!Binary());
+  // leave room for the control line
+  if (_records > 0 &&
+      !_Fits(record.length() + eMaxControlLine, _records + 1))
+    _Exchange();
+  _Put(record.c_str(), record.length());
+  ++_records;
+}
+
+void EnvironmentChannel::WriteRecord(int type, const std::string &data) {
+  ASSERT(Binary());
+  // leave room for the control record
+  if (_records > 0 &&
+      !_Fits(_frame.length() + eRecordHeader + data.length() +
+                 eMaxControlRecord,
+             _records + 1))
+    _Exchange();
+  _frame += static_cast<char>(type);
+  PutInt(_frame, data.length());
+  _frame += data;
+  ++_records;
+  if (0 != _FrameLimit() && _frame.length() >= _FrameLimit())
+    _PutFrame();
+}
+
+size_t EnvironmentChannel::RecordRoom() const {
+  const size_t size = _ChunkSize();
+  if (0 == size)
+    return static_cast<size_t>(-1);
+  return size - eFrameHeader - eRecordHeader - eMaxControlRecord - 1;
+}
+
+void EnvironmentChannel::End(bool send) {
+  _PutControl(_first ? flFirstChunk | flLastChunk : flLastChunk);
+  if (send) {
+    _Close();
+    _Signal();
+  } else
+    _Discard();
+}
+
+void EnvironmentChannel::SendExit() {
+  Begin();
+  _PutControl(flFirstChunk | flExit);
+  _Close();
+  _Signal();
+}
+
+void EnvironmentChannel::WaitForReply() {
+  _Wait();
+  _StartReading();
+  _inFrame = 0;
+}
+
+bool EnvironmentChannel::ReadLine(char *bf, int size) {
+  ASSERT(!Binary());
+  // replies to the chunks sent before come first
+  if (!_pending.empty()) {
+    strncpy(bf, _pending.front().c_str(), size - 1);
+    bf[size - 1] = 0;
+    _pending.pop_front();
+    return true;
+  }
+  if (!_GetLine(bf, size))
+    return false;
+  if (0 == strncmp(bf, "Control:", 8)) {
+    _ControlLine(bf);
+    _StopReading();
+  }
+  return true;
+}
+
+bool EnvironmentChannel::ReadRecord(int &type, std::string &data) {
+  ASSERT(Binary());
+  if (!_pending.empty()) {
+    data.swap(_pending.front());
+    _pending.pop_front();
+  } else {
+    if (!_GetRecord(data))
+      return false;
+    if (rtControl == data[0])
+      _StopReading();
+  }
+  type = static_cast<unsigned char>(data[0]);
+  data.erase(0, eRecordHeader);
+  return true;
+}
+
+void EnvironmentChannel::Continue() {
+  _Signal();
+  _Wait();
+  _StartReading();
+  _inFrame = 0;
+}
+
+void EnvironmentChannel::_PutControl(int flags) {
+  if (Binary()) {
+    // the control record ends the frame
+    _frame += static_cast<char>(rtControl);
+    PutInt(_frame, 8);
+    PutInt(_frame, flags);
+    PutInt(_frame, 0);
+    _PutFrame();
+    return;
+  }
+  char bf[eMaxControlLine];
+  const int len = sprintf(bf, "Control: %d 0\n", flags);
+  _Put(bf, len);
+}
+
+void EnvironmentChannel::_PutFrame() {
+  if (_frame.length() == eFrameHeader)
+    return;
+  _frame[0] = eFrameStart;
+  std::string length;
+  PutInt(length, _frame.length() - eFrameHeader);
+  _frame.replace(1, 4, length);
+  _Put(_frame.c_str(), _frame.length());
+  _frame.assign(eFrameHeader, 0);
+}
+
+// reads the next record of the incoming frames, with its header
+bool EnvironmentChannel::_GetRecord(std::string &record) {
+  char header[eFrameHeader];
+  while (0 == _inFrame) {
+    if (!_GetBytes(header, eFrameHeader) || eFrameStart != header[0]) {
+      Utils::Message("Problem reading response\n");
+      return false;
+    }
+    _inFrame = GetInt(header + 1);
+  }
+  if (_inFrame < eRecordHeader || !_GetBytes(header, eRecordHeader)) {
+    Utils::Message("Problem reading response\n");
+    return false;
+  }
+  const size_t length = GetInt(header + 1);
+  if (eRecordHeader + length > _inFrame) {
+    Utils::Message("Corrupted binary response\n");
+    _inFrame = 0;
+    return false;
+  }
+  record.assign(header, eRecordHeader);
+  record.resize(eRecordHeader + length);
+  if (length > 0 && !_GetBytes(&record[eRecordHeader], length)) {
+    Utils::Message("Problem reading response\n");
+    return false;
+  }
+  _inFrame -= eRecordHeader + length;
+  return true;
+}
+
+// returns the flags of a control line. The environmental
+// process understanding binary frames says so after them
+int EnvironmentChannel::_ControlLine(const char *line) {
+  int flags = flLastChunk, protocol = 0;
+  sscanf(line, "Control: %d %d", &flags, &protocol);
+  if (protocol > _announced && _CanSendFrames())
+    _announced = protocol;
+  return flags;
+}
+
+void EnvironmentChannel::_Exchange() {
+  // send the chunk written so far
+  _PutControl(_first ? flFirstChunk : 0);
+  _Close();
+  _Signal();
+  _Wait();
+  // and keep the reply until it is read
+  _StartReading();
+  _inFrame = 0;
+  char bf[eMaxReplyLine];
+  std::string record;
+  for (;;) {
+    int flags;
+    if (Binary()) {
+      if (!_GetRecord(record))
+        break;
+      if (rtControl != record[0]) {
+        _pending.push_back(record);
+        continue;
+      }
+      flags = record.length() >= eRecordHeader + 4
+                  ? static_cast<int>(GetInt(record.c_str() + eRecordHeader))
+                  : flLastChunk;
+    } else {
+      if (!_GetLine(bf, eMaxReplyLine))
+        break;
+      if (0 != strncmp(bf, "Control:", 8)) {
+        _pending.push_back(bf);
+        continue;
+      }
+      flags = _ControlLine(bf);
+    }
+    if (flags & flLastChunk)
+      break;
+    // the reply itself comes in chunks
+    _StopReading();
+    _Signal();
+    _Wait();
+    _StartReading();
+    _inFrame = 0;
+  }
+  _StopReading();
+  _first = false;
+  _records = 0;
+  _Open();
+}
+
+namespace {
+
+// the exchange through files .to_field<key>.0 and .from_field<key>.0
+// synchronized by a pair of semaphores
+class FileChannel : public EnvironmentChannel {
+public:
+  FileChannel(int);
+  ~FileChannel();
+  std::string Options() const;
+
+protected:
+  void _Open();
+  void _Put(const char *, size_t);
+  void _Close();
+  void _Signal() { _sem.Release(0); }
+  void _Wait() { _sem.Wait(1); }
+  bool _GetLine(char *, int);
+  void _StopReading();
+
+private:
+  SemaphorePair _sem;
+  std::string _outfnm;
+  std::string _infnm;
+  FILE *_fOutFile;
+  FILE *_fInFile;
+};
+
+FileChannel::FileChannel(int key)
+    : EnvironmentChannel(key), _fOutFile(0), _fInFile(0) {
+  _sem.Create(key, false, true);
+  {
+    std::stringstream tfn;
+    tfn << ".to_field" << key << ".0";
+    _outfnm = tfn.str();
+  }
+  {
+    std::stringstream ffn;
+    ffn << ".from_field" << key << ".0";
+    _infnm = ffn.str();
+  }
+}
+
+FileChannel::~FileChannel() {
+  _Close();
+  _StopReading();
+  Utils::RemoveFile(_outfnm.c_str());
+  Utils::RemoveFile(_infnm.c_str());
+}
+
+std::string FileChannel::Options() const {
+  std::stringstream optns;
+  optns << " -k " << _key << " -ext " << _key << ".0";
+  return optns.str();
+}
+
+void FileChannel::_Open() {
+  ASSERT(0 == _fOutFile);
+  _fOutFile = fopen(_outfnm.c_str(), "wt");
+}
+
+void FileChannel::_Put(const char *data, size_t size) {
+  if (0 != _fOutFile)
+    fwrite(data, 1, size, _fOutFile);
+}
+
+void FileChannel::_Close() {
+  if (0 != _fOutFile) {
+    fclose(_fOutFile);
+    _fOutFile = 0;
+  }
+}
+
+bool FileChannel::_GetLine(char *bf, int size) {
+  if (0 == _fInFile)
+    _fInFile = fopen(_infnm.c_str(), "rt");
+  if (0 == _fInFile) {
+    Utils::Message("Error opening response file\n");
+    return false;
+  }
+  if (0 == fgets(bf, size, _fInFile)) {
+    Utils::Message("Problem reading response\n");
+    if (feof(_fInFile))
+      Utils::Message("End of file\n");
+    else if (ferror(_fInFile))
+      perror("error: ");
+    return false;
+  }
+  return true;
+}
+
+void FileChannel::_StopReading() {
+  if (0 != _fInFile) {
+    fclose(_fInFile);
+    _fInFile = 0;
+  }
+}
+
+} // namespace
+
+#ifdef LINUX
+#include "envchannelLnx.imp"
+#endif
+
+EnvironmentChannel *EnvironmentChannel::Create(EnvironmentParams::eCommType type,
+                                               int key) {
+  switch (type) {
+  case EnvironmentParams::ctMemory:
+#ifdef LINUX
+    try {
+      return new SharedMemoryChannel(key);
+    } catch (Exception e) {
+      Utils::Message(e.Msg());
+    }
+#endif
+    Utils::Message("Shared memory not available, using files\n");
+    break;
+  case EnvironmentParams::ctPipes:
+#ifdef LINUX
+    return new PipeChannel(key);
+#else
+    Utils::Message("Pipes not available, using files\n");
+    break;
+#endif
+  case EnvironmentParams::ctSockets:
+    Utils::Message("Sockets not supported, using files\n");
+    break;
+  case EnvironmentParams::ctFiles:
+    break;
+  }
+  return new FileChannel(key);
+}
@@ -0,0 +1,173 @@
+/* ******************************************************************** *
+   Copyright (C) 1990-2022 University of Calgary
+  
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+  
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+  
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ******************************************************************** */
+
+
+
+#ifndef __ENVCHANNEL_H__
+#define __ENVCHANNEL_H__
+
+#include <deque>
+#include <string>
+
+#include "envparams.h"
+
+class Process;
+
+// Media used to exchange queries and replies with
+// the environmental process. Records are sent in the
+// format understood by the communication library
+// (libs/comm), so the type of the channel is selected
+// by "communication type:" in the environment file
+// and existing environmental programs work with any of them.
+// Queries that do not fit in the channel are sent in
+// chunks, the replies to all but the last chunk are
+// kept until they are read.
+// An environmental process that announces binary frames
+// in its control line ("Control: <flags> 1") is sent the
+// queries of the following transmissions as records of
+// binary frames and replies in the same way; the text
+// records remain for the processes that do not.
+// A process that announces batch records ("Control: <flags> 2")
+// is sent the queries of a step as arrays in one record
+// and answers all of them in one record as well.
+class EnvironmentChannel {
+public:
+  // flags in the control lines
+  enum { flFirstChunk = 1, flLastChunk = 4, flExit = 8 };
+  // binary frames, as in libs/comm/communication.h
+  enum {
+    eFrameStart = 2,
+    eFrameHeader = 5,
+    eRecordHeader = 5,
+    eBinaryProtocol = 1,
+    eBatchProtocol = 2
+  };
+  enum {
+    rtQuery = 'Q',
+    rtReply = 'R',
+    rtControl = 'C',
+    rtBatch = 'B',
+    rtAnswers = 'A'
+  };
+  // turtle parameters present in a query
+  enum {
+    tmPosition = 1,
+    tmHeading = 2,
+    tmLeft = 4,
+    tmUp = 8,
+    tmFollowing = 128
+  };
+  // little endian numbers of the records
+  static void PutInt(std::string &, unsigned long);
+  static void PutFloat(std::string &, float);
+  static unsigned long GetInt(const char *);
+  static float GetFloat(const char *);
+
+  // returns the channel of the requested type or files
+  // if it is not available on this platform
+  static EnvironmentChannel *Create(EnvironmentParams::eCommType, int key);
+  virtual ~EnvironmentChannel() {}
+
+  // options added to the command line of the environmental process
+  virtual std::string Options() const = 0;
+  // starts the environmental process connected to the channel
+  virtual void Start(Process &, const char *);
+
+  // sending queries
+  void Begin();
+  // the current transmission is sent in binary frames
+  bool Binary() const { return _protocol >= eBinaryProtocol; }
+  // the queries of the current transmission can be sent in batch records
+  bool Batch() const { return _protocol >= eBatchProtocol; }
+  // the longest record that is sent in one chunk
+  size_t RecordRoom() const;
+  void Write(const std::string &);
+  void WriteRecord(int type, const std::string &);
+  void End(bool send);
+  void SendExit();
+
+  // reading replies
+  void WaitForReply();
+  bool ReadLine(char *, int);
+  // replies to binary frames, data without the record header
+  bool ReadRecord(int &type, std::string &);
+  // lets the environmental process send the next chunk of the reply
+  void Continue();
+
+protected:
+  EnvironmentChannel(int key)
+      : _key(key), _first(true), _records(0), _announced(0), _protocol(0),
+        _inFrame(0) {}
+
+  // called when a new transmission (not a chunk) begins
+  virtual void _BeginTransmission() {}
+  // writing a chunk
+  virtual void _Open() = 0;
+  virtual bool _Fits(size_t, int) const { return true; }
+  virtual void _Put(const char *, size_t) = 0;
+  virtual void _Close() = 0;
+  // drops a chunk that will not be sent
+  virtual void _Discard() { _Close(); }
+  // synchronization
+  virtual void _Signal() {}
+  virtual void _Wait() {}
+  // reading a chunk
+  virtual void _StartReading() {}
+  virtual bool _GetLine(char *, int) = 0;
+  virtual void _StopReading() {}
+  // binary frames, for the channels that can send them
+  virtual bool _CanSendFrames() const { return false; }
+  virtual bool _GetBytes(char *, size_t) { return false; }
+  // when not 0, a frame that grew this long is sent without
+  // waiting for the end of the chunk
+  virtual size_t _FrameLimit() const { return 0; }
+  // when not 0, the number of bytes a chunk can hold
+  virtual size_t _ChunkSize() const { return 0; }
+
+  const int _key;
+
+private:
+  enum {
+    eMaxControlLine = 32,
+    eMaxControlRecord = eRecordHeader + 8,
+    eMaxReplyLine = 256
+  };
+  void _PutControl(int);
+  void _PutFrame();
+  bool _GetRecord(std::string &);
+  int _ControlLine(const char *);
+  void _Exchange();
+
+  bool _first;
+  int _records;
+  // replies to the chunks sent before, whole records in frames
+  std::deque<std::string> _pending;
+  // the protocol announced by the environmental process
+  // and the one used in the current transmission
+  int _announced;
+  int _protocol;
+  // frame being written, with room for the header
+  std::string _frame;
+  // bytes left in the frame being read
+  size_t _inFrame;
+};
+
+#else
+#ifdef WARN_MULTINC
+#warning File already included
+#endif
+#endif
@@ -21,7 +21,12 @@
 #include <unistd.h>
 #endif
 
-#include <sstream>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#include <comm/comm_lib.h>
 
 #include "environment.h"
 #include "envparams.h"
@@ -31,7 +36,8 @@
 #include "vector3d.h"
 #include "turtle.h"
 
-Environment::Environment(const EnvironmentParams &params) : _params(params) {
+Environment::Environment(const EnvironmentParams &params)
+    : _params(params), _sending(false) {
   const int semId =
 #ifdef WIN32
       GetCurrentProcessId()
@@ -39,61 +45,44 @@ Environment::Environment(const EnvironmentParams &params) : _params(params) {
       getpid()
 #endif
       * 4;
-  _sem.Create(semId, false, true);
+  _pChannel.reset(EnvironmentChannel::Create(params.CommType(), semId));
 
   if (!params.CmndLineSpecified())
     throw Exception("Environment command line not specified");
   else {
-    std::stringstream optns;
-    optns << " -k " << semId << " -ext " << semId << ".0";
     _cmndln = params.CmndLine();
     std::string::size_type spc = _cmndln.find_first_of(" \t");
-    _cmndln.insert(spc, optns.str());
-  }
-
-  {
-    std::stringstream tfn;
-    tfn << ".to_field" << semId << ".0";
-    _outfnm = tfn.str();
-  }
-
-  {
-    std::stringstream ffn;
-    ffn << ".from_field" << semId << ".0";
-    _infnm = ffn.str();
+    _cmndln.insert(spc, _pChannel->Options());
   }
-  _fInFile = 0;
-  _fOutFile = 0;
 }
 
 Environment::~Environment() { Stop(); }
 
 void Environment::Stop() {
-  _SendEOT();
+  ASSERT(!_sending);
+  _pChannel->SendExit();
   _server.WaitAndClose(1000);
-  ASSERT(0 == _fInFile);
-  ASSERT(0 == _fOutFile);
-  Utils::RemoveFile(_outfnm.c_str());
-  Utils::RemoveFile(_infnm.c_str());
 }
 
-void Environment::OpenOutputFile() {
-  ASSERT(0 == _fOutFile);
-  _fOutFile = fopen(_outfnm.c_str(), "wt");
+void Environment::BeginOutput() {
+  ASSERT(!_sending);
+  _pChannel->Begin();
+  _sending = true;
 }
 
-void Environment::CloseOutputFile(bool ReleaseSem) {
-  ASSERT(0 != _fOutFile);
-  fputs("Control: 5 0\n", _fOutFile);
-  fclose(_fOutFile);
-  _fOutFile = 0;
-  if (ReleaseSem)
-    _sem.Release(0);
+void Environment::EndOutput(bool send) {
+  ASSERT(_sending);
+  if (send)
+    _SendBatch();
+  else
+    _batch.Clear();
+  _pChannel->End(send);
+  _sending = false;
 }
 
 void Environment::Start() {
   try {
-    _server.Start(_cmndln.c_str());
+    _pChannel->Start(_server, _cmndln.c_str());
   } catch (Exception e) {
     Utils::Message(e.Msg());
   }
@@ -106,185 +95,473 @@ void Environment::Start() {
   Utils::Sleep(1);
 }
 
-void Environment::_SendEOT() {
-  Output output(this);
-  ASSERT(0 != _fOutFile);
-  fputs("Control: 9 0\n", _fOutFile);
+void Environment::_Print(const char *format, ...) {
+  const int BfSize = 256;
+  char bf[BfSize];
+  va_list args;
+  va_start(args, format);
+  const int len = vsnprintf(bf, BfSize, format, args);
+  va_end(args);
+  if (len < 0)
+    return;
+  if (len < BfSize)
+    _record.append(bf, len);
+  else {
+    // does not fit in the local buffer
+    std::vector<char> big(len + 1);
+    va_start(args, format);
+    vsnprintf(&big[0], big.size(), format, args);
+    va_end(args);
+    _record.append(&big[0], len);
+  }
+}
+
+void Environment::_SendRecord() {
+  _pChannel->Write(_record);
+  _record.clear();
 }
 
+namespace {
+
+// returns the parameters of the module at i,
+// sz is set to their size in bytes
+const char *ModuleParams(const LstringIterator &i, size_t &sz) {
+  sz = GetSizeOfParamsData(i.GetModuleId());
+  // Mik 02/2013 - There is no guarantee the struct will not be padded with
+  // extra bytes so we can (1) add 2 bytes to the pointer (assuming
+  // sizeof(__lc_ModuleIdType)==2): const char* pF =
+  // i.Ptr()+sizeof(__lc_ModuleIdType) + 2; or (2) get a pointer to the first
+  // parameter of the module's parameters. Note: getting a pointer to the
+  // first member: moduleId; does not help because there may be padding
+  // between moduleId and the first parameter. We take a temporary struct
+  // defined by L2C and assume it is padded the same way: struct
+  // __lc_FollowingModuleStruct { struct Data { __lc_ModuleIdType moduleId;
+  // float Param0;} data; };
+
+  const __lc_FollowingModuleStruct *pFollowingModule =
+      reinterpret_cast<const __lc_FollowingModuleStruct *>(i.Ptr());
+
+  // now, we can set a pointer to the first floating point parameter.
+  // Using reinterpret_cast in this way is probably very compiler dependent,
+  // so it would be better to add a function/pointer in l2c/lpfg that returns
+  // a pointer to the first parameter. Wouldn't that cause a lot of extra
+  // overhead, as each module would have a pointer to its first parameter?
+  return reinterpret_cast<const char *>(&pFollowingModule->data.Param0);
+}
+
+void PutVector(std::string &record, const Vector3d &v) {
+  EnvironmentChannel::PutFloat(record, v.X());
+  EnvironmentChannel::PutFloat(record, v.Y());
+  EnvironmentChannel::PutFloat(record, v.Z());
+}
+
+void PutFloats(std::string &record, size_t count, const char *pF) {
+  for (size_t i = 0; i < count; ++i) {
+    float v;
+    memcpy(&v, pF + i * sizeof(float), sizeof(float));
+    EnvironmentChannel::PutFloat(record, v);
+  }
+}
+
+} // namespace
+
 void Environment::SendFollowingModule(const LstringIterator &iterator) {
   LstringIterator i(iterator);
   ++i;
   if (!i.AtEnd()) {
-    __lc_ModuleIdType mid = i.GetModuleId();
-    size_t sz = GetSizeOfParams(mid);
-    const char *nm = GetNameOf(mid);
-    fputs(nm, _fOutFile);
-#ifdef NO_MEMCOPY
-    const char *pF = i.Ptr() + sizeof(__lc_ModuleIdType);
-#else
-    // Mik 02/2013 - There is no guarantee the struct will not be padded with
-    // extra bytes so we can (1) add 2 bytes to the pointer (assuming
-    // sizeof(__lc_ModuleIdType)==2): const char* pF =
-    // i.Ptr()+sizeof(__lc_ModuleIdType) + 2; or (2) get a pointer to the first
-    // parameter of the module's parameters. Note: getting a pointer to the
-    // first member: moduleId; does not help because there may be padding
-    // between moduleId and the first parameter. We take a temporary struct
-    // defined by L2C and assume it is padded the same way: struct
-    // __lc_FollowingModuleStruct { struct Data { __lc_ModuleIdType moduleId;
-    // float Param0;} data; };
-
-    const __lc_FollowingModuleStruct *pFollowingModule =
-        reinterpret_cast<const __lc_FollowingModuleStruct *>(i.Ptr());
-
-    // now, we can set a pointer to the first floating point parameter
-    const char *pF =
-        reinterpret_cast<const char *>(&pFollowingModule->data.Param0);
-
-    // using reinterpret_cast in this way is probably very compiler dependent,
-    // so it would be better to add a function/pointer in l2c/lpfg that returns
-    // a pointer to the first parameter. Wouldn't that cause a lot of extra
-    // overhead, as each module would have a pointer to its first parameter?
-#endif
+    size_t sz;
+    const char *pF = ModuleParams(i, sz);
+    _record += GetNameOf(i.GetModuleId());
     if (sz >= sizeof(float))
-      fputc('(', _fOutFile);
+      _record += '(';
     while (sz >= sizeof(float)) {
       float v;
       memcpy(&v, pF, sizeof(float));
-      fprintf(_fOutFile, "%f", v);
+      _Print("%f", v);
       sz -= sizeof(float);
       pF += sizeof(float);
       if (sz >= sizeof(float))
-        fputc(',', _fOutFile);
+        _record += ',';
       else
-        fputc(')', _fOutFile);
+        _record += ')';
     }
   }
 }
 
 void Environment::SendData(float v, const LstringIterator &iterator,
                            const Turtle *pTurtle) {
-  ASSERT(0 != _fOutFile);
-  fprintf(_fOutFile, "%zu E(%f)", iterator.Position(), v);
+  ASSERT(_sending);
+  if (_pChannel->Binary()) {
+    _SendQuery(1, &v, iterator, pTurtle);
+    return;
+  }
+  _Print("%zu E(%f)", iterator.Position(), v);
   if (envparams.FollowingModule())
     SendFollowingModule(iterator);
-  fputc('\n', _fOutFile);
+  _record += '\n';
   _SendTurtleData(pTurtle);
+  _SendRecord();
 }
 
 void Environment::SendData(float v1, float v2, const LstringIterator &iterator,
                            const Turtle *pTurtle) {
-  ASSERT(0 != _fOutFile);
-  fprintf(_fOutFile, "%zu E(%f,%f)", iterator.Position(), v1, v2);
+  ASSERT(_sending);
+  if (_pChannel->Binary()) {
+    const float vs[2] = {v1, v2};
+    _SendQuery(2, vs, iterator, pTurtle);
+    return;
+  }
+  _Print("%zu E(%f,%f)", iterator.Position(), v1, v2);
   if (envparams.FollowingModule())
     SendFollowingModule(iterator);
-  fputc('\n', _fOutFile);
+  _record += '\n';
   _SendTurtleData(pTurtle);
+  _SendRecord();
 }
 
 void Environment::SendData(int numParams, const float *vs,
                            const LstringIterator &iterator,
                            const Turtle *pTurtle) {
-  ASSERT(0 != _fOutFile);
-  fprintf(_fOutFile, "%zu E(", iterator.Position());
+  ASSERT(_sending);
+  if (_pChannel->Binary()) {
+    _SendQuery(numParams, vs, iterator, pTurtle);
+    return;
+  }
+  _Print("%zu E(", iterator.Position());
   for (int i = 0; i < numParams; i++) {
     if (i != 0)
-      fprintf(_fOutFile, ",");
-    fprintf(_fOutFile, "%f", vs[i]);
+      _record += ',';
+    _Print("%f", vs[i]);
   }
-  fprintf(_fOutFile, ")");
+  _record += ')';
   if (envparams.FollowingModule())
     SendFollowingModule(iterator);
-  fputc('\n', _fOutFile);
+  _record += '\n';
   _SendTurtleData(pTurtle);
+  _SendRecord();
 }
 
-void Environment::_SendTurtleData(const Turtle *pTurtle) const {
+void Environment::_SendTurtleData(const Turtle *pTurtle) {
   if (!(_params.PosFmt().empty())) {
     Vector3d p = pTurtle->GetPosition();
-    fprintf(_fOutFile, _params.PosFmt().c_str(), p.X(), p.Y(), p.Z());
-    fputc('\n', _fOutFile);
+    _Print(_params.PosFmt().c_str(), p.X(), p.Y(), p.Z());
+    _record += '\n';
   }
   if (!(_params.HeadFmt().empty())) {
     Vector3d h = pTurtle->GetHeading();
-    fprintf(_fOutFile, _params.HeadFmt().c_str(), h.X(), h.Y(), h.Z());
-    fputc('\n', _fOutFile);
+    _Print(_params.HeadFmt().c_str(), h.X(), h.Y(), h.Z());
+    _record += '\n';
   }
   if (!(_params.LeftFmt().empty())) {
     Vector3d l = pTurtle->GetLeft();
-    fprintf(_fOutFile, _params.LeftFmt().c_str(), l.X(), l.Y(), l.Z());
-    fputc('\n', _fOutFile);
+    _Print(_params.LeftFmt().c_str(), l.X(), l.Y(), l.Z());
+    _record += '\n';
   }
   if (!(_params.UpFmt().empty())) {
     Vector3d u = pTurtle->GetUp();
-    fprintf(_fOutFile, _params.UpFmt().c_str(), u.X(), u.Y(), u.Z());
-    fputc('\n', _fOutFile);
+    _Print(_params.UpFmt().c_str(), u.X(), u.Y(), u.Z());
+    _record += '\n';
+  }
+}
+
+// the query as the record read by GetBinaryQuery in libs/comm:
+// position, the module, the following module and the turtle
+// parameters given in the environment file
+void Environment::_SendQuery(int numParams, const float *vs,
+                             const LstringIterator &iterator,
+                             const Turtle *pTurtle) {
+  if (_pChannel->Batch()) {
+    _AddToBatch(numParams, vs, iterator, pTurtle);
+    return;
+  }
+  _record.clear();
+  EnvironmentChannel::PutInt(_record, iterator.Position());
+  _PutModule("E", numParams, reinterpret_cast<const char *>(vs));
+  if (_params.FollowingModuleSlot())
+    _PutFollowingModule(iterator);
+
+  const size_t mask = _record.length();
+  _record += '\0';
+  if (!(_params.PosFmt().empty())) {
+    _record[mask] |= EnvironmentChannel::tmPosition;
+    PutVector(_record, pTurtle->GetPosition());
+  }
+  if (!(_params.HeadFmt().empty())) {
+    _record[mask] |= EnvironmentChannel::tmHeading;
+    PutVector(_record, pTurtle->GetHeading());
   }
+  if (!(_params.LeftFmt().empty())) {
+    _record[mask] |= EnvironmentChannel::tmLeft;
+    PutVector(_record, pTurtle->GetLeft());
+  }
+  if (!(_params.UpFmt().empty())) {
+    _record[mask] |= EnvironmentChannel::tmUp;
+    PutVector(_record, pTurtle->GetUp());
+  }
+  _pChannel->WriteRecord(EnvironmentChannel::rtQuery, _record);
 }
 
-void Environment::WaitForReply() { _sem.Wait(1); }
+// symbol and parameters, the longer ones are cut
+// to the limits of the communication library
+void Environment::_PutModule(const char *name, size_t numParams,
+                             const char *pF) {
+  size_t len = strlen(name);
+  if (len > CMAXSYMBOLLEN)
+    len = CMAXSYMBOLLEN;
+  _record += static_cast<char>(len);
+  _record.append(name, len);
+  if (numParams > CMAXPARAMS)
+    numParams = CMAXPARAMS;
+  _record += static_cast<char>(numParams);
+  for (size_t i = 0; i < numParams; ++i) {
+    float v;
+    memcpy(&v, pF + i * sizeof(float), sizeof(float));
+    _record += '\1';
+    EnvironmentChannel::PutFloat(_record, v);
+  }
+}
 
-FILE *Environment::_OpenInput() {
-  FILE *res = 0;
-  res = fopen(_infnm.c_str(), "rt");
-  return res;
+// an empty module when there is none or it is not sent
+void Environment::_PutFollowingModule(const LstringIterator &iterator) {
+  LstringIterator i(iterator);
+  ++i;
+  if (i.AtEnd() || !_params.FollowingModule()) {
+    _PutModule("", 0, 0);
+    return;
+  }
+  size_t sz;
+  const char *pF = ModuleParams(i, sz);
+  _PutModule(GetNameOf(i.GetModuleId()), sz / sizeof(float), pF);
 }
 
-void Environment::GetReply(EnvironmentReply &reply) {
-  do {
-    if (0 == _fInFile)
-      _fInFile = _OpenInput();
+// the query is added to the arrays of the batch record,
+// which is sent when the next query would not fit in the chunk
+void Environment::_AddToBatch(int numParams, const float *vs,
+                              const LstringIterator &iterator,
+                              const Turtle *pTurtle) {
+  const size_t count = numParams > CMAXPARAMS ? CMAXPARAMS : numParams;
+  size_t size = 5 + count * sizeof(float);
 
-    if (0 == _fInFile) {
-      Utils::Message("Error opening response file\n");
-      return;
+  const char *name = "";
+  size_t following = 0;
+  const char *pF = 0;
+  if (_params.FollowingModule()) {
+    LstringIterator i(iterator);
+    ++i;
+    if (!i.AtEnd()) {
+      size_t sz;
+      pF = ModuleParams(i, sz);
+      name = GetNameOf(i.GetModuleId());
+      following = sz / sizeof(float);
+      if (following > CMAXPARAMS)
+        following = CMAXPARAMS;
     }
-    ASSERT(0 != _fInFile);
-    char bf[256];
-    bf[0] = 0;
-    if (0 == fgets(bf, 256, _fInFile)) {
-      Utils::Message("Problem reading response\n");
-      if (feof(_fInFile))
-        Utils::Message("End of file\n");
-      else if (ferror(_fInFile))
-        perror("error: ");
-      strcpy(bf, "Control: 5");
-    }
-    reply.Set(bf);
-    if (!reply.DataPresent()) {
-      fclose(_fInFile);
-      _fInFile = 0;
+    size += CMAXSYMBOLLEN + 1 + following * sizeof(float);
+  }
+
+  const std::string *formats[4] = {&_params.PosFmt(), &_params.HeadFmt(),
+                                   &_params.LeftFmt(), &_params.UpFmt()};
+  for (int i = 0; i < 4; ++i)
+    if (!formats[i]->empty())
+      size += 3 * sizeof(float);
+
+  if (_batch.count > 0 && _batch.Length() + size > _pChannel->RecordRoom())
+    _SendBatch();
+
+  EnvironmentChannel::PutInt(_batch.distances, iterator.Position());
+  _batch.counts += static_cast<char>(count);
+  PutFloats(_batch.params, count, reinterpret_cast<const char *>(vs));
+  if (_params.FollowingModule()) {
+    // symbols are padded to the same length
+    std::string symbol(name);
+    symbol.resize(CMAXSYMBOLLEN, '\0');
+    _batch.symbols += symbol;
+    _batch.followingCounts += static_cast<char>(following);
+    PutFloats(_batch.followingParams, following, pF);
+  }
+  if (!formats[0]->empty())
+    PutVector(_batch.turtle[0], pTurtle->GetPosition());
+  if (!formats[1]->empty())
+    PutVector(_batch.turtle[1], pTurtle->GetHeading());
+  if (!formats[2]->empty())
+    PutVector(_batch.turtle[2], pTurtle->GetLeft());
+  if (!formats[3]->empty())
+    PutVector(_batch.turtle[3], pTurtle->GetUp());
+  ++_batch.count;
+}
+
+// the batch record read by LoadBatchRecord in libs/comm:
+// the number of queries, the turtle mask and the arrays
+void Environment::_SendBatch() {
+  if (0 == _batch.count)
+    return;
+  _record.clear();
+  EnvironmentChannel::PutInt(_record, _batch.count);
+  int mask = 0;
+  if (_params.FollowingModule())
+    mask |= EnvironmentChannel::tmFollowing;
+  if (!(_params.PosFmt().empty()))
+    mask |= EnvironmentChannel::tmPosition;
+  if (!(_params.HeadFmt().empty()))
+    mask |= EnvironmentChannel::tmHeading;
+  if (!(_params.LeftFmt().empty()))
+    mask |= EnvironmentChannel::tmLeft;
+  if (!(_params.UpFmt().empty()))
+    mask |= EnvironmentChannel::tmUp;
+  _record += static_cast<char>(mask);
+  _record += _batch.distances;
+  _record += _batch.counts;
+  _record += _batch.symbols;
+  _record += _batch.followingCounts;
+  _record += _batch.params;
+  _record += _batch.followingParams;
+  for (int i = 0; i < 4; ++i)
+    _record += _batch.turtle[i];
+  _pChannel->WriteRecord(EnvironmentChannel::rtBatch, _record);
+  _batch.Clear();
+}
+
+void Environment::Batch::Clear() {
+  count = 0;
+  distances.clear();
+  counts.clear();
+  symbols.clear();
+  followingCounts.clear();
+  params.clear();
+  followingParams.clear();
+  for (int i = 0; i < 4; ++i)
+    turtle[i].clear();
+}
+
+// the length of the record data
+size_t Environment::Batch::Length() const {
+  size_t length = 5 + distances.length() + counts.length() +
+                  symbols.length() + followingCounts.length() +
+                  params.length() + followingParams.length();
+  for (int i = 0; i < 4; ++i)
+    length += turtle[i].length();
+  return length;
+}
+
+void Environment::WaitForReply() { _pChannel->WaitForReply(); }
+
+const EnvironmentReplies &Environment::GetReplies() {
+  _replies.Clear();
+  if (_pChannel->Binary()) {
+    // the replies to binary queries are binary
+    int type;
+    while (_pChannel->ReadRecord(type, _record)) {
+      if (EnvironmentChannel::rtControl == type) {
+        if (_record.length() < 4 ||
+            (EnvironmentChannel::GetInt(_record.c_str()) &
+             EnvironmentChannel::flLastChunk))
+          break;
+        _pChannel->Continue();
+      } else if (EnvironmentChannel::rtAnswers == type) {
+        if (!_replies.AddAnswers(_record))
+          Utils::Message("Invalid binary response received from environment\n");
+      } else if (EnvironmentChannel::rtReply != type || !_replies.Add(_record))
+        Utils::Message("Invalid binary response received from environment\n");
     }
-    if (reply.ExpectingMore()) {
-      _sem.Release(0);
-      WaitForReply();
+    _record.clear();
+    return _replies;
+  }
+  const int BfSize = 256;
+  char bf[BfSize];
+  while (_pChannel->ReadLine(bf, BfSize)) {
+    if (0 == strncmp("Control:", bf, 7)) {
+      int flags = EnvironmentChannel::flLastChunk;
+      sscanf(bf, "Control: %d", &flags);
+      if (flags & EnvironmentChannel::flLastChunk)
+        break;
+      _pChannel->Continue();
+    } else if (!_replies.Add(bf))
+      Utils::Message("Invalid response received from environment: %s", bf);
+  }
+  return _replies;
+}
+
+void EnvironmentReplies::Clear() {
+  _positions.clear();
+  _offsets.assign(1, 0);
+  _values.clear();
+}
+
+bool EnvironmentReplies::Add(const char *line) {
+  char *end;
+  const unsigned long pos = strtoul(line, &end, 10);
+  if (end == line)
+    return false;
+  // find beginning of E's parameters
+  const char *p = strchr(end, '(');
+  if (0 == p)
+    return false;
+  const size_t first = _values.size();
+  for (;;) {
+    // skip '(' or ','
+    ++p;
+    _values.push_back(static_cast<float>(strtod(p, &end)));
+    p = end + strcspn(end, ",)");
+    if (0 == *p) {
+      _values.resize(first);
+      return false;
     }
-  } while (reply.ExpectingMore());
+    if (')' == *p)
+      break;
+  }
+  _positions.push_back(pos);
+  _offsets.push_back(_values.size());
+  return true;
+}
+
+bool EnvironmentReplies::Add(const std::string &record) {
+  // position, symbol, parameters with their set flags
+  const char *p = record.c_str();
+  const char *end = p + record.length();
+  if (end - p < 5)
+    return false;
+  const unsigned long pos = EnvironmentChannel::GetInt(p);
+  p += 4;
+  const size_t len = static_cast<unsigned char>(*p++);
+  if (end - p < static_cast<ptrdiff_t>(len) + 1)
+    return false;
+  p += len;
+  const size_t count = static_cast<unsigned char>(*p++);
+  if (end - p < static_cast<ptrdiff_t>(5 * count))
+    return false;
+  for (size_t i = 0; i < count; ++i, p += 5)
+    // parameters not set are sent as empty in text replies, read as 0
+    _values.push_back(0 != p[0] ? EnvironmentChannel::GetFloat(p + 1) : 0.0f);
+  _positions.push_back(pos);
+  _offsets.push_back(_values.size());
+  return true;
 }
 
-void EnvironmentReply::Set(const char *input) {
-  std::string str(input);
-  if (0 == strncmp("Control:", str.c_str(), 7)) {
-    _hasData = false;
-    int r;
-    sscanf(str.c_str(), "Control: %d", &r);
-    if (r & flLastChunk)
-      _more = false;
-    else
-      _more = true;
-  } else {
-    _data.clear();
-    _hasData = true;
-    _more = false;
-    // extract position
-    _pos = atoi(str.c_str());
-    // find beginning of E's parameters
-    size_t token = str.find_first_of('(');
-    do {
-      str.erase(0, token + 1);
-      float v = static_cast<float>(atof(str.c_str()));
-      _data.push_back(v);
-      token = str.find_first_of(",)");
-    } while (str.at(token) != ')');
+bool EnvironmentReplies::AddAnswers(const std::string &record) {
+  const char *p = record.c_str();
+  const char *end = p + record.length();
+  if (end - p < 4)
+    return false;
+  const size_t count = EnvironmentChannel::GetInt(p);
+  p += 4;
+  if (static_cast<size_t>(end - p) / 5 < count)
+    return false;
+  const char *counts = p + 4 * count;
+  const char *pV = counts + count;
+  size_t values = 0;
+  for (size_t i = 0; i < count; ++i)
+    values += static_cast<unsigned char>(counts[i]);
+  if (static_cast<size_t>(end - pV) / 4 < values)
+    return false;
+  _positions.reserve(_positions.size() + count);
+  _offsets.reserve(_offsets.size() + count);
+  _values.reserve(_values.size() + values);
+  for (size_t i = 0; i < count; ++i, p += 4) {
+    _positions.push_back(EnvironmentChannel::GetInt(p));
+    const size_t n = static_cast<unsigned char>(counts[i]);
+    for (size_t j = 0; j < n; ++j, pV += 4)
+      _values.push_back(EnvironmentChannel::GetFloat(pV));
+    _offsets.push_back(_values.size());
   }
+  return true;
 }
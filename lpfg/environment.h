@@ -20,38 +20,62 @@
 #ifndef __ENVIRONMENT_H__
 #define __ENVIRONMENT_H__
 
+#include <memory>
 #include <string>
 #include <vector>
 
-#include <cstdio>
-
 #include "asrt.h"
-#include "semaphore.h"
+#include "envchannel.h"
 #include "process.h"
 
 class LstringIterator;
 class Turtle;
 class EnvironmentParams;
 
+// reply to one query, a view into EnvironmentReplies
 class EnvironmentReply {
 public:
-  EnvironmentReply() : _hasData(false), _more(false) {}
-  void Set(const char *);
-  bool DataPresent() const { return _hasData; }
-  int Position() const {
-    ASSERT(DataPresent());
-    return _pos;
+  EnvironmentReply(size_t pos, const float *pData, size_t size)
+      : _pos(pos), _pData(pData), _size(size) {}
+  size_t Position() const { return _pos; }
+  size_t Size() const { return _size; }
+  float GetParameter(size_t item) const {
+    ASSERT(item < _size);
+    return _pData[item];
+  }
+
+private:
+  size_t _pos;
+  const float *_pData;
+  size_t _size;
+};
+
+// all the replies received in one step, parameters
+// are stored in one array so that they can be
+// scattered back into the string in a single pass
+class EnvironmentReplies {
+public:
+  EnvironmentReplies() { Clear(); }
+  void Clear();
+  // parses a reply line: position E(v1,v2,...)
+  bool Add(const char *);
+  // parses the data of a binary reply record
+  bool Add(const std::string &);
+  // parses the replies to a batch record: their number, then
+  // the arrays of positions, numbers of parameters and parameters
+  bool AddAnswers(const std::string &);
+  size_t Count() const { return _positions.size(); }
+  EnvironmentReply operator[](size_t i) const {
+    ASSERT(i < Count());
+    return EnvironmentReply(_positions[i], _values.data() + _offsets[i],
+                            _offsets[i + 1] - _offsets[i]);
   }
-  size_t Size() const { return _data.size(); }
-  bool ExpectingMore() const { return _more; }
-  float GetParameter(size_t item) const { return _data[item]; }
 
 private:
-  enum flags { flFirstChunk = 1, flLastChunk = 4, flExit = 8 };
-  bool _hasData;
-  bool _more;
-  int _pos;
-  std::vector<float> _data;
+  std::vector<size_t> _positions;
+  // parameters of reply i are in [_offsets[i], _offsets[i+1])
+  std::vector<size_t> _offsets;
+  std::vector<float> _values;
 };
 
 class Environment {
@@ -65,17 +89,18 @@ public:
   void SendData(float, float, const LstringIterator &, const Turtle *);
   void SendData(int, const float *, const LstringIterator &, const Turtle *);
   void WaitForReply();
-  void GetReply(EnvironmentReply &);
+  // reads the whole reply for the step
+  const EnvironmentReplies &GetReplies();
 
   class Output {
   public:
     Output(Environment *pEnv) : _pEnv(pEnv), _ignore(false) {
       if (0 != _pEnv)
-        _pEnv->OpenOutputFile();
+        _pEnv->BeginOutput();
     }
     ~Output() {
       if (0 != _pEnv)
-        _pEnv->CloseOutputFile(!_ignore);
+        _pEnv->EndOutput(!_ignore);
     }
     void Ignore() { _ignore = true; }
 
@@ -84,24 +109,49 @@ public:
     bool _ignore;
   };
 
-  void OpenOutputFile();
-  void CloseOutputFile(bool /* sendToEnv */);
+  void BeginOutput();
+  void EndOutput(bool /* sendToEnv */);
   bool IsRunning() const { return _server.IsRunning(); }
 
 private:
   void SendFollowingModule(const LstringIterator &);
-  FILE *_OpenInput();
-  void _SendEOT();
-  void _SendTurtleData(const Turtle *) const;
+  void _SendRecord();
+  void _SendTurtleData(const Turtle *);
+  void _Print(const char *, ...);
+  // binary queries
+  void _SendQuery(int, const float *, const LstringIterator &, const Turtle *);
+  void _PutModule(const char *, size_t, const char *);
+  void _PutFollowingModule(const LstringIterator &);
+  // batch records
+  void _AddToBatch(int, const float *, const LstringIterator &,
+                   const Turtle *);
+  void _SendBatch();
+
+  // queries of a step kept as the arrays of a batch record
+  struct Batch {
+    Batch() { Clear(); }
+    void Clear();
+    size_t Length() const;
+    size_t count;
+    std::string distances;
+    std::string counts;
+    std::string symbols;
+    std::string followingCounts;
+    std::string params;
+    std::string followingParams;
+    // position, heading, left and up
+    std::string turtle[4];
+  };
 
   const EnvironmentParams &_params;
-  SemaphorePair _sem;
+  std::unique_ptr<EnvironmentChannel> _pChannel;
   Process _server;
   std::string _cmndln;
-  std::string _outfnm;
-  std::string _infnm;
-  FILE *_fOutFile;
-  FILE *_fInFile;
+  // query being composed, text or binary record data
+  std::string _record;
+  bool _sending;
+  EnvironmentReplies _replies;
+  Batch _batch;
 };
 
 #else
@@ -17,6 +17,7 @@
 
 
 
+#include <cstring>
 #include <sstream>
 
 #include "envparams.h"
@@ -29,7 +30,7 @@ const char *EnvironmentParams::_strLabels[] = {
     "turtle left:",         "turtle up:",
     "turtle line width:",   "turtle scale factor:",
     "interpreted modules:", "verbose:",
-    "following module:"};
+    "following module:",    "binary queries:"};
 
 EnvironmentParams envparams;
 
@@ -46,6 +47,7 @@ void EnvironmentParams::Default() {
   _scaleFmt = "";
   _FlagClear(flVerbose);
   _FlagClear(flFollMod);
+  _FlagClear(flNoFollSlot);
 }
 
 void EnvironmentParams::Load(const char *fname) {
@@ -97,14 +99,41 @@ void EnvironmentParams::Load(const char *fname) {
         _Error(line, src);
       break;
     case lFollowingModule:
-      if (!_ReadOnOff(line + cntn, flFollMod))
+      // the communication library reads yes and no
+      if (_IsWord(line + cntn, "yes"))
+        _FlagSet(flFollMod);
+      else if (_IsWord(line + cntn, "no")) {
+        _FlagClear(flFollMod);
+        _FlagSet(flNoFollSlot);
+      } else if (!_ReadOnOff(line + cntn, flFollMod))
         _Error(line, src);
       break;
+    case lBinaryQueries:
+      // read by the environmental process, which does not
+      // announce binary frames when they are off
+      break;
     }
   }
 }
 
-void EnvironmentParams::_ReadCommType(const char *) {}
+bool EnvironmentParams::_IsWord(const char *ln, const char *word) {
+  ln = Utils::SkipBlanks(ln);
+  const size_t len = strlen(word);
+  return 0 == strncmp(ln, word, len) && 0 == Utils::SkipBlanks(ln + len)[0];
+}
+
+void EnvironmentParams::_ReadCommType(const char *ln) {
+  // the same keywords as in the communication library
+  ln = Utils::SkipBlanks(ln);
+  if (0 == strncmp(ln, "memory", 6))
+    _commType = ctMemory;
+  else if (0 == strncmp(ln, "pipes", 5))
+    _commType = ctPipes;
+  else if (0 == strncmp(ln, "sockets", 7))
+    _commType = ctSockets;
+  else
+    _commType = ctFiles;
+}
 
 void EnvironmentParams::_ReadExecutable(const char *ln, const char *fnm) {
   ln = Utils::SkipBlanks(ln);
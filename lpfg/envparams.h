@@ -30,7 +30,11 @@ public:
   void Default();
   void Load(const char *);
   enum eCommType { ctPipes, ctSockets, ctMemory, ctFiles };
+  eCommType CommType() const { return _commType; }
   bool FollowingModule() const { return _IsFlagSet(flFollMod); }
+  // libs/comm expects the following module in binary
+  // queries unless "following module: no" is given
+  bool FollowingModuleSlot() const { return !_IsFlagSet(flNoFollSlot); }
   bool CmndLineSpecified() const { return !_cmndln.empty(); }
   const char *CmndLine() const { return _cmndln.c_str(); }
   const std::string &PosFmt() const { return _posFmt; }
@@ -52,8 +56,13 @@ private:
   std::string _lineWidthFmt;
   std::string _scaleFmt;
 
-  enum eFlags { flVerbose = 1 << 0, flFollMod = 1 << 1 };
+  enum eFlags {
+    flVerbose = 1 << 0,
+    flFollMod = 1 << 1,
+    flNoFollSlot = 1 << 2
+  };
 
+  static bool _IsWord(const char *, const char *);
   void _ReadCommType(const char *);
   void _ReadExecutable(const char *, const char *);
   void _ReadTurtlePos(const char *);
@@ -76,6 +85,7 @@ private:
     lInterpretedModules,
     lVerbose,
     lFollowingModule,
+    lBinaryQueries,
 
     elCount
   };
@@ -21,6 +21,7 @@ typedef short int __lc_ModuleIdType;
 // set it to float
 // 8-byte alignment set it to double
 // etc.
+// the size of every module is a multiple of its size
 typedef double __lc_MainAlignType;
 
 struct __lc_BasicParameterStruct {
@@ -108,7 +109,8 @@ struct __lc_ProductionPredecessor {
 
 struct __lc_ModuleData {
   const char *Name;
-  int size;
+  int size;       // the whole module, padded
+  int paramsSize; // the parameters only, with the padding between them
 };
 
 typedef const char *__lc_Text;
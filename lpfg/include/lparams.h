@@ -19,6 +19,14 @@ enum __lc_GroupType { __lc_gtUnspecified, __lc_gtLsystem, __lc_gtGillespie };
 #define StartBranchIdent "SB"
 #define EndBranchIdent "EB"
 
+// modules are padded to a multiple of the size of
+// __lc_MainAlignType (see lintrfc.h), so their parameters
+// are aligned and accessed in place in the L-string.
+// Define MEMCOPY_PARAMS to copy them to local structures instead
+#ifndef MEMCOPY_PARAMS
+#define NO_MEMCOPY
+#endif
+
 #else
 #ifdef WARN_MULTINC
 #warning File already included
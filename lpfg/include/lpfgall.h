@@ -4,6 +4,7 @@
 #pragma L2C start
 
 #include <memory.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include "lparams.h"
@@ -56,6 +56,8 @@ DECLSPEC int InterpretationMaxDepth();
 DECLSPEC int RingLsystem();
 
 DECLSPEC bool IgnoreEnvironment();
+DECLSPEC bool IsParallelDerivation();
+DECLSPEC int NewContextQueries();
 
 DECLSPEC int NumOfTables();
 DECLSPEC int CurrentGroup();
@@ -318,6 +320,15 @@ inline void NoEnvironment() { __IgnoreEnvironment = true; }
 
 bool IgnoreEnvironment() { return __IgnoreEnvironment; }
 
+// Declares that productions have no side effects outside their successor
+// (no writes to global variables), so lpfg may apply them in parallel.
+bool __ParallelDerivation = false;
+
+inline void ParallelDerivation() { __ParallelDerivation = true; }
+inline void SerialDerivation() { __ParallelDerivation = false; }
+
+bool IsParallelDerivation() { return __ParallelDerivation; }
+
 int __CurrentTable = 0;
 
 void UseGroup(int i) {
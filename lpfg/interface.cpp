@@ -36,16 +36,26 @@
 #include "ContextScanner.h"
 #include "PerformanceMonitor.h"
 
+#include <atomic>
+#include <cstdarg>
+
 #ifdef LINUX
 using namespace Qt;
 #endif // LINUX
 
-// the one and only successor storage
+// the successor storage
 // used by all kinds of rules:
 // productions, interpretation and decomposition.
+// One per thread, so that parallel derivation workers
+// can apply productions independently.
 // Would be nice to somehow hide it.
 // Maybe inside LPFG or LEngine?
-static SuccessorStorage succstrg;
+static thread_local SuccessorStorage succstrg;
+
+// set in parallel derivation worker threads
+static thread_local bool bParallelWorker = false;
+// set when a worker tried to modify global state
+static std::atomic<bool> bSideEffect(false);
 
 // Pointer to the (only)
 // instance of LPFG.
@@ -54,6 +64,33 @@ LPFG *Interface::pLpfg = 0;
 
 SuccessorStorage &Interface::GetSuccessorStorage() { return succstrg; }
 
+void Interface::ParallelWorker(bool bWorker) { bParallelWorker = bWorker; }
+
+bool Interface::SerialOnly() {
+  if (bParallelWorker) {
+    bSideEffect = true;
+    return true;
+  }
+  return false;
+}
+
+bool Interface::SideEffectDetected() { return bSideEffect; }
+
+void Interface::ResetSideEffect() { bSideEffect = false; }
+
+void Interface::Message(const char *format, ...) {
+  // output from productions depends on the order
+  // in which they are applied
+  if (SerialOnly())
+    return;
+  char bf[10240];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(bf, sizeof(bf), format, args);
+  va_end(args);
+  Utils::Message("%s", bf);
+}
+
 float Interface::VFunc(int id) {
   return functions.GetDefaultValue(id-1);
 }
@@ -330,6 +367,8 @@ __lc_V2f Interface::CurveV2fPoint(int id, float t) {
 }
 
 void Interface::CurveReset(int id) {
+  if (SerialOnly())
+    return;
   // if the contour id is invalid
   // just print the warning
   if (!contours.ValidId(id))
@@ -339,6 +378,8 @@ void Interface::CurveReset(int id) {
 }
 
 void Interface::CurveSetPoint(int id, int i, float x, float y, float z) {
+  if (SerialOnly())
+    return;
   // if the contour id is invalid
   // just print the warning
   if (!contours.ValidId(id))
@@ -355,6 +396,8 @@ void Interface::CurveSetPoint(int id, int i, float x, float y, float z) {
 }
 
 void Interface::CurveScale(int id, float x, float y, float z) {
+  if (SerialOnly())
+    return;
   // if the contour id is invalid
   // just print the warning
   if (!contours.ValidId(id))
@@ -364,6 +407,8 @@ void Interface::CurveScale(int id, float x, float y, float z) {
 }
 
 void Interface::CurveRecalc(int id) {
+  if (SerialOnly())
+    return;
   // if the contour id is invalid
   // just print the warning
   if (!contours.ValidId(id))
@@ -385,7 +430,11 @@ float Interface::CurveGAL(int id) {
     return contours.GetAccess(id).GetArcLen();
 }
 
-void Interface::RunCmnd(const char *cmnd) { Utils::ExecuteDetached(cmnd); }
+void Interface::RunCmnd(const char *cmnd) {
+  if (SerialOnly())
+    return;
+  Utils::ExecuteDetached(cmnd);
+}
 
 SurfaceObj Interface::GetSurface(int id) {
   SurfaceObj res;
@@ -433,9 +482,16 @@ __lc_V3f Interface::GetSurfacePoint(int id, int pt) {
 
 static unsigned short main_xsubi[3] = {0x330E, 0, 0};
 
-double Interface::Ran(double range) { return erand48(main_xsubi) * range; }
+double Interface::Ran(double range) {
+  // the sequence depends on the order in which productions are applied
+  if (SerialOnly())
+    return 0.0;
+  return erand48(main_xsubi) * range;
+}
 
 void Interface::SeedRan(long seed) {
+  if (SerialOnly())
+    return;
   main_xsubi[0] = static_cast<unsigned short>(seed);
   main_xsubi[1] = static_cast<unsigned short>(seed >> 16);
   main_xsubi[2] = 0;
@@ -448,16 +504,30 @@ TabletStatus Interface::GetTabletStatus(void) {
 }
 
 void Interface::UserMenuItem(const char *name, unsigned int ref) {
+  if (SerialOnly())
+    return;
   pLpfg->_userMenu.add(std::string(name), ref);
 }
 
-void Interface::UserMenuClear(void) { pLpfg->UserMenuClear(); }
+void Interface::UserMenuClear(void) {
+  if (SerialOnly())
+    return;
+  pLpfg->UserMenuClear();
+}
 
 int Interface::UserMenuChoice(void) { return pLpfg->UserMenuChoice(); }
 
-void Interface::RunSimulation(void) { pLpfg->RunSim(); }
+void Interface::RunSimulation(void) {
+  if (SerialOnly())
+    return;
+  pLpfg->RunSim();
+}
 
-void Interface::PauseSimulation(void) { pLpfg->Stop(); }
+void Interface::PauseSimulation(void) {
+  if (SerialOnly())
+    return;
+  pLpfg->Stop();
+}
 
 BsurfaceObjS Interface::GetBsurfaceS(int id) {
   BsurfaceObjS res;
@@ -508,6 +578,8 @@ bool Interface::terrainNormalAt(V3f world, V3f &surface) {
 }
 
 void Interface::terrainVisibilityAll(VisibilityMode mode) {
+  if (SerialOnly())
+    return;
   if (terrainData != NULL)
     terrainData->terrainVisibilityAll(mode);
   else
@@ -515,12 +587,16 @@ void Interface::terrainVisibilityAll(VisibilityMode mode) {
 }
 void Interface::terrainVisibilityPatch(VisibilityMode mode, int level,
                                        V3f worldSpacePoint) {
+  if (SerialOnly())
+    return;
   if (terrainData != NULL)
     terrainData->terrainVisibilityPatch(mode, level, worldSpacePoint);
   else
     Utils::Error("terrainVisibilityPatch: Terrain Not Loaded\n");
 }
 void Interface::scaleTerrainBy(float val) {
+  if (SerialOnly())
+    return;
   if (terrainData != NULL)
     terrainData->scaleTerrainBy(val);
   else
@@ -528,10 +604,14 @@ void Interface::scaleTerrainBy(float val) {
 }
 
 float Interface::SetOrGetParameterf(const char *name, float defaultVal) {
+  if (SerialOnly())
+    return defaultVal;
   return pLpfg->setOrGetParameterf(name, defaultVal);
 }
 
 int Interface::SetOrGetParameteri(const char *name, int defaultVal) {
+  if (SerialOnly())
+    return defaultVal;
   return pLpfg->setOrGetParameteri(name, defaultVal);
 }
 
@@ -548,18 +628,30 @@ int Interface::GetParameteri(const char *name) {
 }
 
 void Interface::SetParameterf(const char *name, float value) {
+  if (SerialOnly())
+    return;
   pLpfg->SetParameterf(name, value);
 }
 
 void Interface::SetParameteri(const char *name, int value) {
+  if (SerialOnly())
+    return;
   pLpfg->SetParameteri(name, value);
 }
 
-void Interface::DelayWrite() { pLpfg->DelayWrite(); }
+void Interface::DelayWrite() {
+  if (SerialOnly())
+    return;
+  pLpfg->DelayWrite();
+}
 
-void Interface::Write() { pLpfg->Write(); }
+void Interface::Write() {
+  if (SerialOnly())
+    return;
+  pLpfg->Write();
+}
 
-static ContextScanner *pActiveScanner = NULL;
+static thread_local ContextScanner *pActiveScanner = NULL;
 
 const char *Interface::GetModuleAddr(__lc_ModuleIdType mid) {
   if (pActiveScanner != NULL) {
@@ -635,6 +727,6 @@ char *Interface::GetNextModuleSpot(int iSize) {
   return succstrg.GetNextChunk(iSize);
 }
 
-void Interface::StartPerformance() { PerformanceMonitor::Start(1); }
+void Interface::StartPerformance() { PerformanceMonitor::Start(PerformanceMonitor::pmMatch); }
 
-void Interface::StopPerformance() { PerformanceMonitor::Stop(1); }
+void Interface::StopPerformance() { PerformanceMonitor::Stop(PerformanceMonitor::pmMatch); }
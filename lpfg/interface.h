@@ -108,6 +108,16 @@ const char *GetModuleAddr(__lc_ModuleIdType);
 char *GetNextModuleSpot(int iSize);
 void StartPerformance();
 void StopPerformance();
+void Message(const char *, ...);
+
+// Parallel derivation: productions applied by worker threads
+// must not modify lpfg's global state. Functions that do
+// call SerialOnly() first; inside a worker the call is suppressed
+// and recorded, so that the derivation step can be redone serially.
+void ParallelWorker(bool);
+bool SerialOnly();
+bool SideEffectDetected();
+void ResetSideEffect();
 
 extern LPFG *pLpfg;
 
@@ -13,6 +13,8 @@
 #include "ContextScanner.h"
 #include "PerformanceMonitor.h"
 #include <iostream>
+#include <thread>
+#include <exception>
 // Including float.h under Windows for _finite
 #ifdef WIN32
 #include <float.h>
@@ -23,7 +25,7 @@ void LEngine::DeriveString() {
   // by performing the specified number of steps
 
   if (ValidLsystem()) {
-    TIME_THIS(0);
+    TIME_THIS(PerformanceMonitor::pmSimulation);
     _step = 0;
     _GillespieTime = 0.0;
     // empty both strings
@@ -56,6 +58,12 @@ void LEngine::DeriveString() {
   if (comlineparam.TimedMode()) {
     std::ofstream target("PerformanceLog.txt");
     PerformanceMonitor::Report(target);
+    target << "Memory pool high-water mark: " << _pool.HighWaterMark()
+           << " of " << _pool.Reserved() << " bytes\n";
+    std::ofstream json("PerformanceLog.json");
+    PerformanceMonitor::ReportJSON(json);
+    std::ofstream csv("PerformanceLog.csv");
+    PerformanceMonitor::ReportCSV(csv);
   }
 
   if (comlineparam.InterpretToFile()) {
@@ -89,6 +97,7 @@ void LEngine::DecomposeString(const Lstring &src, Lstring &trg, int depth,
       if (!applied) {
         applied = TryDecompose(iter, 0);
       }
+      PerformanceMonitor::Tally(1, applied ? 1 : 0);
 
       // if no matching interpretation rule
       // can be found
@@ -128,13 +137,22 @@ void LEngine::DecomposeString(const Lstring &src, Lstring &trg, int depth,
 
 bool LEngine::TryDecompose(const LstringIterator &citer, int iGroup) const {
   MatchDecompositionParameters matchParameters(iGroup, _dll);
+  // most modules have no decomposition rules
+  if (0 == matchParameters.NumOfModuleProductions(citer.GetModuleId()))
+    return false;
   __lc_CallerData cd;
   return FindMatch(citer, cd, matchParameters);
 }
 
 bool LEngine::TryInterpret(const LstringIterator &citer, int iGroup,
                            int iVGroup) const {
+  // views without view-specific interpretation rules
+  if (iVGroup >= _dll.NumOfVGroups())
+    return false;
   MatchInterpretationParameters matchParameters(iGroup, iVGroup, _dll);
+  // most modules have no interpretation rules
+  if (0 == matchParameters.NumOfModuleProductions(citer.GetModuleId()))
+    return false;
   __lc_CallerData cd;
   return FindMatch(citer, cd, matchParameters);
 }
@@ -181,10 +199,14 @@ void LEngine::Derive() {
     if (HasDecompositions()) {
       try {
         // decompose
+        TIME_THIS(PerformanceMonitor::pmDecompose);
+        PerformanceMonitor::CountThis countThis(
+            PerformanceMonitor::pmDecompose);
         DecomposeString(_lstring, _derivedstring, _dll.DecompositionMaxDepth(),
                         grp);
         _lstring.Swap(_derivedstring);
         _derivedstring.Clear();
+        countThis.Bytes(_lstring.BytesUsed());
       } catch (Utils::SEWrapper sew) {
 #ifdef _WINDOWS
         switch (sew.n) {
@@ -253,22 +275,109 @@ void LEngine::Axiom() {
   }
 }
 
+void LEngine::IndexContext() {
+  _lstring.BuildBranchIndex();
+  for (int iConsiderGroup = 0; iConsiderGroup < _dll.NumOfConsiderGroups();
+       ++iConsiderGroup) {
+    // every module is considered
+    if (0 == _dll.NumOfConsidered(iConsiderGroup) &&
+        0 == _dll.NumOfIgnored(iConsiderGroup))
+      continue;
+    LstringIterator iter(_lstring);
+    // the current run of modules not considered
+    size_t begin = 0, count = 0;
+    if (!iter.AtEnd())
+      do {
+        if (!Considered(iter.GetModuleId(), iConsiderGroup)) {
+          if (0 == count++)
+            begin = iter.Position();
+        } else {
+          if (count >= Lstring::eMinIgnoredRun)
+            _lstring.AddIgnoredRun(iConsiderGroup, begin, iter.Position());
+          count = 0;
+        }
+      } while (++iter);
+    if (count >= Lstring::eMinIgnoredRun)
+      _lstring.AddIgnoredRun(iConsiderGroup, begin, iter.Position());
+  }
+}
+
 void LEngine::DeriveForward(int tbl) {
   ASSERT(ValidLsystem());
+  TIME_THIS(PerformanceMonitor::pmDerive);
 
   Debug("Deriving forward\n");
-  LstringIterator iterator(_lstring);
   _derivedstring.Clear();
-  const bool ring = _dll.RingLsystem();
+  // context matching skips branches
+  // and ignored modules using an index
+  if (_dll.HasContext())
+    IndexContext();
 
   if (comlineparam.DebugMode()) {
     Utils::Message("Dumping the string:\n");
     DumpString(_lstring);
   }
 
-  __lc_CallerData cd;
+  const int threads = DerivationThreads(tbl);
+  if (threads < 2 || !DeriveForwardParallel(tbl, threads)) {
+    __lc_CallerData cd;
+    DeriveForwardRange(tbl, 0, _lstring.BytesUsed(), _derivedstring, cd);
+  }
+
+  // swap the new string with the old one
+  _lstring.Swap(_derivedstring);
+  // the inert spans of the new string
+  // refer to this group
+  _inertGroup = tbl;
+  PerformanceMonitor::Count(PerformanceMonitor::pmDerive, 0,
+                            _lstring.BytesUsed(), 0);
+  if (comlineparam.DebugMode() || comlineparam.DumpString()) {
+    Utils::Message("After deriving forward\n");
+    DumpString(_lstring);
+  }
+}
+
+size_t LEngine::DeriveForwardRange(int tbl, size_t begin, size_t end,
+                                   Lstring &target, __lc_CallerData &cd) {
+  // derives the modules starting in [begin, end)
+  // and appends the result to target.
+  // Returns the position at which the derivation stopped,
+  // which may be past end if the last production
+  // (or Cut) consumed modules beyond it
+  LstringIterator iterator(_lstring, begin);
+  const bool ring = _dll.RingLsystem();
+  // statistics for the performance monitor
+  size_t modules = 0, productions = 0;
+  PerformanceMonitor::CountThis countMatch(PerformanceMonitor::pmMatch);
+  // runs of modules without productions
+  // are copied at once
+  const bool bulk = !comlineparam.DebugMode();
+  // in incremental mode the spans copied that way
+  // in the previous step are not even scanned
+  const std::vector<Lstring::Range> &spans = _lstring.InertSpans();
+  size_t span = spans.size();
+  if (bulk && comlineparam.IncrementalMode() && tbl == _inertGroup)
+    span = 0;
+
   if (!iterator.AtEnd())
     for (;;) {
+      if (iterator.Position() >= end) {
+        PerformanceMonitor::Count(PerformanceMonitor::pmDerive, modules, 0,
+                                  productions);
+        return iterator.Position();
+      }
+      // skip the spans already passed
+      while (span < spans.size() && spans[span].End() <= iterator.Position())
+        ++span;
+      if (span < spans.size() && spans[span].Begin() <= iterator.Position()) {
+        const size_t spanEnd = std::min(spans[span].End(), end);
+        target.AppendInert(_lstring, iterator.Position(), spanEnd);
+        iterator = LstringIterator(_lstring, spanEnd);
+        if (iterator.AtEnd())
+          break;
+        continue;
+      }
+      ++modules;
       // if the current modeul is Cut
       if (Cut_id == iterator.GetModuleId()) {
         // skip to the end of the current branch
@@ -283,17 +392,18 @@ void LEngine::DeriveForward(int tbl) {
         int nop0 = _dll.NumOfModulePProductions(0, iterator.GetModuleId());
         // first check the current group/table
         if (0 != tbl && nop > 0)
-          applied = TryForwardGroup(tbl, iterator, cd, nop, ring);
+          applied = TryForwardGroup(tbl, iterator, cd, nop, ring, target);
         // then check the default group/table
         if (!applied && nop0 > 0)
-          applied = TryForwardGroup(0, iterator, cd, nop0, ring);
+          applied = TryForwardGroup(0, iterator, cd, nop0, ring, target);
 
         // if a production fired
         if (applied) {
           Debug("applied\n");
+          ++productions;
           // append the contents of the successor storage
           // to the new string
-          _derivedstring.Add(Interface::GetSuccessorStorage());
+          target.Add(Interface::GetSuccessorStorage());
           // advance the iterator
           // by the number of modules
           // in the strict predecessor
@@ -303,29 +413,143 @@ void LEngine::DeriveForward(int tbl) {
           } else if (!(iterator += cd.Strct().Count()))
             break;
         }
+        // if the module has no productions at all
+        // copy it together with the following such modules
+        else if (bulk && 0 == nop && 0 == nop0) {
+          const size_t runBegin = iterator.Position();
+          bool more = ++iterator;
+          while (more && iterator.Position() < end &&
+                 Inert(tbl, iterator.GetModuleId())) {
+            ++modules;
+            more = ++iterator;
+          }
+          target.AppendInert(_lstring, runBegin, iterator.Position());
+          if (!more)
+            break;
+        }
         // otherwise
         else {
           // apply identity production
           Debug("identity applied\n");
-          _derivedstring.Append(iterator);
+          target.Append(iterator);
           // and advance
           if (!++iterator)
             break;
         }
       }
     }
-  // swap the new string with the old one
-  _lstring.Swap(_derivedstring);
-  if (comlineparam.DebugMode() || comlineparam.DumpString()) {
-    Utils::Message("After deriving forward\n");
-    DumpString(_lstring);
+  PerformanceMonitor::Count(PerformanceMonitor::pmDerive, modules, 0,
+                            productions);
+  return _lstring.BytesUsed();
+}
+
+int LEngine::DerivationThreads(int tbl) const {
+  // parallel derivation must be requested on the command line
+  // and declared safe by the L-system
+  int threads = comlineparam.DerivationThreads();
+  if (0 == threads)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  if (threads < 2 || !_parallelDerivation || !_dll.ParallelDerivation())
+    return 1;
+  // productions looking at the new string
+  // depend on all the preceding derivation
+  if (_dll.NewContextQueries() || _dll.HasNewLeftContext(tbl) ||
+      _dll.HasNewLeftContext(0))
+    return 1;
+  // ring L-systems wrap around the end of the string
+  if (_dll.RingLsystem())
+    return 1;
+  if (comlineparam.DebugMode())
+    return 1;
+  if (_lstring.BytesUsed() < eMinParallelDerivationSize)
+    return 1;
+  return threads;
+}
+
+bool LEngine::DeriveForwardParallel(int tbl, int threads) {
+  // returns false if the step must be derived serially.
+  // The string is split into chunks at module boundaries
+  // and each chunk is derived by a separate thread
+  std::vector<size_t> bounds;
+  bounds.push_back(0);
+  {
+    const size_t chunk = _lstring.BytesUsed() / threads;
+    LstringIterator iterator(_lstring);
+    while (!iterator.AtEnd() &&
+           static_cast<int>(bounds.size()) < threads) {
+      if (iterator.Position() >= bounds.size() * chunk)
+        bounds.push_back(iterator.Position());
+      if (!++iterator)
+        break;
+    }
+  }
+  bounds.push_back(_lstring.BytesUsed());
+  const size_t chunks = bounds.size() - 1;
+
+  std::vector<std::unique_ptr<Lstring>> targets(chunks);
+  std::vector<size_t> reached(chunks);
+  std::vector<std::exception_ptr> errors(chunks);
+  Interface::ResetSideEffect();
+  {
+    auto worker = [&](size_t i) {
+      Interface::ParallelWorker(true);
+      try {
+        __lc_CallerData cd;
+        targets[i].reset(new Lstring(eLstringInitSize));
+        reached[i] =
+            DeriveForwardRange(tbl, bounds[i], bounds[i + 1], *targets[i], cd);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+      Interface::ParallelWorker(false);
+    };
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < chunks; ++i)
+      pool.push_back(std::thread(worker, i));
+    // the first chunk is derived by this thread
+    worker(0);
+    for (size_t i = 0; i < pool.size(); ++i)
+      pool[i].join();
+  }
+  for (size_t i = 0; i < chunks; ++i) {
+    if (errors[i])
+      std::rethrow_exception(errors[i]);
+  }
+
+  if (Interface::SideEffectDetected()) {
+    Utils::Message("Productions modify global state: "
+                   "parallel derivation disabled\n");
+    Interface::ResetSideEffect();
+    _parallelDerivation = false;
+    _derivedstring.Clear();
+    return false;
   }
+
+  // join the chunks
+  __lc_CallerData cd;
+  size_t pos = 0;
+  for (size_t i = 0; i < chunks; ++i) {
+    if (pos == bounds[i]) {
+      _derivedstring.Append(*targets[i]);
+      pos = reached[i];
+    }
+    // the previous chunk ended with a production
+    // extending into this one
+    else if (pos < bounds[i + 1])
+      pos = DeriveForwardRange(tbl, pos, bounds[i + 1], _derivedstring, cd);
+  }
+  return true;
 }
 
 void LEngine::DeriveGForward(int tbl) {
+  TIME_THIS(PerformanceMonitor::pmDerive);
   ASSERT(ValidLsystem());
 
   Debug("Deriving Gillespie forward\n");
+  // context matching skips branches
+  // and ignored modules using an index
+  if (_dll.HasContext())
+    IndexContext();
   LstringIterator iterator(_lstring);
   _derivedstring.Clear(eForward);
   const bool ring = _dll.RingLsystem();
@@ -333,9 +557,13 @@ void LEngine::DeriveGForward(int tbl) {
   __lc_CallerData cd;
   std::vector<GillespieSuccessor> gsa;
   typedef std::vector<GillespieSuccessor>::const_iterator iter;
+  // statistics for the performance monitor
+  size_t modules = 0, productions = 0;
+  PerformanceMonitor::CountThis countMatch(PerformanceMonitor::pmMatch);
   // iterate the string
   if (!iterator.AtEnd())
     for (;;) {
+      ++modules;
       // skip the branch if module Cut found
       if (Cut_id == iterator.GetModuleId()) {
         Debug("Skipping module %s\n", iterator.GetModuleName());
@@ -374,10 +602,13 @@ void LEngine::DeriveGForward(int tbl) {
         Debug("Replacing\n");
         // replace the predecessor with successor directly in the main string
         _lstring.Replace(_derivedstring, it->Successor(), it->Predecessor());
+        ++productions;
         break;
       }
     }
   }
+  PerformanceMonitor::Count(PerformanceMonitor::pmDerive, modules,
+                            _lstring.BytesUsed(), productions);
 
   if (comlineparam.DebugMode() || comlineparam.DumpString()) {
     Utils::Message("After deriving forward\n");
@@ -401,8 +632,14 @@ void LEngine::ApplyForwardGGroup(int tbl, const LstringIterator &iter,
                                  __lc_CallerData &cd, int nop,
                                  std::vector<GillespieSuccessor> &gsa,
                                  bool ring) {
+  // matching is timed once for the module,
+  // not for every predecessor tried
+  TIME_THIS(PerformanceMonitor::pmMatch);
+  int tried = 0;
   // for every production in the group
   for (int i = 0; i < nop; ++i) {
+    timeThis.Restart();
+    ++tried;
     cd.Reset();
     // get the predecessor
     const __lc_ProductionPredecessor &pred =
@@ -413,6 +650,7 @@ void LEngine::ApplyForwardGGroup(int tbl, const LstringIterator &iter,
         TryMatchForward(iter, cd, pred, iteratorSet, ring);
     // if it does
     if (0 != pCaller) {
+      timeThis.Stop();
       GillespieSuccessor gs;
       // store the start and end position of the predecessor modules
       // for the current production
@@ -509,10 +747,15 @@ void LEngine::ApplyForwardGGroup(int tbl, const LstringIterator &iter,
       _derivedstring.Append(tmp);
     }
   }
+  PerformanceMonitor::Tally(1, tried);
 }
 
 bool LEngine::TryForwardGroup(int grp, LstringIterator &iterator,
-                              __lc_CallerData &cd, int nop, bool ring) {
+                              __lc_CallerData &cd, int nop, bool ring,
+                              Lstring &target) {
+  // matching is timed once for the module,
+  // not for every predecessor tried
+  TIME_THIS(PerformanceMonitor::pmMatch);
   // iterate through the productions
   // in the group grp
   for (int i = 0; i < nop; ++i) {
@@ -523,12 +766,13 @@ bool LEngine::TryForwardGroup(int grp, LstringIterator &iterator,
         _dll.GetModulePProductionPredecessor(grp, iterator.GetModuleId(), i);
     // check if it matches the current string position
 
-    ProductionMatchIteratorSet iteratorSet(_lstring, _derivedstring);
+    ProductionMatchIteratorSet iteratorSet(_lstring, target);
     __lc_ProdCaller pCaller =
         TryMatchForward(iterator, cd, pred, iteratorSet, ring);
 
     // if it does then execute
     if (0 != pCaller) {
+      timeThis.Stop();
       // clear the successor storage
       Interface::GetSuccessorStorage().Clear();
       // and try to apply the production
@@ -547,17 +791,26 @@ bool LEngine::TryForwardGroup(int grp, LstringIterator &iterator,
       pgLContextScanner = NULL;
       pgRNContextScanner = NULL;
       pgLNContextScanner = NULL;
-      if (bApplied)
+      if (bApplied) {
+        PerformanceMonitor::Tally(1, i + 1);
         return true;
+      }
+      timeThis.Restart();
     }
   }
+  PerformanceMonitor::Tally(1, nop);
   // no production applied
   return false;
 }
 
 void LEngine::DeriveBackward(int tbl) {
   ASSERT(ValidLsystem());
+  TIME_THIS(PerformanceMonitor::pmDerive);
   Debug("Deriving backward\n");
+  // context matching skips branches
+  // and ignored modules using an index
+  if (_dll.HasContext())
+    IndexContext();
 
   LstringIterator iterator(_lstring);
   // the new string grows backward
@@ -566,12 +819,16 @@ void LEngine::DeriveBackward(int tbl) {
   iterator.FindEOS();
 
   const bool ring = _dll.RingLsystem();
+  // statistics for the performance monitor
+  size_t modules = 0, productions = 0;
+  PerformanceMonitor::CountThis countMatch(PerformanceMonitor::pmMatch);
 
   __lc_CallerData cd;
   // if not at the beginning
   while (!iterator.AtBeginning()) {
     // move one position back
     --iterator;
+    ++modules;
     // warn about Cut module in the string
     // cut is not performed when deriving backward
     if (Cut_id == iterator.GetModuleId())
@@ -595,13 +852,16 @@ void LEngine::DeriveBackward(int tbl) {
       Interface::GetSuccessorStorage().Clear();
       // apply identity production
       iterator.AppendCurrent(Interface::GetSuccessorStorage());
-    }
+    } else
+      ++productions;
     // add the contents of the successor
     // storage to the new string
     _derivedstring.Add(Interface::GetSuccessorStorage());
   }
   // substitute the new string for the old one
   _lstring.Swap(_derivedstring);
+  PerformanceMonitor::Count(PerformanceMonitor::pmDerive, modules,
+                            _lstring.BytesUsed(), productions);
   if (comlineparam.DebugMode() || comlineparam.DumpString()) {
     Utils::Message("After deriving backward\n");
     DumpString(_lstring);
@@ -613,7 +873,6 @@ LEngine::TryMatchForward(const LstringIterator &citer, __lc_CallerData &cd,
                          const __lc_ProductionPredecessor &pred,
                          ProductionMatchIteratorSet &iteratorSet,
                          bool bRing) const {
-  TIME_THIS(1);
   ASSERT(ValidLsystem());
   // when deriving forward
   // we ignore productions
@@ -631,7 +890,7 @@ LEngine::TryMatchForward(const LstringIterator &citer, __lc_CallerData &cd,
     return 0;
   iteratorSet.rightContext = iter;
   // check the new left context if required
-  LstringIterator diter(_derivedstring);
+  LstringIterator diter(iteratorSet.leftNewContext);
   diter.FindEOS();
 
   // return to the beginning of the strict predecessor
@@ -808,29 +1067,11 @@ bool LEngine::FindMatch(const LstringIterator &citer, __lc_CallerData &cd,
   return false;
 }
 
-#define USE_CONSIDER_LOOKUP
-
-bool LEngine::Considered(__lc_ModuleIdType mid, int iConsiderGroup) const {
-  // specifies whether the given module
-  // should be considered
-#ifdef USE_CONSIDER_LOOKUP
-  ASSERT(ValidLsystem());
-  return _dll.IsConsidered(mid, iConsiderGroup);
-#else
-  if (SB_id == mid)
-    return true;
-  if (EB_id == mid)
-    return true;
-  if (_dll.NumOfConsidered() > 0)
-    return InConsidered(mid);
-  if (_dll.NumOfIgnored() > 0)
-    return !InIgnored(mid);
-  return true;
-#endif
-}
-
 bool LEngine::TryBackwardGroup(int grp, LstringIterator &iterator,
                                __lc_CallerData &cd, int nop, bool ring) {
+  // matching is timed once for the module,
+  // not for every predecessor tried
+  TIME_THIS(PerformanceMonitor::pmMatch);
   // iterate the grp group
   // of productions
   for (int i = 0; i < nop; ++i) {
@@ -846,6 +1087,7 @@ bool LEngine::TryBackwardGroup(int grp, LstringIterator &iterator,
         TryMatchBackward(iterator, cd, pred, iteratorSet, ring);
     // if a matching production is found
     if (0 != pCaller) {
+      timeThis.Stop();
       // clear the successor storage
       Interface::GetSuccessorStorage().Clear();
       // and try to apply
@@ -872,11 +1114,14 @@ bool LEngine::TryBackwardGroup(int grp, LstringIterator &iterator,
         // strict predecessor
         if (pred.Strct.count > 1)
           iterator -= pred.Strct.count - 1;
+        PerformanceMonitor::Tally(1, i + 1);
         // end exit
         return true;
       }
+      timeThis.Restart();
     }
   }
+  PerformanceMonitor::Tally(1, nop);
   // no production applied
   return false;
 }
@@ -886,7 +1131,6 @@ LEngine::TryMatchBackward(const LstringIterator &citer, __lc_CallerData &cd,
                           const __lc_ProductionPredecessor &pred,
                           ProductionMatchIteratorSet &iteratorSet,
                           bool bRing) const {
-  TIME_THIS(1);
   ASSERT(ValidLsystem());
   // when deriving backward
   // we ignore productions
@@ -29,6 +29,7 @@
 #include "envparams.h"
 #include "exception.h"
 #include "environment.h"
+#include "dllcache.h"
 #include "funcs.h"
 #include "surfarr.h"
 #include "contourarr.h"
@@ -46,6 +47,12 @@ size_t GetSizeOfParams(int mid) {
   return aModuleData[mid].size;
 }
 
+size_t GetSizeOfParamsData(int mid) {
+  // return the size of the parameters alone,
+  // without the module ids and the padding
+  return aModuleData[mid].paramsSize;
+}
+
 const char *GetNameOf(int mid) {
   // return the string
   // representing the module's name
@@ -59,12 +66,14 @@ LEngine::LEngine()
   InitGillespieXSubi();
   _GillespieTime = 0.0;
   _stopFlag = false;
+  _parallelDerivation = true;
+  _inertGroup = -1;
 }
 
 LEngine::~LEngine() {
   if (comlineparam.TimedMode()) {
     std::ofstream fpstrg("fps.txt");
-    fpstrg << "FPS: " << _sDrawCount / PerformanceMonitor::TimeGroup(3)
+    fpstrg << "FPS: " << _sDrawCount / PerformanceMonitor::TimeGroup(PerformanceMonitor::pmDrawGL)
            << std::endl;
   }
 }
@@ -106,7 +115,7 @@ bool LEngine::ConnectToLsys() {
         success = false;
       } else {
         __lc_ExportedFromLpfg exported;
-        exported.fMessage = Utils::Message;
+        exported.fMessage = Interface::Message;
         exported.fFunc = Interface::Func;
         exported.fPFunc = Interface::PFunc;
         exported.fTFunc = Interface::TFunc;
@@ -202,8 +211,10 @@ bool LEngine::ConnectToLsys() {
   }
 
   // initialize aModulData array
-  if (success)
+  if (success) {
     aModuleData = _dll.GetModuleData(0);
+    _parallelDerivation = true;
+  }
 
   // if there were any errors
   if (!success) {
@@ -272,14 +283,21 @@ bool LEngine::NewLsystem(const char *lfile) {
   // preprocess the file
   PreprocessLsystem(lfile, PreprocessedFile());
 
-  // try to translate
-  if (!Translate(PreprocessedFile(), TranslatedFile())) {
-    Utils::Mark("Error translating L++ to C++");
-    return false;
-  }
+  // an unchanged L-system is taken from the cache
+  DllCache cache(comlineparam.UseDll() || comlineparam.NoDllCache()
+                     ? 0
+                     : PreprocessedFile());
+  if (!cache.Fetch(LPFGParams::CompiledLsys)) {
+    // try to translate
+    if (!Translate(PreprocessedFile(), TranslatedFile())) {
+      Utils::Mark("Error translating L++ to C++");
+      return false;
+    }
 
-  // try to compile
-  CompileLsys(TranslatedFile());
+    // try to compile
+    CompileLsys(TranslatedFile());
+    cache.Store(LPFGParams::CompiledLsys);
+  }
   // try to connect
   bool res = ConnectToLsys();
   // if connected and environmental program present
@@ -480,11 +498,22 @@ void LEngine::DumpString(std::ostream &trg) const {
   }
 }
 
-bool LEngine::InsertReadData(const EnvironmentReply &reply) {
-  LstringIterator iter(_lstring);
-  if (!iter.ValidPosition(reply.Position(), _dll.NumOfModules() - 1))
-    return false;
-  iter.MoveTo(reply.Position(), _dll.NumOfModules() - 1);
+bool LEngine::InsertReadData(LstringIterator &iter,
+                             const EnvironmentReply &reply) {
+  // the replies come in the order of the queries, so the
+  // iterator is only moved forward to the module replied to.
+  // A reply out of order is checked and reached directly
+  if (iter.AtEnd() || reply.Position() < iter.Position()) {
+    if (!iter.ValidPosition(reply.Position(), _dll.NumOfModules() - 1))
+      return false;
+    iter.MoveTo(reply.Position(), _dll.NumOfModules() - 1);
+  } else {
+    while (iter.Position() < reply.Position())
+      if (!++iter)
+        return false;
+    if (iter.Position() != reply.Position())
+      return false;
+  }
 
   switch (iter.GetModuleId()) {
   case E1_id:
@@ -565,14 +594,15 @@ void LEngine::ReadAnswer() {
   ASSERT(0 != _pEnvironment.get());
   if (_pEnvironment->IsRunning()) {
     _pEnvironment->WaitForReply();
-    EnvironmentReply reply;
-    _pEnvironment->GetReply(reply);
-    while (reply.DataPresent()) {
-      if (!InsertReadData(reply))
+    const EnvironmentReplies &replies = _pEnvironment->GetReplies();
+    // scatter the replies back into the string
+    LstringIterator iter(_lstring);
+    for (size_t i = 0; i < replies.Count(); ++i) {
+      const EnvironmentReply reply = replies[i];
+      if (!InsertReadData(iter, reply))
         Utils::Message(
-            "Invalid response received from environment at position %d\n",
+            "Invalid response received from environment at position %zu\n",
             reply.Position());
-      _pEnvironment->GetReply(reply);
     }
   }
 }
@@ -117,7 +117,12 @@ public:
     gillespie_xsubi[2] = 0;
   }
 
-  bool Considered(__lc_ModuleIdType, int iConsiderGroup) const;
+  // specifies whether the given module
+  // should be considered in context matching
+  bool Considered(__lc_ModuleIdType mid, int iConsiderGroup) const {
+    ASSERT(ValidLsystem());
+    return _dll.IsConsidered(mid, iConsiderGroup);
+  }
 
 #ifdef LINUX
   // MC June 2014 - changed so there is a pointer to QGLWidget for each View
@@ -143,6 +148,8 @@ private:
   LsysDll _dll;
 
   enum { eLstringInitSize = 10240 };
+  // strings shorter than this are always derived serially
+  enum { eMinParallelDerivationSize = 65536 };
 
   double GRand() const { return erand48(gillespie_xsubi); }
   mutable unsigned short gillespie_xsubi[3];
@@ -150,6 +157,10 @@ private:
   double _GillespieTime;
   // step counter
   int _step;
+  // cleared when productions turned out to have side effects
+  bool _parallelDerivation;
+  // group for which the inert spans of _lstring were found
+  int _inertGroup;
   // set to true by the Stop function in L-system
   bool _stopFlag;
   // the current string
@@ -163,8 +174,20 @@ private:
   std::unique_ptr<Environment> _pEnvironment;
 
   void Axiom();
+  // indexes the brackets and the runs of ignored modules
+  // of the string for context matching
+  void IndexContext();
   void DeriveForward(int);
-  bool TryForwardGroup(int, LstringIterator &, __lc_CallerData &, int, bool);
+  size_t DeriveForwardRange(int, size_t, size_t, Lstring &, __lc_CallerData &);
+  bool DeriveForwardParallel(int, int);
+  // true if the module has no productions in the group
+  bool Inert(int tbl, __lc_ModuleIdType mid) const {
+    return Cut_id != mid && 0 == _dll.NumOfModulePProductions(tbl, mid) &&
+           0 == _dll.NumOfModulePProductions(0, mid);
+  }
+  int DerivationThreads(int) const;
+  bool TryForwardGroup(int, LstringIterator &, __lc_CallerData &, int, bool,
+                       Lstring &);
   void DeriveBackward(int);
   bool TryBackwardGroup(int, LstringIterator &, __lc_CallerData &, int, bool);
 
@@ -180,7 +203,7 @@ private:
                        int grp) const;
   void InterpretForEnvironment(int);
   void ReadAnswer();
-  bool InsertReadData(const EnvironmentReply &);
+  bool InsertReadData(LstringIterator &, const EnvironmentReply &);
 
   struct ProductionMatchIteratorSet {
     ProductionMatchIteratorSet(Lstring &oldString, Lstring &newString)
@@ -211,58 +234,44 @@ private:
                          const __lc_ProductionModules &, bool bRing,
                          int iConsiderGroup) const;
 
+  // the predecessors of decompositions or interpretations
+  // in one (view) group, read directly from the table
+  // built when the L-system was connected
   class MatchParameters {
   protected:
-    MatchParameters(const LsysDll &dll)
-        : _dll(dll), _bIsRing(_dll.RingLsystem()) {}
+    MatchParameters(const PredecessorTable &table, size_t first,
+                    const LsysDll &dll)
+        : _table(table), _first(first), _bIsRing(dll.RingLsystem()) {}
 
   public:
-    virtual int NumOfModuleProductions(__lc_ModuleIdType moduleId) const = 0;
-    virtual const __lc_ProductionPredecessor &
-    GetModuleProductionPredecessor(__lc_ModuleIdType moduleId,
-                                   int id) const = 0;
+    int NumOfModuleProductions(__lc_ModuleIdType moduleId) const {
+      return _table.Count(_first + moduleId);
+    }
+    const __lc_ProductionPredecessor &
+    GetModuleProductionPredecessor(__lc_ModuleIdType moduleId, int id) const {
+      return _table.Get(_first + moduleId, id);
+    }
     bool IsRing() const { return _bIsRing; }
 
-  protected:
-    const LsysDll &_dll;
-
   private:
+    const PredecessorTable &_table;
+    // entry of the module with id 0
+    size_t _first;
     bool _bIsRing;
   };
 
   class MatchInterpretationParameters : public MatchParameters {
   public:
     MatchInterpretationParameters(int iGroup, int iVGroup, const LsysDll &dll)
-        : MatchParameters(dll), _iGroup(iGroup), _iVGroup(iVGroup) {}
-    virtual int NumOfModuleProductions(__lc_ModuleIdType moduleId) const {
-      return _dll.NumOfModuleIProductions(_iGroup, _iVGroup, moduleId);
-    }
-    virtual const __lc_ProductionPredecessor &
-    GetModuleProductionPredecessor(__lc_ModuleIdType moduleId, int id) const {
-      return _dll.GetModuleIProductionPredecessor(_iGroup, _iVGroup, moduleId,
-                                                  id);
-    }
-
-  private:
-    int _iGroup;
-    int _iVGroup;
+        : MatchParameters(dll.InterpretationTable(),
+                          dll.IEntry(iGroup, iVGroup, 0), dll) {}
   };
 
   class MatchDecompositionParameters : public MatchParameters {
   public:
     MatchDecompositionParameters(int iGroup, const LsysDll &dll)
-        : MatchParameters(dll), _iGroup(iGroup) {}
-
-    virtual int NumOfModuleProductions(__lc_ModuleIdType moduleId) const {
-      return _dll.NumOfModuleDProductions(_iGroup, moduleId);
-    }
-    virtual const __lc_ProductionPredecessor &
-    GetModuleProductionPredecessor(__lc_ModuleIdType moduleId, int id) const {
-      return _dll.GetModuleDProductionPredecessor(_iGroup, moduleId, id);
-    }
-
-  private:
-    int _iGroup;
+        : MatchParameters(dll.DecompositionTable(), dll.DEntry(iGroup, 0),
+                          dll) {}
   };
 
   bool FindMatch(const LstringIterator &citer, __lc_CallerData &cd,
@@ -309,6 +318,7 @@ private:
       if (!applied) {
         applied = TryInterpret(iter, 0, vgrp);
       }
+      PerformanceMonitor::Tally(1, applied ? 1 : 0);
 
       // if no matching interpretation rule
       // can be found
@@ -82,7 +82,9 @@ void LEngine::DrawGL(Vector3d vn, int vgrp, unsigned int glbase,
     return;
 
   ++_sDrawCount;
-  TIME_THIS(3);
+  TIME_THIS(PerformanceMonitor::pmDrawGL);
+  PerformanceMonitor::CountThis countThis(PerformanceMonitor::pmDrawGL,
+                                          _lstring.BytesUsed());
 
   // polygon is used to store
   // and draw polygons
@@ -127,6 +129,9 @@ void LEngine::DrawPOVRay(std::ofstream &scene_trg,
                          std::ofstream &terrain_trg, std::ofstream &layout,
                          int vgrp) const {
   // output to POVray
+  TIME_THIS(PerformanceMonitor::pmOutputPOVRay);
+  PerformanceMonitor::CountThis countThis(PerformanceMonitor::pmOutputPOVRay,
+                                          _lstring.BytesUsed());
   POVRayTurtle turtle(scene_trg, surface_trg_arr, layout);
 
   turtle.terrainDeclaration(terrain_trg);
@@ -139,6 +144,9 @@ void LEngine::DrawPOVRay(std::ofstream &scene_trg,
 void LEngine::DrawRayshade(std::ofstream &target,
                            const Projection &currentProjection, GLEnv &glEnv,
                            std::string fname, int vgrp) const {
+  TIME_THIS(PerformanceMonitor::pmOutputRayshade);
+  PerformanceMonitor::CountThis countThis(PerformanceMonitor::pmOutputRayshade,
+                                          _lstring.BytesUsed());
   std::string name = fname.substr(0, fname.size() - 4);
   //  Output to Rayshade
   // the following call is necessary otherwise the opengl context is reset
@@ -160,6 +168,9 @@ void LEngine::DrawRayshade(std::ofstream &target,
 }
 
 void LEngine::InterpretToFile(const std::string &targetFilename) const {
+  TIME_THIS(PerformanceMonitor::pmInterpret);
+  PerformanceMonitor::CountThis countThis(PerformanceMonitor::pmInterpret,
+                                          _lstring.BytesUsed());
   WriteTextFile targetFile(targetFilename.c_str());
   TextFileTurtle turtle(targetFile.Fp());
   std::stack<TextFileTurtle> stack;
@@ -179,6 +190,9 @@ void LEngine::InterpretToFile(const std::string &targetFilename) const {
 void LEngine::DrawObj(std::string fname, GLEnv &glEnv, const Volume &v,
                       int vgrp) const {
   // output to obj
+  TIME_THIS(PerformanceMonitor::pmOutputObj);
+  PerformanceMonitor::CountThis countThis(PerformanceMonitor::pmOutputObj,
+                                          _lstring.BytesUsed());
   try {
     ObjOutputStore store(fname, glEnv, v);
     ObjTurtle turtle(store);
@@ -195,6 +209,9 @@ void LEngine::DrawPostscript(std::ostream &trg, int vgrp,
                              const Projection &currentProjection,
                              DParams::ProjectionMode mode) const {
   // output to postscript
+  TIME_THIS(PerformanceMonitor::pmOutputPostscript);
+  PerformanceMonitor::CountThis countThis(
+      PerformanceMonitor::pmOutputPostscript, _lstring.BytesUsed());
   Volume vv = CalculateVolume(vgrp).first;
   PsOutputStore store;
   PostscriptTurtle turtle(trg, store, vv, currentProjection, mode);
@@ -206,12 +223,14 @@ void LEngine::DrawPostscript(std::ostream &trg, int vgrp,
 
 void LEngine::InterpretForEnvironment(int grp) {
   if (IsESensitive() || _pEnvironment.get() != NULL) {
-    TIME_THIS(2);
+    TIME_THIS(PerformanceMonitor::pmEnvironment);
+    PerformanceMonitor::CountThis countThis(PerformanceMonitor::pmEnvironment,
+                                            _lstring.BytesUsed());
     ASSERT(ValidLsystem());
     bool IgnoreAnswer = false;
     {
       // Output represents the communication
-      // media (file)
+      // channel (files, shared memory or pipes)
       Environment::Output output(_pEnvironment.get());
       EnvironmentTurtle turtle(_lstring,
 #ifdef USE_MESH
@@ -49,24 +49,48 @@
 #endif
 
 // interface from the lpfg predefined function to the LPFG object
-void Interface::UseView(int vid) { pLpfg->UseView(vid); }
+void Interface::UseView(int vid) {
+  if (SerialOnly())
+    return;
+  pLpfg->UseView(vid);
+}
 
 // interface from the lpfg predefined function to the LPFG object
-void Interface::CloseView(int vid) { pLpfg->CloseView(vid); }
+void Interface::CloseView(int vid) {
+  if (SerialOnly())
+    return;
+  pLpfg->CloseView(vid);
+}
 
 // interface from the lpfg predefined function to the LPFG object
-void Interface::DisplayFrame() { pLpfg->DisplayFrame(); }
+void Interface::DisplayFrame() {
+  if (SerialOnly())
+    return;
+  pLpfg->DisplayFrame();
+}
 
-void Interface::OutputFrame(const char *name) { pLpfg->SetOutputFrame(name); }
+void Interface::OutputFrame(const char *name) {
+  if (SerialOnly())
+    return;
+  pLpfg->SetOutputFrame(name);
+}
 
 // interface from the lpfg predefined function to the LPFG object
 int Interface::StepNo() { return pLpfg->GetLEngine().StepNo(); }
 
 double Interface::GillespieTime() { return pLpfg->GillespieTime(); }
 
-void Interface::SeedGillespie(long seed) { pLpfg->SeedGillespie(seed); }
+void Interface::SeedGillespie(long seed) {
+  if (SerialOnly())
+    return;
+  pLpfg->SeedGillespie(seed);
+}
 
-void Interface::ResetGillespie() { pLpfg->ResetGillespie(); }
+void Interface::ResetGillespie() {
+  if (SerialOnly())
+    return;
+  pLpfg->ResetGillespie();
+}
 
 LPFG::~LPFG() {
   // reset the global LPFG pointer
@@ -943,13 +967,21 @@ CameraPosition Interface::GetCameraPosition(int vid) {
   return pLpfg->GetView(vid)->GetCameraPosition();
 }
 
-void Interface::Stop() { pLpfg->StopFunction(); }
+void Interface::Stop() {
+  if (SerialOnly())
+    return;
+  pLpfg->StopFunction();
+}
 
 void Interface::OutputString(const char *filename) {
+  if (SerialOnly())
+    return;
   pLpfg->OutputString(std::string(filename));
 }
 
 void Interface::LoadString(const char *filename) {
+  if (SerialOnly())
+    return;
   pLpfg->LoadString(std::string(filename));
 }
 
@@ -1,13 +1,13 @@
 TEMPLATE = app
 CONFIG  += qt opengl core 
 SOURCES  = animparam.cpp colormap.cpp comlineparam.cpp configfile.cpp \
-	   contour.cpp contourarr.cpp drawparam.cpp dynlib.cpp \
-	   lsysdll.cpp environment.cpp envparams.cpp envturtle.cpp \
+	   contour.cpp contourarr.cpp dllcache.cpp drawparam.cpp dynlib.cpp \
+	   lsysdll.cpp envchannel.cpp environment.cpp envparams.cpp envturtle.cpp \
 	   exception.cpp file.cpp funcs.cpp function.cpp gencyldata.cpp \
 	   gencyltrtl.cpp glenv.cpp glturtle.cpp interface.cpp \
 	   lengine.cpp lderive.cpp linterpret.cpp lightsrc.cpp lock.cpp \
 	   lpfg.cpp lstring.cpp lstriter.cpp mainLnx.cpp material.cpp \
-	   materialset.cpp mempool.cpp numchecktrtl.cpp \
+	   materialset.cpp mempool.cpp numchecktrtl.cpp PerformanceMonitor.cpp \
 	   objout.cpp objturtle.cpp patch.cpp pipepair.cpp  psout.cpp polygon.cpp \
 	   povmesh.cpp povray.cpp povtrngl.cpp povrayturtle.cpp \
 	   process.cpp projection.cpp psturtle.cpp rect.cpp rayshadeturtle.cpp \
@@ -21,11 +21,19 @@
 #include "lstriter.h"
 #include "succstor.h"
 #include <stdio.h>
+#include <algorithm>
+
+#include "StdModulesStruct.h"
+
+static const size_t kNoMatch = static_cast<size_t>(-1);
 
 const int BfSize = 256;
 static char bf[BfSize];
 
-Lstring::Lstring(size_t initSize) : _pPool(0) {
+Lstring::Lstring(size_t initSize)
+    : _pPool(0), _poolMark(), _branchIndexed(false) {
+  // modules must stay aligned also when growing backward
+  ASSERT(0 == initSize % sizeof(__lc_MainAlignType));
   // allocate memory
   _mem = (char *)malloc(initSize);
   if (0 == _mem) {
@@ -38,25 +46,11 @@ Lstring::Lstring(size_t initSize) : _pPool(0) {
   _direction = eForward;
 }
 
-Lstring::Lstring(MemoryPool *pPool) : _pPool(pPool) {
+Lstring::Lstring(MemoryPool *pPool)
+    : _pPool(pPool), _poolMark(pPool->GetMark()), _branchIndexed(false) {
   // memory provided by the MemoryPool
-  _mem = _pPool->GetMem();
-
-  if (0 != _mem) {
-    _size = _pPool->GetMemSize();
-  }
-  // unless nothing available
-  // then allocate memory yourself
-  else {
-    _pPool = 0;
-    _mem = (char *)malloc(eInitSize);
-    if (0 == _mem) {
-      sprintf(bf, "Out of memory, cannot allocate: %d", eInitSize);
-      throw bf;
-    }
-    _size = eInitSize;
-  }
-
+  _size = _pPool->GetMemSize();
+  _mem = _pPool->GetMem(_size);
   _lastByte = 0;
   _direction = eForward;
 }
@@ -64,12 +58,14 @@ Lstring::Lstring(MemoryPool *pPool) : _pPool(pPool) {
 Lstring::~Lstring() {
   // free memory
   if (_pPool != 0)
-    _pPool->Release(_mem);
+    _pPool->Release(_poolMark);
   else
     free(_mem);
 }
 
 void Lstring::Clear(DerivationDirection dir) {
+  _DropBranchIndex();
+  _inert.clear();
   // assume new growing direction
   _direction = dir;
   // reset the content
@@ -96,6 +92,7 @@ void Lstring::Append(const LstringIterator &iter) {
   // pointed to by the iterator
   // available in forward growth only
   ASSERT(eForward == _direction);
+  _DropBranchIndex();
   const size_t size = iter.GetModuleSize();
   // make sure there is enough room
   while (BytesFree() < size)
@@ -109,14 +106,45 @@ void Lstring::Append(const LstringIterator &iter) {
 
 void Lstring::Append(const Lstring &src) {
   ASSERT(eForward == _direction);
+  _DropBranchIndex();
   while (BytesFree() < src.BytesUsed())
     _Grow();
   memcpy(_mem + _lastByte, src._mem, src.BytesUsed());
+  // the inert spans of src move with it
+  for (size_t i = 0; i < src._inert.size(); ++i)
+    _AddInertSpan(_lastByte + src._inert[i].Begin(),
+                  _lastByte + src._inert[i].End());
   _lastByte += src.BytesUsed();
   ASSERT(_lastByte <= _size);
 }
 
+void Lstring::AppendInert(const Lstring &src, size_t begin, size_t end) {
+  ASSERT(eForward == _direction);
+  ASSERT(begin <= end);
+  _DropBranchIndex();
+  const size_t size = end - begin;
+  while (BytesFree() < size)
+    _Grow();
+  memcpy(_mem + _lastByte, src._mem + begin, size);
+  _AddInertSpan(_lastByte, _lastByte + size);
+  _lastByte += size;
+  ASSERT(_lastByte <= _size);
+}
+
+void Lstring::_AddInertSpan(size_t begin, size_t end) {
+  // merge with the previous span if adjacent
+  if (!_inert.empty() && _inert.back().End() == begin)
+    _inert.back().End(end);
+  else {
+    Range span;
+    span.Begin(begin);
+    span.End(end);
+    _inert.push_back(span);
+  }
+}
+
 void Lstring::_Append(const SuccessorStorage &storage) {
+  _DropBranchIndex();
   // make sure there is enough room
   while (BytesFree() < storage.Size())
     _Grow();
@@ -128,6 +156,8 @@ void Lstring::_Append(const SuccessorStorage &storage) {
 }
 
 void Lstring::_Prepend(const SuccessorStorage &storage) {
+  _DropBranchIndex();
+  _inert.clear();
   // make sure there is enough room
   while (BytesFree() < storage.Size())
     _Grow();
@@ -138,21 +168,14 @@ void Lstring::_Prepend(const SuccessorStorage &storage) {
 }
 
 void Lstring::_Grow() {
+  // positions change when growing backward
+  _DropBranchIndex();
   // double the size of the buffer
   size_t newsize = _size * 2;
   // if using pool
-  if (0 != _pPool) {
-    // then alloc as new
-    char *aNew = (char *)malloc(newsize);
-    if (0 == aNew) {
-      sprintf(bf, "Out of memory, cannot allocate: %zu", newsize);
-      throw bf;
-    }
-    // release the pool
-    _pPool->Release(_mem);
-    _pPool = 0;
-    _mem = aNew;
-  }
+  // then grow within the pool
+  if (0 != _pPool)
+    _mem = _pPool->Grow(_mem, _size, newsize);
   // otherwise realloc
   else {
     char *aNew = (char *)realloc(_mem, newsize);
@@ -214,6 +237,22 @@ void Lstring::Swap(Lstring &swp) {
     _pPool = swp._pPool;
     swp._pPool = pTmp;
   }
+
+  {
+    MemoryPool::Mark tmp = _poolMark;
+    _poolMark = swp._poolMark;
+    swp._poolMark = tmp;
+  }
+
+  {
+    bool tmp = _branchIndexed;
+    _branchIndexed = swp._branchIndexed;
+    swp._branchIndexed = tmp;
+    _brackets.swap(swp._brackets);
+    _ignoredRuns.swap(swp._ignoredRuns);
+  }
+
+  _inert.swap(swp._inert);
 }
 
 char *Lstring::GetParams(const LstringIterator &iter) const {
@@ -222,6 +261,8 @@ char *Lstring::GetParams(const LstringIterator &iter) const {
 }
 
 void Lstring::Insert(void *pModule, size_t size, size_t offset) {
+  _DropBranchIndex();
+  _inert.clear();
   if (BytesFree() < size) {
     _Grow();
   }
@@ -240,6 +281,8 @@ void Lstring::Insert(void *pModule, size_t size, size_t offset) {
 void Lstring::Replace(const Lstring &src, const Lstring::Range &srcpos,
                       const Lstring::Range &trgpos) {
   ASSERT(&src != this);
+  _DropBranchIndex();
+  _inert.clear();
 
   if (srcpos.Size() != trgpos.Size()) {
     if (srcpos.Size() > trgpos.Size()) {
@@ -264,3 +307,70 @@ void Lstring::Replace(const Lstring &src, const Lstring::Range &srcpos,
 
   memcpy(_mem + trgpos.Begin(), src._mem + srcpos.Begin(), srcpos.Size());
 }
+
+void Lstring::BuildBranchIndex() {
+  _DropBranchIndex();
+  // indices of the open brackets
+  std::vector<size_t> open;
+  LstringIterator iter(*this);
+  if (!iter.AtEnd())
+    do {
+      if (SB_id == iter.GetModuleId()) {
+        open.push_back(_brackets.size());
+        _brackets.push_back(std::make_pair(iter.Position(), kNoMatch));
+      } else if (EB_id == iter.GetModuleId()) {
+        if (open.empty())
+          _brackets.push_back(std::make_pair(iter.Position(), kNoMatch));
+        else {
+          std::pair<size_t, size_t> &sb = _brackets[open.back()];
+          open.pop_back();
+          sb.second = iter.Position();
+          _brackets.push_back(std::make_pair(iter.Position(), sb.first));
+        }
+      }
+    } while (++iter);
+  _branchIndexed = true;
+}
+
+bool Lstring::MatchingBracket(size_t pos, size_t &match) const {
+  // returns false if there is no index
+  // or the bracket at pos is not matched
+  if (!_branchIndexed)
+    return false;
+  std::vector<std::pair<size_t, size_t>>::const_iterator it =
+      std::lower_bound(_brackets.begin(), _brackets.end(),
+                       std::make_pair(pos, size_t(0)));
+  if (it == _brackets.end() || it->first != pos || kNoMatch == it->second)
+    return false;
+  match = it->second;
+  return true;
+}
+
+void Lstring::AddIgnoredRun(int iConsiderGroup, size_t begin, size_t end) {
+  ASSERT(_branchIndexed);
+  if (_ignoredRuns.size() <= static_cast<size_t>(iConsiderGroup))
+    _ignoredRuns.resize(iConsiderGroup + 1);
+  Range run;
+  run.Begin(begin);
+  run.End(end);
+  _ignoredRuns[iConsiderGroup].push_back(run);
+}
+
+bool Lstring::IgnoredRun(size_t pos, int iConsiderGroup, Range &run) const {
+  // returns false if the module at pos
+  // is not in an indexed run
+  if (_ignoredRuns.size() <= static_cast<size_t>(iConsiderGroup))
+    return false;
+  const std::vector<Range> &runs = _ignoredRuns[iConsiderGroup];
+  // the first run beginning after pos
+  std::vector<Range>::const_iterator it =
+      std::upper_bound(runs.begin(), runs.end(), pos,
+                       [](size_t p, const Range &r) { return p < r.Begin(); });
+  if (it == runs.begin())
+    return false;
+  --it;
+  if (pos >= it->End())
+    return false;
+  run = *it;
+  return true;
+}
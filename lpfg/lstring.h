@@ -20,6 +20,9 @@
 #ifndef __LSTRING_H__
 #define __LSTRING_H__
 
+#include <utility>
+#include <vector>
+
 #include "mempool.h"
 #include "lpfgparams.h"
 #include "include/lparams.h"
@@ -40,6 +43,9 @@ public:
   void Add(SuccessorStorage &);         // after adding clears the storage
   void Append(const LstringIterator &); // adds the current module
   void Append(const Lstring &);
+  // appends the modules in [begin, end) of src and records
+  // them as inert: without productions in the current group
+  void AppendInert(const Lstring &src, size_t begin, size_t end);
   size_t AllocatedSize() const { return _size; }
   size_t BytesUsed() const;
   size_t BytesFree() const {
@@ -71,6 +77,23 @@ public:
 
   void Replace(const Lstring &src, const Range &srcpos, const Range &trgpos);
 
+  // index of matching brackets (SB/EB) used to skip
+  // branches without scanning them. Any change to
+  // the string discards it
+  void BuildBranchIndex();
+  bool MatchingBracket(size_t pos, size_t &match) const;
+  // runs of at least eMinIgnoredRun modules not considered
+  // in a consider group, skipped at once when matching
+  // context. Added after BuildBranchIndex and discarded
+  // together with the branch index
+  enum { eMinIgnoredRun = 4 };
+  void AddIgnoredRun(int iConsiderGroup, size_t begin, size_t end);
+  bool IgnoredRun(size_t pos, int iConsiderGroup, Range &run) const;
+
+  // spans appended by AppendInert, in order. Unlike the
+  // branch index they are kept when appending to the string
+  const std::vector<Range> &InertSpans() const { return _inert; }
+
 private:
   void _Append(const SuccessorStorage &);
   void _Prepend(const SuccessorStorage &);
@@ -80,7 +103,24 @@ private:
   size_t _lastByte;
   DerivationDirection _direction;
   MemoryPool *_pPool;
+  // pool memory is released up to here
+  MemoryPool::Mark _poolMark;
   void _Grow();
+
+  void _DropBranchIndex() {
+    _branchIndexed = false;
+    _brackets.clear();
+    _ignoredRuns.clear();
+  }
+  bool _branchIndexed;
+  // position of each bracket and of its match,
+  // sorted by position
+  std::vector<std::pair<size_t, size_t>> _brackets;
+  // for each consider group, sorted by position
+  std::vector<std::vector<Range>> _ignoredRuns;
+
+  void _AddInertSpan(size_t begin, size_t end);
+  std::vector<Range> _inert;
 };
  
 #else
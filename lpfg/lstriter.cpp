@@ -119,9 +119,11 @@ bool LstringIterator::FindEOB() {
   if (!AtEnd())
     do {
       const int mid = GetModuleId();
-      if (SB_id == mid)
-        ++nested;
-      else if (EB_id == mid) {
+      if (SB_id == mid) {
+        // skip nested branches if indexed
+        if (!_JumpToMatchingBracket())
+          ++nested;
+      } else if (EB_id == mid) {
         --nested;
         if (0 == nested)
           return true;
@@ -158,13 +160,65 @@ bool LstringIterator::FindBOB() {
       --nested;
       if (0 == nested)
         return true;
-    } else if (EB_id == mid)
-      ++nested;
+    } else if (EB_id == mid) {
+      // skip nested branches if indexed
+      if (!_JumpToMatchingBracket())
+        ++nested;
+      else if (AtBeginning())
+        break;
+    }
     operator--();
   }
   return false;
 }
 
+bool LstringIterator::SkipBranch(bool bRing) {
+  ASSERT(SB_id == GetModuleId());
+  if (_JumpToMatchingBracket())
+    return true;
+  Advance(bRing);
+  return FindEOB(bRing);
+}
+
+bool LstringIterator::SkipBranchBack(bool bRing) {
+  ASSERT(EB_id == GetModuleId());
+  // FindBOB does not accept SB at the beginning
+  // of the string unless in a ring L-system
+  if (_JumpToMatchingBracket())
+    return bRing || !AtBeginning();
+  if (!Back(bRing))
+    return false;
+  return FindBOB(bRing);
+}
+
+bool LstringIterator::SkipIgnored(int iConsiderGroup) {
+  Lstring::Range run;
+  if (!_lstring.IgnoredRun(_currentPos, iConsiderGroup, run))
+    return false;
+  _currentPos = run.End();
+  if (!AtEnd())
+    _RetrieveModuleId();
+  return true;
+}
+
+bool LstringIterator::SkipIgnoredBack(int iConsiderGroup) {
+  Lstring::Range run;
+  if (!_lstring.IgnoredRun(_currentPos, iConsiderGroup, run))
+    return false;
+  _currentPos = run.Begin();
+  _RetrieveModuleId();
+  return true;
+}
+
+bool LstringIterator::_JumpToMatchingBracket() {
+  size_t match;
+  if (!_lstring.MatchingBracket(_currentPos, match))
+    return false;
+  _currentPos = match;
+  _RetrieveModuleId();
+  return true;
+}
+
 bool LstringIterator::FindBOBRing() {
   int nested = 1;
   const size_t initPos = _currentPos;
@@ -18,6 +18,7 @@
 #include "asrt.h"
 
 size_t GetSizeOfParams(int);
+size_t GetSizeOfParamsData(int);
 const char *GetNameOf(int);
 
 class Lstring;
@@ -75,6 +76,16 @@ public:
   bool FindBOB(bool bRing) { return bRing ? FindBOBRing() : FindBOB(); }
   bool FindBOB(); // if current module is SB will return immediately
   bool FindBOBRing();
+  // from SB move to the matching EB
+  // (or from EB back to the matching SB)
+  // using the branch index of the string if present
+  bool SkipBranch(bool bRing);
+  bool SkipBranchBack(bool bRing);
+  // from a module not considered in the consider group
+  // move past the indexed run of such modules containing it
+  // (or back to its first module). False if there is no such run
+  bool SkipIgnored(int iConsiderGroup);
+  bool SkipIgnoredBack(int iConsiderGroup);
   const char *Ptr() const { return _mem + _currentPos; }
   const char *GetModuleName() const { return GetNameOf(GetModuleId()); }
   size_t GetModuleSize() const {
@@ -113,6 +124,7 @@ protected:
 private:
   __lc_ModuleIdType _CurrentModuleId;
   size_t _moduleSize;
+  bool _JumpToMatchingBracket();
   void _RetrieveModuleId() {
     ASSERT(!AtEnd());
 #ifdef NO_MEMCOPY
@@ -250,9 +250,15 @@ bool LsysDll::_Map() {
     res = false;
   }
 
+  // not required
+  _pIsParallelDerivation = (pfBoolVoid)GetProc("IsParallelDerivation");
+  _pNewContextQueries = (pfIntVoid)GetProc("NewContextQueries");
+
   if (res) {
+    BuildPredecessorTables();
     DetermineIfESensitive();
     DetermineIfHasDecompositions();
+    DetermineNewLeftContext();
     BuildConsiderArray();
   }
 
@@ -299,6 +305,14 @@ void LsysDll::_Unmap() {
   _pGetDerivationType = 0;
   _pGetModuleUnionSize = 0;
   _pNumOfConsiderGroups = 0;
+  _pIsParallelDerivation = 0;
+  _pNewContextQueries = 0;
+  _ring = false;
+  _HasContext = false;
+  _modules = _groups = _vgroups = 0;
+  _PTable.Clear();
+  _DTable.Clear();
+  _ITable.Clear();
 }
 
 void LsysDll::DetermineIfESensitive() {
@@ -374,6 +388,62 @@ void LsysDll::DetermineIfHasDecompositions() {
   }
 }
 
+void LsysDll::BuildPredecessorTables() {
+  // copy the module -> predecessors lookup
+  // out of the dll, so that matching
+  // does not call the dll for every module
+  _ring = (0 != _pRingLsystem());
+  _modules = _pNumOfModules();
+  _groups = _pNumOfGroups();
+  _vgroups = _pNumOfVGroups();
+
+  _PTable.Clear();
+  _DTable.Clear();
+  _ITable.Clear();
+  _HasContext = false;
+  for (int grp = 0; grp < _groups; ++grp) {
+    for (int mid = 0; mid < _modules; ++mid) {
+      const int np = _pNumOfModulePProductions(grp, mid);
+      for (int i = 0; i < np; ++i)
+        _PTable.Add(_pGetModulePProductionPredecessor(grp, mid, i));
+      _PTable.Close();
+      const int nd = _pNumOfModuleDProductions(grp, mid);
+      for (int i = 0; i < nd; ++i)
+        _DTable.Add(_pGetModuleDProductionPredecessor(grp, mid, i));
+      _DTable.Close();
+    }
+    // productions with context scan the string
+    for (int i = 0; i < _pNumOfProductions(grp); ++i) {
+      const __lc_ProductionPredecessor &pred =
+          _pGetProductionPredecessor(grp, i);
+      if (pred.LCntxt.Cntxt.count > 0 || pred.RCntxt.Cntxt.count > 0)
+        _HasContext = true;
+    }
+    for (int vgrp = 0; vgrp < _vgroups; ++vgrp) {
+      for (int mid = 0; mid < _modules; ++mid) {
+        const int ni = _pNumOfModuleIProductions(grp, vgrp, mid);
+        for (int i = 0; i < ni; ++i)
+          _ITable.Add(_pGetModuleIProductionPredecessor(grp, vgrp, mid, i));
+        _ITable.Close();
+      }
+    }
+  }
+}
+
+void LsysDll::DetermineNewLeftContext() {
+  // productions with new left context (<<) read the string
+  // derived so far, which prevents deriving the group in parallel
+  _NewLeftContext.assign(NumOfGroups(), false);
+  for (int tbl = 0; tbl < NumOfGroups(); ++tbl) {
+    for (int i = 0; i < NumOfProductions(tbl); ++i) {
+      if (GetProductionPredecessor(tbl, i).LCntxt.HasNewContext()) {
+        _NewLeftContext[tbl] = true;
+        break;
+      }
+    }
+  }
+}
+
 void LsysDll::BuildConsiderArray() {
   _considered.resize(NumOfModules() * NumOfConsiderGroups());
 
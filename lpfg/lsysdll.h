@@ -28,6 +28,35 @@
 #include "dynlib.h"
 #include "asrt.h"
 
+// Predecessors of the productions (or decompositions, or
+// interpretations) applicable to each module, stored in one
+// contiguous array. Entries are indexed by group, view group
+// and module id and are filled in order.
+class PredecessorTable {
+public:
+  PredecessorTable() { Clear(); }
+  void Clear() {
+    _first.assign(1, 0);
+    _pred.clear();
+  }
+  void Add(const __lc_ProductionPredecessor &pred) { _pred.push_back(&pred); }
+  // ends the current entry
+  void Close() { _first.push_back(static_cast<int>(_pred.size())); }
+
+  int Count(size_t entry) const {
+    ASSERT(entry + 1 < _first.size());
+    return _first[entry + 1] - _first[entry];
+  }
+  const __lc_ProductionPredecessor &Get(size_t entry, int i) const {
+    ASSERT(i < Count(entry));
+    return *_pred[_first[entry] + i];
+  }
+
+private:
+  std::vector<int> _first;
+  std::vector<const __lc_ProductionPredecessor *> _pred;
+};
+
 class LsysDll : public DynLibrary {
 public:
   LsysDll();
@@ -62,19 +91,16 @@ public:
   }
   int NumOfModulePProductions(int iGroup, __lc_ModuleIdType moduleId) const {
     ASSERT(Connected());
-    ASSERT(grp < NumOfGroups());
-    return _pNumOfModulePProductions(iGroup, moduleId);
+    return _PTable.Count(PEntry(iGroup, moduleId));
   }
   int NumOfModuleDProductions(int iGroup, __lc_ModuleIdType moduleId) const {
     ASSERT(Connected());
-    ASSERT(grp < NumOfGroups());
-    return _pNumOfModuleDProductions(iGroup, moduleId);
+    return _DTable.Count(DEntry(iGroup, moduleId));
   }
   int NumOfModuleIProductions(int iGroup, int iVGroup,
                               __lc_ModuleIdType moduleId) const {
     ASSERT(Connected());
-    ASSERT(grp < NumOfGroups());
-    return _pNumOfModuleIProductions(iGroup, iVGroup, moduleId);
+    return _ITable.Count(IEntry(iGroup, iVGroup, moduleId));
   }
   int NumOfDecompositions(int grp) const {
     ASSERT(Connected());
@@ -108,22 +134,33 @@ public:
   GetModulePProductionPredecessor(int iGroup, __lc_ModuleIdType moduleId,
                                   int item) const {
     ASSERT(Connected());
-    ASSERT(grp < NumOfGroups());
-    return _pGetModulePProductionPredecessor(iGroup, moduleId, item);
+    return _PTable.Get(PEntry(iGroup, moduleId), item);
   }
   const __lc_ProductionPredecessor &
   GetModuleDProductionPredecessor(int iGroup, __lc_ModuleIdType moduleId,
                                   int item) const {
     ASSERT(Connected());
-    ASSERT(grp < NumOfGroups());
-    return _pGetModuleDProductionPredecessor(iGroup, moduleId, item);
+    return _DTable.Get(DEntry(iGroup, moduleId), item);
   }
   const __lc_ProductionPredecessor &
   GetModuleIProductionPredecessor(int iGroup, int iVGroup,
                                   __lc_ModuleIdType moduleId, int item) const {
     ASSERT(Connected());
-    ASSERT(grp < NumOfGroups());
-    return _pGetModuleIProductionPredecessor(iGroup, iVGroup, moduleId, item);
+    return _ITable.Get(IEntry(iGroup, iVGroup, moduleId), item);
+  }
+
+  // direct access to the predecessor tables.
+  // Entries for consecutive module ids are consecutive
+  const PredecessorTable &DecompositionTable() const { return _DTable; }
+  const PredecessorTable &InterpretationTable() const { return _ITable; }
+  size_t DEntry(int iGroup, __lc_ModuleIdType moduleId) const {
+    ASSERT(iGroup < _groups);
+    return iGroup * _modules + moduleId;
+  }
+  size_t IEntry(int iGroup, int iVGroup, __lc_ModuleIdType moduleId) const {
+    ASSERT(iGroup < _groups);
+    ASSERT(iVGroup < _vgroups);
+    return (iGroup * _vgroups + iVGroup) * _modules + moduleId;
   }
   int NumOfConsidered(int iConsiderGroup) const {
     ASSERT(Connected());
@@ -171,19 +208,36 @@ public:
   }
   bool RingLsystem() const {
     ASSERT(Connected());
-    return _pRingLsystem() != 0;
+    return _ring;
   }
   bool IgnoreEnvironment() const {
     ASSERT(Connected());
     return _pIgnoreEnvironment();
   }
   int CurrentGroup() const { return _pCurrentGroup(); }
-  int NumOfGroups() const { return _pNumOfGroups(); }
-  int NumOfVGroups() const { return _pNumOfVGroups(); }
+  int NumOfGroups() const { return _groups; }
+  int NumOfVGroups() const { return _vgroups; }
   int NumOfConsiderGroups() const { return _pNumOfConsiderGroups(); }
 
   bool IsEnvSensitive() const { return _EnvSensitive; }
   bool HasDecompositions() const { return _HasDecompositions; }
+  // true if any production has left or right context
+  bool HasContext() const { return _HasContext; }
+
+  // optional: L-systems translated by older versions of l2c
+  // do not export these and are always derived serially
+  bool ParallelDerivation() const {
+    ASSERT(Connected());
+    return (0 != _pIsParallelDerivation) && _pIsParallelDerivation();
+  }
+  bool NewContextQueries() const {
+    ASSERT(Connected());
+    return (0 == _pNewContextQueries) || (0 != _pNewContextQueries());
+  }
+  bool HasNewLeftContext(int grp) const {
+    ASSERT(grp < NumOfGroups());
+    return _NewLeftContext[grp];
+  }
 
   __lc_GroupType DerivationType(int grp) const {
     return _pGetDerivationType(grp);
@@ -200,13 +254,19 @@ protected:
 private:
   void DetermineIfESensitive();
   void DetermineIfHasDecompositions();
+  void DetermineNewLeftContext();
+  void BuildPredecessorTables();
+  size_t PEntry(int iGroup, __lc_ModuleIdType moduleId) const {
+    ASSERT(iGroup < _groups);
+    return iGroup * _modules + moduleId;
+  }
   bool IsESensitive(const __lc_ProductionPredecessor &) const;
   bool IsESensitive(__lc_ModuleIdType) const;
 
   void BuildConsiderArray();
   void BuildConsiderGroup(int iConsiderGroup);
   int ConsiderIndex(__lc_ModuleIdType moduleId, int iConsiderGroup) const {
-    return iConsiderGroup * NumOfModules() + moduleId;
+    return iConsiderGroup * _modules + moduleId;
   }
   bool InConsidered(__lc_ModuleIdType moduleId, int iConsiderGroup) const;
   bool InIgnored(__lc_ModuleIdType moduleId, int iConsiderGroup) const;
@@ -270,9 +330,21 @@ private:
   pfIntVoid _pNumOfConsiderGroups;
   pfGroupTypeInt _pGetDerivationType;
   pfIntVoid _pGetModuleUnionSize;
+  pfBoolVoid _pIsParallelDerivation;
+  pfIntVoid _pNewContextQueries;
 
   bool _EnvSensitive;
   bool _HasDecompositions;
+  bool _HasContext;
+  // cached when connected, used in every matching
+  bool _ring;
+  int _modules;
+  int _groups;
+  int _vgroups;
+  PredecessorTable _PTable;
+  PredecessorTable _DTable;
+  PredecessorTable _ITable;
+  std::vector<bool> _NewLeftContext;
   std::vector<bool> _considered;
 };
 
@@ -17,14 +17,77 @@
 
 
 
+#include <cstring>
+
 #include "mempool.h"
 
-MemoryPool::MemoryPool() {
-  _bf = (char *)malloc(eChunkSize * eChunkCount);
-  if (0 == _bf)
+MemoryPool::MemoryPool() : _current(0), _used(0), _base(0), _highWaterMark(0) {
+  Slab slab;
+  slab.bf = (char *)malloc(eFirstSlabSize);
+  if (0 == slab.bf)
     throw "Out of memory";
-  for (int i = 0; i < eChunkCount; ++i)
-    _stack.Push(i);
+  slab.size = eFirstSlabSize;
+  _slabs.push_back(slab);
+}
+
+MemoryPool::~MemoryPool() {
+  for (size_t i = 0; i < _slabs.size(); ++i)
+    free(_slabs[i].bf);
+}
+
+char *MemoryPool::GetMem(size_t size) {
+  size = _Aligned(size);
+  while (_used + size > _slabs[_current].size)
+    _NextSlab(size);
+  char *pX = _slabs[_current].bf + _used;
+  _used += size;
+  if (_base + _used > _highWaterMark)
+    _highWaterMark = _base + _used;
+  return pX;
 }
 
-MemoryPool::~MemoryPool() { free(_bf); }
+char *MemoryPool::Grow(char *pX, size_t size, size_t newsize) {
+  ASSERT(newsize >= size);
+  const Slab &slab = _slabs[_current];
+  // if pX is the last block allocated
+  // and there is room in the current slab
+  // then just extend it
+  if (pX >= slab.bf && pX < slab.bf + _used) {
+    const size_t offset = pX - slab.bf;
+    if (offset + _Aligned(size) == _used &&
+        offset + _Aligned(newsize) <= slab.size) {
+      _used = offset;
+      return GetMem(newsize);
+    }
+  }
+  // otherwise move to a new block.
+  // The old one is released together with it
+  char *pNew = GetMem(newsize);
+  memcpy(pNew, pX, size);
+  return pNew;
+}
+
+void MemoryPool::_NextSlab(size_t size) {
+  // move on to the next slab,
+  // allocating a new one if necessary
+  _base += _slabs[_current].size;
+  _used = 0;
+  ++_current;
+  if (_current == _slabs.size()) {
+    Slab slab;
+    slab.size = 2 * _slabs.back().size;
+    while (slab.size < size)
+      slab.size *= 2;
+    slab.bf = (char *)malloc(slab.size);
+    if (0 == slab.bf)
+      throw "Out of memory";
+    _slabs.push_back(slab);
+  }
+}
+
+size_t MemoryPool::Reserved() const {
+  size_t res = 0;
+  for (size_t i = 0; i < _slabs.size(); ++i)
+    res += _slabs[i].size;
+  return res;
+}
@@ -21,51 +21,72 @@
 #define __MEMPOOL_H__
 
 #include <cstdlib>
+#include <vector>
 
 #include "asrt.h"
 
+// Arena used by the temporary Lstrings created
+// in recursive decompositions and interpretations.
+// Memory is taken from slabs growing geometrically
+// and released in LIFO order by returning to a Mark,
+// which takes constant time. Slabs are kept until
+// the pool is destroyed, so after the first few steps
+// no heap allocation takes place.
 class MemoryPool {
 public:
   MemoryPool();
   ~MemoryPool();
-  char *GetMem() {
-    if (_stack.Empty())
-      return 0;
-    else
-      return _bf + eChunkSize * _stack.Pop();
+
+  // position in the pool
+  struct Mark {
+    size_t slab;
+    size_t used;
+    size_t base;
+  };
+  Mark GetMark() const {
+    Mark mark = {_current, _used, _base};
+    return mark;
   }
-  size_t GetMemSize() const { return eChunkSize; }
-  void Release(const char *pX) {
-    ASSERT(!_stack.Full());
-    size_t ix = (pX - _bf) / eChunkSize;
-    _stack.Push(ix);
+
+  char *GetMem(size_t size);
+  // resizes the block pX (of size bytes). If it is the last
+  // block allocated it grows in place, otherwise its contents
+  // are copied to a new block
+  char *Grow(char *pX, size_t size, size_t newsize);
+  // releases all memory allocated after the mark was taken
+  void Release(const Mark &mark) {
+    ASSERT(mark.slab <= _current);
+    _current = mark.slab;
+    _used = mark.used;
+    _base = mark.base;
   }
-  enum { eChunkSize = 1024, eChunkCount = 64 };
+
+  // initial size of an Lstring in the pool
+  size_t GetMemSize() const { return eChunkSize; }
+  // maximum number of bytes in use at any time
+  size_t HighWaterMark() const { return _highWaterMark; }
+  // bytes allocated from the heap
+  size_t Reserved() const;
+
+  enum { eChunkSize = 1024, eFirstSlabSize = 65536, eAlignment = 16 };
 
 private:
-  class Stack {
-  public:
-    Stack() : _top(0) {}
-    void Push(size_t i) {
-      ASSERT(!Full());
-      _arr[_top] = i;
-      ++_top;
-    }
-    size_t Pop() {
-      ASSERT(!Empty());
-      --_top;
-      return _arr[_top];
-    }
-    bool Empty() const { return 0 == _top; }
-    bool Full() const { return eSize == _top; }
+  void _NextSlab(size_t size);
+  static size_t _Aligned(size_t size) {
+    return (size + eAlignment - 1) & ~size_t(eAlignment - 1);
+  }
 
-  private:
-    enum { eSize = eChunkCount };
-    int _top;
-    size_t _arr[eSize];
+  struct Slab {
+    char *bf;
+    size_t size;
   };
-  Stack _stack;
-  char *_bf;
+  std::vector<Slab> _slabs;
+  // current slab, bytes used in it
+  // and bytes in all the slabs before it
+  size_t _current;
+  size_t _used;
+  size_t _base;
+  size_t _highWaterMark;
 };
 
 #else
@@ -61,6 +61,12 @@ public:
   ~Process();
 
   void Start(const char *);
+#ifndef WIN32
+  // starts the process with its standard input and output
+  // connected to pipes. toProcess and fromProcess receive
+  // the ends of the pipes used by the caller
+  void Start(const char *, int &toProcess, int &fromProcess);
+#endif
 
 #ifdef WIN32
   void WaitAndClose(DWORD);
@@ -73,6 +79,7 @@ private:
 #ifdef WIN32
   HANDLE _hProcess;
 #else
+  void _Start(const char *, const int *);
   pid_t _pid;
 #endif
 };
@@ -904,13 +904,22 @@ void RayshadeTurtle::BlendContours(int id1, int id2, float b) {
 ///   Format is:
 ///     name <name>
 ///     grid # # #
+///   or, with "rayshade aggregate: bvh" in the view file,
+///     name <name>
+///     bvh
 /// NOTE: The grid numbers are used to determine the number of voxels
 ///   used by the rayshader at runtime. 40x40x40 is a high enough default
 ///   for most cases, but there could be special cases where either more or
 ///   less is more optimal. In the original rayshade, it's assumed that 40
 ///   is enough for a refined pass, while 20 is used for a more coarse pass.
+///   A bounding volume hierarchy adapts to the geometry instead, which
+///   suits thin branches and dense clusters of leaves better.
 void RayshadeTurtle::StartNewGrid(int *size, std::string fname) const {
   _target << "name " << fname << "\n";
+  if (drawparams.RayshadeAggregate() == DParams::raBvh) {
+    _target << "bvh\n";
+    return;
+  }
   for (int i = 0; i < 3; i++)
     if (size[i] == 0)
       size[i] = 40;
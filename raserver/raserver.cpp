@@ -83,6 +83,7 @@ Permissions user_permissions;
 // prototypes
 static void serve_client(int sock);
 static void fetch_file(const char *fname, MessagePipe &pipe);
+static void fetch_stream(const char *fname, MessagePipe &pipe);
 static void get_realpath(const char *path, MessagePipe &pipe);
 static void get_readlink(const char *path, MessagePipe &pipe);
 static void get_dir(const char *fname, MessagePipe &pipe);
@@ -97,6 +98,7 @@ static void do_archive_object(const char *str, MessagePipe &pipe);
 static void do_dearchive_object(const char *str, MessagePipe &pipe);
 static void do_paste_object(const char *str, MessagePipe &pipe);
 static void do_putfile(const char *str, const long n, MessagePipe &pipe);
+static void do_put_stream(const char *fname, MessagePipe &pipe);
 static void do_copyfile(const char *str, MessagePipe &pipe);
 static void do_compfile(const char *str, MessagePipe &pipe);
 static void do_mkdir(const char *path, MessagePipe &pipe);
@@ -280,6 +282,10 @@ void serve_client(int sock) {
             "raserver:: I think I am talking to an old client (pre 4.3)\n");
   } else {
     std::string version = "protocol 4.3";
+    // the extensions of the protocol follow the version, where older
+    // clients do not look for them
+    version += '\0';
+    version += "stream";
     messagePipe.send_message(
         Message(RA_VERSION_RESPONSE, version.c_str(), version.length() + 1));
   }
@@ -371,6 +377,11 @@ void serve_client(int sock) {
         print_header("FETCH_FILE_REQUEST");
       fetch_file(m->data, messagePipe);
       break;
+    case RA_FETCH_STREAM_REQUEST:
+      if (raserver_debug)
+        print_header("FETCH_STREAM_REQUEST");
+      fetch_stream(m->data, messagePipe);
+      break;
     case RA_REALPATH_REQUEST:
       if (raserver_debug)
         print_header("REALPATH_REQUEST");
@@ -461,6 +472,11 @@ void serve_client(int sock) {
         print_header("PUTFILE_REQUEST");
       do_putfile(m->data, m->length, messagePipe);
       break;
+    case RA_PUT_STREAM_REQUEST:
+      if (raserver_debug)
+        print_header("PUT_STREAM_REQUEST");
+      do_put_stream(m->data, messagePipe);
+      break;
     case RA_MKDIR_REQUEST:
       if (raserver_debug)
         print_header("MKDIR_REQUEST");
@@ -550,7 +566,11 @@ void fetch_file(const char *fname, MessagePipe &pipe) {
     return;
   }
 
+  // start with room for the whole file, if its size is known
+  struct stat st;
   long alloc = 16384;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size + 1 > alloc)
+    alloc = st.st_size + 1;
   char *buf = (char *)xmalloc(alloc);
   buf[0] = 'y';
   long size = 1;
@@ -563,7 +583,7 @@ void fetch_file(const char *fname, MessagePipe &pipe) {
       break;
     size += l;
     if (alloc == size) {
-      alloc += 16384;
+      alloc *= 2;
       buf = (char *)xrealloc(buf, alloc);
     }
   }
@@ -584,6 +604,62 @@ void fetch_file(const char *fname, MessagePipe &pipe) {
   xfree(buf);
 }
 
+/******************************************************************************
+ *
+ * will stream the requested file (fname) through the pipe
+ *
+ * - the response is 'y' followed by the size of the file in 8 bytes
+ *   (least significant first), after which the file is sent with
+ *   MessagePipe::send_stream()
+ * - if the file cannot be sent (i.e. cannot be open), the response
+ *   is "n" and nothing follows
+ *
+ */
+
+void fetch_stream(const char *fname, MessagePipe &pipe) {
+  if (raserver_debug)
+    fprintf(stderr, "raserver:fetch_stream( %s)\n", fname);
+
+  Message m(RA_FETCH_STREAM_RESPONSE, "n", 1);
+
+  if (!user_permissions.TestPermissions(curr_user_name, fname, "r")) {
+    if (raserver_debug)
+      fprintf(stderr,
+              "User %s trying to read file %s without read permissions!\n",
+              curr_user_name, fname);
+    // simulate a file open failure
+    pipe.send_message(m);
+    return;
+  }
+
+  // open the file for reading
+  int fd = open(fname, O_RDONLY);
+  struct stat st;
+  if (fd == -1 || fstat(fd, &st) == -1) {
+    // open failed - send message with a failure
+    if (fd != -1)
+      close(fd);
+    pipe.send_message(m);
+    return;
+  }
+
+  long long size = S_ISREG(st.st_mode) ? (long long)st.st_size : 0;
+  if (raserver_debug)
+    fprintf(stderr, "raserver:fetch_stream() sending %lld bytes.\n", size);
+
+  char response[9];
+  response[0] = 'y';
+  for (int i = 1; i <= 8; i++) {
+    response[i] = size % 256;
+    size /= 256;
+  }
+  if (pipe.send_message(Message(RA_FETCH_STREAM_RESPONSE, response, 9)) == 0)
+    pipe.send_stream(RA_STREAM_FRAME, RA_STREAM_END, fd);
+
+  // close the file
+  close(fd);
+}
+
 /******************************************************************************
  *
  * will send a directory list to the client
@@ -1504,6 +1580,75 @@ void do_putfile(const char *str, const long length, MessagePipe &pipe) {
   pipe.send_message(m2);
 }
 
+/******************************************************************************
+ *
+ * will receive a file streamed by the client into 'fname'
+ *
+ * - the first response is 'y' if the file could be opened, in which case
+ *   the client sends it with MessagePipe::send_stream(), and a second
+ *   response tells whether all of it was written ('y') or not ('n')
+ * - 'fname' is only replaced once all of the file was written
+ *
+ */
+
+void do_put_stream(const char *fname, MessagePipe &pipe) {
+  Message failure(RA_PUT_STREAM_RESPONSE, "n", 2);
+
+  if (!user_permissions.TestPermissions(curr_user_name, fname, "w")) {
+    if (raserver_debug)
+      fprintf(stderr,
+              "User %s trying to put file %s without proper permissions!\n",
+              curr_user_name, fname);
+    pipe.send_message(failure);
+    return;
+  }
+
+  // the data is received into a temporary file next to the destination,
+  // which replaces it only once all of the data arrived, so a failed
+  // transfer leaves the existing file as it was. Renaming over a link
+  // replaces the link, not the file it points to
+  char *tmp_name = dsprintf("%s.raput%ld", fname, (long)getpid());
+  unlink(tmp_name);
+  int fd = open(tmp_name, O_WRONLY | O_CREAT | O_EXCL,
+                S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+  if (fd == -1) {
+    // could not open the temporary file
+    pipe.send_message(failure);
+    perror("raserver:do_put_stream():open()");
+    xfree(tmp_name);
+    return;
+  }
+  Message ready(RA_PUT_STREAM_RESPONSE, "y", 2);
+  if (pipe.send_message(ready)) {
+    close(fd);
+    unlink(tmp_name);
+    xfree(tmp_name);
+    return;
+  }
+
+  // receive the data straight into the file
+  int result = pipe.receive_stream(RA_STREAM_FRAME, RA_STREAM_END, fd);
+  if (result == 3)
+    perror("raserver:do_put_stream():write()");
+  if (close(fd) == -1 && result == 0) {
+    perror("raserver:do_put_stream():close()");
+    result = 3;
+  }
+  if (result == 0 && rename(tmp_name, fname) == -1) {
+    perror("raserver:do_put_stream():rename()");
+    result = 3;
+  }
+  if (result != 0)
+    unlink(tmp_name);
+  xfree(tmp_name);
+  if (result == 1)
+    // the client is gone
+    return;
+
+  Message done(RA_PUT_STREAM_RESPONSE, result == 0 ? "y" : "n", 2);
+  pipe.send_message(done);
+}
+
 /******************************************************************************
  *
  * will attemp create a directory 'path'
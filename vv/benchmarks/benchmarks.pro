@@ -0,0 +1,14 @@
+# Benchmarks of the vv library, not part of the default build.
+# Build with: qmake benchmarks.pro && make
+# lifetime.cpp is a separate check of the vertex lifetimes, see its header.
+TEMPLATE = app
+CONFIG  += console
+CONFIG  -= app_bundle
+CONFIG  += c++11 thread
+QT      -= gui
+TARGET   = stellar
+INCLUDEPATH += ../vvlib
+SOURCES  = stellar.cpp
+
+MY_BASE  = ../..
+include( $${MY_BASE}/common.pri )
@@ -0,0 +1,107 @@
+/*
+  Checks that CompactVertex/CompactMesh keep and destroy vertices at the
+  same points as AbstractVertex/AbstractMesh: assigning to the last VPtr
+  of a vertex leaves the vertex to the VOwner, releasing the last VPtr or
+  removing the vertex from a mesh destroys it.
+
+  Build with:
+    c++ -I../vvlib -o lifetime lifetime.cpp
+*/
+
+#include <cstdio>
+
+#include <algebra/abstractvertex.hpp>
+#include <algebra/abstractmesh.hpp>
+#include <algebra/compactvertex.hpp>
+#include <algebra/compactmesh.hpp>
+
+/* counts the positions alive, each vertex holds at least one */
+struct Position {
+  static int alive;
+
+  Position() { ++alive; }
+  Position(const Position&) { ++alive; }
+  ~Position() { --alive; }
+  Position& operator=(const Position&) { return *this; }
+};
+
+int Position::alive = 0;
+
+struct Edge {};
+
+typedef algebra::AbstractVertex<Position, Edge> AVertex;
+typedef algebra::AbstractMesh<AVertex>          AMesh;
+typedef algebra::CompactVertex<Position, Edge>  CVertex;
+typedef algebra::CompactMesh<CVertex>           CMesh;
+
+static bool failed = false;
+
+static void Check(bool ok, const char* name, const char* what) {
+  if (!ok) {
+    fprintf(stderr, "FAILED: %s: %s\n", name, what);
+    failed = true;
+  }
+}
+
+template <class V, class M>
+void Run(const char* name) {
+  typedef typename V::VPtr VPtr;
+  int none = Position::alive;
+
+  {
+    VPtr a = (new V())->vptr();
+    V* raw = a.raw();
+    int one = Position::alive;
+
+    a = VPtr();
+    Check(Position::alive == one, name,
+	  "reassigning the last reference keeps the vertex");
+
+    VPtr again(raw);
+    Check(again->getLabel() == raw->getLabel(), name,
+	  "the kept vertex can be referenced again");
+  }
+  Check(Position::alive == none, name,
+	"releasing the last reference destroys the vertex");
+
+  {
+    VPtr a = (new V())->vptr();
+    VPtr b = (new V())->vptr();
+    V* raw = a.raw();
+    int two = Position::alive;
+
+    a = b;
+    Check(Position::alive == two, name,
+	  "reassigning to another vertex keeps the previous one");
+    Check(a == b, name, "both pointers refer to the second vertex");
+
+    a = a;
+    Check(Position::alive == two && a == b, name,
+	  "self assignment keeps the vertex");
+
+    VPtr again(raw);
+  }
+  Check(Position::alive == none, name,
+	"releasing both vertices destroys them");
+
+  {
+    M mesh;
+    mesh.createVertex();
+    Check(Position::alive > none && mesh.vertexCount() == 1, name,
+	  "the mesh holds the only reference");
+
+    mesh.loopStart();
+    mesh.removeVertex(mesh.getCurrent());
+    Check(Position::alive == none && mesh.vertexCount() == 0, name,
+	  "removing the vertex from the mesh destroys it");
+  }
+}
+
+int main() {
+  Run<AVertex, AMesh>("abstract");
+  Run<CVertex, CMesh>("compact");
+
+  if (!failed)
+    printf("vertex lifetime: OK\n");
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,227 @@
+/*
+  Compares the vertex storage of AbstractVertex/AbstractMesh with
+  CompactVertex/CompactMesh on repeated subdivision of an octahedron.
+
+  Each level splits every edge with a new vertex (replace and
+  nbAssign), connects the new vertices into four triangles per old
+  triangle (next and prev), and then averages every vertex with its
+  neighbours through the old neighbourhoods (synchronise, getOld and
+  the neighbourhood iteration), as a typical vv model step does.
+  The smoothing is also run on all processors through
+  util::ForAll::parallel.
+
+  usage: stellar [levels]
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <chrono>
+
+#include <algebra/abstractvertex.hpp>
+#include <algebra/abstractmesh.hpp>
+#include <algebra/compactvertex.hpp>
+#include <algebra/compactmesh.hpp>
+#include <util/parallel_forall.hpp>
+
+struct Position {
+  double p[3];
+};
+
+struct Edge {};
+
+typedef algebra::AbstractVertex<Position, Edge> AVertex;
+typedef algebra::AbstractMesh<AVertex>          AMesh;
+typedef algebra::CompactVertex<Position, Edge>  CVertex;
+typedef algebra::CompactMesh<CVertex>           CMesh;
+
+static double Now() {
+  return std::chrono::duration<double>(
+	   std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void Normalize(double* p) {
+  double l = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+  for (int i = 0; i < 3; ++i)
+    p[i] /= l;
+}
+
+/* Builds the octahedron, neighbourhoods counter-clockwise from outside. */
+template <class V, class M>
+void Octahedron(M& mesh) {
+  typedef typename V::VPtr VPtr;
+  static const int nb[6][4] = {
+    {2, 4, 3, 5}, {2, 5, 3, 4}, {0, 5, 1, 4},
+    {0, 4, 1, 5}, {0, 2, 1, 3}, {0, 3, 1, 2}
+  };
+  VPtr v[6];
+
+  for (int i = 0; i < 6; ++i) {
+    v[i] = mesh.createVertex();
+    for (int c = 0; c < 3; ++c)
+      v[i]->getPosition().p[c] = (c == i / 2) ? (i % 2 ? -1 : 1) : 0;
+  }
+
+  for (int i = 0; i < 6; ++i) {
+    typename V::Neighbourhood n;
+    for (int j = 0; j < 4; ++j)
+      n.push_back(std::make_pair(v[nb[i][j]], Edge()));
+    v[i]->nbAssign(n);
+  }
+}
+
+/* Splits each edge (p,q) with x and connects x to the new vertices of
+   the two triangles next to the edge. */
+template <class V, class M>
+void Subdivide(M& mesh) {
+  typedef typename V::VPtr VPtr;
+  std::vector<VPtr> edges;
+
+  for (mesh.loopStart(); mesh.loopNotDone(); mesh.loopNext()) {
+    VPtr p = mesh.getCurrent();
+    for (p.loopStart(); p.loopNotDone(); p.loopNext()) {
+      VPtr q = p.getCurrent();
+      if (p < q) {
+	edges.push_back(p);
+	edges.push_back(q);
+      }
+    }
+  }
+
+  std::vector<VPtr> added;
+  for (size_t i = 0; i < edges.size(); i += 2) {
+    VPtr& p = edges[i];
+    VPtr& q = edges[i + 1];
+    VPtr x = mesh.createVertex();
+
+    for (int c = 0; c < 3; ++c)
+      x->getPosition().p[c] = p->getPosition().p[c] + q->getPosition().p[c];
+    Normalize(x->getPosition().p);
+
+    p->replace(q, x);
+    q->replace(p, x);
+    added.push_back(x);
+  }
+
+  for (size_t i = 0; i < added.size(); ++i) {
+    VPtr& x = added[i];
+    VPtr& p = edges[2 * i];
+    VPtr& q = edges[2 * i + 1];
+    typename V::Neighbourhood n;
+
+    n.push_back(std::make_pair(p, Edge()));
+    n.push_back(std::make_pair(p->prev(x), Edge()));
+    n.push_back(std::make_pair(q->next(x), Edge()));
+    n.push_back(std::make_pair(q, Edge()));
+    n.push_back(std::make_pair(q->prev(x), Edge()));
+    n.push_back(std::make_pair(p->next(x), Edge()));
+    x->nbAssign(n);
+  }
+}
+
+/* Moves each vertex towards the average of its old neighbours. */
+template <class V, class M>
+void Smooth(M& mesh) {
+  typedef typename V::VPtr VPtr;
+
+  mesh.synchronise();
+  for (mesh.loopStart(); mesh.loopNotDone(); mesh.loopNext()) {
+    VPtr v = mesh.getCurrent();
+    double s[3] = {0, 0, 0};
+    int n = 0;
+
+    VPtr o = v->getOld();
+    for (o->getOld().loopStart(); o->getOld().loopNotDone(); o.loopNext()) {
+      VPtr u = o.getCurrent();
+      for (int c = 0; c < 3; ++c)
+	s[c] += u->getOld()->getPosition().p[c];
+      ++n;
+    }
+
+    for (int c = 0; c < 3; ++c)
+      v->getPosition().p[c] = 0.5 * v->getPosition().p[c] + 0.5 * s[c] / n;
+    Normalize(v->getPosition().p);
+  }
+}
+
+/* The same smoothing step, reading the neighbours from a snapshot. */
+struct SmoothVertex {
+  template <class S>
+  void operator()(const S& s, unsigned int i, Position& pos) const {
+    double sum[3] = {0, 0, 0};
+    unsigned int n = s.neighbourCount(i);
+
+    for (unsigned int k = 0; k < n; ++k)
+      for (int c = 0; c < 3; ++c)
+	sum[c] += s.position(s.neighbour(i, k)).p[c];
+
+    for (int c = 0; c < 3; ++c)
+      pos.p[c] = 0.5 * pos.p[c] + 0.5 * sum[c] / int(n);
+    Normalize(pos.p);
+  }
+};
+
+/* Counts the neighbours, checks that the neighbourhoods are symmetric
+   and consistently oriented, and sums the coordinates rounded to 1e-9
+   so that the sum does not depend on the order of the vertices. */
+template <class V, class M>
+bool Check(M& mesh, unsigned int& relations, long long& sum) {
+  typedef typename V::VPtr VPtr;
+  bool ok = true;
+
+  relations = 0;
+  sum = 0;
+  for (mesh.loopStart(); mesh.loopNotDone(); mesh.loopNext()) {
+    VPtr p = mesh.getCurrent();
+    for (int c = 0; c < 3; ++c)
+      sum += std::llround(std::fabs(p->getPosition().p[c]) * 1e9) * (c + 1);
+    for (p.loopStart(); p.loopNotDone(); p.loopNext()) {
+      VPtr q = p.getCurrent();
+      ++relations;
+      if (!q->in(p) || p->next(q) != q->prev(p))
+	ok = false;
+    }
+  }
+  return ok;
+}
+
+template <class V, class M>
+void Run(const char* name, int levels, bool parallel) {
+  M mesh;
+  double t0 = Now();
+  Octahedron<V>(mesh);
+
+  double subdivide = 0, smooth = 0;
+  for (int l = 0; l < levels; ++l) {
+    double t1 = Now();
+    Subdivide<V>(mesh);
+    double t2 = Now();
+    if (parallel)
+      util::ForAll::parallel<V>(mesh, SmoothVertex());
+    else
+      Smooth<V>(mesh);
+    double t3 = Now();
+    subdivide += t2 - t1;
+    smooth += t3 - t2;
+  }
+  double total = Now() - t0;
+
+  unsigned int relations;
+  long long sum;
+  bool ok = Check<V>(mesh, relations, sum);
+
+  printf("%-17s %8u vertices %9u relations %s  subdivide %7.3fs  smooth %7.3fs  total %7.3fs  (sum %lld)\n",
+	 name, mesh.vertexCount(), relations, ok ? "ok " : "BAD",
+	 subdivide, smooth, total, sum);
+}
+
+int main(int argc, char** argv) {
+  int levels = argc > 1 ? atoi(argv[1]) : 8;
+
+  Run<CVertex, CMesh>("compact", levels, false);
+  Run<CVertex, CMesh>("compact/parallel", levels, true);
+  Run<AVertex, AMesh>("abstract", levels, false);
+  Run<AVertex, AMesh>("abstract/parallel", levels, true);
+  return 0;
+}
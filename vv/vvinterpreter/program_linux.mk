@@ -16,5 +16,6 @@ LIBS = -L'$(VVLIBDIR)' -lvv
 %.o: %.cpp
 	$(CXX) $(CXXFLAGS) $(INCDIRS) -c -o $@ $< 
 
+# VVP2CPPFLAGS=-compact stores the vertices in the compact form
 %.cpp: %.vvp
-	vvp2cpp $< $@
+	vvp2cpp $(VVP2CPPFLAGS) $< $@
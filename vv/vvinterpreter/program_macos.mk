@@ -20,6 +20,7 @@ LIBS = -L'$(VVLIBDIR)' -lvv $(LIBS_MacOS)
 %.o: %.cpp
 	$(CXX) $(CXXFLAGS) $(INCDIRS) -c -o $@ $< 
 
+# VVP2CPPFLAGS=-compact stores the vertices in the compact form
 %.cpp: %.vvp
-	vvp2cpp $< $@
+	vvp2cpp $(VVP2CPPFLAGS) $< $@
 
@@ -0,0 +1,264 @@
+#ifndef __ALGEBRA__COMPACTMESH_HPP__
+#define __ALGEBRA__COMPACTMESH_HPP__
+
+#include <vector>
+
+namespace algebra {
+  template <class V>
+
+  /** @brief Vertex set for CompactVertex.
+
+      This class has the interface of AbstractMesh, but keeps the
+      vertices in an array and finds them through their handles
+      instead of in a std::set.  Vertices are iterated in the order
+      they were added.  A removed vertex leaves an empty slot, which
+      is skipped by the iteration and dropped when the slots are
+      compacted outside of an iteration.
+  */
+  class CompactMesh {
+  public:
+    typedef typename V::VPtr VPtr;
+
+    /** @brief A base class for functions.
+
+        Functions inherited from VFunc can be applied to each vertex
+        in a particular set.
+    */
+    class VFunc {
+    public:
+      virtual ~VFunc() {}
+      virtual void operator()(VPtr v) = 0;
+    };
+
+    CompactMesh();
+    virtual ~CompactMesh();
+
+    VPtr createVertex();
+    void addVertex(const VPtr& v);
+    void removeVertex(const VPtr& v);
+    void clear();
+    void merge(CompactMesh& m);
+
+    void forEachVertex(VFunc& f);
+
+    unsigned int vertexCount() ;
+    bool         in(const VPtr& v);
+
+    VPtr select();
+
+    void synchronise();
+
+    void loopStart();
+    bool loopNotDone();
+    void loopNext();
+    VPtr getCurrent();
+
+    virtual CompactMesh<V>& operator=(const CompactMesh<V>& m);
+
+  private:
+    void compact();
+
+    std::vector<VPtr>         vertices;
+    std::vector<unsigned int> slot;     // position + 1 in vertices for each handle, 0 if absent
+    unsigned int              count;
+    unsigned int              current;
+    bool                      looping;
+  };
+}
+
+/** @brief Constructor */
+template <class V> algebra::CompactMesh<V>::CompactMesh() :
+  count(0),
+  current(0),
+  looping(false)
+{}
+
+/** @brief Destructor */
+template <class V> algebra::CompactMesh<V>::~CompactMesh() {}
+
+/** @brief Allocate a new vertex and add it to the set. */
+template <class V>
+typename algebra::CompactMesh<V>::VPtr algebra::CompactMesh<V>::createVertex() {
+  V* vp = new V();
+  VPtr v = vp->vptr();
+
+  addVertex(v);
+  return v;
+}
+
+/** @brief Add a vertex to the set.
+    @param v The vertex to be inserted.
+
+    If v points to null or already exists in the set, then nothing
+    happens.
+*/
+template <class V>
+void algebra::CompactMesh<V>::addVertex(const VPtr& v) {
+  if (!v) return;
+  unsigned int h = v->getHandle();
+  if (h >= slot.size())
+    slot.resize(h + 1 > 2 * slot.size() ? h + 1 : 2 * slot.size(), 0);
+  if (slot[h]) return;
+
+  vertices.push_back(v);
+  slot[h] = (unsigned int)(vertices.size());
+  ++count;
+}
+
+/** @brief Remove a specified vertex from the set.
+    @param v The vertex to be removed.
+
+    If v does not exist in the set, nothing happens.
+*/
+template <class V>
+void algebra::CompactMesh<V>::removeVertex(const VPtr& v) {
+  if (!in(v)) return;
+  unsigned int h = v->getHandle();
+  unsigned int i = slot[h] - 1;
+  slot[h] = 0;
+  --count;
+  // the mesh may hold the last reference, which is released when
+  // removed goes out of scope, as erasing it from AbstractMesh does
+  VPtr removed = vertices[i];
+  vertices[i] = VPtr();
+
+  if (!looping && 2 * count < vertices.size())
+    compact();
+}
+
+/** @brief Remove all vertices from the set. */
+template <class V>
+void algebra::CompactMesh<V>::clear() {
+  for (unsigned int i = 0; i < vertices.size(); ++i)
+    if (vertices[i])
+      slot[vertices[i]->getHandle()] = 0;
+  vertices.clear();
+  count = 0;
+  current = 0;
+}
+
+/** @brief Add all the vertices from another set into this one.
+    @param m The supplied set.
+
+    After this function, all the vertices in m and the current set
+    exist exactly once in the current set.  No changer are made to m.
+*/
+template <class V>
+void algebra::CompactMesh<V>::merge(algebra::CompactMesh<V>& m) {
+  for (unsigned int i = 0; i < m.vertices.size(); ++i)
+    addVertex(m.vertices[i]);
+}
+
+/** @brief Execute the f on each vertex in the mesh.
+    @param f A function object inherited from VFunc.
+*/
+template <class V>
+void algebra::CompactMesh<V>::forEachVertex(VFunc& f) {
+  for (unsigned int i = 0; i < vertices.size(); ++i)
+    if (vertices[i])
+      f(vertices[i]);
+}
+
+/** @brief Return the number of vertices in the set. */
+template <class V>
+unsigned int algebra::CompactMesh<V>::vertexCount()  {
+  return count;
+}
+
+/** @brief Check if a vertex is contained in the set. */
+template <class V>
+bool algebra::CompactMesh<V>::in(const VPtr& v) {
+  if (!v) return false;
+  unsigned int h = v->getHandle();
+  return (h < slot.size() && slot[h] != 0);
+}
+
+template <class V>
+typename V::VPtr algebra::CompactMesh<V>::select() {
+  for (unsigned int i = 0; i < vertices.size(); ++i)
+    if (vertices[i])
+      return vertices[i];
+  return typename V::VPtr();
+}
+
+/** @brief Record the current state of each vertex in the set. */
+template <class V>
+void algebra::CompactMesh<V>::synchronise() {
+  for (unsigned int i = 0; i < vertices.size(); ++i)
+    if (vertices[i])
+      vertices[i]->synchronise();
+}
+
+/** @brief Start the iteration.
+
+    This function exists for providing iteration in the generated code.
+*/
+template <class V>
+void algebra::CompactMesh<V>::loopStart() {
+  if (count < vertices.size())
+    compact();
+  current = 0;
+  looping = true;
+}
+
+/** @brief Get the current vertex in the iteration.
+
+    This function exists for providing iteration in the generated code.
+*/
+template <class V>
+typename algebra::CompactMesh<V>::VPtr algebra::CompactMesh<V>::getCurrent() {
+  return vertices[current];
+}
+
+/** @brief Check if there is more vertices to iterate over.
+
+    This function exists for providing iteration in the generated code.
+*/
+template <class V>
+bool algebra::CompactMesh<V>::loopNotDone() {
+  while (current < vertices.size() && !vertices[current])
+    ++current;
+  bool done = (current == vertices.size());
+  if (done) looping = false;
+  return !done;
+}
+
+/** @brief Advance the iteration.
+
+    This function exists for providing iteration in the generated code.
+*/
+template <class V>
+void algebra::CompactMesh<V>::loopNext() {
+  ++current;
+}
+
+/** @brief Copy a vertex set.
+    @param m The supplied vertex.
+
+    This function copies the contents of the vertex set of m to the
+    current one.  The current set is overwritten.
+*/
+template <class V>
+algebra::CompactMesh<V>& algebra::CompactMesh<V>::operator=(const algebra::CompactMesh<V>& m) {
+  if (this == &m) return *this;
+  clear();
+  for (unsigned int i = 0; i < m.vertices.size(); ++i)
+    addVertex(m.vertices[i]);
+  return *this;
+}
+
+/** @brief Drop the empty slots left by removed vertices. */
+template <class V>
+void algebra::CompactMesh<V>::compact() {
+  unsigned int n = 0;
+  for (unsigned int i = 0; i < vertices.size(); ++i)
+    if (vertices[i]) {
+      if (n != i)
+	vertices[n] = vertices[i];
+      slot[vertices[n]->getHandle()] = n + 1;
+      ++n;
+    }
+  vertices.resize(n);
+}
+
+#endif
@@ -0,0 +1,1115 @@
+#ifndef __ALGEBRA__COMPACTVERTEX_HPP__
+#define __ALGEBRA__COMPACTVERTEX_HPP__
+
+#include <iostream>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+namespace algebra
+{
+  /** @brief Abstract vertex with compact storage.
+    @param A type that encapsulates the properties of the vertex that
+    are not relevant to the vv-algebra.
+
+    This class provides the same algebra and smart pointer semantics
+    as AbstractVertex, but is laid out for large meshes.  Vertices of
+    the same size are allocated in blocks of consecutive slots, each
+    vertex has a small integer handle that stays the same for its
+    whole life, and a neighbourhood is a cyclic array of handles that
+    is kept inside the vertex when it has at most NB_INLINE members.
+    References to edges returned by getEdge() are only valid until
+    the neighbourhood is changed.  Removing the current neighbour
+    while iterating over the neighbourhood continues the iteration
+    with the neighbour that followed it.
+    */
+  template <class PosVertex, class Edge>
+   class CompactVertex
+     {
+   public:
+    typedef PosVertex    position_type;
+    typedef Edge         edge_type;
+    typedef unsigned int handle_type;
+
+    /** @brief Neighbourhood members stored inside the vertex. */
+    static const unsigned int NB_INLINE = 6;
+    /** @brief Vertices allocated at once for each vertex size. */
+    static const unsigned int VERTICES_PER_BLOCK = 1024;
+
+    /** @brief A memory management container.
+
+      The VOwner keeps the table that maps handles to vertices and
+      the blocks the vertices are allocated from.  As with
+      AbstractVertex, all remaining vertices are destroyed when it
+      is destroyed.
+      */
+    class VOwner
+      {
+      struct Pool
+        {
+        std::size_t        size;
+        void*              free_slot;
+        std::vector<char*> blocks;
+        char*              next;
+        char*              end;
+        };
+
+      std::vector<CompactVertex<PosVertex, Edge>*> table;
+      std::vector<handle_type>                     free_handles;
+      std::vector<Pool>                            pools;
+      bool isActive;
+    public:
+      /** @brief Constructor */
+      VOwner() : isActive(true) {}
+
+      /** @brief Destructor. */
+      ~VOwner()
+        {
+        clear();
+        for (typename std::vector<Pool>::iterator i = pools.begin(); i != pools.end(); ++i)
+          for (std::size_t j = 0; j < i->blocks.size(); ++j)
+            ::operator delete(i->blocks[j]);
+        }
+
+      /** @brief Add a vertex and return its handle. */
+      handle_type add(CompactVertex<PosVertex, Edge>* v)
+        {
+        if (free_handles.empty())
+          {
+          table.push_back(v);
+          return handle_type(table.size() - 1);
+          }
+        handle_type h = free_handles.back();
+        free_handles.pop_back();
+        table[h] = v;
+        return h;
+        }
+
+      /** @brief Remove a vertex, its handle can be reused. */
+      void remove(handle_type h)
+        {
+        table[h] = 0;
+        free_handles.push_back(h);
+        }
+
+      /** @brief Return the vertex with a given handle. */
+      CompactVertex<PosVertex, Edge>* vertex(handle_type h) const
+        {
+        return table[h];
+        }
+
+      /** @brief Return one more than the largest handle in use so far. */
+      handle_type handleCount() const
+        {
+        return handle_type(table.size());
+        }
+
+      /** @brief Destroy all vertices. */
+      void clear()
+        {
+        isActive = false;
+        for (std::size_t h = 0; h < table.size(); ++h)
+          {
+          if (table[h])
+            delete table[h];
+          }
+        }
+
+      /** @brief Check if the memory pool is active. */
+      bool active() {return isActive;}
+
+      /** @brief Allocate memory for a vertex of a given size. */
+      void* allocate(std::size_t size)
+        {
+        size = (size + 15) & ~std::size_t(15);
+
+        Pool* pool = 0;
+        for (std::size_t i = 0; i < pools.size(); ++i)
+          if (pools[i].size == size)
+            pool = &pools[i];
+        if (!pool)
+          {
+          Pool p;
+          p.size = size;
+          p.free_slot = 0;
+          p.next = p.end = 0;
+          pools.push_back(p);
+          pool = &pools.back();
+          }
+
+        if (pool->free_slot)
+          {
+          void* slot = pool->free_slot;
+          pool->free_slot = *reinterpret_cast<void**>(slot);
+          return slot;
+          }
+
+        if (pool->next == pool->end)
+          {
+          pool->next = static_cast<char*>(::operator new(size * VERTICES_PER_BLOCK));
+          pool->end = pool->next + size * VERTICES_PER_BLOCK;
+          pool->blocks.push_back(pool->next);
+          }
+        void* slot = pool->next;
+        pool->next += size;
+        return slot;
+        }
+
+      /** @brief Return the memory of a vertex to its block. */
+      void deallocate(void* p, std::size_t size)
+        {
+        size = (size + 15) & ~std::size_t(15);
+        for (std::size_t i = 0; i < pools.size(); ++i)
+          if (pools[i].size == size)
+            {
+            *reinterpret_cast<void**>(p) = pools[i].free_slot;
+            pools[i].free_slot = p;
+            return;
+            }
+        }
+      };
+    static VOwner vowner;
+
+   public:
+
+    /** @brief A smart pointer for compact vertices.
+
+      The following smart pointer uses reference counting to destroy
+      vertices as soon as they are no longer referenced.
+      */
+    class VPtr
+      {
+      mutable CompactVertex<PosVertex, Edge>* ptr;
+
+    public:
+      /** @brief Default constructor */
+      VPtr() : ptr(0) {}
+
+      /** @brief Copy constructor from raw pointer. */
+      VPtr(CompactVertex<PosVertex, Edge>* p) : ptr(p)
+        {
+        if (ptr) ++(ptr->refcount);
+        }
+
+      /** @brief Copy constructor from another smart pointer. */
+      VPtr(const VPtr& p) : ptr(p.ptr)
+        {
+        if (ptr) ++(ptr->refcount);
+        }
+
+      /** @brief Destructor */
+      ~VPtr()
+        {
+        if (ptr) release(ptr);
+        }
+
+      void loopStart();
+      bool loopNotDone();
+      void loopNext();
+      VPtr getCurrent();
+
+      /** @brief Pointer dereference */
+      inline CompactVertex<PosVertex, Edge>& operator*() const
+        {
+        return *ptr;
+        }
+
+      /** @brief Member dereference */
+      inline CompactVertex<PosVertex, Edge>* operator->() const
+        {
+        if (!ptr)
+          {
+          std::cerr << "Fatal Error: Dereference of null pointer attempted." << std::endl;
+          throw 0;
+          }
+        return ptr;
+        }
+
+      /** @brief Return a raw pointer */
+      inline CompactVertex<PosVertex, Edge>* raw() const
+        {
+        return ptr;
+        }
+
+      /** @brief Conversion to bool to check if the pointer is not null. */
+      inline operator bool()
+        {
+        return (ptr != 0);
+        }
+
+      /** @brief Check if the pointer is null. */
+      inline bool operator!() const
+        {
+        return (ptr == 0);
+        }
+
+      /** @brief Check if two smart pointers refer to the same vertex. */
+      inline bool operator==(const VPtr& v) const
+        {
+        check(v);
+        return (ptr == v.ptr);
+        }
+
+      /** @brief Check if two smart pointers do not refer to the same vertex. */
+      inline bool operator!=(const VPtr& v) const
+        {
+        check(v);
+        return (ptr != v.ptr);
+        }
+
+      /** @brief Compare the order of two vertices */
+      inline bool operator< (const VPtr& v) const
+        {
+        check(v);
+        return (ptr < v.ptr);
+        }
+
+      /** @brief Compare the order of two vertices */
+      inline bool operator> (const VPtr& v) const
+        {
+        check(v);
+        return (ptr > v.ptr);
+        }
+
+      /** @brief Compare the order of two vertices */
+      inline bool operator<= (const VPtr& v) const
+        {
+        check(v);
+        return (ptr <= v.ptr);
+        }
+
+      /** @brief Compare the order of two vertices */
+      inline bool operator>= (const VPtr& v) const
+        {
+        check(v);
+        return (ptr >= v.ptr);
+        }
+
+      /** @brief Assign a vertex from one smart pointer to another.
+
+        As with AbstractVertex, the previous vertex is not destroyed
+        when this was its last reference, it is kept by the VOwner.
+        */
+      VPtr& operator= (const VPtr& v)
+        {
+        if (ptr) --(ptr->refcount);
+        ptr = v.ptr;
+        if (ptr) ++(ptr->refcount);
+        return *this;
+        }
+
+      /** @brief Assymmetric edge access */
+      Edge& operator^(VPtr& v)
+        {
+        ptr->synchEdges();
+        return ptr->getEdge(v);
+        }
+
+      /** @brief Symmetric edge access */
+      Edge& operator|(VPtr& v)
+        {
+        ptr->synchEdges();
+        v->addSynchEdge(*this);
+        return ptr->getEdge(v);
+        }
+
+    private:
+      inline void check(const VPtr& v) const
+        {
+        if (!ptr || !v)
+          {
+          std::cerr << "Fatal Error: Dereference of null pointer attempted." << std::endl;
+          throw 0;
+          }
+        }
+      };
+
+    friend class VPtr;
+
+    /** @brief Neighbourhood function.
+
+      A base class to iterate a function over a vertex neighbourhood.
+      */
+    class NFunc
+      {
+    public:
+     NFunc() {}
+     virtual ~NFunc() {}
+     virtual void operator()(VPtr v, VPtr neighbour) = 0;
+      };
+
+    /** @brief Neighbourhood passed to nbAssign(). */
+    typedef typename std::vector<std::pair<VPtr, Edge> > Neighbourhood;
+
+    // Construction and Deruction
+    CompactVertex();
+    virtual ~CompactVertex();
+
+    /** @brief Vertices are allocated from the blocks of the VOwner. */
+    static void* operator new(std::size_t size)
+      {
+      return vowner.allocate(size);
+      }
+
+    /** @brief Return the memory of a vertex to the VOwner. */
+    static void operator delete(void* p, std::size_t size)
+      {
+      vowner.deallocate(p, size);
+      }
+
+    // Positional operations
+    PosVertex&   getPosition();
+
+    // Edge operations
+    Edge& getEdge(const VPtr& v);
+    bool  isNullEdge(const VPtr& v);
+    void  addSynchEdge(VPtr& v);
+    void  synchEdges();
+
+    // Vertex Queries
+    unsigned int getLabel();
+    handle_type  getHandle() const {return handle;}
+    bool         operator==(const CompactVertex& v) const;
+    bool         operator< (const CompactVertex& v) const;
+    VPtr         vptr();
+
+    // Neighbourhood Queries;
+    unsigned int getNeighbourCount();
+    bool         in(VPtr& v);
+    VPtr         next(VPtr& v);
+    VPtr         next_flagged();
+    VPtr         prev(VPtr& v);
+    VPtr         prev_flagged();
+    VPtr         next(VPtr& v, unsigned int k);
+    VPtr         next_flagged(unsigned int k);
+    VPtr         prev(VPtr& v, unsigned int k);
+    VPtr         prev_flagged(unsigned int k);
+    VPtr         select();
+    VPtr         flagged();
+
+    // Neighbourhood Operations
+    void remove(VPtr& target);
+    void remove_flagged();
+    void replace(VPtr& target, VPtr& v);
+    void replace_flagged(VPtr& v);
+    void spliceNext(VPtr& target, VPtr& v);
+    void spliceNext_flagged(VPtr& v);
+    void splicePrev(VPtr& target, VPtr& v);
+    void splicePrev_flagged(VPtr& v);
+    void flag(VPtr& target);
+
+    void forEachNeighbour(NFunc& f);
+    void recurseForEachNeighbour(NFunc& f);
+
+    /** @brief Reset the label counter.
+
+      This function is only used internally by the library.  It
+      should not be generaly used.
+      */
+    static void resetLabels()
+      {
+      nextlabel = 0;
+      }
+
+    /** @brief Reassign a vertex label.
+
+      This function is only used internally by the library.  It
+      should not be generaly used.
+      */
+    void relabel(unsigned int l) {label = l;}
+
+    // state synch
+    void synchronise();
+    VPtr getOld();
+    void restore();
+
+    // neighbourhood building
+    void nbClear();
+    void nbAssign(Neighbourhood& nba);
+
+    // cloning
+    VPtr clone();
+
+   private:
+    /** @brief A neighbour and the edge to it. */
+    struct NbEntry
+      {
+      handle_type v;
+      Edge        e;
+      };
+
+    /** @brief Cyclic neighbourhood of handles.
+
+      Each entry holds a reference to its vertex, just as the smart
+      pointers in the neighbourhood of AbstractVertex do.
+      */
+    class NbList
+      {
+    public:
+      NbList() : count(0), capacity(NB_INLINE), data(buffer) {}
+      NbList(const NbList& l) : count(0), capacity(NB_INLINE), data(buffer)
+        {
+        *this = l;
+        }
+      ~NbList()
+        {
+        clear();
+        if (data != buffer) delete[] data;
+        }
+
+      NbList& operator=(const NbList& l)
+        {
+        if (this == &l) return *this;
+        for (unsigned int i = 0; i < l.count; ++i)
+          acquire(l.data[i].v);
+        clear();
+        reserve(l.count);
+        for (unsigned int i = 0; i < l.count; ++i)
+          data[i] = l.data[i];
+        count = l.count;
+        return *this;
+        }
+
+      unsigned int size() const {return count;}
+      NbEntry& operator[](unsigned int i) {return data[i];}
+      const NbEntry& operator[](unsigned int i) const {return data[i];}
+
+      /** @brief Index of a vertex, or -1 if it is not a neighbour. */
+      int find(handle_type h) const
+        {
+        for (unsigned int i = 0; i < count; ++i)
+          if (data[i].v == h)
+            return int(i);
+        return -1;
+        }
+
+      void insert(unsigned int pos, handle_type h, const Edge& e)
+        {
+        acquire(h);
+        reserve(count + 1);
+        for (unsigned int i = count; i > pos; --i)
+          data[i] = data[i - 1];
+        data[pos].v = h;
+        data[pos].e = e;
+        ++count;
+        }
+
+      void erase(unsigned int pos)
+        {
+        handle_type h = data[pos].v;
+        for (unsigned int i = pos + 1; i < count; ++i)
+          data[i - 1] = data[i];
+        --count;
+        data[count].e = Edge();
+        release(vowner.vertex(h));
+        }
+
+      void setVertex(unsigned int pos, handle_type h)
+        {
+        acquire(h);
+        handle_type old = data[pos].v;
+        data[pos].v = h;
+        release(vowner.vertex(old));
+        }
+
+      void clear()
+        {
+        while (count)
+          {
+          --count;
+          data[count].e = Edge();
+          release(vowner.vertex(data[count].v));
+          }
+        }
+
+    private:
+      void reserve(unsigned int n)
+        {
+        if (n <= capacity) return;
+        unsigned int c = std::max(n, 2 * capacity);
+        NbEntry* d = new NbEntry[c];
+        for (unsigned int i = 0; i < count; ++i)
+          d[i] = data[i];
+        if (data != buffer) delete[] data;
+        data = d;
+        capacity = c;
+        }
+
+      unsigned int count;
+      unsigned int capacity;
+      NbEntry*     data;
+      NbEntry      buffer[NB_INLINE];
+      };
+
+    static void acquire(handle_type h)
+      {
+      ++(vowner.vertex(h)->refcount);
+      }
+
+    static void release(CompactVertex<PosVertex, Edge>* v)
+      {
+      if (vowner.active() && --(v->refcount) == 0)
+        delete v;
+      }
+
+    int  find(const NbList& l, const VPtr& v) const;
+    void insertAt(unsigned int pos, VPtr& v);
+
+    unsigned int        label;
+    static unsigned int nextlabel;
+    unsigned int        refcount;
+    handle_type         handle;
+
+    NbList              neighbours;
+    NbList              old_neighbours;
+    NbList*             nb;
+
+    PosVertex           position;
+    PosVertex           old_position;
+
+    int f_index;
+    int old_f_index;
+
+    bool old;
+
+    unsigned int current;
+    bool         looping_old;
+
+    Edge              nulledge;
+    std::vector<VPtr> esynch;
+     };
+}
+
+template <class PosVertex, class Edge>
+unsigned int algebra::CompactVertex<PosVertex, Edge>::nextlabel = 0;
+
+/** @brief Constructor. */
+template <class PosVertex, class Edge>
+algebra::CompactVertex<PosVertex, Edge>::CompactVertex() :
+label(nextlabel),
+ refcount(0),
+ neighbours(),
+ old_neighbours(),
+ position(),
+ old_position(),
+ f_index(-1),
+ old_f_index(-1),
+ old(false),
+ current(0),
+ looping_old(false)
+{
+  handle = vowner.add(this);
+  nextlabel++;
+  nb = &neighbours;
+}
+
+/** @brief Destructor. */
+template <class PosVertex, class Edge>
+algebra::CompactVertex<PosVertex, Edge>::~CompactVertex()
+{
+  vowner.remove(handle);
+}
+
+/** @brief Find a vertex in a neighbourhood.
+
+  Returns the index of the vertex or -1.  As comparing smart pointers,
+  it fails on a null vertex if the neighbourhood is not empty.
+  */
+template <class PosVertex, class Edge>
+int algebra::CompactVertex<PosVertex, Edge>::find(const NbList& l, const VPtr& v) const
+{
+  if (l.size() == 0)
+    return -1;
+  if (!v)
+    {
+    std::cerr << "Fatal Error: Dereference of null pointer attempted." << std::endl;
+    throw 0;
+    }
+  return l.find(v->handle);
+}
+
+/** @brief Insert a vertex into the current neighbourhood, keeping the
+  flagged and iterated neighbours. */
+template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::insertAt(unsigned int pos, VPtr& v)
+{
+  neighbours.insert(pos, v->handle, Edge());
+  if (f_index >= int(pos))
+    ++f_index;
+  if (!looping_old && current >= pos)
+    ++current;
+}
+
+/** @brief Return the vertex properties. */
+ template <class PosVertex, class Edge>
+PosVertex& algebra::CompactVertex<PosVertex, Edge>::getPosition()
+{
+  if (old)
+    {
+    restore();
+    return old_position;
+    }
+  else return position;
+}
+
+/** @brief Edge access. */
+ template <class PosVertex, class Edge>
+Edge& algebra::CompactVertex<PosVertex, Edge>::getEdge(const VPtr& v)
+{
+  int i = find(*nb, v);
+  Edge* ret = (i < 0) ? &nulledge : &((*nb)[i].e);
+  restore();
+  if (ret == &nulledge)
+    {
+    std::cerr << "Fatal error: Null edge was accessed." << std::endl;
+    throw 0;
+    }
+  return *ret;
+}
+
+/** @brief Test for a null edge. */
+ template <class PosVertex, class Edge>
+bool algebra::CompactVertex<PosVertex, Edge>::isNullEdge(const VPtr& v)
+{
+  int i = find(*nb, v);
+  restore();
+  return (i < 0);
+}
+
+/** @brief Add an edge to the synchronisation list */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::addSynchEdge(VPtr& v)
+{
+  if (std::find(esynch.begin(), esynch.end(), v) == esynch.end())
+    esynch.push_back(v);
+}
+
+/** @brief Synchronise the edges */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::synchEdges()
+{
+  for (std::size_t i = 0; i < esynch.size(); i++)
+    {
+    VPtr v = this->vptr();
+    if (esynch[i]->in(v))
+      getEdge(esynch[i]) = esynch[i]->getEdge(this->vptr());
+    }
+  esynch.clear();
+}
+
+/** @brief Get the vertex label. */
+ template <class PosVertex, class Edge>
+unsigned int algebra::CompactVertex<PosVertex, Edge>::getLabel()
+{
+  return label;
+}
+
+/** @brief Check for equality */
+template <class PosVertex, class Edge>
+bool algebra::CompactVertex<PosVertex, Edge>::operator==(const algebra::CompactVertex<PosVertex, Edge>& v) const
+{
+  return label == v.label;
+}
+
+/** @brief Compare vertex order. */
+template <class PosVertex, class Edge>
+bool algebra::CompactVertex<PosVertex, Edge>::operator<(const algebra::CompactVertex<PosVertex, Edge>& v) const
+{
+  return label < v.label;
+}
+
+/** @brief Get a smart pointer to the vertex. */
+ template <class PosVertex, class Edge>
+typename algebra::CompactVertex<PosVertex, Edge>::VPtr algebra::CompactVertex<PosVertex, Edge>::vptr()
+{
+  return VPtr(this);
+}
+
+/** @brief Get the number of vertices in the neighourhood. */
+ template <class PosVertex, class Edge>
+unsigned int algebra::CompactVertex<PosVertex, Edge>::getNeighbourCount()
+{
+  unsigned int i = nb->size();
+  restore();
+  return i;
+}
+
+/** @brief Check if a vertex exists in the neighbourhood.
+  @param v The vertex to search for.
+  */
+ template <class PosVertex, class Edge>
+bool algebra::CompactVertex<PosVertex, Edge>::in(VPtr& v)
+{
+  bool ret = (find(*nb, v) >= 0);
+  restore();
+  return ret;
+}
+
+/**
+ * @brief Get the vertex after the target in the neighbourhood.
+ * @param v The vertex to search for.
+ */
+ template <class PosVertex, class Edge>
+typename algebra::CompactVertex<PosVertex, Edge>::VPtr algebra::CompactVertex<PosVertex, Edge>::next(VPtr& v)
+{
+  return next(v, 1);
+}
+
+/** @brief return the next after the flagged vertex. */
+ template <class PosVertex, class Edge>
+typename algebra::CompactVertex<PosVertex, Edge>::VPtr algebra::CompactVertex<PosVertex, Edge>::next_flagged()
+{
+  return next_flagged(1);
+}
+
+/** @brief Get the vertex before the target in the neighbourhood.
+  @param v The target to search for.
+  */
+ template <class PosVertex, class Edge>
+typename algebra::CompactVertex<PosVertex, Edge>::VPtr algebra::CompactVertex<PosVertex, Edge>::prev(VPtr& v)
+{
+  return prev(v, 1);
+}
+
+/** @brief return the previous to the flagged vertex. */
+ template <class PosVertex, class Edge>
+typename algebra::CompactVertex<PosVertex, Edge>::VPtr algebra::CompactVertex<PosVertex, Edge>::prev_flagged()
+{
+  return prev_flagged(1);
+}
+
+/** @brief Get the k-th vertex after the target in the neighbourhood.
+  @param v The vertex to search for.
+  @param k Number of vertices to skip after v
+  */
+ template <class PosVertex, class Edge>
+typename algebra::CompactVertex<PosVertex, Edge>::VPtr algebra::CompactVertex<PosVertex, Edge>::next(VPtr& v, unsigned int k)
+{
+  VPtr ret;
+  int i = find(*nb, v);
+  if (i >= 0)
+    ret = vowner.vertex((*nb)[(i + k) % nb->size()].v);
+  restore();
+  return ret;
+}
+
+/** @brief return the kth vertex after the flagged vertex.
+  @param k Number of vertices to skip after the flagged
+  */
+ template <class PosVertex, class Edge>
+typename algebra::CompactVertex<PosVertex, Edge>::VPtr algebra::CompactVertex<PosVertex, Edge>::next_flagged(unsigned int k)
+{
+  VPtr ret;
+  if (f_index >= 0 && f_index < int(nb->size()))
+    ret = vowner.vertex((*nb)[(f_index + k) % nb->size()].v);
+  restore();
+  return ret;
+}
+
+/** @brief Get the k-th vertex before the target in the neighbourhood.
+  @param v The vertex to search for.
+  @param k Number of vertices to skip after v
+  */
+ template <class PosVertex, class Edge>
+typename algebra::CompactVertex<PosVertex, Edge>::VPtr algebra::CompactVertex<PosVertex, Edge>::prev(VPtr& v, unsigned int k)
+{
+  VPtr ret;
+  int i = find(*nb, v);
+  if (i >= 0)
+    {
+    unsigned int n = nb->size();
+    ret = vowner.vertex((*nb)[(i + n - k % n) % n].v);
+    }
+  restore();
+  return ret;
+}
+
+/** @brief return the kth vertex after the flagged vertex.
+  @param k Number of vertices to skip after the flagged
+  */
+ template <class PosVertex, class Edge>
+typename algebra::CompactVertex<PosVertex, Edge>::VPtr algebra::CompactVertex<PosVertex, Edge>::prev_flagged(unsigned int k)
+{
+  VPtr ret;
+  if (f_index >= 0 && f_index < int(nb->size()))
+    {
+    unsigned int n = nb->size();
+    ret = vowner.vertex((*nb)[(f_index + n - k % n) % n].v);
+    }
+  restore();
+  return ret;
+}
+
+/** @brief Returns a vertex from the neighbourhood.
+*/
+ template <class PosVertex, class Edge>
+typename algebra::CompactVertex<PosVertex, Edge>::VPtr algebra::CompactVertex<PosVertex, Edge>::select()
+{
+  VPtr ret;
+  if (nb->size())
+    ret = vowner.vertex((*nb)[0].v);
+  restore();
+  return ret;
+}
+
+/** @brief Returns the flagged vertex. */
+ template <class PosVertex, class Edge>
+typename algebra::CompactVertex<PosVertex, Edge>::VPtr algebra::CompactVertex<PosVertex, Edge>::flagged()
+{
+  if (f_index >= 0 && f_index < int(nb->size()))
+    return vowner.vertex((*nb)[f_index].v);
+  else
+    return VPtr();
+}
+
+/** @brief Removes a vertex from the neighbourhood.
+  @param target The vertex to be removed.
+  */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::remove(VPtr& target)
+{
+  restore();
+  synchEdges();
+  int i = find(neighbours, target);
+  if (i < 0)
+    return;
+
+  if (i == f_index)
+    f_index = -1;
+  else if (i < f_index)
+    --f_index;
+  if (!looping_old && unsigned(i) <= current)
+    --current;
+  neighbours.erase(i);
+}
+
+/** @brief Remove the flagged vertex. */
+ template  <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::remove_flagged()
+{
+  restore();
+  synchEdges();
+  if (f_index < 0) return;
+  VPtr target = vowner.vertex(neighbours[f_index].v);
+  remove(target);
+  f_index = -1;
+}
+
+/** @brief Replace a vertex in the neighbourhood.
+  @param target The vertex to be replaced.
+  @param v The new vertex that replace the target.
+  */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::replace(VPtr& target, VPtr& v)
+{
+  restore();
+  synchEdges();
+  int i = find(neighbours, target);
+  if (i >= 0)
+    neighbours.setVertex(i, v->handle);
+}
+
+/** @brief replaced the flagged vertex with v.
+  @param v The new vertex that replace the target.
+  */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::replace_flagged(VPtr& v)
+{
+  restore();
+  synchEdges();
+  if (f_index >= 0)
+    neighbours.setVertex(f_index, v->handle);
+}
+
+/** @brief Insert a vertex after another in the neighbourhood.
+  @param target The vertex before the place where the new vertex is inserted.
+  @param v The vertex to be inserted.
+  */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::spliceNext(VPtr& target, VPtr& v)
+{
+  restore();
+  int i = find(neighbours, target);
+  insertAt(i >= 0 ? i + 1 : neighbours.size(), v);
+}
+
+/** @brief Insert a vertex after the flagged vertex
+  @param v The vertex to be inserted.
+  */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::spliceNext_flagged(VPtr& v)
+{
+  restore();
+  if (f_index >= 0)
+    insertAt(f_index + 1, v);
+}
+
+/** @brief Insert a vertex before another in the neighbourhood.
+  @param target The vertex after the place where the new vertex is inserted.
+  @param v The vertex to be inserted.
+  */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::splicePrev(VPtr& target, VPtr& v)
+{
+  restore();
+  int i = find(neighbours, target);
+  insertAt(i >= 0 ? i : neighbours.size(), v);
+}
+
+/** @brief Insert a vertex after the flagged vertex
+  @param v The vertex to be inserted.
+  */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::splicePrev_flagged(VPtr& v)
+{
+  restore();
+  if (f_index >= 0)
+    insertAt(f_index, v);
+}
+
+/** @brief Sets the flagged vertex.
+  @param target The vertex to flag.
+
+  If target does not exist in the neighbourhood or targe is null, then
+  the function has no effect.
+  */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::flag(VPtr& target)
+{
+  restore();
+  int i = find(neighbours, target);
+  if (i >= 0)
+    f_index = i;
+}
+
+/** @brief Application of a function to each vertex in the neighbourhood.
+  @param f A function inherited from NFunc.
+  */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::forEachNeighbour(NFunc& f)
+{
+  for (unsigned int i = 0; i < neighbours.size(); ++i)
+    f(vptr(), VPtr(vowner.vertex(neighbours[i].v)));
+}
+
+/** @brief Recursive application of a function to each vertex in the neighbourhood.
+  @param f A function inherited from NFunc.
+  */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::recurseForEachNeighbour(NFunc& f)
+{
+  for (unsigned int i = 0; i < nb->size(); ++i)
+    vowner.vertex((*nb)[i].v)->forEachNeighbour(f);
+}
+
+/**
+ * @brief Record the state of the vertex.
+ */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::synchronise()
+{
+  restore();
+  old_neighbours = neighbours;
+  old_position = position;
+  old_f_index = f_index;
+}
+
+/** @brief Restore the current state of the vertex. */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::restore()
+{
+  if (old)
+    {
+    nb = &neighbours;
+    std::swap(position, old_position);
+    std::swap(f_index, old_f_index);
+
+    old = false;
+    }
+}
+
+/** @brief Activate the old version of the vertex state. */
+ template <class PosVertex, class Edge>
+typename algebra::CompactVertex<PosVertex, Edge>::VPtr algebra::CompactVertex<PosVertex, Edge>::getOld()
+{
+  if (!old)
+    {
+    nb = &old_neighbours;
+    std::swap(position, old_position);
+    std::swap(f_index, old_f_index);
+
+    old = true;
+    }
+  return vptr();
+}
+
+/** @brief Remove all vertices from the neighbourhood. */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::nbClear()
+{
+  restore();
+  old_neighbours.clear();
+  neighbours.clear();
+  f_index = old_f_index = -1;
+}
+
+/** @brief Assign a new neighbourhood to the vertex. */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::nbAssign(Neighbourhood& nba)
+{
+  restore();
+  NbList l;
+  for (typename Neighbourhood::iterator i = nba.begin(); i != nba.end(); ++i)
+    l.insert(l.size(), i->first->handle, i->second);
+  neighbours = l;
+  f_index = -1;
+}
+
+/** @brief Start the neighbourhood iteration. */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::VPtr::loopStart()
+{
+  ptr->current = 0;
+  ptr->looping_old = ptr->old;
+  ptr->restore();
+}
+
+/** @brief Check if the neighbourhood iteration is not complete. */
+ template <class PosVertex, class Edge>
+bool algebra::CompactVertex<PosVertex, Edge>::VPtr::loopNotDone()
+{
+  bool ret = (ptr->current < ptr->nb->size());
+  ptr->restore();
+  return ret;
+}
+
+/** @brief Advance the neighbourhood iteration. */
+ template <class PosVertex, class Edge>
+void algebra::CompactVertex<PosVertex, Edge>::VPtr::loopNext()
+{
+  ++(ptr->current);
+}
+
+/** @brief Get the current vertex of neighbourhood iteration. */
+ template <class PosVertex, class Edge>
+typename algebra::CompactVertex<PosVertex, Edge>::VPtr algebra::CompactVertex<PosVertex, Edge>::VPtr::getCurrent()
+{
+  NbList& l = ptr->looping_old ? ptr->old_neighbours : ptr->neighbours;
+  return vowner.vertex(l[ptr->current].v);
+}
+
+/** @Brief Clone the vertex. */
+ template <class PosVertex, class Edge>
+typename algebra::CompactVertex<PosVertex, Edge>::VPtr algebra::CompactVertex<PosVertex, Edge>::clone()
+{
+  VPtr v(new CompactVertex<PosVertex, Edge>());
+  v->neighbours = neighbours;
+  v->position = position;
+  return v;
+}
+
+template <class PosVertex, class Edge>
+typename algebra::CompactVertex<PosVertex, Edge>::VOwner algebra::CompactVertex<PosVertex, Edge>::vowner;
+
+#endif
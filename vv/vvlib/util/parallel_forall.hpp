@@ -0,0 +1,189 @@
+#ifndef UTIL_PARALLEL_FORALL_HPP
+#define UTIL_PARALLEL_FORALL_HPP
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+#include <unordered_map>
+
+namespace util
+{
+  namespace ForAll
+    {
+    /**
+     * Frozen copy of the positions and neighbourhoods of a vertex set.
+     *
+     * Vertices are referred to by their index in the snapshot.  The
+     * first size() vertices are those of the mesh, neighbours that are
+     * not in the mesh follow them and have no neighbourhood.  A
+     * snapshot holds no smart pointers, so it can be read from several
+     * threads at once.
+     */
+    template <class V>
+      class Snapshot
+        {
+      public:
+        typedef typename V::VPtr          VPtr;
+        typedef typename V::position_type position_type;
+
+        /** Returned by the queries when there is no such neighbour. */
+        static const unsigned int none = ~0u;
+
+        template <class Mesh>
+          explicit Snapshot( Mesh& mesh )
+            {
+            std::unordered_map<const void*, unsigned int> index;
+
+            for( mesh.loopStart() ; mesh.loopNotDone() ; mesh.loopNext() )
+              {
+              VPtr v = mesh.getCurrent();
+              v->restore();
+              index[ v.raw() ] = (unsigned int)vertices.size();
+              vertices.push_back( v );
+              positions.push_back( v->getPosition() );
+              }
+            updated = (unsigned int)vertices.size();
+
+            nb_start.push_back( 0 );
+            for( unsigned int i = 0 ; i < updated ; ++i )
+              {
+              VPtr v = vertices[ i ];
+              for( v.loopStart() ; v.loopNotDone() ; v.loopNext() )
+                {
+                VPtr n = v.getCurrent();
+                typename std::unordered_map<const void*, unsigned int>::iterator it = index.find( n.raw() );
+                if( it == index.end() )
+                  {
+                  n->restore();
+                  it = index.insert( std::make_pair( (const void*)n.raw(), (unsigned int)positions.size() ) ).first;
+                  positions.push_back( n->getPosition() );
+                  }
+                nb.push_back( it->second );
+                }
+              nb_start.push_back( (unsigned int)nb.size() );
+              }
+            }
+
+        /** Number of vertices of the mesh. */
+        unsigned int size() const { return updated; }
+
+        const position_type& position( unsigned int i ) const { return positions[ i ]; }
+
+        unsigned int neighbourCount( unsigned int i ) const
+          {
+          return i < updated ? nb_start[ i + 1 ] - nb_start[ i ] : 0;
+          }
+
+        /** The k-th member of the neighbourhood of i. */
+        unsigned int neighbour( unsigned int i, unsigned int k ) const
+          {
+          return nb[ nb_start[ i ] + k ];
+          }
+
+        /** Position of j in the neighbourhood of i, or none. */
+        unsigned int find( unsigned int i, unsigned int j ) const
+          {
+          for( unsigned int k = 0 ; k < neighbourCount( i ) ; ++k )
+            if( neighbour( i, k ) == j )
+              return k;
+          return none;
+          }
+
+        bool in( unsigned int i, unsigned int j ) const { return find( i, j ) != none; }
+
+        /** The neighbour after j in the neighbourhood of i. */
+        unsigned int next( unsigned int i, unsigned int j ) const
+          {
+          unsigned int k = find( i, j );
+          if( k == none ) return none;
+          return neighbour( i, ( k + 1 ) % neighbourCount( i ) );
+          }
+
+        /** The neighbour before j in the neighbourhood of i. */
+        unsigned int prev( unsigned int i, unsigned int j ) const
+          {
+          unsigned int k = find( i, j );
+          if( k == none ) return none;
+          unsigned int n = neighbourCount( i );
+          return neighbour( i, ( k + n - 1 ) % n );
+          }
+
+        /** The vertex of the mesh with index i, only to be used outside of the threads. */
+        VPtr vertex( unsigned int i ) const { return vertices[ i ]; }
+
+      private:
+        std::vector<VPtr>          vertices;
+        std::vector<position_type> positions;
+        std::vector<unsigned int>  nb_start;
+        std::vector<unsigned int>  nb;
+        unsigned int               updated;
+        };
+
+    /**
+     * Synchronous update of all vertices of a mesh on several threads.
+     *
+     * A snapshot of the mesh is taken, then f( snapshot, i, position )
+     * is called for every vertex i of the mesh, concurrently, with
+     * position initialised to the old position of i.  When all vertices
+     * are done, the new positions are written to the vertices at once.
+     * f must only read the snapshot and write position; it must not use
+     * the vertices or smart pointers themselves.  A threads value of 0
+     * uses one thread per processor.
+     */
+    template <class V, class Mesh, class F>
+      void parallel( Mesh& mesh, const F& f, unsigned int threads = 0 )
+        {
+        const unsigned int chunk = 256;
+        Snapshot<V> snapshot( mesh );
+        std::vector<typename V::position_type> result;
+        const unsigned int n = snapshot.size();
+
+        result.reserve( n );
+        for( unsigned int i = 0 ; i < n ; ++i )
+          result.push_back( snapshot.position( i ) );
+
+        if( threads == 0 )
+          threads = std::max( 1u, std::thread::hardware_concurrency() );
+        threads = std::max( 1u, std::min( threads, ( n + chunk - 1 ) / chunk ) );
+
+        std::atomic<unsigned int> next_chunk( 0 );
+        std::vector<std::exception_ptr> errors( threads );
+        auto worker = [ & ]( unsigned int t )
+          {
+          try
+            {
+            unsigned int first;
+            while( ( first = next_chunk.fetch_add( chunk ) ) < n )
+              {
+              unsigned int last = std::min( first + chunk, n );
+              for( unsigned int i = first ; i < last ; ++i )
+                f( snapshot, i, result[ i ] );
+              }
+            }
+          catch( ... )
+            {
+            errors[ t ] = std::current_exception();
+            next_chunk = n;
+            }
+          };
+
+        std::vector<std::thread> pool;
+        for( unsigned int t = 1 ; t < threads ; ++t )
+          pool.push_back( std::thread( worker, t ) );
+        // the calling thread takes part as well
+        worker( 0 );
+        for( unsigned int t = 0 ; t < pool.size() ; ++t )
+          pool[ t ].join();
+
+        for( unsigned int t = 0 ; t < threads ; ++t )
+          if( errors[ t ] )
+            std::rethrow_exception( errors[ t ] );
+
+        for( unsigned int i = 0 ; i < n ; ++i )
+          snapshot.vertex( i )->getPosition() = result[ i ];
+        }
+    }
+}
+
+#endif // UTIL_PARALLEL_FORALL_HPP
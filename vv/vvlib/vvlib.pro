@@ -22,6 +22,8 @@ SOURCES  = \
 HEADERS = \
     ./algebra/abstractmesh.hpp \
     ./algebra/abstractvertex.hpp \
+    ./algebra/compactmesh.hpp \
+    ./algebra/compactvertex.hpp \
     ./algebra/opqueue.hpp \
     ./algebra/xmlmesh.hpp \
     ./algorithms/cloneset.hpp \
@@ -43,6 +45,7 @@ HEADERS = \
     ./util/matrix.hpp \
     ./util/minmax.hpp \
     ./util/palette.hpp \
+    ./util/parallel_forall.hpp \
     ./util/parms.hpp \
     ./util/point.hpp \
     ./util/range.hpp \
@@ -1,11 +1,13 @@
 #include <stdio.h>
 #include <stdarg.h>
+#include <string.h>
 
 extern int yyparse();
 extern FILE* yyin;
 char *filename;
 FILE *out;
 size_t lineno;
+int compact = 0; /* vertices derive from CompactVertex */
 
 struct list_node {
   struct list_node* next;
@@ -55,18 +57,22 @@ void StartVProp() {
   fprintf(out, "struct Position {");
 }
 
+const char* VertexBase() {
+  return compact ? "algebra::CompactVertex" : "algebra::AbstractVertex";
+}
+
 void EndVProp() {
   struct list_node* t_node;
   struct list_node* p_node;
 
-  fprintf(out, "class vertex : public algebra::AbstractVertex<Position, edge> {");
+  fprintf(out, "class vertex : public %s<Position, edge> {", VertexBase());
   fprintf(out, "public:");
 
   t_node = v_types.first;
   p_node = v_properties.first;
 
   if (t_node)
-    fprintf(out, "  vertex() : algebra::AbstractVertex<Position, edge>() {}");
+    fprintf(out, "  vertex() : %s<Position, edge>() {}", VertexBase());
 
   fprintf(out, "  vertex(");
 
@@ -78,7 +84,7 @@ void EndVProp() {
     if (t_node) fprintf(out, ", ");
   }
 
-  fprintf(out, ") : algebra::AbstractVertex<Position, edge>() {");
+  fprintf(out, ") : %s<Position, edge>() {", VertexBase());
 
   p_node = v_properties.first;
   while (p_node) {
@@ -275,8 +281,16 @@ char proxy[] =
     "}";
 #endif
 
+  /* -compact stores the vertices in the compact, index-based
+     form; the mesh is the same XML mesh for both */
+  if (argc == 4 && strcmp(argv[1], "-compact") == 0) {
+    compact = 1;
+    argc--;
+    argv++;
+  }
+
   if (argc != 3) {
-    fprintf(stderr, "Usage: vvp2cpp <input vvp file> <output cpp file>");
+    fprintf(stderr, "Usage: vvp2cpp [-compact] <input vvp file> <output cpp file>");
     return -1;
   }
 